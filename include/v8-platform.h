@@ -236,6 +236,17 @@ class PageAllocator {
    */
   virtual bool SetPermissions(void* address, size_t length,
                               Permission permissions) = 0;
+
+  /**
+   * Makes pages in an allocated range inaccessible and lets the OS reclaim
+   * them. The range must be page aligned and currently accessible with
+   * kReadWrite. Unlike SetPermissions with kNoAccess, the pages are guaranteed
+   * to read as zero once they are made accessible again with SetPermissions,
+   * and the range stays reserved. Returns false if this is not supported, in
+   * which case the range is left unchanged and callers must fall back to
+   * freeing it. The default allocator implements this on all platforms.
+   */
+  virtual bool DecommitPages(void* address, size_t length) { return false; }
 };
 
 /**
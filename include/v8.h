@@ -6749,6 +6749,21 @@ class V8_EXPORT HeapCodeStatistics {
   friend class Isolate;
 };
 
+/**
+ * A bytecode dispatch of the interpreter, as sampled with
+ * --ignition-dispatch-sampling. See Isolate::GetBytecodeDispatchSamples.
+ */
+struct BytecodeDispatchSample {
+  /** The id of the script containing the function, or -1. */
+  int script_id;
+  /** The start position of the function in the script's source. */
+  int function_position;
+  /** The name of the bytecode whose handler dispatched. */
+  const char* bytecode;
+  /** The name of the bytecode it dispatched to. */
+  const char* next_bytecode;
+};
+
 class RetainedObjectInfo;
 
 
@@ -7490,6 +7505,18 @@ class V8_EXPORT Isolate {
    */
   bool GetHeapCodeAndMetadataStatistics(HeapCodeStatistics* object_statistics);
 
+  /**
+   * Get the most recent bytecode dispatches sampled by the interpreter.
+   * Dispatches are only sampled with --ignition-dispatch-sampling.
+   *
+   * \param samples Caller allocated buffer to store the samples in, oldest
+   *   first.
+   * \param capacity The number of samples the buffer can hold.
+   * \returns the number of samples stored.
+   */
+  size_t GetBytecodeDispatchSamples(BytecodeDispatchSample* samples,
+                                    size_t capacity);
+
   /**
    * Get a call stack sample from the isolate.
    * \param state Execution state.
@@ -189,6 +189,10 @@ bool SetPermissions(void* address, size_t size,
   return GetPageAllocator()->SetPermissions(address, size, access);
 }
 
+bool DecommitPages(void* address, size_t size) {
+  return GetPageAllocator()->DecommitPages(address, size);
+}
+
 byte* AllocatePage(void* address, size_t* allocated) {
   size_t page_size = AllocatePageSize();
   void* result =
@@ -131,6 +131,12 @@ inline bool SetPermissions(Address address, size_t size,
   return SetPermissions(reinterpret_cast<void*>(address), size, access);
 }
 
+// Makes the memory inaccessible and lets the OS reclaim it. |address| and
+// |size| must be multiples of CommitPageSize(). The memory reads as zero once
+// it is made accessible again. Returns true on success, otherwise false.
+V8_EXPORT_PRIVATE
+V8_WARN_UNUSED_RESULT bool DecommitPages(void* address, size_t size);
+
 // Convenience function that allocates a single system page with read and write
 // permissions. |address| is a hint. Returns the base address of the memory and
 // the page size via |allocated| on success. Returns nullptr on failure.
@@ -41,6 +41,7 @@
 #include "src/global-handles.h"
 #include "src/globals.h"
 #include "src/icu_util.h"
+#include "src/interpreter/interpreter.h"
 #include "src/isolate-inl.h"
 #include "src/json-parser.h"
 #include "src/json-stringifier.h"
@@ -8531,6 +8532,24 @@ bool Isolate::GetHeapCodeAndMetadataStatistics(
   return true;
 }
 
+size_t Isolate::GetBytecodeDispatchSamples(BytecodeDispatchSample* samples,
+                                           size_t capacity) {
+  i::Isolate* isolate = reinterpret_cast<i::Isolate*>(this);
+  std::vector<i::interpreter::Interpreter::DispatchSample> dispatch_samples(
+      capacity);
+  size_t count = isolate->interpreter()->GetDispatchSamples(
+      dispatch_samples.data(), capacity);
+  for (size_t i = 0; i < count; i++) {
+    const i::interpreter::Interpreter::DispatchSample& sample =
+        dispatch_samples[i];
+    samples[i].script_id = sample.script_id;
+    samples[i].function_position = sample.function_position;
+    samples[i].bytecode = i::interpreter::Bytecodes::ToString(sample.from);
+    samples[i].next_bytecode = i::interpreter::Bytecodes::ToString(sample.to);
+  }
+  return count;
+}
+
 void Isolate::GetStackSample(const RegisterState& state, void** frames,
                              size_t frames_limit, SampleInfo* sample_info) {
   RegisterState regs = state;
@@ -171,6 +171,14 @@ bool OS::SetPermissions(void* address, size_t size, MemoryPermission access) {
   return VirtualAlloc(address, size, MEM_COMMIT, protect) != nullptr;
 }
 
+// static
+bool OS::DecommitPages(void* address, size_t size) {
+  DCHECK_EQ(0, reinterpret_cast<uintptr_t>(address) % CommitPageSize());
+  DCHECK_EQ(0, size % CommitPageSize());
+  // Decommitted pages are zero-filled when they are committed again.
+  return VirtualFree(address, size, MEM_DECOMMIT) != 0;
+}
+
 // static
 bool OS::HasLazyCommits() {
   // TODO(alph): implement for the platform.
@@ -119,6 +119,18 @@ bool OS::SetPermissions(void* address, size_t size, MemoryPermission access) {
                          prot) == ZX_OK;
 }
 
+// static
+bool OS::DecommitPages(void* address, size_t size) {
+  DCHECK_EQ(0, reinterpret_cast<uintptr_t>(address) % CommitPageSize());
+  DCHECK_EQ(0, size % CommitPageSize());
+  // Decommitting needs a writable mapping, so drop the pages before making
+  // the range inaccessible. Decommitted pages are zero-filled on next access.
+  uintptr_t addr = reinterpret_cast<uintptr_t>(address);
+  return zx_vmar_op_range(zx_vmar_root_self(), ZX_VMAR_OP_DECOMMIT, addr, size,
+                          nullptr, 0) == ZX_OK &&
+         zx_vmar_protect(zx_vmar_root_self(), addr, size, 0) == ZX_OK;
+}
+
 // static
 bool OS::HasLazyCommits() {
   // TODO(scottmg): Port, https://crbug.com/731217.
@@ -1190,6 +1190,7 @@ namespace internal {
   /* Wasm */                                                                   \
   ASM(WasmCompileLazy)                                                         \
   TFC(WasmStackGuard, WasmRuntimeCall, 1)                                      \
+  TFC(WasmTierUp, WasmRuntimeCall, 1)                                          \
   TFC(ThrowWasmTrapUnreachable, WasmRuntimeCall, 1)                            \
   TFC(ThrowWasmTrapMemOutOfBounds, WasmRuntimeCall, 1)                         \
   TFC(ThrowWasmTrapDivByZero, WasmRuntimeCall, 1)                              \
@@ -16,6 +16,10 @@ TF_BUILTIN(WasmStackGuard, CodeStubAssembler) {
   TailCallRuntime(Runtime::kWasmStackGuard, NoContextConstant());
 }
 
+TF_BUILTIN(WasmTierUp, CodeStubAssembler) {
+  TailCallRuntime(Runtime::kWasmTierUp, NoContextConstant());
+}
+
 #define DECLARE_ENUM(name)                                                    \
   TF_BUILTIN(ThrowWasm##name, CodeStubAssembler) {                            \
     int message_id = wasm::WasmOpcodes::TrapReasonToMessageId(wasm::k##name); \
@@ -289,6 +289,7 @@ bool Builtins::IsLazy(int index) {
     case kTypedArrayConstructorLazyDeoptContinuation:
     case kWasmCompileLazy:                    // Required by wasm.
     case kWasmStackGuard:                     // Required by wasm.
+    case kWasmTierUp:                         // Required by wasm.
       return false;
     default:
       // TODO(6624): Extend to other kinds.
@@ -323,6 +324,7 @@ bool Builtins::IsIsolateIndependent(int index) {
     // TODO(mstarzinger): Will be made Isolate independent once the CEntry stub
     // is loaded from the instance.
     case kWasmStackGuard:
+    case kWasmTierUp:
       return false;
     default:
       return true;
@@ -84,6 +84,7 @@ class CodeEventListener {
   virtual void SetterCallbackEvent(Name* name, Address entry_point) = 0;
   virtual void RegExpCodeCreateEvent(AbstractCode* code, String* source) = 0;
   virtual void CodeMoveEvent(AbstractCode* from, Address to) = 0;
+  virtual void CodeDeleteEvent(Address start) = 0;
   virtual void SharedFunctionInfoMoveEvent(Address from, Address to) = 0;
   virtual void CodeMovingGCEvent() = 0;
   virtual void CodeDisableOptEvent(AbstractCode* code,
@@ -158,6 +159,9 @@ class CodeEventDispatcher {
   void CodeMoveEvent(AbstractCode* from, Address to) {
     CODE_EVENT_DISPATCH(CodeMoveEvent(from, to));
   }
+  void CodeDeleteEvent(Address start) {
+    CODE_EVENT_DISPATCH(CodeDeleteEvent(start));
+  }
   void SharedFunctionInfoMoveEvent(Address from, Address to) {
     CODE_EVENT_DISPATCH(SharedFunctionInfoMoveEvent(from, to));
   }
@@ -4,6 +4,8 @@
 
 #include "src/compiler-dispatcher/optimizing-compile-dispatcher.h"
 
+#include <algorithm>
+
 #include "src/base/atomicops.h"
 #include "src/base/template-utils.h"
 #include "src/cancelable-task.h"
@@ -66,7 +68,9 @@ class OptimizingCompileDispatcher::CompileTask : public CancelableTask {
             dispatcher_->recompilation_delay_));
       }
 
-      dispatcher_->CompileNext(dispatcher_->NextInput(true));
+      size_t memory = 0;
+      OptimizedCompilationJob* job = dispatcher_->NextInput(&memory, true);
+      dispatcher_->CompileNext(job, memory);
     }
     {
       base::LockGuard<base::Mutex> lock_guard(&dispatcher_->ref_count_mutex_);
@@ -89,18 +93,42 @@ OptimizingCompileDispatcher::~OptimizingCompileDispatcher() {
     DCHECK_EQ(0, ref_count_);
   }
 #endif
-  DCHECK_EQ(0, input_queue_length_);
-  DeleteArray(input_queue_);
+  DCHECK(input_queue_.empty());
+  DCHECK_EQ(0u, in_flight_memory_);
+}
+
+bool OptimizingCompileDispatcher::IsQueueAvailable() {
+  {
+    base::LockGuard<base::Mutex> access_input_queue(&input_queue_mutex_);
+    if (input_queue_capacity_ > 0 &&
+        input_queue_.size() >= static_cast<size_t>(input_queue_capacity_)) {
+      return false;
+    }
+  }
+  if (max_queue_memory_ == 0) return true;
+  return queued_memory() < max_queue_memory_;
+}
+
+size_t OptimizingCompileDispatcher::queued_memory() {
+  // Hold both locks so that a job moving to the output queue is not missed
+  // or counted twice.
+  base::LockGuard<base::Mutex> access_input_queue(&input_queue_mutex_);
+  base::LockGuard<base::Mutex> access_output_queue(&output_queue_mutex_);
+  return input_queue_memory_ + in_flight_memory_ + output_queue_memory_;
 }
 
 OptimizedCompilationJob* OptimizingCompileDispatcher::NextInput(
-    bool check_if_flushing) {
+    size_t* memory, bool check_if_flushing) {
   base::LockGuard<base::Mutex> access_input_queue_(&input_queue_mutex_);
-  if (input_queue_length_ == 0) return nullptr;
-  OptimizedCompilationJob* job = input_queue_[InputQueueIndex(0)];
+  *memory = 0;
+  if (input_queue_.empty()) return nullptr;
+  std::pop_heap(input_queue_.begin(), input_queue_.end());
+  OptimizedCompilationJob* job = input_queue_.back().job;
+  size_t job_memory = input_queue_.back().memory;
   DCHECK_NOT_NULL(job);
-  input_queue_shift_ = InputQueueIndex(1);
-  input_queue_length_--;
+  DCHECK_GE(input_queue_memory_, job_memory);
+  input_queue_memory_ -= job_memory;
+  input_queue_.pop_back();
   if (check_if_flushing) {
     if (static_cast<ModeFlag>(base::Acquire_Load(&mode_)) == FLUSH) {
       AllowHandleDereference allow_handle_dereference;
@@ -108,34 +136,47 @@ OptimizedCompilationJob* OptimizingCompileDispatcher::NextInput(
       return nullptr;
     }
   }
+  in_flight_memory_ += job_memory;
+  *memory = job_memory;
   return job;
 }
 
-void OptimizingCompileDispatcher::CompileNext(OptimizedCompilationJob* job) {
+void OptimizingCompileDispatcher::CompileNext(OptimizedCompilationJob* job,
+                                              size_t memory) {
   if (!job) return;
 
   // The function may have already been optimized by OSR.  Simply continue.
   CompilationJob::Status status = job->ExecuteJob();
   USE(status);  // Prevent an unused-variable error.
 
+  // The zones of the job stay alive until it is installed, account for them
+  // again now that the job is done growing them.
+  size_t output_memory = job->AllocatedMemory();
+
   // The function may have already been optimized by OSR.  Simply continue.
   // Use a mutex to make sure that functions marked for install
   // are always also queued.
+  base::LockGuard<base::Mutex> access_input_queue_(&input_queue_mutex_);
   base::LockGuard<base::Mutex> access_output_queue_(&output_queue_mutex_);
-  output_queue_.push(job);
+  DCHECK_GE(in_flight_memory_, memory);
+  in_flight_memory_ -= memory;
+  output_queue_.push({job, output_memory});
+  output_queue_memory_ += output_memory;
   isolate_->stack_guard()->RequestInstallCode();
 }
 
-void OptimizingCompileDispatcher::FlushOutputQueue(bool restore_function_code) {
-  for (;;) {
-    OptimizedCompilationJob* job = nullptr;
-    {
-      base::LockGuard<base::Mutex> access_output_queue_(&output_queue_mutex_);
-      if (output_queue_.empty()) return;
-      job = output_queue_.front();
-      output_queue_.pop();
-    }
+OptimizedCompilationJob* OptimizingCompileDispatcher::NextOutput() {
+  base::LockGuard<base::Mutex> access_output_queue_(&output_queue_mutex_);
+  if (output_queue_.empty()) return nullptr;
+  OutputQueueEntry entry = output_queue_.front();
+  output_queue_.pop();
+  DCHECK_GE(output_queue_memory_, entry.memory);
+  output_queue_memory_ -= entry.memory;
+  return entry.job;
+}
 
+void OptimizingCompileDispatcher::FlushOutputQueue(bool restore_function_code) {
+  while (OptimizedCompilationJob* job = NextOutput()) {
     DisposeCompilationJob(job, restore_function_code);
   }
 }
@@ -143,13 +184,13 @@ void OptimizingCompileDispatcher::FlushOutputQueue(bool restore_function_code) {
 void OptimizingCompileDispatcher::Flush(BlockingBehavior blocking_behavior) {
   if (blocking_behavior == BlockingBehavior::kDontBlock) {
     if (FLAG_block_concurrent_recompilation) Unblock();
-    base::LockGuard<base::Mutex> access_input_queue_(&input_queue_mutex_);
-    while (input_queue_length_ > 0) {
-      OptimizedCompilationJob* job = input_queue_[InputQueueIndex(0)];
-      DCHECK_NOT_NULL(job);
-      input_queue_shift_ = InputQueueIndex(1);
-      input_queue_length_--;
-      DisposeCompilationJob(job, true);
+    {
+      base::LockGuard<base::Mutex> access_input_queue_(&input_queue_mutex_);
+      for (const InputQueueEntry& entry : input_queue_) {
+        DisposeCompilationJob(entry.job, true);
+      }
+      input_queue_.clear();
+      input_queue_memory_ = 0;
     }
     FlushOutputQueue(true);
     if (FLAG_trace_concurrent_recompilation) {
@@ -181,8 +222,12 @@ void OptimizingCompileDispatcher::Stop() {
 
   if (recompilation_delay_ != 0) {
     // At this point the optimizing compiler thread's event loop has stopped.
-    // There is no need for a mutex when reading input_queue_length_.
-    while (input_queue_length_ > 0) CompileNext(NextInput());
+    // There is no need for a mutex when reading input_queue_.
+    while (!input_queue_.empty()) {
+      size_t memory = 0;
+      OptimizedCompilationJob* job = NextInput(&memory);
+      CompileNext(job, memory);
+    }
     InstallOptimizedFunctions();
   } else {
     FlushOutputQueue(false);
@@ -192,14 +237,7 @@ void OptimizingCompileDispatcher::Stop() {
 void OptimizingCompileDispatcher::InstallOptimizedFunctions() {
   HandleScope handle_scope(isolate_);
 
-  for (;;) {
-    OptimizedCompilationJob* job = nullptr;
-    {
-      base::LockGuard<base::Mutex> access_output_queue_(&output_queue_mutex_);
-      if (output_queue_.empty()) return;
-      job = output_queue_.front();
-      output_queue_.pop();
-    }
+  while (OptimizedCompilationJob* job = NextOutput()) {
     OptimizedCompilationInfo* info = job->compilation_info();
     Handle<JSFunction> function(*info->closure());
     if (function->HasOptimizedCode()) {
@@ -216,14 +254,15 @@ void OptimizingCompileDispatcher::InstallOptimizedFunctions() {
 }
 
 void OptimizingCompileDispatcher::QueueForOptimization(
-    OptimizedCompilationJob* job) {
+    OptimizedCompilationJob* job, int priority) {
   DCHECK(IsQueueAvailable());
+  size_t memory = job->AllocatedMemory();
   {
-    // Add job to the back of the input queue.
+    // Add job to the input queue, behind the jobs of at least its priority.
     base::LockGuard<base::Mutex> access_input_queue(&input_queue_mutex_);
-    DCHECK_LT(input_queue_length_, input_queue_capacity_);
-    input_queue_[InputQueueIndex(input_queue_length_)] = job;
-    input_queue_length_++;
+    input_queue_.push_back({job, priority, input_queue_sequence_++, memory});
+    input_queue_memory_ += memory;
+    std::push_heap(input_queue_.begin(), input_queue_.end());
   }
   if (FLAG_block_concurrent_recompilation) {
     blocked_jobs_++;
@@ -6,6 +6,7 @@
 #define V8_COMPILER_DISPATCHER_OPTIMIZING_COMPILE_DISPATCHER_H_
 
 #include <queue>
+#include <vector>
 
 #include "src/allocation.h"
 #include "src/base/atomicops.h"
@@ -14,6 +15,7 @@
 #include "src/base/platform/platform.h"
 #include "src/flags.h"
 #include "src/globals.h"
+#include "testing/gtest/include/gtest/gtest_prod.h"  // nogncheck
 
 namespace v8 {
 namespace internal {
@@ -26,58 +28,98 @@ class V8_EXPORT_PRIVATE OptimizingCompileDispatcher {
   explicit OptimizingCompileDispatcher(Isolate* isolate)
       : isolate_(isolate),
         input_queue_capacity_(FLAG_concurrent_recompilation_queue_length),
-        input_queue_length_(0),
-        input_queue_shift_(0),
+        input_queue_sequence_(0),
+        input_queue_memory_(0),
+        in_flight_memory_(0),
+        output_queue_memory_(0),
+        max_queue_memory_(
+            static_cast<size_t>(FLAG_concurrent_recompilation_max_memory) *
+            MB),
         blocked_jobs_(0),
         ref_count_(0),
         recompilation_delay_(FLAG_concurrent_recompilation_delay) {
     base::Relaxed_Store(&mode_, static_cast<base::AtomicWord>(COMPILE));
-    input_queue_ = NewArray<OptimizedCompilationJob*>(input_queue_capacity_);
   }
 
   ~OptimizingCompileDispatcher();
 
   void Stop();
   void Flush(BlockingBehavior blocking_behavior);
-  // Takes ownership of |job|.
-  void QueueForOptimization(OptimizedCompilationJob* job);
+  // Takes ownership of |job|. Jobs with a higher |priority| (usually the
+  // invocation count of the function) are compiled first, jobs of equal
+  // priority in the order they were queued.
+  void QueueForOptimization(OptimizedCompilationJob* job, int priority = 0);
   void Unblock();
   void InstallOptimizedFunctions();
 
-  inline bool IsQueueAvailable() {
-    base::LockGuard<base::Mutex> access_input_queue(&input_queue_mutex_);
-    return input_queue_length_ < input_queue_capacity_;
-  }
+  // Returns false if the input queue is full, or if the jobs owned by the
+  // dispatcher hold more than --concurrent-recompilation-max-memory.
+  bool IsQueueAvailable();
+
+  // Zone memory held by jobs that are waiting to be compiled, being compiled
+  // or waiting to be installed.
+  size_t queued_memory();
 
   static bool Enabled() { return FLAG_concurrent_recompilation; }
 
  private:
+  FRIEND_TEST(OptimizingCompileDispatcherTest, PriorityOrder);
+
   class CompileTask;
 
   enum ModeFlag { COMPILE, FLUSH };
 
+  struct InputQueueEntry {
+    OptimizedCompilationJob* job;
+    int priority;
+    uint64_t sequence;
+    size_t memory;
+
+    // Orders the entries of the input queue heap, whose top is the entry with
+    // the highest priority that was queued first.
+    bool operator<(const InputQueueEntry& other) const {
+      if (priority != other.priority) return priority < other.priority;
+      return sequence > other.sequence;
+    }
+  };
+
+  struct OutputQueueEntry {
+    OptimizedCompilationJob* job;
+    size_t memory;
+  };
+
   void FlushOutputQueue(bool restore_function_code);
-  void CompileNext(OptimizedCompilationJob* job);
-  OptimizedCompilationJob* NextInput(bool check_if_flushing = false);
-
-  inline int InputQueueIndex(int i) {
-    int result = (i + input_queue_shift_) % input_queue_capacity_;
-    DCHECK_LE(0, result);
-    DCHECK_LT(result, input_queue_capacity_);
-    return result;
-  }
+  // |memory| is what NextInput charged to the in-flight jobs for |job|.
+  void CompileNext(OptimizedCompilationJob* job, size_t memory);
+  // Takes the job with the highest priority out of the input queue. Its
+  // memory, returned in |memory|, stays charged to the in-flight jobs until
+  // CompileNext hands the job to the output queue.
+  OptimizedCompilationJob* NextInput(size_t* memory,
+                                     bool check_if_flushing = false);
+  OptimizedCompilationJob* NextOutput();
 
   Isolate* isolate_;
 
-  // Circular queue of incoming recompilation tasks (including OSR).
-  OptimizedCompilationJob** input_queue_;
+  // Heap of incoming recompilation tasks (including OSR), ordered by
+  // priority. A capacity of 0 means that the queue is not bounded.
+  std::vector<InputQueueEntry> input_queue_;
   int input_queue_capacity_;
-  int input_queue_length_;
-  int input_queue_shift_;
+  uint64_t input_queue_sequence_;
+  // Zone memory held by the jobs in the input queue.
+  size_t input_queue_memory_;
+  // Zone memory held by the jobs taken out of the input queue that are not
+  // yet in the output queue, as of when they were taken out. Guarded by
+  // |input_queue_mutex_|.
+  size_t in_flight_memory_;
   base::Mutex input_queue_mutex_;
 
   // Queue of recompilation tasks ready to be installed (excluding OSR).
-  std::queue<OptimizedCompilationJob*> output_queue_;
+  std::queue<OutputQueueEntry> output_queue_;
+  // Zone memory held by the jobs in the output queue.
+  size_t output_queue_memory_;
+  // Limit on the memory held by the jobs in both queues and in flight (0
+  // means no limit).
+  size_t max_queue_memory_;
   // Used for job based recompilation which has multiple producers on
   // different threads.
   base::Mutex output_queue_mutex_;
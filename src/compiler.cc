@@ -13,6 +13,9 @@
 #include "src/ast/prettyprinter.h"
 #include "src/ast/scopes.h"
 #include "src/base/optional.h"
+#include "src/base/platform/condition-variable.h"
+#include "src/base/platform/mutex.h"
+#include "src/base/template-utils.h"
 #include "src/bootstrapper.h"
 #include "src/compilation-cache.h"
 #include "src/compiler-dispatcher/compiler-dispatcher.h"
@@ -36,6 +39,7 @@
 #include "src/parsing/scanner-character-streams.h"
 #include "src/runtime-profiler.h"
 #include "src/snapshot/code-serializer.h"
+#include "src/snapshot/persistent-code-cache.h"
 #include "src/unicode-cache.h"
 #include "src/unoptimized-compilation-info.h"
 #include "src/vm-state-inl.h"
@@ -441,10 +445,147 @@ CompilationJob::Status FinalizeUnoptimizedCompilationJob(
 std::unique_ptr<UnoptimizedCompilationJob> ExecuteUnoptimizedCompileJobs(
     ParseInfo* parse_info, FunctionLiteral* literal,
     AccountingAllocator* allocator,
-    UnoptimizedCompilationJobList* inner_function_jobs) {
+    UnoptimizedCompilationJobList* inner_function_jobs, Zone* zone,
+    uintptr_t stack_limit);
+
+// Compiles the eager inner functions of the top-level function of a streamed
+// script on worker threads, in parallel with the streaming thread. Worker
+// tasks that only start running once all functions have been compiled find
+// no work left and only touch this object, which they keep alive.
+class ParallelInnerFunctionCompilation {
+ public:
+  ParallelInnerFunctionCompilation(
+      ParseInfo* parse_info, AccountingAllocator* allocator,
+      const ZoneVector<FunctionLiteral*>& literals)
+      : parse_info_(parse_info),
+        allocator_(allocator),
+        literals_(literals.begin(), literals.end()),
+        next_literal_(0),
+        running_(0),
+        failed_(false) {}
+
+  static bool ShouldCompileInParallel(
+      ParseInfo* parse_info, FunctionLiteral* literal,
+      const ZoneVector<FunctionLiteral*>& eager_inner_literals) {
+    // Only the inner functions of the top-level function are distributed, so
+    // that worker threads never block on nested compilations. Runtime call
+    // stats and source range maps are not thread-safe, and asm.js validation
+    // uses the stack limit of the streaming thread.
+    return FLAG_parallel_compile_tasks && parse_info->on_background_thread() &&
+           literal == parse_info->literal() &&
+           eager_inner_literals.size() > 1 &&
+           !literal->scope()->ContainsAsmModule() &&
+           parse_info->runtime_call_stats() == nullptr &&
+           parse_info->source_range_map() == nullptr;
+  }
+
+  // Compiles inner functions (and their eager inner functions) until there
+  // are none left, using |stack_limit| for the current thread.
+  void CompileUntilDone(uintptr_t stack_limit) {
+    for (;;) {
+      FunctionLiteral* literal;
+      {
+        base::LockGuard<base::Mutex> guard(&mutex_);
+        if (failed_ || next_literal_ == literals_.size()) return;
+        literal = literals_[next_literal_++];
+        running_++;
+      }
+
+      Zone zone(allocator_, ZONE_NAME);
+      UnoptimizedCompilationJobList inner_function_jobs;
+      std::unique_ptr<UnoptimizedCompilationJob> job(
+          ExecuteUnoptimizedCompileJobs(parse_info_, literal, allocator_,
+                                        &inner_function_jobs, &zone,
+                                        stack_limit));
+
+      base::LockGuard<base::Mutex> guard(&mutex_);
+      if (job) {
+        jobs_.emplace_front(std::move(job));
+        jobs_.splice_after(jobs_.before_begin(), inner_function_jobs);
+      } else {
+        failed_ = true;
+      }
+      if (--running_ == 0) idle_.NotifyAll();
+    }
+  }
+
+  // Waits for the functions still being compiled on other threads and moves
+  // all jobs to |inner_function_jobs|. Returns false if any compile failed.
+  bool WaitAndTakeJobs(UnoptimizedCompilationJobList* inner_function_jobs) {
+    base::LockGuard<base::Mutex> guard(&mutex_);
+    while (running_ > 0) idle_.Wait(&mutex_);
+    if (failed_) return false;
+    inner_function_jobs->splice_after(inner_function_jobs->before_begin(),
+                                      jobs_);
+    return true;
+  }
+
+ private:
+  ParseInfo* const parse_info_;
+  AccountingAllocator* const allocator_;
+  std::vector<FunctionLiteral*> literals_;
+
+  base::Mutex mutex_;
+  base::ConditionVariable idle_;
+  size_t next_literal_;
+  int running_;
+  bool failed_;
+  UnoptimizedCompilationJobList jobs_;
+
+  DISALLOW_COPY_AND_ASSIGN(ParallelInnerFunctionCompilation);
+};
+
+class ParallelInnerFunctionCompileTask : public v8::Task {
+ public:
+  ParallelInnerFunctionCompileTask(
+      std::shared_ptr<ParallelInnerFunctionCompilation> compilation)
+      : compilation_(compilation), stack_size_(FLAG_stack_size) {}
+
+  void Run() override {
+    DisallowHeapAllocation no_allocation;
+    DisallowHandleAllocation no_handles;
+    DisallowHandleDereference no_deref;
+    uintptr_t stack_limit = GetCurrentStackPosition() - stack_size_ * KB;
+    compilation_->CompileUntilDone(stack_limit);
+  }
+
+ private:
+  std::shared_ptr<ParallelInnerFunctionCompilation> compilation_;
+  int stack_size_;
+
+  DISALLOW_COPY_AND_ASSIGN(ParallelInnerFunctionCompileTask);
+};
+
+bool ExecuteInnerFunctionCompileJobsInParallel(
+    ParseInfo* parse_info, const ZoneVector<FunctionLiteral*>& literals,
+    AccountingAllocator* allocator,
+    UnoptimizedCompilationJobList* inner_function_jobs,
+    uintptr_t stack_limit) {
+  parse_info->set_compiled_in_parallel();
+  std::shared_ptr<ParallelInnerFunctionCompilation> compilation =
+      std::make_shared<ParallelInnerFunctionCompilation>(parse_info, allocator,
+                                                         literals);
+  size_t num_tasks =
+      std::min(literals.size() - 1,
+               static_cast<size_t>(
+                   V8::GetCurrentPlatform()->NumberOfWorkerThreads()));
+  for (size_t i = 0; i < num_tasks; i++) {
+    V8::GetCurrentPlatform()->CallOnWorkerThread(
+        base::make_unique<ParallelInnerFunctionCompileTask>(compilation));
+  }
+  compilation->CompileUntilDone(stack_limit);
+  return compilation->WaitAndTakeJobs(inner_function_jobs);
+}
+
+std::unique_ptr<UnoptimizedCompilationJob> ExecuteUnoptimizedCompileJobs(
+    ParseInfo* parse_info, FunctionLiteral* literal,
+    AccountingAllocator* allocator,
+    UnoptimizedCompilationJobList* inner_function_jobs, Zone* zone,
+    uintptr_t stack_limit) {
   if (UseAsmWasm(literal, parse_info->is_asm_wasm_broken())) {
     std::unique_ptr<UnoptimizedCompilationJob> asm_job(
         AsmJs::NewCompilationJob(parse_info, literal, allocator));
+    asm_job->set_stack_limit(stack_limit);
     if (asm_job->ExecuteJob() == CompilationJob::SUCCEEDED) {
       return asm_job;
     }
@@ -454,21 +595,32 @@ std::unique_ptr<UnoptimizedCompilationJob> ExecuteUnoptimizedCompileJobs(
     // with a validation error or another error that could be solve by falling
     // through to standard unoptimized compile.
   }
-  ZoneVector<FunctionLiteral*> eager_inner_literals(0, parse_info->zone());
+  ZoneVector<FunctionLiteral*> eager_inner_literals(0, zone);
   std::unique_ptr<UnoptimizedCompilationJob> job(
       interpreter::Interpreter::NewCompilationJob(
           parse_info, literal, allocator, &eager_inner_literals));
+  job->set_stack_limit(stack_limit);
 
   if (job->ExecuteJob() != CompilationJob::SUCCEEDED) {
     // Compilation failed, return null.
     return std::unique_ptr<UnoptimizedCompilationJob>();
   }
 
+  if (ParallelInnerFunctionCompilation::ShouldCompileInParallel(
+          parse_info, literal, eager_inner_literals)) {
+    if (!ExecuteInnerFunctionCompileJobsInParallel(
+            parse_info, eager_inner_literals, allocator, inner_function_jobs,
+            stack_limit)) {
+      return std::unique_ptr<UnoptimizedCompilationJob>();
+    }
+    return job;
+  }
+
   // Recursively compile eager inner literals.
   for (FunctionLiteral* inner_literal : eager_inner_literals) {
     std::unique_ptr<UnoptimizedCompilationJob> inner_job(
         ExecuteUnoptimizedCompileJobs(parse_info, inner_literal, allocator,
-                                      inner_function_jobs));
+                                      inner_function_jobs, zone, stack_limit));
     // Compilation failed, return null.
     if (!inner_job) return std::unique_ptr<UnoptimizedCompilationJob>();
     inner_function_jobs->emplace_front(std::move(inner_job));
@@ -491,8 +643,9 @@ std::unique_ptr<UnoptimizedCompilationJob> GenerateUnoptimizedCode(
 
   // Prepare and execute compilation of the outer-most function.
   std::unique_ptr<UnoptimizedCompilationJob> outer_function_job(
-      ExecuteUnoptimizedCompileJobs(parse_info, parse_info->literal(),
-                                    allocator, inner_function_jobs));
+      ExecuteUnoptimizedCompileJobs(
+          parse_info, parse_info->literal(), allocator, inner_function_jobs,
+          parse_info->zone(), parse_info->stack_limit()));
   if (!outer_function_job) return std::unique_ptr<UnoptimizedCompilationJob>();
 
   // Character stream shouldn't be used again.
@@ -630,9 +783,12 @@ bool GetOptimizedCodeNow(OptimizedCompilationJob* job, Isolate* isolate) {
   return true;
 }
 
-bool GetOptimizedCodeLater(OptimizedCompilationJob* job, Isolate* isolate) {
+bool GetOptimizedCodeLater(OptimizedCompilationJob* job, Isolate* isolate,
+                           int priority) {
   OptimizedCompilationInfo* compilation_info = job->compilation_info();
-  if (!isolate->optimizing_compile_dispatcher()->IsQueueAvailable()) {
+  OptimizingCompileDispatcher* dispatcher =
+      isolate->optimizing_compile_dispatcher();
+  if (!dispatcher->IsQueueAvailable()) {
     if (FLAG_trace_concurrent_recompilation) {
       PrintF("  ** Compilation queue full, will retry optimizing ");
       compilation_info->closure()->ShortPrint();
@@ -657,7 +813,7 @@ bool GetOptimizedCodeLater(OptimizedCompilationJob* job, Isolate* isolate) {
                "V8.RecompileSynchronous");
 
   if (job->PrepareJob(isolate) != CompilationJob::SUCCEEDED) return false;
-  isolate->optimizing_compile_dispatcher()->QueueForOptimization(job);
+  dispatcher->QueueForOptimization(job, priority);
 
   if (FLAG_trace_concurrent_recompilation) {
     PrintF("  ** Queued ");
@@ -699,8 +855,13 @@ MaybeHandle<Code> GetOptimizedCode(Handle<JSFunction> function,
     return cached_code;
   }
 
-  // Reset profiler ticks, function is no longer considered hot.
+  // Functions that were called more often are compiled first when
+  // optimizing concurrently. Profiler ticks are not used for this since they
+  // are reset whenever the function is optimized or deoptimized.
   DCHECK(shared->is_compiled());
+  int const priority = function->feedback_vector()->invocation_count();
+
+  // Reset profiler ticks, function is no longer considered hot.
   function->feedback_vector()->set_profiler_ticks(0);
 
   VMState<COMPILER> state(isolate);
@@ -758,7 +919,7 @@ MaybeHandle<Code> GetOptimizedCode(Handle<JSFunction> function,
   compilation_info->ReopenHandlesInNewHandleScope();
 
   if (mode == ConcurrencyMode::kConcurrent) {
-    if (GetOptimizedCodeLater(job.get(), isolate)) {
+    if (GetOptimizedCodeLater(job.get(), isolate, priority)) {
       job.release();  // The background recompile job owns this now.
 
       // Set the optimization marker and return a code object which checks it.
@@ -1700,6 +1861,24 @@ MaybeHandle<SharedFunctionInfo> Compiler::GetSharedFunctionInfoForScript(
         // Deserializer failed. Fall through to compile.
         compile_timer.set_consuming_code_cache_failed();
       }
+    } else if (PersistentCodeCache::IsEnabled() &&
+               natives == NOT_NATIVES_CODE && !origin_options.IsModule() &&
+               !isolate->debug()->is_loaded()) {
+      // Then check the code cache persisted by earlier processes.
+      HistogramTimerScope timer(isolate->counters()->compile_deserialize());
+      RuntimeCallTimerScope runtimeTimer(
+          isolate, RuntimeCallCounterId::kCompileDeserialize);
+      TRACE_EVENT0(TRACE_DISABLED_BY_DEFAULT("v8.compile"),
+                   "V8.CompileDeserialize");
+      Handle<SharedFunctionInfo> inner_result;
+      if (PersistentCodeCache::Lookup(isolate, source, origin_options)
+              .ToHandle(&inner_result)) {
+        // Promote to per-isolate compilation cache.
+        DCHECK(inner_result->is_compiled());
+        compilation_cache->PutScript(source, isolate->native_context(),
+                                     language_mode, inner_result);
+        maybe_result = inner_result;
+      }
     }
   }
 
@@ -1723,6 +1902,9 @@ MaybeHandle<SharedFunctionInfo> Compiler::GetSharedFunctionInfoForScript(
       DCHECK(result->is_compiled());
       compilation_cache->PutScript(source, isolate->native_context(),
                                    language_mode, result);
+      if (PersistentCodeCache::IsEnabled() && natives == NOT_NATIVES_CODE) {
+        PersistentCodeCache::ScheduleStoreScript(isolate, result);
+      }
     } else if (maybe_result.is_null() && natives != EXTENSION_CODE &&
                natives != NATIVES_CODE) {
       isolate->ReportPendingMessages();
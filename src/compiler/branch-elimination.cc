@@ -43,6 +43,8 @@ Reduction BranchElimination::Reduce(Node* node) {
       return ReduceIf(node, true);
     case IrOpcode::kStart:
       return ReduceStart(node);
+    case IrOpcode::kCheckBounds:
+      return ReduceCheckBounds(node);
     default:
       if (node->op()->ControlOutputCount() > 0) {
         return ReduceOtherControl(node);
@@ -90,6 +92,73 @@ Reduction BranchElimination::ReduceBranch(Node* node) {
   return TakeConditionsFromFirstControl(node);
 }
 
+Reduction BranchElimination::ReduceCheckBounds(Node* node) {
+  if (!FLAG_turbo_bounds_check_elimination) return NoChange();
+  Node* index = NodeProperties::GetValueInput(node, 0);
+  Node* length = NodeProperties::GetValueInput(node, 1);
+  Node* effect = NodeProperties::GetEffectInput(node);
+  Node* control = NodeProperties::GetControlInput(node);
+  // If we do not know anything about the predecessor, wait until we do.
+  if (!reduced_.Get(control)) {
+    return NoChange();
+  }
+
+  // The lower bound of the check is only redundant if the typer proved that
+  // {index} is a non-negative integer, which is the case for the induction
+  // variables of loops counting up from zero.
+  if (!NodeProperties::IsTyped(node) || !NodeProperties::IsTyped(index) ||
+      !NodeProperties::GetType(index).Is(Type::Unsigned32())) {
+    return NoChange();
+  }
+
+  // Look for a dominating condition that proves {index} < {length}, i.e.
+  // either (index < length) being true or (length <= index) being false.
+  ControlPathConditions conditions = node_conditions_.Get(control);
+  Node* branch = nullptr;
+  for (Node* const use : index->uses()) {
+    bool expected_value;
+    switch (use->opcode()) {
+      case IrOpcode::kNumberLessThan:
+      case IrOpcode::kSpeculativeNumberLessThan:
+        if (use->InputAt(0) != index || use->InputAt(1) != length) continue;
+        expected_value = true;
+        break;
+      case IrOpcode::kNumberLessThanOrEqual:
+      case IrOpcode::kSpeculativeNumberLessThanOrEqual:
+        if (use->InputAt(0) != length || use->InputAt(1) != index) continue;
+        expected_value = false;
+        break;
+      default:
+        continue;
+    }
+    bool condition_value;
+    if (conditions.LookupCondition(use, &branch, &condition_value) &&
+        condition_value == expected_value && !branch->IsDead()) {
+      break;
+    }
+    branch = nullptr;
+  }
+  if (branch == nullptr) return NoChange();
+
+  // The {branch} now guards a memory access, so mark it as a safety check.
+  IsSafetyCheck branch_safety = IsSafetyCheckOf(branch->op());
+  IsSafetyCheck combined_safety =
+      CombineSafetyChecks(branch_safety, IsSafetyCheck::kCriticalSafetyCheck);
+  if (branch_safety != combined_safety) {
+    NodeProperties::ChangeOp(
+        branch, common()->MarkAsSafetyCheck(branch->op(), combined_safety));
+  }
+
+  // Keep the type of the bounds check, which is narrower than the type of
+  // {index}, for representation selection.
+  Type const type = NodeProperties::GetType(node);
+  Node* value = graph()->NewNode(common()->TypeGuard(type), index, effect,
+                                 control);
+  NodeProperties::SetType(value, type);
+  ReplaceWithValue(node, value, value, control);
+  return Replace(value);
+}
+
 Reduction BranchElimination::ReduceDeoptimizeConditional(Node* node) {
   DCHECK(node->opcode() == IrOpcode::kDeoptimizeIf ||
          node->opcode() == IrOpcode::kDeoptimizeUnless);
@@ -814,6 +814,8 @@ class PipelineCompilationJob final : public OptimizedCompilationJob {
         pipeline_(&data_),
         linkage_(nullptr) {}
 
+  size_t AllocatedMemory() const override;
+
  protected:
   Status PrepareJobImpl(Isolate* isolate) final;
   Status ExecuteJobImpl() final;
@@ -900,6 +902,10 @@ PipelineCompilationJob::Status PipelineCompilationJob::ExecuteJobImpl() {
   return SUCCEEDED;
 }
 
+size_t PipelineCompilationJob::AllocatedMemory() const {
+  return zone_.allocation_size() + zone_stats_.GetCurrentAllocatedBytes();
+}
+
 PipelineCompilationJob::Status PipelineCompilationJob::FinalizeJobImpl(
     Isolate* isolate) {
   Handle<Code> code = pipeline_.FinalizeCode();
@@ -29,6 +29,7 @@
 #include "src/compiler/machine-operator.h"
 #include "src/compiler/node-matchers.h"
 #include "src/compiler/node-origin-table.h"
+#include "src/compiler/node-properties.h"
 #include "src/compiler/pipeline.h"
 #include "src/compiler/simd-scalar-lowering.h"
 #include "src/compiler/zone-stats.h"
@@ -121,6 +122,7 @@ WasmGraphBuilder::WasmGraphBuilder(
       cur_bufsize_(kDefaultBufferSize),
       has_simd_(ContainsSimd(sig)),
       untrusted_code_mitigations_(FLAG_untrusted_code_mitigations),
+      bounds_checks_(zone),
       sig_(sig),
       source_position_table_(source_position_table) {
   DCHECK_IMPLIES(use_trap_handler(), trap_handler::IsTrapHandlerEnabled());
@@ -3090,9 +3092,15 @@ Node* WasmGraphBuilder::BoundsCheckMem(uint8_t access_size, Node* index,
   Node* effective_size = graph()->NewNode(mcgraph()->machine()->Int32Sub(),
                                           mem_size, end_offset_node);
 
-  // Introduce the actual bounds check.
-  Node* cond = graph()->NewNode(m->Uint32LessThan(), index, effective_size);
-  TrapIfFalse(wasm::kTrapMemOutOfBounds, cond, position);
+  // Introduce the actual bounds check, unless a dominating check already
+  // covers this access.
+  if (!FLAG_wasm_bounds_check_elimination ||
+      !IsBoundsCheckRedundant(index, end_offset)) {
+    Node* cond = graph()->NewNode(m->Uint32LessThan(), index, effective_size);
+    Node* check = TrapIfFalse(wasm::kTrapMemOutOfBounds, cond, position);
+    bounds_checks_.insert(
+        std::make_pair(check, BoundsCheck{index, end_offset}));
+  }
 
   if (untrusted_code_mitigations_) {
     // In the fallthrough case, condition the index with the memory mask.
@@ -3103,6 +3111,39 @@ Node* WasmGraphBuilder::BoundsCheckMem(uint8_t access_size, Node* index,
   return Uint32ToUintptr(index);
 }
 
+// Memory never shrinks, so a bounds check that dominates the current position
+// makes checks of the same index with no larger end offset redundant. For
+// constant indexes, a check of a larger constant end address suffices.
+// Dominance is only detected by walking up the control chain while each node
+// has a single control input, which covers straight-line code, the arms of
+// branches and the bodies of loops whose back edge is not connected yet.
+bool WasmGraphBuilder::IsBoundsCheckRedundant(Node* index,
+                                              uint32_t end_offset) {
+  // Limits the compile time spent per memory access.
+  static constexpr int kMaxControlDistance = 32;
+  if (bounds_checks_.empty()) return false;
+  Uint32Matcher index_match(index);
+  uint64_t end_address = index_match.HasValue()
+                             ? uint64_t{index_match.Value()} + end_offset
+                             : 0;
+  Node* control = Control();
+  for (int distance = 0; distance < kMaxControlDistance; ++distance) {
+    auto it = bounds_checks_.find(control);
+    if (it != bounds_checks_.end()) {
+      const BoundsCheck& check = it->second;
+      if (check.index == index && check.end_offset >= end_offset) return true;
+      Uint32Matcher checked_match(check.index);
+      if (index_match.HasValue() && checked_match.HasValue() &&
+          uint64_t{checked_match.Value()} + check.end_offset >= end_address) {
+        return true;
+      }
+    }
+    if (control->op()->ControlInputCount() != 1) return false;
+    control = NodeProperties::GetControlInput(control);
+  }
+  return false;
+}
+
 const Operator* WasmGraphBuilder::GetSafeLoadOperator(int offset,
                                                       wasm::ValueType type) {
   int alignment = offset % (wasm::ValueTypes::ElementSizeInBytes(type));
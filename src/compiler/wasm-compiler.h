@@ -362,6 +362,15 @@ class WasmGraphBuilder {
   bool needs_stack_check_ = false;
   const bool untrusted_code_mitigations_ = true;
 
+  // The explicit bounds checks emitted so far, keyed by the TrapUnless node
+  // (i.e. the control after the check). The check guarantees that the memory
+  // at {index + end_offset} is accessible.
+  struct BoundsCheck {
+    Node* index;
+    uint32_t end_offset;
+  };
+  ZoneUnorderedMap<Node*, BoundsCheck> bounds_checks_;
+
   wasm::FunctionSig* const sig_;
 
   compiler::WasmDecorator* decorator_ = nullptr;
@@ -374,6 +383,7 @@ class WasmGraphBuilder {
   // BoundsCheckMem receives a uint32 {index} node and returns a ptrsize index.
   Node* BoundsCheckMem(uint8_t access_size, Node* index, uint32_t offset,
                        wasm::WasmCodePosition, EnforceBoundsCheck);
+  bool IsBoundsCheckRedundant(Node* index, uint32_t end_offset);
   Node* Uint32ToUintptr(Node*);
   const Operator* GetSafeLoadOperator(int offset, wasm::ValueType type);
   const Operator* GetSafeStoreOperator(int offset, wasm::ValueType type);
@@ -9,6 +9,8 @@
 
 #include <algorithm>
 #include <fstream>
+#include <map>
+#include <tuple>
 #include <unordered_map>
 #include <utility>
 #include <vector>
@@ -1968,6 +1970,33 @@ void Shell::WriteIgnitionDispatchCountersFile(v8::Isolate* isolate) {
       isolate, JSON::Stringify(context, dispatch_counters).ToLocalChecked());
 }
 
+void Shell::WriteIgnitionDispatchSamplesFile(v8::Isolate* isolate) {
+  std::vector<BytecodeDispatchSample> samples(
+      std::max(1, i::FLAG_ignition_dispatch_sampling_buffer));
+  size_t count =
+      isolate->GetBytecodeDispatchSamples(samples.data(), samples.size());
+
+  // Aggregate the samples into bytecode pair frequencies per function.
+  typedef std::tuple<int, int, std::string, std::string> SampleKey;
+  std::map<SampleKey, size_t> frequencies;
+  for (size_t i = 0; i < count; i++) {
+    const BytecodeDispatchSample& sample = samples[i];
+    frequencies[SampleKey(sample.script_id, sample.function_position,
+                          sample.bytecode, sample.next_bytecode)]++;
+  }
+
+  std::ofstream samples_stream(i::FLAG_ignition_dispatch_samples_output_file);
+  samples_stream << "script_id,function_position,bytecode,next_bytecode,count"
+                 << std::endl;
+  for (auto const& entry : frequencies) {
+    samples_stream << std::get<0>(entry.first) << ","
+                   << std::get<1>(entry.first) << ","
+                   << std::get<2>(entry.first) << ","
+                   << std::get<3>(entry.first) << "," << entry.second
+                   << std::endl;
+  }
+}
+
 namespace {
 int LineFromOffset(Local<debug::Script> script, int offset) {
   debug::Location location = script->GetSourceLocation(offset);
@@ -3424,6 +3453,10 @@ int Shell::Main(int argc, char* argv[]) {
         i::FLAG_trace_ignition_dispatches_output_file != nullptr) {
       WriteIgnitionDispatchCountersFile(isolate);
     }
+    if (i::FLAG_ignition_dispatch_sampling &&
+        i::FLAG_ignition_dispatch_samples_output_file != nullptr) {
+      WriteIgnitionDispatchSamplesFile(isolate);
+    }
 
     // Shut down contexts and collect garbage.
     cached_code_map_.clear();
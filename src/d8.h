@@ -491,6 +491,8 @@ class Shell : public i::AllStatic {
   static std::vector<ExternalizedContents> externalized_contents_;
 
   static void WriteIgnitionDispatchCountersFile(v8::Isolate* isolate);
+  // Write the sampled bytecode dispatches per function to a CSV file.
+  static void WriteIgnitionDispatchSamplesFile(v8::Isolate* isolate);
   // Append LCOV coverage data to file.
   static void WriteLcovData(v8::Isolate* isolate, const char* file);
   static Counter* GetCounter(const char* name, bool is_histogram);
@@ -13,6 +13,7 @@
 #include "src/disasm.h"
 #include "src/frames-inl.h"
 #include "src/global-handles.h"
+#include "src/interpreter/bytecode-decoder.h"
 #include "src/interpreter/interpreter.h"
 #include "src/macro-assembler.h"
 #include "src/objects/debug-objects-inl.h"
@@ -799,6 +800,13 @@ void Deoptimizer::DoComputeOutputFrames() {
     }
   }
 
+  if (FLAG_generalize_feedback_on_deopt_loop && bailout_type_ == EAGER &&
+      !deoptimizing_throw_ && count > 0 &&
+      translated_state_.frames()[count - 1].kind() ==
+          TranslatedFrame::kInterpretedFunction) {
+    GeneralizeFeedbackForDeoptLoop(&translated_state_.frames()[count - 1]);
+  }
+
   // Print some helpful diagnostic information.
   if (trace_scope_ != nullptr) {
     double ms = timer.Elapsed().InMillisecondsF();
@@ -814,6 +822,141 @@ void Deoptimizer::DoComputeOutputFrames() {
   }
 }
 
+namespace {
+
+// Returns the operand index of the feedback slot of the unary, binary and
+// compare {bytecode}s, on whose type feedback TurboFan speculates, or -1 for
+// all other bytecodes.
+int OperationFeedbackSlotOperandIndex(interpreter::Bytecode bytecode) {
+  switch (bytecode) {
+    case interpreter::Bytecode::kInc:
+    case interpreter::Bytecode::kDec:
+    case interpreter::Bytecode::kNegate:
+    case interpreter::Bytecode::kBitwiseNot:
+      return 0;
+    case interpreter::Bytecode::kAdd:
+    case interpreter::Bytecode::kSub:
+    case interpreter::Bytecode::kMul:
+    case interpreter::Bytecode::kDiv:
+    case interpreter::Bytecode::kMod:
+    case interpreter::Bytecode::kExp:
+    case interpreter::Bytecode::kBitwiseOr:
+    case interpreter::Bytecode::kBitwiseXor:
+    case interpreter::Bytecode::kBitwiseAnd:
+    case interpreter::Bytecode::kShiftLeft:
+    case interpreter::Bytecode::kShiftRight:
+    case interpreter::Bytecode::kShiftRightLogical:
+    case interpreter::Bytecode::kAddSmi:
+    case interpreter::Bytecode::kSubSmi:
+    case interpreter::Bytecode::kMulSmi:
+    case interpreter::Bytecode::kDivSmi:
+    case interpreter::Bytecode::kModSmi:
+    case interpreter::Bytecode::kExpSmi:
+    case interpreter::Bytecode::kBitwiseOrSmi:
+    case interpreter::Bytecode::kBitwiseXorSmi:
+    case interpreter::Bytecode::kBitwiseAndSmi:
+    case interpreter::Bytecode::kShiftLeftSmi:
+    case interpreter::Bytecode::kShiftRightSmi:
+    case interpreter::Bytecode::kShiftRightLogicalSmi:
+    case interpreter::Bytecode::kTestEqual:
+    case interpreter::Bytecode::kTestEqualStrict:
+    case interpreter::Bytecode::kTestLessThan:
+    case interpreter::Bytecode::kTestGreaterThan:
+    case interpreter::Bytecode::kTestLessThanOrEqual:
+    case interpreter::Bytecode::kTestGreaterThanOrEqual:
+      return 1;
+    default:
+      return -1;
+  }
+}
+
+// Whether a generic operation avoids deoptimizations for {reason}, which
+// speculative unary, binary and compare operations fail with when their
+// inputs or results do not match the feedback.
+bool IsOperationSpeculationReason(DeoptimizeReason reason) {
+  switch (reason) {
+    case DeoptimizeReason::kDivisionByZero:
+    case DeoptimizeReason::kLostPrecision:
+    case DeoptimizeReason::kLostPrecisionOrNaN:
+    case DeoptimizeReason::kMinusZero:
+    case DeoptimizeReason::kNaN:
+    case DeoptimizeReason::kNotAHeapNumber:
+    case DeoptimizeReason::kNotANumberOrOddball:
+    case DeoptimizeReason::kNotASmi:
+    case DeoptimizeReason::kNotAString:
+    case DeoptimizeReason::kNotASymbol:
+    case DeoptimizeReason::kOverflow:
+      return true;
+    default:
+      return false;
+  }
+}
+
+}  // namespace
+
+// A function that keeps deoptimizing at the same operation for the same
+// reason does so because its type feedback does not capture why the
+// speculation failed. Rather than eventually disabling optimization for the
+// function, we record that the operation has seen arbitrary inputs, so the
+// next optimization uses a generic operation there instead of a speculative
+// one.
+void Deoptimizer::GeneralizeFeedbackForDeoptLoop(
+    TranslatedFrame* translated_frame) {
+  DeoptimizeReason reason = GetDeoptInfo(compiled_code_, from_).deopt_reason;
+  if (!IsOperationSpeculationReason(reason)) return;
+
+  // Find the feedback vector of the (possibly inlined) function we deopt to.
+  Object* function = translated_frame->begin()->GetRawValue();
+  if (!function->IsJSFunction()) return;
+  JSFunction* target = JSFunction::cast(function);
+  if (target->shared() != translated_frame->raw_shared_info() ||
+      !target->has_feedback_vector()) {
+    return;
+  }
+
+  // Decode the feedback slot operand of the bytecode we deopt to.
+  BytecodeArray* bytecode_array = target->shared()->GetBytecodeArray();
+  int bytecode_offset = translated_frame->node_id().ToInt();
+  if (bytecode_offset < 0 || bytecode_offset >= bytecode_array->length()) {
+    return;
+  }
+  Address address =
+      bytecode_array->GetFirstBytecodeAddress() + bytecode_offset;
+  interpreter::Bytecode bytecode =
+      interpreter::Bytecodes::FromByte(Memory::uint8_at(address));
+  interpreter::OperandScale operand_scale = interpreter::OperandScale::kSingle;
+  if (interpreter::Bytecodes::IsPrefixScalingBytecode(bytecode)) {
+    operand_scale =
+        interpreter::Bytecodes::PrefixBytecodeToOperandScale(bytecode);
+    address += 1;
+    bytecode = interpreter::Bytecodes::FromByte(Memory::uint8_at(address));
+  }
+  int operand_index = OperationFeedbackSlotOperandIndex(bytecode);
+  if (operand_index < 0) return;
+  uint32_t slot_index = interpreter::BytecodeDecoder::DecodeUnsignedOperand(
+      address + interpreter::Bytecodes::GetOperandOffset(
+                    bytecode, operand_index, operand_scale),
+      interpreter::OperandType::kIdx, operand_scale);
+
+  FeedbackNexus nexus(target->feedback_vector(),
+                      FeedbackVector::ToSlot(slot_index));
+  if (nexus.kind() != FeedbackSlotKind::kBinaryOp &&
+      nexus.kind() != FeedbackSlotKind::kCompareOp) {
+    return;
+  }
+  int count = target->feedback_vector()->RecordOperationDeopt(
+      FeedbackVector::ToSlot(slot_index), reason);
+  if (count < FLAG_deopt_loop_threshold) return;
+  nexus.ConfigureGenericOperation();
+  if (trace_scope_ != nullptr) {
+    PrintF(trace_scope_->file(),
+           "[deoptimizing: generalizing feedback of %s @%d (slot %u) after "
+           "%d deopts: %s]\n",
+           interpreter::Bytecodes::ToString(bytecode), bytecode_offset,
+           slot_index, count, DeoptimizeReasonToString(reason));
+  }
+}
+
 void Deoptimizer::DoComputeInterpretedFrame(TranslatedFrame* translated_frame,
                                             int frame_index,
                                             bool goto_catch_handler) {
@@ -97,6 +97,8 @@ INT32_ACCESSORS(FeedbackVector, length, kLengthOffset)
 INT32_ACCESSORS(FeedbackVector, invocation_count, kInvocationCountOffset)
 INT32_ACCESSORS(FeedbackVector, profiler_ticks, kProfilerTicksOffset)
 INT32_ACCESSORS(FeedbackVector, deopt_count, kDeoptCountOffset)
+INT32_ACCESSORS(FeedbackVector, deopt_loop_slot, kDeoptLoopSlotOffset)
+INT32_ACCESSORS(FeedbackVector, deopt_loop_info, kDeoptLoopInfoOffset)
 
 bool FeedbackVector::is_empty() const { return length() == 0; }
 
@@ -113,6 +115,14 @@ void FeedbackVector::increment_deopt_count() {
   }
 }
 
+DeoptimizeReason FeedbackVector::deopt_loop_reason() const {
+  return DeoptLoopReasonBits::decode(deopt_loop_info());
+}
+
+int FeedbackVector::deopt_loop_count() const {
+  return DeoptLoopCountBits::decode(deopt_loop_info());
+}
+
 Code* FeedbackVector::optimized_code() const {
   MaybeObject* slot = optimized_code_weak_or_smi();
   DCHECK(slot->IsSmi() || slot->IsClearedWeakHeapObject() ||
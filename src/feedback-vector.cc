@@ -216,6 +216,8 @@ Handle<FeedbackVector> FeedbackVector::New(Isolate* isolate,
   DCHECK_EQ(vector->invocation_count(), 0);
   DCHECK_EQ(vector->profiler_ticks(), 0);
   DCHECK_EQ(vector->deopt_count(), 0);
+  DCHECK_EQ(vector->deopt_loop_slot(), -1);
+  DCHECK_EQ(vector->deopt_loop_info(), 0);
 
   // Ensure we can skip the write barrier
   Handle<Object> uninitialized_sentinel = UninitializedSentinel(isolate);
@@ -319,6 +321,18 @@ void FeedbackVector::SetOptimizationMarker(OptimizationMarker marker) {
   set_optimized_code_weak_or_smi(MaybeObject::FromSmi(Smi::FromEnum(marker)));
 }
 
+int FeedbackVector::RecordOperationDeopt(FeedbackSlot slot,
+                                         DeoptimizeReason reason) {
+  int count = 1;
+  if (deopt_loop_slot() == slot.ToInt() && deopt_loop_reason() == reason) {
+    count = std::min(deopt_loop_count() + 1, DeoptLoopCountBits::kMax);
+  }
+  set_deopt_loop_slot(slot.ToInt());
+  set_deopt_loop_info(DeoptLoopReasonBits::encode(reason) |
+                      DeoptLoopCountBits::encode(count));
+  return count;
+}
+
 void FeedbackVector::EvictOptimizedCodeMarkedForDeoptimization(
     SharedFunctionInfo* shared, const char* reason) {
   MaybeObject* slot = optimized_code_weak_or_smi();
@@ -1010,6 +1024,17 @@ CompareOperationHint FeedbackNexus::GetCompareOperationFeedback() const {
   return CompareOperationHintFromFeedback(feedback);
 }
 
+void FeedbackNexus::ConfigureGenericOperation() {
+  int feedback;
+  if (kind() == FeedbackSlotKind::kBinaryOp) {
+    feedback = BinaryOperationFeedback::kAny;
+  } else {
+    DCHECK_EQ(FeedbackSlotKind::kCompareOp, kind());
+    feedback = CompareOperationFeedback::kAny;
+  }
+  SetFeedback(Smi::FromInt(feedback), SKIP_WRITE_BARRIER);
+}
+
 ForInHint FeedbackNexus::GetForInFeedback() const {
   DCHECK_EQ(kind(), FeedbackSlotKind::kForIn);
   int feedback = Smi::ToInt(GetFeedback()->ToSmi());
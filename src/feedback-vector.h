@@ -9,6 +9,7 @@
 
 #include "src/base/logging.h"
 #include "src/base/macros.h"
+#include "src/deoptimize-reason.h"
 #include "src/elements-kind.h"
 #include "src/globals.h"
 #include "src/objects/map.h"
@@ -174,9 +175,24 @@ class FeedbackVector : public HeapObject {
   // [deopt_count]: The number of times this function has deoptimized.
   DECL_INT32_ACCESSORS(deopt_count)
 
+  // [deopt_loop_slot]: The feedback slot of the operation at which this
+  // function eagerly deoptimized last, or -1.
+  DECL_INT32_ACCESSORS(deopt_loop_slot)
+
+  // [deopt_loop_info]: Why the function deoptimized at deopt_loop_slot, and
+  // how many times in a row it did so for that reason.
+  DECL_INT32_ACCESSORS(deopt_loop_info)
+
   inline void clear_invocation_count();
   inline void increment_deopt_count();
 
+  // Records an eager deoptimization for |reason| at the operation that uses
+  // |slot|, and returns how many times in a row the function deoptimized at
+  // that operation for that reason.
+  int RecordOperationDeopt(FeedbackSlot slot, DeoptimizeReason reason);
+  inline DeoptimizeReason deopt_loop_reason() const;
+  inline int deopt_loop_count() const;
+
   inline Code* optimized_code() const;
   inline OptimizationMarker optimization_marker() const;
   inline bool has_optimized_code() const;
@@ -283,6 +299,8 @@ class FeedbackVector : public HeapObject {
   V(kInvocationCountOffset, kInt32Size)      \
   V(kProfilerTicksOffset, kInt32Size)        \
   V(kDeoptCountOffset, kInt32Size)           \
+  V(kDeoptLoopSlotOffset, kInt32Size)        \
+  V(kDeoptLoopInfoOffset, kInt32Size)        \
   V(kUnalignedHeaderSize, 0)
 
   DEFINE_FIELD_OFFSET_CONSTANTS(HeapObject::kHeaderSize, FEEDBACK_VECTOR_FIELDS)
@@ -292,6 +310,9 @@ class FeedbackVector : public HeapObject {
       RoundUp<kPointerAlignment>(kUnalignedHeaderSize);
   static const int kFeedbackSlotsOffset = kHeaderSize;
 
+  class DeoptLoopReasonBits : public BitField<DeoptimizeReason, 0, 8> {};
+  class DeoptLoopCountBits : public BitField<int, 8, 23> {};
+
   class BodyDescriptor;
   // No weak fields.
   typedef BodyDescriptor BodyDescriptorWeak;
@@ -622,6 +643,9 @@ class FeedbackNexus final {
 
   BinaryOperationHint GetBinaryOperationFeedback() const;
   CompareOperationHint GetCompareOperationFeedback() const;
+  // For BinaryOp and CompareOp ICs: Records that the operation has seen
+  // arbitrary inputs, so optimized code will not speculate on them.
+  void ConfigureGenericOperation();
   ForInHint GetForInFeedback() const;
 
   // For KeyedLoad ICs.
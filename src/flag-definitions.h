@@ -332,6 +332,9 @@ DEFINE_INT(interrupt_budget, 144 * KB,
 DEFINE_BOOL(ignition_elide_noneffectful_bytecodes, true,
             "elide bytecodes which won't have any external effect")
 DEFINE_BOOL(ignition_reo, true, "use ignition register equivalence optimizer")
+DEFINE_BOOL(ignition_liveness_optimizer, false,
+            "compact registers and thread jumps in finished bytecode based on "
+            "register liveness")
 DEFINE_BOOL(ignition_filter_expression_positions, true,
             "filter expression positions before the bytecode pipeline")
 DEFINE_BOOL(ignition_share_named_property_feedback, true,
@@ -358,6 +361,18 @@ DEFINE_BOOL(trace_ignition_dispatches, false,
 DEFINE_STRING(trace_ignition_dispatches_output_file, nullptr,
               "the file to which the bytecode handler dispatch table is "
               "written (by default, the table is not written to a file)")
+DEFINE_BOOL(ignition_dispatch_sampling, false,
+            "samples the dispatches to bytecode handlers by the ignition "
+            "interpreter, one each time a function runs out of interrupt "
+            "budget")
+DEFINE_INT(ignition_dispatch_sampling_window, 64,
+           "the number of dispatches after running out of interrupt budget "
+           "that the sampled dispatch is randomly picked from")
+DEFINE_INT(ignition_dispatch_sampling_buffer, 64 * KB,
+           "the number of most recent dispatch samples to keep")
+DEFINE_STRING(ignition_dispatch_samples_output_file, nullptr,
+              "the file to which d8 writes the sampled dispatches per "
+              "function (by default, the samples are not written to a file)")
 
 DEFINE_BOOL(fast_math, true, "faster (but maybe less accurate) math functions")
 DEFINE_BOOL(trace_track_allocation_sites, false,
@@ -371,7 +386,10 @@ DEFINE_BOOL(concurrent_recompilation, true,
 DEFINE_BOOL(trace_concurrent_recompilation, false,
             "track concurrent recompilation")
 DEFINE_INT(concurrent_recompilation_queue_length, 8,
-           "the length of the concurrent compilation queue")
+           "the length of the concurrent compilation queue (0 means unbounded)")
+DEFINE_INT(concurrent_recompilation_max_memory, 0,
+           "the maximum zone memory (in MB) held by concurrent recompilation "
+           "jobs waiting to be compiled or installed (0 means no limit)")
 DEFINE_INT(concurrent_recompilation_delay, 0,
            "artificial compilation delay in ms")
 DEFINE_BOOL(block_concurrent_recompilation, false,
@@ -474,6 +492,8 @@ DEFINE_BOOL(turbo_move_optimization, true, "optimize gap moves in TurboFan")
 DEFINE_BOOL(turbo_jt, true, "enable jump threading in TurboFan")
 DEFINE_BOOL(turbo_loop_peeling, true, "Turbofan loop peeling")
 DEFINE_BOOL(turbo_loop_variable, true, "Turbofan loop variable optimization")
+DEFINE_BOOL(turbo_bounds_check_elimination, true,
+            "eliminate bounds checks dominated by a less-than check")
 DEFINE_BOOL(turbo_cf_optimization, true, "optimize control flow in TurboFan")
 DEFINE_BOOL(turbo_escape, true, "enable escape analysis")
 DEFINE_BOOL(turbo_allocation_folding, true, "Turbofan allocation folding")
@@ -526,20 +546,38 @@ DEFINE_BOOL(wasm_write_protect_code_memory, false,
             "write protect code memory on the wasm native heap")
 DEFINE_BOOL(wasm_trace_serialization, false,
             "trace serialization/deserialization")
+DEFINE_BOOL(wasm_lazy_deserialization, false,
+            "deserialize wasm functions on their first call")
 DEFINE_BOOL(wasm_async_compilation, true,
             "enable actual asynchronous compilation for WebAssembly.compile")
 DEFINE_BOOL(wasm_test_streaming, false,
             "use streaming compilation instead of async compilation for tests")
+DEFINE_UINT(wasm_shared_module_cache_size, 0,
+            "maximum size (in MB) of the process-wide cache of compiled wasm "
+            "modules shared by all isolates (0 disables the cache)")
 // Parallel compilation confuses turbo_stats, force single threaded.
 DEFINE_VALUE_IMPLICATION(turbo_stats, wasm_num_compilation_tasks, 0)
 DEFINE_UINT(wasm_max_mem_pages, v8::internal::wasm::kV8MaxWasmMemoryPages,
             "maximum memory size of a wasm instance")
 DEFINE_UINT(wasm_max_table_size, v8::internal::wasm::kV8MaxWasmTableSize,
             "maximum table size of a wasm instance")
+DEFINE_UINT(wasm_memory_pool_size, 0,
+            "number of address space reservations of freed wasm memories "
+            "that are kept for reuse by new memories")
 DEFINE_BOOL(wasm_tier_up, false,
             "enable basic tiering up to the optimizing compiler")
 DEFINE_IMPLICATION(future, wasm_tier_up)
 DEFINE_IMPLICATION(wasm_tier_up, liftoff)
+DEFINE_BOOL(wasm_dynamic_tiering, false,
+            "tier up only hot functions to the optimizing compiler, as counted "
+            "by Liftoff code")
+DEFINE_IMPLICATION(wasm_dynamic_tiering, wasm_tier_up)
+DEFINE_INT(wasm_tiering_budget, 1000,
+           "number of calls and loop iterations after which a function is "
+           "tiered up with --wasm-dynamic-tiering")
+DEFINE_BOOL(wasm_free_superseded_code, true,
+            "free the Liftoff code of tiered-up functions, except for its "
+            "tier-up prologue, once it is no longer executing")
 DEFINE_DEBUG_BOOL(trace_wasm_decoder, false, "trace decoding of wasm code")
 DEFINE_DEBUG_BOOL(trace_wasm_decode_time, false,
                   "trace decoding time of wasm code")
@@ -553,6 +591,9 @@ DEFINE_INT(trace_wasm_ast_start, 0,
 DEFINE_INT(trace_wasm_ast_end, 0, "end function for wasm AST trace (exclusive)")
 DEFINE_BOOL(liftoff, false,
             "enable liftoff, the experimental wasm baseline compiler")
+DEFINE_BOOL(liftoff_no_fallback, false,
+            "abort instead of falling back to turbofan when liftoff cannot "
+            "compile a function (for testing)")
 DEFINE_DEBUG_BOOL(trace_liftoff, false,
                   "trace liftoff, the wasm baseline compiler")
 DEFINE_DEBUG_BOOL(wasm_break_on_decoder_error, false,
@@ -593,6 +634,9 @@ DEFINE_BOOL(experimental_wasm_mut_global, false,
 DEFINE_BOOL(wasm_opt, false, "enable wasm optimization")
 DEFINE_BOOL(wasm_no_bounds_checks, false,
             "disable bounds checks (performance testing only)")
+DEFINE_BOOL(wasm_bounds_check_elimination, true,
+            "eliminate explicit wasm bounds checks that are implied by "
+            "dominating ones")
 DEFINE_BOOL(wasm_no_stack_checks, false,
             "disable stack checks (performance testing only)")
 
@@ -605,6 +649,8 @@ DEFINE_IMPLICATION(wasm_fuzzer_gen_test, single_threaded)
 DEFINE_BOOL(print_wasm_code, false, "Print WebAssembly code")
 DEFINE_BOOL(wasm_interpret_all, false,
             "Execute all wasm code in the wasm interpreter")
+DEFINE_BOOL(wasm_interpreter_register_code, true,
+            "translate functions to register code in the wasm interpreter")
 DEFINE_BOOL(asm_wasm_lazy_compilation, false,
             "enable lazy compilation for asm-wasm modules")
 DEFINE_IMPLICATION(validate_asm, asm_wasm_lazy_compilation)
@@ -612,6 +658,9 @@ DEFINE_BOOL(wasm_lazy_compilation, false,
             "enable lazy compilation for all wasm modules")
 DEFINE_DEBUG_BOOL(trace_wasm_lazy_compilation, false,
                   "trace lazy compilation of wasm functions")
+DEFINE_BOOL(wasm_parallel_validation, false,
+            "validate the functions of lazily compiled wasm modules on "
+            "background threads")
 // wasm-interpret-all resets {asm-,}wasm-lazy-compilation.
 DEFINE_NEG_IMPLICATION(wasm_interpret_all, asm_wasm_lazy_compilation)
 DEFINE_NEG_IMPLICATION(wasm_interpret_all, wasm_lazy_compilation)
@@ -857,6 +906,12 @@ DEFINE_BOOL(trace_opt_verbose, false, "extra verbose compilation tracing")
 DEFINE_IMPLICATION(trace_opt_verbose, trace_opt)
 DEFINE_BOOL(trace_opt_stats, false, "trace lazy optimization statistics")
 DEFINE_BOOL(trace_deopt, false, "trace optimize function deoptimization")
+DEFINE_BOOL(generalize_feedback_on_deopt_loop, false,
+            "stop speculating on the input types of unary, binary and compare "
+            "operations at which a function keeps deoptimizing")
+DEFINE_INT(deopt_loop_threshold, 2,
+           "number of deoptimizations in a row at the same operation and for "
+           "the same reason after which its feedback is generalized")
 DEFINE_BOOL(trace_file_names, false,
             "include file names in trace-opt/trace-deopt output")
 DEFINE_BOOL(trace_interrupts, false, "trace interrupts when they are handled")
@@ -864,6 +919,10 @@ DEFINE_BOOL(opt, true, "use adaptive optimizations")
 DEFINE_BOOL(always_opt, false, "always try to optimize functions")
 DEFINE_BOOL(always_osr, false, "always try to OSR functions")
 DEFINE_BOOL(prepare_always_opt, false, "prepare for turning on always opt")
+DEFINE_STRING(hot_function_profile, nullptr,
+              "read a profile of hot functions to optimize early from file")
+DEFINE_STRING(dump_hot_function_profile, nullptr,
+              "write a profile of hot functions to file on shutdown")
 
 DEFINE_BOOL(trace_serializer, false, "print code serializer trace")
 #ifdef DEBUG
@@ -881,6 +940,11 @@ DEFINE_BOOL(compiler_dispatcher, false, "enable compiler dispatcher")
 DEFINE_BOOL(trace_compiler_dispatcher, false,
             "trace compiler dispatcher activity")
 
+// compiler.cc
+DEFINE_BOOL(parallel_compile_tasks, false,
+            "compile the eagerly compiled inner functions of streamed scripts "
+            "on parallel worker threads")
+
 // compiler-dispatcher-job.cc
 DEFINE_BOOL(
     trace_compiler_dispatcher_jobs, false,
@@ -977,6 +1041,12 @@ DEFINE_IMPLICATION(aggressive_lazy_inner_functions, lazy_inner_functions)
 DEFINE_BOOL(preparser_scope_analysis, true,
             "perform scope analysis for preparsed inner functions")
 DEFINE_IMPLICATION(preparser_scope_analysis, aggressive_lazy_inner_functions)
+DEFINE_BOOL(parallel_preparse, false,
+            "preparse large top-level functions of streamed scripts on "
+            "worker threads")
+DEFINE_BOOL(parallel_preparse_wait_for_testing, false,
+            "let the parser wait for the worker threads to preparse every "
+            "function they find (for testing)")
 
 // simulator-arm.cc, simulator-arm64.cc and simulator-mips.cc
 DEFINE_BOOL(trace_sim, false, "Trace simulator execution")
@@ -1050,6 +1120,11 @@ DEFINE_BOOL(profile_deserialization, false,
 DEFINE_BOOL(serialization_statistics, false,
             "Collect statistics on serialized objects.")
 
+// persistent-code-cache.cc
+DEFINE_STRING(code_cache_dir, nullptr,
+              "directory in which to persist the code caches of compiled "
+              "scripts across processes")
+
 // Regexp
 DEFINE_BOOL(regexp_optimization, true, "generate optimized regexp code")
 DEFINE_BOOL(regexp_mode_modifiers, false, "enable inline flags in regexp.")
@@ -1341,6 +1416,8 @@ DEFINE_BOOL(single_threaded, false, "disable the use of background tasks")
 DEFINE_IMPLICATION(single_threaded, single_threaded_gc)
 DEFINE_NEG_IMPLICATION(single_threaded, concurrent_recompilation)
 DEFINE_NEG_IMPLICATION(single_threaded, compiler_dispatcher)
+DEFINE_NEG_IMPLICATION(single_threaded, parallel_compile_tasks)
+DEFINE_NEG_IMPLICATION(single_threaded, parallel_preparse)
 
 //
 // Parallel and concurrent GC (Orinoco) related flags.
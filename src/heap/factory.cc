@@ -419,6 +419,8 @@ Handle<FeedbackVector> Factory::NewFeedbackVector(
   vector->set_invocation_count(0);
   vector->set_profiler_ticks(0);
   vector->set_deopt_count(0);
+  vector->set_deopt_loop_slot(-1);
+  vector->set_deopt_loop_info(0);
   // TODO(leszeks): Initialize based on the feedback metadata.
   MemsetPointer(vector->slots_start(),
                 MaybeObject::FromObject(*undefined_value()), length);
@@ -2092,6 +2094,8 @@ Handle<FeedbackVector> Factory::CopyFeedbackVector(
     result->set_invocation_count(array->invocation_count());
     result->set_profiler_ticks(array->profiler_ticks());
     result->set_deopt_count(array->deopt_count());
+    result->set_deopt_loop_slot(array->deopt_loop_slot());
+    result->set_deopt_loop_info(array->deopt_loop_info());
     for (int i = 0; i < len; i++) result->set(i, array->get(i), mode);
   }
   return result;
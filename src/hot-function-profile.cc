@@ -0,0 +1,114 @@
+// Copyright 2018 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "src/hot-function-profile.h"
+
+#include "src/base/platform/platform.h"
+#include "src/flags.h"
+#include "src/objects-inl.h"
+#include "src/objects/string-inl.h"
+
+namespace v8 {
+namespace internal {
+
+namespace {
+
+const char kProfileHeader[] = "v8-hot-function-profile";
+const int kProfileVersion = 2;
+
+}  // namespace
+
+HotFunctionProfile* HotFunctionProfile::profile_ = nullptr;
+
+void HotFunctionProfile::InitializeOncePerProcess() {
+  if (FLAG_hot_function_profile == nullptr &&
+      FLAG_dump_hot_function_profile == nullptr) {
+    return;
+  }
+  DCHECK_NULL(profile_);
+  profile_ = new HotFunctionProfile();
+  if (FLAG_hot_function_profile != nullptr &&
+      !profile_->ReadFromFile(FLAG_hot_function_profile)) {
+    PrintF(stderr, "Could not read hot function profile from %s\n",
+           FLAG_hot_function_profile);
+  }
+}
+
+void HotFunctionProfile::TearDown() {
+  if (profile_ == nullptr) return;
+  if (FLAG_dump_hot_function_profile != nullptr &&
+      !profile_->WriteToFile(FLAG_dump_hot_function_profile)) {
+    PrintF(stderr, "Could not write hot function profile to %s\n",
+           FLAG_dump_hot_function_profile);
+  }
+  delete profile_;
+  profile_ = nullptr;
+}
+
+// static
+uint32_t HotFunctionProfile::HashSource(String* source) {
+  // 32-bit FNV-1a, which (unlike the string hash) looks at every character of
+  // long strings and does not depend on the per-isolate hash seed.
+  uint32_t hash = 2166136261u;
+  StringCharacterStream stream(source);
+  while (stream.HasMore()) {
+    hash = (hash ^ stream.GetNext()) * 16777619u;
+  }
+  return hash;
+}
+
+void HotFunctionProfile::RecordHot(const FunctionKey& key) {
+  base::LockGuard<base::Mutex> guard(&mutex_);
+  functions_.insert(key);
+}
+
+bool HotFunctionProfile::IsHot(const FunctionKey& key) {
+  base::LockGuard<base::Mutex> guard(&mutex_);
+  return functions_.find(key) != functions_.end();
+}
+
+size_t HotFunctionProfile::size() {
+  base::LockGuard<base::Mutex> guard(&mutex_);
+  return functions_.size();
+}
+
+bool HotFunctionProfile::ReadFromFile(const char* filename) {
+  FILE* file = base::OS::FOpen(filename, "r");
+  if (file == nullptr) return false;
+  char header[sizeof(kProfileHeader)];
+  int version;
+  bool success = fscanf(file, "%23s %d", header, &version) == 2 &&
+                 strcmp(header, kProfileHeader) == 0 &&
+                 version == kProfileVersion;
+  if (success) {
+    base::LockGuard<base::Mutex> guard(&mutex_);
+    FunctionKey key;
+    while (fscanf(file, "%u %d %d", &key.source_hash, &key.start_position,
+                  &key.end_position) == 3) {
+      functions_.insert(key);
+    }
+    success = feof(file) != 0;
+  }
+  fclose(file);
+  return success;
+}
+
+bool HotFunctionProfile::WriteToFile(const char* filename) {
+  FILE* file = base::OS::FOpen(filename, "w");
+  if (file == nullptr) return false;
+  {
+    base::LockGuard<base::Mutex> guard(&mutex_);
+    fprintf(file, "%s %d\n", kProfileHeader, kProfileVersion);
+    for (const FunctionKey& key : functions_) {
+      fprintf(file, "%u %d %d\n", key.source_hash, key.start_position,
+              key.end_position);
+    }
+  }
+  bool success = ferror(file) == 0;
+  fclose(file);
+  return success;
+}
+
+}  // namespace internal
+}  // namespace v8
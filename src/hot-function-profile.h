@@ -0,0 +1,76 @@
+// Copyright 2018 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef V8_HOT_FUNCTION_PROFILE_H_
+#define V8_HOT_FUNCTION_PROFILE_H_
+
+#include <set>
+
+#include "src/base/macros.h"
+#include "src/base/platform/mutex.h"
+#include "src/globals.h"
+
+namespace v8 {
+namespace internal {
+
+// A process-wide profile of the functions that the RuntimeProfiler found hot
+// enough to optimize. Functions are identified by a hash of their script's
+// source and their source range, so that a profile written by a warmed-up
+// process (--dump-hot-function-profile) can be read by a freshly started one
+// (--hot-function-profile), whose isolates then optimize those functions as
+// soon as they have collected some type feedback instead of re-learning that
+// they are hot.
+class V8_EXPORT_PRIVATE HotFunctionProfile final {
+ public:
+  struct FunctionKey {
+    uint32_t source_hash;
+    int start_position;
+    int end_position;
+
+    bool operator<(const FunctionKey& other) const {
+      if (source_hash != other.source_hash) {
+        return source_hash < other.source_hash;
+      }
+      if (start_position != other.start_position) {
+        return start_position < other.start_position;
+      }
+      return end_position < other.end_position;
+    }
+  };
+
+  HotFunctionProfile() {}
+
+  // Reads the profile given by --hot-function-profile, if any, and prepares
+  // recording if --dump-hot-function-profile is given.
+  static void InitializeOncePerProcess();
+  // Writes the profile to --dump-hot-function-profile, if given.
+  static void TearDown();
+
+  // Returns the process-wide profile, or nullptr if neither reading nor
+  // writing a profile was requested.
+  static HotFunctionProfile* Get() { return profile_; }
+
+  // Computes the hash of a script source as used by FunctionKey.
+  static uint32_t HashSource(String* source);
+
+  void RecordHot(const FunctionKey& key);
+  bool IsHot(const FunctionKey& key);
+  size_t size();
+
+  bool ReadFromFile(const char* filename);
+  bool WriteToFile(const char* filename);
+
+ private:
+  static HotFunctionProfile* profile_;
+
+  base::Mutex mutex_;
+  std::set<FunctionKey> functions_;
+
+  DISALLOW_COPY_AND_ASSIGN(HotFunctionProfile);
+};
+
+}  // namespace internal
+}  // namespace v8
+
+#endif  // V8_HOT_FUNCTION_PROFILE_H_
@@ -2359,7 +2359,14 @@ void AccessorAssembler::LoadIC_BytecodeHandler(const LoadICParameters* p,
                            &var_handler, &try_polymorphic);
 
     BIND(&if_handler);
-    HandleLoadICHandlerCase(p, CAST(var_handler.value()), &miss, exit_point);
+    {
+      Label if_other_handler(this);
+      HandleLoadICTaggedFieldFastCase(p, CAST(var_handler.value()),
+                                      &if_other_handler, exit_point);
+
+      BIND(&if_other_handler);
+      HandleLoadICHandlerCase(p, CAST(var_handler.value()), &miss, exit_point);
+    }
 
     BIND(&try_polymorphic);
     {
@@ -2391,6 +2398,40 @@ void AccessorAssembler::LoadIC_BytecodeHandler(const LoadICParameters* p,
   }
 }
 
+void AccessorAssembler::HandleLoadICTaggedFieldFastCase(
+    const LoadICParameters* p, TNode<Object> handler, Label* if_other,
+    ExitPoint* exit_point) {
+  Comment("LoadIC_tagged_field_fast");
+  GotoIfNot(TaggedIsSmi(handler), if_other);
+
+  // Field handlers for the receiver itself need neither access checks nor
+  // lookups, so a tagged field can be loaded right away. Everything else,
+  // including double fields, takes the generic path.
+  Node* handler_word = SmiUntag(CAST(handler));
+  Node* kind_and_flags = WordAnd(
+      handler_word,
+      IntPtrConstant(LoadHandler::KindBits::kMask |
+                     LoadHandler::DoAccessCheckOnReceiverBits::kMask |
+                     LoadHandler::LookupOnReceiverBits::kMask |
+                     LoadHandler::IsDoubleBits::kMask));
+  GotoIfNot(WordEqual(kind_and_flags,
+                      IntPtrConstant(LoadHandler::KindBits::encode(
+                          LoadHandler::kField))),
+            if_other);
+
+  Node* index = DecodeWord<LoadHandler::FieldIndexBits>(handler_word);
+  Node* offset = IntPtrMul(index, IntPtrConstant(kPointerSize));
+  Label inobject(this), out_of_object(this);
+  Branch(IsSetWord<LoadHandler::IsInobjectBits>(handler_word), &inobject,
+         &out_of_object);
+
+  BIND(&inobject);
+  exit_point->Return(LoadObjectField(p->holder, offset));
+
+  BIND(&out_of_object);
+  exit_point->Return(LoadObjectField(LoadFastProperties(p->holder), offset));
+}
+
 void AccessorAssembler::LoadIC(const LoadICParameters* p) {
   // Must be kept in sync with LoadIC_BytecodeHandler.
 
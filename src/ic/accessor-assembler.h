@@ -87,6 +87,12 @@ class AccessorAssembler : public CodeStubAssembler {
   // construction on common paths.
   void LoadIC_BytecodeHandler(const LoadICParameters* p, ExitPoint* exit_point);
 
+  // Loads tagged fields of the holder directly for field Smi handlers, and
+  // jumps to |if_other| for all other handlers.
+  void HandleLoadICTaggedFieldFastCase(const LoadICParameters* p,
+                                       TNode<Object> handler, Label* if_other,
+                                       ExitPoint* exit_point);
+
   // Loads dataX field from the DataHandler object.
   TNode<MaybeObject> LoadHandlerDataField(SloppyTNode<DataHandler> handler,
                                           int data_index);
@@ -14,6 +14,7 @@
 #include "src/interpreter/bytecode-flags.h"
 #include "src/interpreter/bytecode-jump-table.h"
 #include "src/interpreter/bytecode-label.h"
+#include "src/interpreter/bytecode-liveness-optimizer.h"
 #include "src/interpreter/bytecode-register-allocator.h"
 #include "src/interpreter/control-flow-builders.h"
 #include "src/objects-inl.h"
@@ -943,6 +944,14 @@ Handle<BytecodeArray> BytecodeGenerator::FinalizeBytecode(
         incoming_new_target_or_generator_);
   }
 
+  if (FLAG_ignition_liveness_optimizer) {
+    Zone zone(isolate->allocator(), ZONE_NAME);
+    BytecodeLivenessOptimizer optimizer(&zone, bytecode_array,
+                                        builder()->fixed_register_count(),
+                                        incoming_new_target_or_generator_);
+    optimizer.Optimize();
+  }
+
   return bytecode_array;
 }
 
@@ -0,0 +1,260 @@
+// Copyright 2018 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "src/interpreter/bytecode-liveness-optimizer.h"
+
+#include "src/bit-vector.h"
+#include "src/compiler/bytecode-analysis.h"
+#include "src/handler-table.h"
+#include "src/interpreter/bytecode-array-iterator.h"
+#include "src/objects-inl.h"
+#include "src/source-position-table.h"
+
+namespace v8 {
+namespace internal {
+namespace interpreter {
+
+namespace {
+
+Address OperandStart(Handle<BytecodeArray> bytecode_array,
+                     const BytecodeArrayIterator& iterator, int operand_index) {
+  return bytecode_array->GetFirstBytecodeAddress() +
+         iterator.current_offset() + iterator.current_prefix_offset() +
+         Bytecodes::GetOperandOffset(iterator.current_bytecode(),
+                                     operand_index,
+                                     iterator.current_operand_scale());
+}
+
+bool FitsOperand(OperandSize size, uint32_t value) {
+  switch (size) {
+    case OperandSize::kByte:
+      return value <= static_cast<uint32_t>(kMaxUInt8);
+    case OperandSize::kShort:
+      return value <= static_cast<uint32_t>(kMaxUInt16);
+    case OperandSize::kQuad:
+      return true;
+    case OperandSize::kNone:
+      break;
+  }
+  UNREACHABLE();
+}
+
+void WriteOperand(Address operand_start, OperandSize size, uint32_t value) {
+  switch (size) {
+    case OperandSize::kByte:
+      WriteUnalignedValue<uint8_t>(operand_start, static_cast<uint8_t>(value));
+      return;
+    case OperandSize::kShort:
+      WriteUnalignedValue<uint16_t>(operand_start,
+                                    static_cast<uint16_t>(value));
+      return;
+    case OperandSize::kQuad:
+      WriteUnalignedValue<uint32_t>(operand_start, value);
+      return;
+    case OperandSize::kNone:
+      break;
+  }
+  UNREACHABLE();
+}
+
+bool IsSingleRegisterOperandType(OperandType type) {
+  return type == OperandType::kReg || type == OperandType::kRegOut;
+}
+
+}  // namespace
+
+BytecodeLivenessOptimizer::BytecodeLivenessOptimizer(
+    Zone* zone, Handle<BytecodeArray> bytecode_array, int fixed_register_count,
+    Register incoming_new_target_or_generator)
+    : zone_(zone),
+      bytecode_array_(bytecode_array),
+      fixed_register_count_(fixed_register_count),
+      incoming_new_target_or_generator_(incoming_new_target_or_generator),
+      register_count_(bytecode_array->register_count()) {}
+
+void BytecodeLivenessOptimizer::Optimize() {
+  compiler::BytecodeAnalysis analysis(bytecode_array_, zone(), true);
+  analysis.Analyze(BailoutId::None());
+  CompactRegisters(analysis);
+  ThreadJumps(analysis);
+}
+
+void BytecodeLivenessOptimizer::CompactRegisters(
+    const compiler::BytecodeAnalysis& analysis) {
+  const int first_temporary = fixed_register_count_;
+  const int temporary_count = register_count_ - first_temporary;
+  if (temporary_count <= 1 || temporary_count > kMaxTemporaryRegisters) return;
+
+  // Temporaries only ever used as single register operands can be renamed.
+  // All other temporaries keep their index.
+  BitVector renamable(temporary_count, zone());
+  BitVector pinned(temporary_count, zone());
+  auto pin = [&](int index) {
+    index -= first_temporary;
+    if (index >= 0 && index < temporary_count) pinned.Add(index);
+  };
+  if (incoming_new_target_or_generator_.is_valid()) {
+    pin(incoming_new_target_or_generator_.index());
+  }
+  HandlerTable table(*bytecode_array_);
+  for (int i = 0; i < table.NumberOfRangeEntries(); ++i) {
+    pin(table.GetRangeData(i));
+  }
+  for (BytecodeArrayIterator it(bytecode_array_); !it.done(); it.Advance()) {
+    Bytecode bytecode = it.current_bytecode();
+    for (int i = 0; i < Bytecodes::NumberOfOperands(bytecode); ++i) {
+      OperandType type = Bytecodes::GetOperandType(bytecode, i);
+      if (!Bytecodes::IsRegisterOperandType(type)) continue;
+      int index = it.GetRegisterOperand(i).index();
+      if (IsSingleRegisterOperandType(type)) {
+        if (index >= first_temporary) renamable.Add(index - first_temporary);
+      } else {
+        for (int j = 0; j < it.GetRegisterOperandRange(i); ++j) {
+          pin(index + j);
+        }
+      }
+    }
+  }
+  renamable.Subtract(pinned);
+
+  ZoneVector<int> temporaries(zone());
+  for (BitVector::Iterator it(&renamable); !it.Done(); it.Advance()) {
+    temporaries.push_back(it.Current());
+  }
+  if (temporaries.size() <= 1) return;
+
+  // Two temporaries interfere if one of them is written while the other is
+  // live. Values that are live on function entry are all undefined, so that
+  // is enough even for temporaries which are read before being written.
+  ZoneVector<BitVector*> interference(temporary_count, nullptr, zone());
+  for (int temporary : temporaries) {
+    interference[temporary] = new (zone()) BitVector(temporary_count, zone());
+  }
+  for (BytecodeArrayIterator it(bytecode_array_); !it.done(); it.Advance()) {
+    Bytecode bytecode = it.current_bytecode();
+    for (int i = 0; i < Bytecodes::NumberOfOperands(bytecode); ++i) {
+      if (Bytecodes::GetOperandType(bytecode, i) != OperandType::kRegOut) {
+        continue;
+      }
+      int output = it.GetRegisterOperand(i).index() - first_temporary;
+      if (output < 0 || !renamable.Contains(output)) continue;
+      const compiler::BytecodeLivenessState* liveness =
+          analysis.GetOutLivenessFor(it.current_offset());
+      for (int temporary : temporaries) {
+        if (temporary != output &&
+            liveness->RegisterIsLive(temporary + first_temporary)) {
+          interference[output]->Add(temporary);
+          interference[temporary]->Add(output);
+        }
+      }
+    }
+  }
+
+  // Greedily give each temporary the lowest index not used by any of the
+  // temporaries it interferes with. The n-th temporary needs at most n
+  // distinct indices before it, so no temporary is renamed to a higher
+  // index and every operand still fits its encoding.
+  ZoneVector<int> renamed(temporary_count, -1, zone());
+  bool changed = false;
+  BitVector used(static_cast<int>(temporaries.size()), zone());
+  for (size_t i = 0; i < temporaries.size(); ++i) {
+    int temporary = temporaries[i];
+    used.Clear();
+    for (BitVector::Iterator it(interference[temporary]); !it.Done();
+         it.Advance()) {
+      int slot = renamed[it.Current()];
+      if (slot >= 0) used.Add(slot);
+    }
+    size_t slot = 0;
+    while (used.Contains(static_cast<int>(slot))) slot++;
+    DCHECK_LE(slot, i);
+    renamed[temporary] = static_cast<int>(slot);
+    if (slot != i) changed = true;
+  }
+  if (!changed) return;
+
+  for (BytecodeArrayIterator it(bytecode_array_); !it.done(); it.Advance()) {
+    Bytecode bytecode = it.current_bytecode();
+    for (int i = 0; i < Bytecodes::NumberOfOperands(bytecode); ++i) {
+      OperandType type = Bytecodes::GetOperandType(bytecode, i);
+      if (!IsSingleRegisterOperandType(type)) continue;
+      int temporary = it.GetRegisterOperand(i).index() - first_temporary;
+      if (temporary < 0 || !renamable.Contains(temporary)) continue;
+      Register reg(temporaries[renamed[temporary]] + first_temporary);
+      WriteOperand(OperandStart(bytecode_array_, it, i),
+                   Bytecodes::GetOperandSize(bytecode, i,
+                                             it.current_operand_scale()),
+                   static_cast<uint32_t>(reg.ToOperand()));
+    }
+  }
+
+  int register_count = first_temporary;
+  for (int temporary = 0; temporary < temporary_count; ++temporary) {
+    int index = -1;
+    if (pinned.Contains(temporary)) {
+      index = temporary;
+    } else if (renamable.Contains(temporary)) {
+      index = temporaries[renamed[temporary]];
+    }
+    register_count = std::max(register_count, first_temporary + index + 1);
+  }
+  DCHECK_LE(register_count, register_count_);
+  register_count_ = register_count;
+  bytecode_array_->set_frame_size(register_count * kPointerSize);
+}
+
+void BytecodeLivenessOptimizer::ThreadJumps(
+    const compiler::BytecodeAnalysis& analysis) {
+  const int length = bytecode_array_->length();
+
+  // Jumps with a source position are kept on the path, so that the debugger
+  // still steps through them (e.g. for break statements).
+  BitVector has_position(length, zone());
+  for (SourcePositionTableIterator it(bytecode_array_->SourcePositionTable());
+       !it.done(); it.Advance()) {
+    has_position.Add(it.code_offset());
+  }
+
+  ZoneVector<int> jump_target(length, -1, zone());
+  for (BytecodeArrayIterator it(bytecode_array_); !it.done(); it.Advance()) {
+    Bytecode bytecode = it.current_bytecode();
+    if (bytecode == Bytecode::kJump || bytecode == Bytecode::kJumpConstant) {
+      jump_target[it.current_offset()] = it.GetJumpTargetOffset();
+    }
+  }
+
+  for (BytecodeArrayIterator it(bytecode_array_); !it.done(); it.Advance()) {
+    Bytecode bytecode = it.current_bytecode();
+    if (!Bytecodes::IsJumpImmediate(bytecode) ||
+        bytecode == Bytecode::kJumpLoop) {
+      continue;
+    }
+    int target = it.GetJumpTargetOffset();
+    int final_target = target;
+    for (int i = 0; i < kMaxJumpChainLength; ++i) {
+      int next = jump_target[final_target];
+      if (next < 0 || has_position.Contains(final_target) ||
+          analysis.IsLoopHeader(final_target)) {
+        break;
+      }
+      final_target = next;
+    }
+    // Don't add entries to loop headers, which are expected to be reached
+    // only by falling through and by their back edges.
+    if (final_target == target || analysis.IsLoopHeader(final_target)) {
+      continue;
+    }
+    DCHECK_GT(final_target, target);
+    uint32_t delta = static_cast<uint32_t>(
+        final_target - it.current_offset() - it.current_prefix_offset());
+    OperandSize size =
+        Bytecodes::GetOperandSize(bytecode, 0, it.current_operand_scale());
+    if (!FitsOperand(size, delta)) continue;
+    WriteOperand(OperandStart(bytecode_array_, it, 0), size, delta);
+  }
+}
+
+}  // namespace interpreter
+}  // namespace internal
+}  // namespace v8
@@ -0,0 +1,73 @@
+// Copyright 2018 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef V8_INTERPRETER_BYTECODE_LIVENESS_OPTIMIZER_H_
+#define V8_INTERPRETER_BYTECODE_LIVENESS_OPTIMIZER_H_
+
+#include "src/globals.h"
+#include "src/handles.h"
+#include "src/interpreter/bytecode-register.h"
+#include "src/zone/zone-containers.h"
+
+namespace v8 {
+namespace internal {
+
+class BytecodeArray;
+
+namespace compiler {
+class BytecodeAnalysis;
+}  // namespace compiler
+
+namespace interpreter {
+
+// A pass over a finished bytecode array that rewrites it in place, using the
+// register liveness computed by BytecodeAnalysis:
+//
+//  - Temporary registers whose live ranges never overlap are merged, which
+//    compacts the register file and shrinks the frame size. The register
+//    allocator only reuses registers once their allocation scope has ended,
+//    so values with disjoint lifetimes often occupy different registers.
+//  - Forward jumps to unconditional jumps are retargeted to the final
+//    destination, when the new offset fits the existing operand.
+//
+// Locals, which the debugger reads by index, and registers that are part of
+// register lists or pairs keep their index. Since operands are only ever
+// rewritten to smaller or equally sized values, the bytecode never moves.
+class V8_EXPORT_PRIVATE BytecodeLivenessOptimizer final {
+ public:
+  BytecodeLivenessOptimizer(Zone* zone, Handle<BytecodeArray> bytecode_array,
+                            int fixed_register_count,
+                            Register incoming_new_target_or_generator);
+
+  void Optimize();
+
+  // Number of registers in the frame after optimization.
+  int register_count() const { return register_count_; }
+
+ private:
+  // Functions with more temporaries are left alone, to bound the size of the
+  // interference matrix.
+  static const int kMaxTemporaryRegisters = 1024;
+  // Maximum number of jumps followed when threading a jump.
+  static const int kMaxJumpChainLength = 8;
+
+  void CompactRegisters(const compiler::BytecodeAnalysis& analysis);
+  void ThreadJumps(const compiler::BytecodeAnalysis& analysis);
+
+  Zone* zone() const { return zone_; }
+
+  Zone* zone_;
+  Handle<BytecodeArray> bytecode_array_;
+  int fixed_register_count_;
+  Register incoming_new_target_or_generator_;
+  int register_count_;
+
+  DISALLOW_COPY_AND_ASSIGN(BytecodeLivenessOptimizer);
+};
+
+}  // namespace interpreter
+}  // namespace internal
+}  // namespace v8
+
+#endif  // V8_INTERPRETER_BYTECODE_LIVENESS_OPTIMIZER_H_
@@ -1304,6 +1304,7 @@ Node* InterpreterAssembler::Advance(Node* delta, bool backward) {
 
 Node* InterpreterAssembler::Jump(Node* delta, bool backward) {
   DCHECK(!Bytecodes::IsStarLookahead(bytecode_, operand_scale_));
+  DCHECK(!Bytecodes::IsJumpIfLookahead(bytecode_, operand_scale_));
 
   UpdateInterruptBudget(TruncateIntPtrToInt32(delta), backward);
   Node* new_bytecode_offset = Advance(delta, backward);
@@ -1382,6 +1383,77 @@ void InterpreterAssembler::InlineStar() {
   accumulator_use_ = previous_acc_use;
 }
 
+void InterpreterAssembler::JumpIfDispatchLookahead(Node* target_bytecode) {
+  Label do_inline_jump_if_true(this), do_inline_jump_if_false(this),
+      done(this);
+
+  Node* jump_if_true_bytecode =
+      IntPtrConstant(static_cast<int>(Bytecode::kJumpIfTrue));
+  Node* jump_if_false_bytecode =
+      IntPtrConstant(static_cast<int>(Bytecode::kJumpIfFalse));
+  GotoIf(WordEqual(target_bytecode, jump_if_true_bytecode),
+         &do_inline_jump_if_true);
+  Branch(WordEqual(target_bytecode, jump_if_false_bytecode),
+         &do_inline_jump_if_false, &done);
+
+  BIND(&do_inline_jump_if_true);
+  {
+    RecordBytecodeDispatch(target_bytecode);
+    InlineJumpIf(Bytecode::kJumpIfTrue);
+  }
+  BIND(&do_inline_jump_if_false);
+  {
+    RecordBytecodeDispatch(target_bytecode);
+    InlineJumpIf(Bytecode::kJumpIfFalse);
+  }
+  BIND(&done);
+}
+
+void InterpreterAssembler::InlineJumpIf(Bytecode jump_bytecode) {
+  DCHECK(jump_bytecode == Bytecode::kJumpIfTrue ||
+         jump_bytecode == Bytecode::kJumpIfFalse);
+  Bytecode previous_bytecode = bytecode_;
+  AccumulatorUse previous_acc_use = accumulator_use_;
+
+  bytecode_ = jump_bytecode;
+  accumulator_use_ = AccumulatorUse::kNone;
+
+#ifdef V8_TRACE_IGNITION
+  TraceBytecode(Runtime::kInterpreterTraceBytecodeEntry);
+#endif
+  Node* accumulator = GetAccumulator();
+  Node* relative_jump = BytecodeOperandUImmWord(0);
+  CSA_ASSERT(this, TaggedIsNotSmi(accumulator));
+  CSA_ASSERT(this, IsBoolean(accumulator));
+  Node* jump_value = jump_bytecode == Bytecode::kJumpIfTrue ? TrueConstant()
+                                                            : FalseConstant();
+
+  Label do_jump(this), no_jump(this), done(this);
+  Branch(WordEqual(accumulator, jump_value), &do_jump, &no_jump);
+  BIND(&do_jump);
+  {
+    UpdateInterruptBudget(TruncateIntPtrToInt32(relative_jump), false);
+    Advance(relative_jump);
+    Goto(&done);
+  }
+  BIND(&no_jump);
+  {
+    Advance();
+    Goto(&done);
+  }
+  BIND(&done);
+
+  DCHECK_EQ(accumulator_use_, Bytecodes::GetAccumulatorUse(bytecode_));
+
+  // Dispatch as |jump_bytecode|, so that the dispatch is traced and sampled
+  // like the one of a JumpIfTrue or JumpIfFalse handler.
+  Node* target_bytecode = LoadBytecode(BytecodeOffset());
+  DispatchToBytecode(target_bytecode, BytecodeOffset());
+
+  bytecode_ = previous_bytecode;
+  accumulator_use_ = previous_acc_use;
+}
+
 Node* InterpreterAssembler::Dispatch() {
   Comment("========= Dispatch");
   DCHECK_IMPLIES(Bytecodes::MakesCallAlongCriticalPath(bytecode_), made_call_);
@@ -1390,15 +1462,21 @@ Node* InterpreterAssembler::Dispatch() {
 
   if (Bytecodes::IsStarLookahead(bytecode_, operand_scale_)) {
     target_bytecode = StarDispatchLookahead(target_bytecode);
+  } else if (Bytecodes::IsJumpIfLookahead(bytecode_, operand_scale_)) {
+    JumpIfDispatchLookahead(target_bytecode);
   }
   return DispatchToBytecode(target_bytecode, BytecodeOffset());
 }
 
-Node* InterpreterAssembler::DispatchToBytecode(Node* target_bytecode,
-                                               Node* new_bytecode_offset) {
+void InterpreterAssembler::RecordBytecodeDispatch(Node* target_bytecode) {
   if (FLAG_trace_ignition_dispatches) {
     TraceBytecodeDispatch(target_bytecode);
   }
+}
+
+Node* InterpreterAssembler::DispatchToBytecode(Node* target_bytecode,
+                                               Node* new_bytecode_offset) {
+  RecordBytecodeDispatch(target_bytecode);
 
   Node* target_code_entry =
       Load(MachineType::Pointer(), DispatchTableRawPointer(),
@@ -1441,9 +1519,7 @@ void InterpreterAssembler::DispatchWide(OperandScale operand_scale) {
   Node* next_bytecode_offset = Advance(1);
   Node* next_bytecode = LoadBytecode(next_bytecode_offset);
 
-  if (FLAG_trace_ignition_dispatches) {
-    TraceBytecodeDispatch(next_bytecode);
-  }
+  RecordBytecodeDispatch(next_bytecode);
 
   Node* base_index;
   switch (operand_scale) {
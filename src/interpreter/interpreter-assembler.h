@@ -404,6 +404,20 @@ class V8_EXPORT_PRIVATE InterpreterAssembler : public CodeStubAssembler {
   // next dispatch offset.
   void InlineStar();
 
+  // Look ahead for JumpIfTrue and JumpIfFalse and, if |target_bytecode| is
+  // one of them, inline it in a branch that dispatches on its own. Falls
+  // through for any other |target_bytecode|.
+  void JumpIfDispatchLookahead(compiler::Node* target_bytecode);
+
+  // Build code for the conditional jump |jump_bytecode| at the current
+  // BytecodeOffset() and dispatch to the next bytecode, which is either the
+  // jump target or the bytecode following the jump.
+  void InlineJumpIf(Bytecode jump_bytecode);
+
+  // Traces a dispatch from the current bytecode to |target_bytecode| if
+  // enabled by --trace-ignition-dispatches.
+  void RecordBytecodeDispatch(compiler::Node* target_bytecode);
+
   // Dispatch to the bytecode handler with code offset |handler|.
   compiler::Node* DispatchToBytecodeHandler(compiler::Node* handler,
                                             compiler::Node* bytecode_offset,
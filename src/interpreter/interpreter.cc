@@ -8,9 +8,11 @@
 #include <memory>
 
 #include "src/ast/prettyprinter.h"
+#include "src/base/utils/random-number-generator.h"
 #include "src/bootstrapper.h"
 #include "src/compiler.h"
 #include "src/counters-inl.h"
+#include "src/frames-inl.h"
 #include "src/interpreter/bytecode-generator.h"
 #include "src/interpreter/bytecodes.h"
 #include "src/log.h"
@@ -47,7 +49,15 @@ class InterpreterCompilationJob final : public UnoptimizedCompilationJob {
   DISALLOW_COPY_AND_ASSIGN(InterpreterCompilationJob);
 };
 
-Interpreter::Interpreter(Isolate* isolate) : isolate_(isolate) {
+Interpreter::Interpreter(Isolate* isolate)
+    : isolate_(isolate),
+      dispatch_sampling_armed_(false),
+      dispatches_until_sample_(0),
+      sample_frame_(kNullAddress),
+      sample_from_(Bytecode::kIllegal),
+      sample_from_scale_(OperandScale::kSingle),
+      sample_from_offset_(0),
+      next_dispatch_sample_(0) {
   memset(dispatch_table_, 0, sizeof(dispatch_table_));
 
   if (FLAG_trace_ignition_dispatches) {
@@ -84,7 +94,7 @@ Code* Interpreter::GetBytecodeHandler(Bytecode bytecode,
   DCHECK(IsDispatchTableInitialized());
   DCHECK(Bytecodes::BytecodeHasHandler(bytecode, operand_scale));
   size_t index = GetDispatchTableIndex(bytecode, operand_scale);
-  Address code_entry = dispatch_table_[index];
+  Address code_entry = handler_table()[index];
   return Code::GetCodeFromTargetAddress(code_entry);
 }
 
@@ -93,7 +103,7 @@ void Interpreter::SetBytecodeHandler(Bytecode bytecode,
                                      Code* handler) {
   DCHECK(handler->kind() == Code::BYTECODE_HANDLER);
   size_t index = GetDispatchTableIndex(bytecode, operand_scale);
-  dispatch_table_[index] = handler->entry();
+  handler_table()[index] = handler->entry();
 }
 
 // static
@@ -113,15 +123,20 @@ size_t Interpreter::GetDispatchTableIndex(Bytecode bytecode,
 }
 
 void Interpreter::IterateDispatchTable(RootVisitor* v) {
+  IterateTable(v, dispatch_table_);
+  if (dispatch_sampling_armed_) IterateTable(v, saved_dispatch_table_.get());
+}
+
+void Interpreter::IterateTable(RootVisitor* v, Address* table) {
   for (int i = 0; i < kDispatchTableSize; i++) {
-    Address code_entry = dispatch_table_[i];
+    Address code_entry = table[i];
     Object* code = code_entry == kNullAddress
                        ? nullptr
                        : Code::GetCodeFromTargetAddress(code_entry);
     Object* old_code = code;
     v->VisitRootPointer(Root::kDispatchTable, nullptr, &code);
     if (code != old_code) {
-      dispatch_table_[i] = reinterpret_cast<Code*>(code)->entry();
+      table[i] = reinterpret_cast<Code*>(code)->entry();
     }
   }
 }
@@ -236,7 +251,7 @@ bool Interpreter::IsDispatchTableInitialized() const {
 const char* Interpreter::LookupNameOfBytecodeHandler(Code* code) {
 #ifdef ENABLE_DISASSEMBLER
 #define RETURN_NAME(Name, ...)                                 \
-  if (dispatch_table_[Bytecodes::ToByte(Bytecode::k##Name)] == \
+  if (handler_table()[Bytecodes::ToByte(Bytecode::k##Name)] == \
       code->entry()) {                                         \
     return #Name;                                              \
   }
@@ -253,6 +268,140 @@ uintptr_t Interpreter::GetDispatchCounter(Bytecode from, Bytecode to) const {
                                            to_index];
 }
 
+void Interpreter::RecordDispatchSample(JSFunction* function, Bytecode from,
+                                       Bytecode to) {
+  DisallowHeapAllocation no_gc;
+  SharedFunctionInfo* shared = function->shared();
+  DispatchSample sample;
+  sample.script_id =
+      shared->script()->IsScript() ? Script::cast(shared->script())->id() : -1;
+  sample.function_position = shared->StartPosition();
+  sample.from = from;
+  sample.to = to;
+
+  size_t buffer_size =
+      static_cast<size_t>(std::max(1, FLAG_ignition_dispatch_sampling_buffer));
+  if (dispatch_samples_.size() < buffer_size) {
+    dispatch_samples_.push_back(sample);
+  } else {
+    dispatch_samples_[next_dispatch_sample_] = sample;
+    next_dispatch_sample_ = (next_dispatch_sample_ + 1) % buffer_size;
+  }
+}
+
+void Interpreter::MaybeArmDispatchSampling() {
+  if (!FLAG_ignition_dispatch_sampling || dispatch_sampling_armed_) return;
+  Heap* heap = isolate_->heap();
+  if (!IsDispatchTableInitialized() ||
+      !heap->deserialize_lazy_handler()->IsCode()) {
+    return;
+  }
+
+  // The DeserializeLazy handlers load the bytecode at the current offset and
+  // ask the runtime for its handler, which is where the sampling happens.
+  static const int kEntriesPerOperandScale = 1 << kBitsPerByte;
+  STATIC_ASSERT(kDispatchTableSize == 3 * kEntriesPerOperandScale);
+  Address lazy_handlers[] = {
+      Code::cast(heap->deserialize_lazy_handler())->entry(),
+      Code::cast(heap->deserialize_lazy_handler_wide())->entry(),
+      Code::cast(heap->deserialize_lazy_handler_extra_wide())->entry()};
+  if (!saved_dispatch_table_) {
+    saved_dispatch_table_.reset(new Address[kDispatchTableSize]);
+  }
+  for (int i = 0; i < kDispatchTableSize; i++) {
+    saved_dispatch_table_[i] = dispatch_table_[i];
+    dispatch_table_[i] = lazy_handlers[i / kEntriesPerOperandScale];
+  }
+  dispatch_sampling_armed_ = true;
+
+  int window = std::max(1, FLAG_ignition_dispatch_sampling_window);
+  dispatches_until_sample_ =
+      isolate_->random_number_generator()->NextInt(window);
+  sample_frame_ = kNullAddress;
+}
+
+void Interpreter::DisarmDispatchSampling() {
+  DCHECK(dispatch_sampling_armed_);
+  std::copy(saved_dispatch_table_.get(),
+            saved_dispatch_table_.get() + kDispatchTableSize, dispatch_table_);
+  dispatch_sampling_armed_ = false;
+}
+
+namespace {
+
+// Returns true if the handler of |bytecode| leaves the function instead of
+// dispatching to another bytecode.
+bool LeavesFunction(Bytecode bytecode) {
+  return Bytecodes::Returns(bytecode) || bytecode == Bytecode::kThrow ||
+         bytecode == Bytecode::kReThrow || bytecode == Bytecode::kAbort;
+}
+
+}  // namespace
+
+Code* Interpreter::SampleDispatch(Bytecode bytecode,
+                                  OperandScale operand_scale) {
+  DCHECK(dispatch_sampling_armed_);
+  Code* handler =
+      GetAndMaybeDeserializeBytecodeHandler(bytecode, operand_scale);
+
+  JavaScriptFrameIterator it(isolate_);
+  if (!FLAG_ignition_dispatch_sampling || it.done() ||
+      !it.frame()->is_interpreted()) {
+    DisarmDispatchSampling();
+    return handler;
+  }
+  if (dispatches_until_sample_ > 0) {
+    dispatches_until_sample_--;
+    return handler;
+  }
+
+  InterpretedFrame* frame = InterpretedFrame::cast(it.frame());
+  int offset = frame->GetBytecodeOffset();
+  if (sample_frame_ != frame->fp() || LeavesFunction(sample_from_)) {
+    // Dispatches from the entry trampoline, or into a different frame than
+    // the last one, did not come from the handler of |sample_from_|. Sample
+    // the dispatch out of |bytecode| instead.
+    sample_frame_ = frame->fp();
+    sample_from_ = bytecode;
+    sample_from_scale_ = operand_scale;
+    sample_from_offset_ = offset;
+    return handler;
+  }
+
+  // With a Star or JumpIf lookahead, the handler of |sample_from_| executed
+  // the following bytecode itself, so the dispatch that the handlers would
+  // otherwise have done went to that bytecode.
+  Bytecode to = bytecode;
+  if (Bytecodes::IsStarLookahead(sample_from_, sample_from_scale_) ||
+      Bytecodes::IsJumpIfLookahead(sample_from_, sample_from_scale_)) {
+    BytecodeArray* bytecode_array = frame->GetBytecodeArray();
+    int next_offset =
+        sample_from_offset_ + Bytecodes::Size(sample_from_, sample_from_scale_);
+    if (next_offset != offset && next_offset < bytecode_array->length()) {
+      Bytecode next = Bytecodes::FromByte(bytecode_array->get(next_offset));
+      if (next == Bytecode::kStar || next == Bytecode::kJumpIfTrue ||
+          next == Bytecode::kJumpIfFalse) {
+        to = next;
+      }
+    }
+  }
+  RecordDispatchSample(frame->function(), sample_from_, to);
+  DisarmDispatchSampling();
+  return handler;
+}
+
+size_t Interpreter::GetDispatchSamples(DispatchSample* samples,
+                                       size_t capacity) const {
+  size_t count = std::min(capacity, dispatch_samples_.size());
+  // The oldest sample is at |next_dispatch_sample_|, skip the samples that do
+  // not fit into |samples|.
+  size_t start = next_dispatch_sample_ + dispatch_samples_.size() - count;
+  for (size_t i = 0; i < count; i++) {
+    samples[i] = dispatch_samples_[(start + i) % dispatch_samples_.size()];
+  }
+  return count;
+}
+
 Local<v8::Object> Interpreter::GetDispatchCountersObject() {
   v8::Isolate* isolate = reinterpret_cast<v8::Isolate*>(isolate_);
   Local<v8::Context> context = isolate->GetCurrentContext();
@@ -6,6 +6,7 @@
 #define V8_INTERPRETER_INTERPRETER_H_
 
 #include <memory>
+#include <vector>
 
 // Clients of this interface shouldn't depend on lots of interpreter internals.
 // Do not include anything from src/interpreter other than
@@ -23,6 +24,7 @@ class BuiltinDeserializerAllocator;
 class Callable;
 class UnoptimizedCompilationJob;
 class FunctionLiteral;
+class JSFunction;
 class ParseInfo;
 class RootVisitor;
 class SetupIsolateDelegate;
@@ -69,6 +71,40 @@ class Interpreter {
 
   V8_EXPORT_PRIVATE Local<v8::Object> GetDispatchCountersObject();
 
+  // A bytecode dispatch sampled with --ignition-dispatch-sampling.
+  struct DispatchSample {
+    int script_id;
+    int function_position;
+    Bytecode from;
+    Bytecode to;
+  };
+
+  // Records the dispatch from |from| to |to| in |function| in the ring
+  // buffer of samples.
+  V8_EXPORT_PRIVATE void RecordDispatchSample(JSFunction* function,
+                                              Bytecode from, Bytecode to);
+
+  // With --ignition-dispatch-sampling, arms the sampling of one dispatch.
+  // Called whenever a function runs out of interrupt budget. Until the sample
+  // is taken, all entries of the dispatch table point to the DeserializeLazy
+  // handlers, which call SampleDispatch() on every dispatch. The bytecode
+  // handlers themselves do not sample, so there is no cost while unarmed.
+  V8_EXPORT_PRIVATE void MaybeArmDispatchSampling();
+
+  bool IsDispatchSamplingArmed() const { return dispatch_sampling_armed_; }
+
+  // Called on every dispatch to |bytecode| with |operand_scale| while
+  // dispatch sampling is armed. Lets a random number of dispatches (below
+  // --ignition-dispatch-sampling-window) pass, then records the next
+  // dispatch from a bytecode handler and disarms. Returns the handler to
+  // dispatch to.
+  Code* SampleDispatch(Bytecode bytecode, OperandScale operand_scale);
+
+  // Copies up to |capacity| of the most recent samples to |samples|, oldest
+  // first, and returns the number of samples copied.
+  V8_EXPORT_PRIVATE size_t GetDispatchSamples(DispatchSample* samples,
+                                              size_t capacity) const;
+
   bool IsDispatchTableInitialized() const;
 
   Address dispatch_table_address() {
@@ -86,6 +122,17 @@ class Interpreter {
 
   uintptr_t GetDispatchCounter(Bytecode from, Bytecode to) const;
 
+  void DisarmDispatchSampling();
+
+  // The table that holds the bytecode handlers. While dispatch sampling is
+  // armed, this is the saved dispatch table.
+  Address* handler_table() {
+    return dispatch_sampling_armed_ ? saved_dispatch_table_.get()
+                                    : dispatch_table_;
+  }
+
+  void IterateTable(RootVisitor* v, Address* table);
+
   // Get dispatch table index of bytecode.
   static size_t GetDispatchTableIndex(Bytecode bytecode,
                                       OperandScale operand_scale);
@@ -98,6 +145,22 @@ class Interpreter {
   Address dispatch_table_[kDispatchTableSize];
   std::unique_ptr<uintptr_t[]> bytecode_dispatch_counters_table_;
 
+  // The dispatch table as it was before dispatch sampling was armed.
+  std::unique_ptr<Address[]> saved_dispatch_table_;
+  bool dispatch_sampling_armed_;
+  // Number of dispatches to let pass before the sampled dispatch.
+  int dispatches_until_sample_;
+  // Frame pointer, bytecode, operand scale and bytecode offset of the
+  // dispatch that the sampled dispatch goes out from, if any.
+  Address sample_frame_;
+  Bytecode sample_from_;
+  OperandScale sample_from_scale_;
+  int sample_from_offset_;
+  // Ring buffer of dispatch samples, |next_dispatch_sample_| is the index of
+  // the sample to overwrite once the buffer is full.
+  std::vector<DispatchSample> dispatch_samples_;
+  size_t next_dispatch_sample_;
+
   DISALLOW_COPY_AND_ASSIGN(Interpreter);
 };
 
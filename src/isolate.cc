@@ -50,6 +50,7 @@
 #include "src/runtime-profiler.h"
 #include "src/setup-isolate.h"
 #include "src/simulator.h"
+#include "src/snapshot/persistent-code-cache.h"
 #include "src/snapshot/startup-deserializer.h"
 #include "src/tracing/tracing-category-observer.h"
 #include "src/trap-handler/trap-handler.h"
@@ -2624,6 +2625,11 @@ void Isolate::ClearSerializerData() {
 void Isolate::Deinit() {
   TRACE_ISOLATE(deinit);
 
+  // Persist code caches before any part of the isolate is torn down.
+  if (PersistentCodeCache::IsEnabled() && !serializer_enabled()) {
+    PersistentCodeCache::StoreScripts(this);
+  }
+
   debug()->Unload();
 
   if (concurrent_recompilation_enabled()) {
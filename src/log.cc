@@ -1450,6 +1450,15 @@ void Logger::CodeMoveEvent(AbstractCode* from, Address to) {
   MoveEventInternal(CodeEventListener::CODE_MOVE_EVENT, from->address(), to);
 }
 
+void Logger::CodeDeleteEvent(Address start) {
+  if (!is_listening_to_code_events()) return;
+  if (!FLAG_log_code || !log_->IsEnabled()) return;
+  Log::MessageBuilder msg(log_);
+  msg << kLogEventsNames[CodeEventListener::CODE_DELETE_EVENT] << kNext
+      << reinterpret_cast<void*>(start);
+  msg.WriteToLogFile();
+}
+
 namespace {
 
 void CodeLinePosEvent(JitLogger* jit_logger, Address code_start,
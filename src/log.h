@@ -208,6 +208,8 @@ class Logger : public CodeEventListener {
   void RegExpCodeCreateEvent(AbstractCode* code, String* source);
   // Emits a code move event.
   void CodeMoveEvent(AbstractCode* from, Address to);
+  // Emits a code delete event.
+  void CodeDeleteEvent(Address start);
   // Emits a code line info record event.
   void CodeLinePosInfoRecordEvent(Address code_start,
                                   ByteArray* source_position_table);
@@ -416,6 +418,7 @@ class CodeEventLogger : public CodeEventListener {
   void GetterCallbackEvent(Name* name, Address entry_point) override {}
   void SetterCallbackEvent(Name* name, Address entry_point) override {}
   void SharedFunctionInfoMoveEvent(Address from, Address to) override {}
+  void CodeDeleteEvent(Address start) override {}
   void CodeMovingGCEvent() override {}
   void CodeDeoptEvent(Code* code, DeoptKind kind, Address pc,
                       int fp_to_sp_delta) override {}
@@ -465,6 +468,7 @@ class ExternalCodeEventListener : public CodeEventListener {
   void SetterCallbackEvent(Name* name, Address entry_point) override {}
   void SharedFunctionInfoMoveEvent(Address from, Address to) override {}
   void CodeMoveEvent(AbstractCode* from, Address to) override {}
+  void CodeDeleteEvent(Address start) override {}
   void CodeDisableOptEvent(AbstractCode* code,
                            SharedFunctionInfo* shared) override {}
   void CodeMovingGCEvent() override {}
@@ -1720,6 +1720,7 @@ void WasmInstanceObject::WasmInstanceObjectPrint(std::ostream& os) {  // NOLINT
      << static_cast<void*>(indirect_function_table_sig_ids());
   os << "\n - indirect_function_table_targets: "
      << static_cast<void*>(indirect_function_table_targets());
+  os << "\n - tiering_budgets: " << static_cast<void*>(tiering_budgets());
   os << "\n";
 }
 
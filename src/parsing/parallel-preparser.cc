@@ -0,0 +1,657 @@
+// Copyright 2018 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "src/parsing/parallel-preparser.h"
+
+#include <algorithm>
+#include <map>
+#include <vector>
+
+#include "src/ast/ast-value-factory.h"
+#include "src/ast/scopes.h"
+#include "src/base/atomic-utils.h"
+#include "src/base/platform/condition-variable.h"
+#include "src/base/platform/mutex.h"
+#include "src/base/template-utils.h"
+#include "src/flags.h"
+#include "src/objects-inl.h"
+#include "src/parsing/parse-info.h"
+#include "src/parsing/preparser.h"
+#include "src/parsing/scanner.h"
+#include "src/pending-compilation-error-handler.h"
+#include "src/unicode-cache.h"
+#include "src/v8.h"
+#include "src/zone/zone.h"
+
+namespace v8 {
+namespace internal {
+
+namespace {
+
+// Functions shorter than this (in characters) are preparsed faster by the
+// parser than it takes to hand them to a worker thread.
+const int kMinFunctionLength = 2 * KB;
+
+// Whether a '/' after |token| is a division rather than the start of a
+// regular expression literal.
+bool EndsExpression(Token::Value token) {
+  switch (token) {
+    case Token::IDENTIFIER:
+    case Token::PRIVATE_NAME:
+    case Token::FUTURE_STRICT_RESERVED_WORD:
+    case Token::ESCAPED_STRICT_RESERVED_WORD:
+    case Token::ASYNC:
+    case Token::AWAIT:
+    case Token::LET:
+    case Token::STATIC:
+    case Token::YIELD:
+    case Token::SUPER:
+    case Token::THIS:
+    case Token::NULL_LITERAL:
+    case Token::TRUE_LITERAL:
+    case Token::FALSE_LITERAL:
+    case Token::NUMBER:
+    case Token::SMI:
+    case Token::STRING:
+    case Token::BIGINT:
+    case Token::REGEXP_LITERAL:
+    case Token::TEMPLATE_TAIL:
+    case Token::RPAREN:
+    case Token::RBRACK:
+    case Token::RBRACE:
+    case Token::INC:
+    case Token::DEC:
+      return true;
+    default:
+      return false;
+  }
+}
+
+// Whether a '{' after |token| opens a block or a function body rather than
+// an object literal.
+bool OpensBlock(Token::Value token) {
+  switch (token) {
+    case Token::UNINITIALIZED:
+    case Token::SEMICOLON:
+    case Token::LBRACE:
+    case Token::ARROW:
+    case Token::ELSE:
+    case Token::TRY:
+    case Token::FINALLY:
+    case Token::DO:
+      return true;
+    default:
+      return EndsExpression(token);
+  }
+}
+
+Token::Value ClosingBracket(Token::Value token) {
+  switch (token) {
+    case Token::LPAREN:
+      return Token::RPAREN;
+    case Token::LBRACK:
+      return Token::RBRACK;
+    default:
+      DCHECK_EQ(Token::LBRACE, token);
+      return Token::RBRACE;
+  }
+}
+
+bool IsFunctionName(Token::Value token) {
+  switch (token) {
+    case Token::IDENTIFIER:
+    case Token::FUTURE_STRICT_RESERVED_WORD:
+    case Token::ESCAPED_STRICT_RESERVED_WORD:
+    case Token::ASYNC:
+    case Token::AWAIT:
+    case Token::LET:
+    case Token::STATIC:
+    case Token::YIELD:
+      return true;
+    default:
+      return false;
+  }
+}
+
+}  // namespace
+
+// The state shared between the parser and the tasks on worker threads.
+class ParallelPreParser::State final
+    : public std::enable_shared_from_this<State> {
+ public:
+  State(ParseInfo* info, PreParser* preparser)
+      : allocator_(info->zone()->allocator()),
+        ast_string_constants_(info->ast_string_constants()),
+        hash_seed_(info->hash_seed()),
+        stream_(info->character_stream()),
+        allow_natives_(preparser->allow_natives()),
+        allow_harmony_do_expressions_(
+            preparser->allow_harmony_do_expressions()),
+        allow_harmony_public_fields_(preparser->allow_harmony_public_fields()),
+        allow_harmony_static_fields_(preparser->allow_harmony_static_fields()),
+        allow_harmony_dynamic_import_(
+            preparser->allow_harmony_dynamic_import()),
+        allow_harmony_import_meta_(preparser->allow_harmony_import_meta()),
+        allow_harmony_bigint_(preparser->allow_harmony_bigint()),
+        allow_harmony_numeric_separator_(
+            preparser->allow_harmony_numeric_separator()),
+        allow_harmony_private_fields_(
+            preparser->allow_harmony_private_fields()),
+        language_mode_(LanguageMode::kSloppy),
+        parser_position_(kNoSourcePosition),
+        finder_position_(0),
+        running_(0),
+        finder_running_(false) {}
+
+  // Called on the parser thread.
+  void Start(LanguageMode language_mode);
+  const Result* Lookup(int start_position, const AstRawString* name,
+                       FunctionKind kind,
+                       FunctionLiteral::FunctionType function_type,
+                       LanguageMode outer_language_mode);
+  void Finish();
+  void ReleaseResults();
+
+  // Called on worker threads.
+  void FindFunctions(Utf16CharacterStream* stream);
+  void PreParse(int start_position, Utf16CharacterStream* stream,
+                uintptr_t stack_limit);
+
+ private:
+  // A function found by the finder.
+  struct Entry {
+    enum Status { kQueued, kRunning, kDone, kFailed, kTakenByParser };
+
+    Status status = kQueued;
+    int start_position = kNoSourcePosition;
+    FunctionKind kind = FunctionKind::kNormalFunction;
+    FunctionLiteral::FunctionType function_type =
+        FunctionLiteral::kAnonymousExpression;
+    bool name_is_one_byte = true;
+    std::vector<uint8_t> name;
+    // Holds the preparsed scope data of the result.
+    std::unique_ptr<Zone> zone;
+    Result result;
+
+    bool Matches(const AstRawString* other_name, FunctionKind other_kind,
+                 FunctionLiteral::FunctionType other_function_type) const {
+      return kind == other_kind && function_type == other_function_type &&
+             name_is_one_byte == other_name->is_one_byte() &&
+             name.size() == static_cast<size_t>(other_name->byte_length()) &&
+             std::equal(name.begin(), name.end(), other_name->raw_data());
+    }
+  };
+
+  // An open bracket seen by the finder.
+  struct Bracket {
+    Token::Value token;
+    // Whether function literals inside the bracket are nested in a block
+    // or in another function, and thus never top-level functions.
+    bool nested;
+    // The function whose body the bracket opens, if any.
+    std::unique_ptr<Entry> function;
+  };
+
+  void Dispatch(std::unique_ptr<Entry> entry, int end_position,
+                Utf16CharacterStream* stream);
+  void ReportFinderPosition(int position, const std::vector<Bracket>& brackets,
+                            const Entry* function);
+  bool PreParseEntry(Entry* entry, Utf16CharacterStream* stream,
+                     uintptr_t stack_limit);
+
+  AccountingAllocator* const allocator_;
+  const AstStringConstants* const ast_string_constants_;
+  const uint32_t hash_seed_;
+  Utf16CharacterStream* const stream_;
+  const bool allow_natives_;
+  const bool allow_harmony_do_expressions_;
+  const bool allow_harmony_public_fields_;
+  const bool allow_harmony_static_fields_;
+  const bool allow_harmony_dynamic_import_;
+  const bool allow_harmony_import_meta_;
+  const bool allow_harmony_bigint_;
+  const bool allow_harmony_numeric_separator_;
+  const bool allow_harmony_private_fields_;
+  // The language mode of the script, set by Start().
+  LanguageMode language_mode_;
+
+  base::AtomicValue<bool> cancelled_;
+  base::Mutex mutex_;
+  base::ConditionVariable done_;
+  // Everything below is protected by |mutex_|.
+  std::map<int, std::unique_ptr<Entry>> entries_;
+  // The start position of the function the parser looked up last. Functions
+  // before it are not worth preparsing anymore.
+  int parser_position_;
+  // The finder has decided about all functions that start before this
+  // position. Only maintained with --parallel-preparse-wait-for-testing.
+  int finder_position_;
+  int running_;
+  bool finder_running_;
+
+  DISALLOW_COPY_AND_ASSIGN(State);
+};
+
+class ParallelPreParser::FinderTask : public v8::Task {
+ public:
+  FinderTask(std::shared_ptr<State> state,
+             std::unique_ptr<Utf16CharacterStream> stream)
+      : state_(state), stream_(std::move(stream)) {}
+
+  void Run() override {
+    DisallowHeapAllocation no_allocation;
+    DisallowHandleAllocation no_handles;
+    DisallowHandleDereference no_deref;
+    state_->FindFunctions(stream_.get());
+  }
+
+ private:
+  std::shared_ptr<State> state_;
+  std::unique_ptr<Utf16CharacterStream> stream_;
+
+  DISALLOW_COPY_AND_ASSIGN(FinderTask);
+};
+
+class ParallelPreParser::PreParseTask : public v8::Task {
+ public:
+  PreParseTask(std::shared_ptr<State> state, int start_position,
+               std::unique_ptr<Utf16CharacterStream> stream)
+      : state_(state),
+        start_position_(start_position),
+        stream_(std::move(stream)),
+        stack_size_(FLAG_stack_size) {}
+
+  void Run() override {
+    DisallowHeapAllocation no_allocation;
+    DisallowHandleAllocation no_handles;
+    DisallowHandleDereference no_deref;
+    uintptr_t stack_limit = GetCurrentStackPosition() - stack_size_ * KB;
+    state_->PreParse(start_position_, stream_.get(), stack_limit);
+  }
+
+ private:
+  std::shared_ptr<State> state_;
+  int start_position_;
+  std::unique_ptr<Utf16CharacterStream> stream_;
+  int stack_size_;
+
+  DISALLOW_COPY_AND_ASSIGN(PreParseTask);
+};
+
+void ParallelPreParser::State::Start(LanguageMode language_mode) {
+  language_mode_ = language_mode;
+  {
+    base::LockGuard<base::Mutex> guard(&mutex_);
+    finder_running_ = true;
+  }
+  // The finder blocks while it waits for the parser to fetch more data.
+  V8::GetCurrentPlatform()->CallBlockingTaskOnWorkerThread(
+      base::make_unique<FinderTask>(shared_from_this(), stream_->Clone(true)));
+}
+
+const ParallelPreParser::Result* ParallelPreParser::State::Lookup(
+    int start_position, const AstRawString* name, FunctionKind kind,
+    FunctionLiteral::FunctionType function_type,
+    LanguageMode outer_language_mode) {
+  base::LockGuard<base::Mutex> guard(&mutex_);
+  if (FLAG_parallel_preparse_wait_for_testing) {
+    // Only terminates if the finder does not need more data than the parser
+    // has fetched to get past the function.
+    while (finder_running_ && finder_position_ <= start_position) {
+      done_.Wait(&mutex_);
+    }
+  }
+  parser_position_ = start_position;
+  auto it = entries_.find(start_position);
+  if (it == entries_.end()) return nullptr;
+  Entry* entry = it->second.get();
+  if (entry->status == Entry::kQueued &&
+      !FLAG_parallel_preparse_wait_for_testing) {
+    // No worker thread got to the function yet, so the parser is faster
+    // preparsing it itself than waiting for one.
+    entry->status = Entry::kTakenByParser;
+    return nullptr;
+  }
+  while (entry->status == Entry::kQueued ||
+         entry->status == Entry::kRunning) {
+    done_.Wait(&mutex_);
+  }
+  if (entry->status != Entry::kDone || outer_language_mode != language_mode_ ||
+      !entry->Matches(name, kind, function_type)) {
+    return nullptr;
+  }
+  return &entry->result;
+}
+
+void ParallelPreParser::State::Finish() {
+  if (cancelled_.Value()) return;
+  cancelled_.SetValue(true);
+  // The parser does not fetch any more data, so the finder must not wait
+  // for it.
+  stream_->StopClones();
+  base::LockGuard<base::Mutex> guard(&mutex_);
+  while (running_ > 0 || finder_running_) done_.Wait(&mutex_);
+}
+
+void ParallelPreParser::State::ReleaseResults() {
+  // Tasks that have not run yet may keep the state alive after the parser is
+  // gone, but the zones must not outlive the isolate's allocator.
+  base::LockGuard<base::Mutex> guard(&mutex_);
+  DCHECK(cancelled_.Value());
+  DCHECK_EQ(0, running_);
+  entries_.clear();
+}
+
+void ParallelPreParser::State::FindFunctions(Utf16CharacterStream* stream) {
+  Zone zone(allocator_, ZONE_NAME);
+  AstValueFactory ast_value_factory(&zone, ast_string_constants_, hash_seed_);
+  UnicodeCache unicode_cache;
+  Scanner scanner(&unicode_cache);
+  scanner.set_allow_harmony_bigint(allow_harmony_bigint_);
+  scanner.set_allow_harmony_numeric_separator(
+      allow_harmony_numeric_separator_);
+  scanner.set_allow_harmony_private_fields(allow_harmony_private_fields_);
+  scanner.Initialize(stream, false);
+
+  // Match brackets at the token level, which finds the end of a function
+  // much faster than preparsing it. Function literals are candidates if they
+  // are not nested in a block or another function, and are not in one of
+  // the positions that make the parser compile them eagerly.
+  std::vector<Bracket> brackets;
+  // For every template literal with open substitutions, the number of open
+  // brackets at its start.
+  std::vector<size_t> templates;
+  // The function whose parameters are being scanned.
+  std::unique_ptr<Entry> function;
+  size_t function_depth = 0;
+  Token::Value previous = Token::UNINITIALIZED;
+  Token::Value before_previous = Token::UNINITIALIZED;
+
+  while (!cancelled_.Value()) {
+    if (V8_UNLIKELY(FLAG_parallel_preparse_wait_for_testing)) {
+      ReportFinderPosition(scanner.location().end_pos, brackets,
+                           function.get());
+    }
+    Token::Value token = scanner.peek();
+    bool line_terminator_before = scanner.HasAnyLineTerminatorBeforeNext();
+    if ((token == Token::DIV || token == Token::ASSIGN_DIV) &&
+        !EndsExpression(previous)) {
+      if (!scanner.ScanRegExpPattern() ||
+          scanner.ScanRegExpFlags().IsNothing()) {
+        break;
+      }
+      scanner.Next();
+      token = Token::REGEXP_LITERAL;
+    } else if (token == Token::RBRACE && !templates.empty() &&
+               templates.back() == brackets.size()) {
+      token = scanner.ScanTemplateContinuation();
+      scanner.Next();
+      if (token == Token::TEMPLATE_TAIL) templates.pop_back();
+    } else {
+      scanner.Next();
+      if (token == Token::TEMPLATE_SPAN) templates.push_back(brackets.size());
+    }
+
+    if (token == Token::EOS || token == Token::ILLEGAL) break;
+
+    if (token == Token::LPAREN || token == Token::LBRACK ||
+        token == Token::LBRACE) {
+      bool nested = !brackets.empty() && brackets.back().nested;
+      std::unique_ptr<Entry> body;
+      if (token == Token::LBRACE) {
+        nested = nested || OpensBlock(previous);
+        if (function && brackets.size() == function_depth &&
+            previous == Token::RPAREN) {
+          body = std::move(function);
+        }
+      }
+      brackets.push_back({token, nested, std::move(body)});
+    } else if (token == Token::RPAREN || token == Token::RBRACK ||
+               token == Token::RBRACE) {
+      if (brackets.empty() || ClosingBracket(brackets.back().token) != token) {
+        break;
+      }
+      if (brackets.back().function) {
+        Dispatch(std::move(brackets.back().function),
+                 scanner.location().end_pos, stream);
+      }
+      brackets.pop_back();
+    } else if (token == Token::FUNCTION &&
+               (brackets.empty() || !brackets.back().nested) &&
+               previous != Token::PERIOD && previous != Token::LPAREN &&
+               previous != Token::NOT) {
+      function.reset(new Entry());
+      function_depth = brackets.size();
+      // The token before the function literal decides whether it is a
+      // declaration, and whether it is compiled eagerly.
+      Token::Value before = previous;
+      if (previous == Token::ASYNC && !line_terminator_before) {
+        function->kind = FunctionKind::kAsyncFunction;
+        before = before_previous;
+      }
+      before_previous = previous;
+      previous = Token::FUNCTION;
+      if (scanner.peek() == Token::MUL) {
+        before_previous = previous;
+        scanner.Next();
+        previous = Token::MUL;
+        function->kind = function->kind == FunctionKind::kAsyncFunction
+                             ? FunctionKind::kAsyncGeneratorFunction
+                             : FunctionKind::kGeneratorFunction;
+      }
+      bool has_name = IsFunctionName(scanner.peek());
+      if (has_name) {
+        before_previous = previous;
+        previous = scanner.Next();
+        const AstRawString* name = scanner.CurrentSymbol(&ast_value_factory);
+        function->name_is_one_byte = name->is_one_byte();
+        function->name.assign(name->raw_data(),
+                              name->raw_data() + name->byte_length());
+      }
+      bool is_declaration = before == Token::UNINITIALIZED ||
+                            before == Token::SEMICOLON ||
+                            EndsExpression(before);
+      if (is_declaration) {
+        function->function_type = FunctionLiteral::kDeclaration;
+      } else if (has_name) {
+        function->function_type = FunctionLiteral::kNamedExpression;
+      }
+      if (before == Token::LPAREN || (is_declaration && !has_name) ||
+          scanner.peek() != Token::LPAREN) {
+        function.reset();
+      } else {
+        function->start_position = scanner.peek_location().beg_pos;
+      }
+      continue;
+    }
+
+    // Only the parameters may follow the function token at its depth.
+    if (function && brackets.size() <= function_depth &&
+        token != Token::RPAREN) {
+      function.reset();
+    }
+    before_previous = previous;
+    previous = token;
+  }
+
+  base::LockGuard<base::Mutex> guard(&mutex_);
+  finder_running_ = false;
+  done_.NotifyAll();
+}
+
+void ParallelPreParser::State::Dispatch(std::unique_ptr<Entry> entry,
+                                        int end_position,
+                                        Utf16CharacterStream* stream) {
+  if (end_position - entry->start_position < kMinFunctionLength) return;
+  int start_position = entry->start_position;
+  {
+    base::LockGuard<base::Mutex> guard(&mutex_);
+    if (cancelled_.Value() || start_position <= parser_position_) return;
+    entries_[start_position] = std::move(entry);
+  }
+  // The finder has seen the whole function, so the preparse task never needs
+  // to wait for more data. It must not, since the parser may wait for it.
+  V8::GetCurrentPlatform()->CallOnWorkerThread(base::make_unique<PreParseTask>(
+      shared_from_this(), start_position, stream->Clone(false)));
+}
+
+void ParallelPreParser::State::ReportFinderPosition(
+    int position, const std::vector<Bracket>& brackets, const Entry* function) {
+  // A function is only decided about at the end of its body.
+  if (function) position = std::min(position, function->start_position);
+  for (const Bracket& bracket : brackets) {
+    if (bracket.function) {
+      position = std::min(position, bracket.function->start_position);
+    }
+  }
+  base::LockGuard<base::Mutex> guard(&mutex_);
+  finder_position_ = position;
+  done_.NotifyAll();
+}
+
+void ParallelPreParser::State::PreParse(int start_position,
+                                        Utf16CharacterStream* stream,
+                                        uintptr_t stack_limit) {
+  Entry* entry;
+  {
+    base::LockGuard<base::Mutex> guard(&mutex_);
+    auto it = entries_.find(start_position);
+    if (cancelled_.Value() || it == entries_.end() ||
+        it->second->status != Entry::kQueued) {
+      return;
+    }
+    entry = it->second.get();
+    entry->status = Entry::kRunning;
+    running_++;
+  }
+
+  // The parser does not touch a running entry, so it can be filled in
+  // without holding the lock.
+  bool success = PreParseEntry(entry, stream, stack_limit);
+
+  base::LockGuard<base::Mutex> guard(&mutex_);
+  entry->status = success ? Entry::kDone : Entry::kFailed;
+  running_--;
+  done_.NotifyAll();
+}
+
+bool ParallelPreParser::State::PreParseEntry(Entry* entry,
+                                             Utf16CharacterStream* stream,
+                                             uintptr_t stack_limit) {
+  entry->zone.reset(new Zone(allocator_, ZONE_NAME));
+  Zone* zone = entry->zone.get();
+  AstValueFactory ast_value_factory(zone, ast_string_constants_, hash_seed_);
+  PendingCompilationErrorHandler pending_error_handler;
+  UnicodeCache unicode_cache;
+  Scanner scanner(&unicode_cache);
+  PreParser preparser(zone, &scanner, stack_limit, &ast_value_factory,
+                      &pending_error_handler, nullptr, nullptr, -1, false,
+                      false);
+#define SET_ALLOW(name) preparser.set_allow_##name(allow_##name##_);
+  SET_ALLOW(natives);
+  SET_ALLOW(harmony_do_expressions);
+  SET_ALLOW(harmony_public_fields);
+  SET_ALLOW(harmony_static_fields);
+  SET_ALLOW(harmony_dynamic_import);
+  SET_ALLOW(harmony_import_meta);
+  SET_ALLOW(harmony_bigint);
+  SET_ALLOW(harmony_numeric_separator);
+  SET_ALLOW(harmony_private_fields);
+#undef SET_ALLOW
+
+  // Leave the scanner where Parser::SkipFunction finds it: with the '(' of
+  // the parameters as the current token.
+  stream->Seek(entry->start_position);
+  scanner.Initialize(stream, false);
+  if (scanner.Next() != Token::LPAREN) return false;
+
+  DeclarationScope* script_scope =
+      new (zone) DeclarationScope(zone, &ast_value_factory);
+  DeclarationScope* function_scope = new (zone)
+      DeclarationScope(zone, script_scope, FUNCTION_SCOPE, entry->kind);
+  function_scope->DeclareDefaultFunctionVariables(&ast_value_factory);
+  function_scope->SetLanguageMode(language_mode_);
+  function_scope->set_start_position(entry->start_position);
+#ifdef DEBUG
+  function_scope->set_needs_migration();
+#endif
+
+  const AstRawString* name =
+      entry->name_is_one_byte
+          ? ast_value_factory.GetOneByteString(
+                Vector<const uint8_t>(entry->name.data(),
+                                      static_cast<int>(entry->name.size())))
+          : ast_value_factory.GetTwoByteString(Vector<const uint16_t>(
+                reinterpret_cast<const uint16_t*>(entry->name.data()),
+                static_cast<int>(entry->name.size() / 2)));
+
+  Result* result = &entry->result;
+  std::fill_n(result->use_counts, arraysize(result->use_counts), 0);
+  result->produced_preparsed_scope_data = nullptr;
+  PreParser::PreParseResult preparse_result = preparser.PreParseFunction(
+      name, entry->kind, entry->function_type, function_scope, false, true,
+      result->use_counts, &result->produced_preparsed_scope_data, -1);
+
+  // Leave aborted functions, errors and warnings to the parser, which knows
+  // how to handle them. Eval calls change how the script scope is allocated,
+  // which only the parser can do.
+  if (preparse_result != PreParser::kPreParseSuccess ||
+      pending_error_handler.has_pending_error() ||
+      pending_error_handler.has_pending_warnings() ||
+      script_scope->inner_scope_calls_eval()) {
+    return false;
+  }
+
+  PreParserLogger* logger = preparser.logger();
+  function_scope->set_end_position(logger->end());
+  result->end_position = logger->end();
+  result->num_parameters = logger->num_parameters();
+  result->num_inner_functions = logger->num_inner_functions();
+  result->language_mode = function_scope->language_mode();
+  result->allow_eval_cache = preparser.allow_eval_cache();
+
+  // Save the scope allocation data of the inner functions, like the parser
+  // does after preparsing. Free variables of top-level functions can only
+  // refer to the script scope, whose variables are allocated regardless.
+  AstNodeFactory factory(&ast_value_factory, zone);
+  function_scope->AnalyzePartially(&factory);
+  return true;
+}
+
+ParallelPreParser::ParallelPreParser(ParseInfo* info, PreParser* preparser)
+    : state_(std::make_shared<State>(info, preparser)),
+      started_(false),
+      num_results_used_(0) {}
+
+ParallelPreParser::~ParallelPreParser() {
+  Finish();
+  state_->ReleaseResults();
+}
+
+// static
+bool ParallelPreParser::IsEnabled(ParseInfo* info) {
+  // Runtime call stats and function events are not thread-safe.
+  return FLAG_parallel_preparse && info->is_toplevel() &&
+         !info->is_module() && info->character_stream()->can_be_cloned() &&
+         info->runtime_call_stats() == nullptr && !FLAG_log_function_events;
+}
+
+const ParallelPreParser::Result* ParallelPreParser::Lookup(
+    int start_position, const AstRawString* name, FunctionKind kind,
+    FunctionLiteral::FunctionType function_type,
+    LanguageMode outer_language_mode) {
+  if (!started_) {
+    started_ = true;
+    state_->Start(outer_language_mode);
+  }
+  const Result* result = state_->Lookup(start_position, name, kind,
+                                        function_type, outer_language_mode);
+  if (result != nullptr) num_results_used_++;
+  return result;
+}
+
+void ParallelPreParser::Finish() { state_->Finish(); }
+
+}  // namespace internal
+}  // namespace v8
@@ -0,0 +1,89 @@
+// Copyright 2018 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef V8_PARSING_PARALLEL_PREPARSER_H_
+#define V8_PARSING_PARALLEL_PREPARSER_H_
+
+#include <memory>
+
+#include "include/v8.h"
+#include "src/ast/ast.h"
+#include "src/base/macros.h"
+#include "src/globals.h"
+
+namespace v8 {
+namespace internal {
+
+class AstRawString;
+class ParseInfo;
+class PreParser;
+class ProducedPreParsedScopeData;
+
+// Preparses the large top-level functions of a streamed script on worker
+// threads, ahead of the parser. A finder task scans a clone of the character
+// stream for function literals that are not nested in other functions, and
+// posts a preparse task for each one that is large enough to be worth it.
+// When the parser reaches such a function, it takes the result instead of
+// preparsing the function itself. The worker threads only read the data that
+// the parser has fetched from the embedder.
+//
+// The finder only looks at tokens, so it may guess wrong about what a
+// function is. Results are therefore only handed out if they match the
+// function the parser actually found at that position, and a wrong guess
+// only costs some time on a worker thread.
+class ParallelPreParser final {
+ public:
+  // What the parser needs to skip a function that was preparsed on a worker
+  // thread; the same data that Parser::SkipFunction gets from preparsing.
+  struct Result {
+    int end_position;
+    int num_parameters;
+    int num_inner_functions;
+    LanguageMode language_mode;
+    bool allow_eval_cache;
+    ProducedPreParsedScopeData* produced_preparsed_scope_data;
+    int use_counts[v8::Isolate::kUseCounterFeatureCount];
+  };
+
+  // The worker threads preparse with the same features as |preparser|.
+  ParallelPreParser(ParseInfo* info, PreParser* preparser);
+  ~ParallelPreParser();
+
+  // Whether the top-level functions of the script parsed with |info| can be
+  // preparsed on worker threads.
+  static bool IsEnabled(ParseInfo* info);
+
+  // Returns the result for the function literal that starts at
+  // |start_position|, or nullptr if the parser should preparse it itself.
+  // Waits if a worker thread is preparsing the function right now. The first
+  // call starts the search for functions, which happens once the parser has
+  // seen the directive prologue of the script.
+  const Result* Lookup(int start_position, const AstRawString* name,
+                       FunctionKind kind,
+                       FunctionLiteral::FunctionType function_type,
+                       LanguageMode outer_language_mode);
+
+  // Cancels all outstanding work and waits for the worker threads to leave
+  // the stream. Results handed out before stay valid until destruction.
+  void Finish();
+
+  // The number of results that Lookup() handed out.
+  int num_results_used() const { return num_results_used_; }
+
+ private:
+  class State;
+  class FinderTask;
+  class PreParseTask;
+
+  std::shared_ptr<State> state_;
+  bool started_;
+  int num_results_used_;
+
+  DISALLOW_COPY_AND_ASSIGN(ParallelPreParser);
+};
+
+}  // namespace internal
+}  // namespace v8
+
+#endif  // V8_PARSING_PARALLEL_PREPARSER_H_
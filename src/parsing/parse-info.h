@@ -83,6 +83,8 @@ class V8_EXPORT_PRIVATE ParseInfo {
   FLAG_ACCESSOR(kWrappedAsFunction, is_wrapped_as_function,
                 set_wrapped_as_function)
   FLAG_ACCESSOR(kAllowEvalCache, allow_eval_cache, set_allow_eval_cache)
+  FLAG_ACCESSOR(kCompiledInParallel, compiled_in_parallel,
+                set_compiled_in_parallel)
 #undef FLAG_ACCESSOR
 
   void set_parse_restriction(ParseRestriction restriction) {
@@ -127,6 +129,12 @@ class V8_EXPORT_PRIVATE ParseInfo {
   FunctionLiteral* literal() const { return literal_; }
   void set_literal(FunctionLiteral* literal) { literal_ = literal; }
 
+  // The number of functions whose preparse results came from worker threads.
+  int num_preparsed_in_parallel() const { return num_preparsed_in_parallel_; }
+  void set_num_preparsed_in_parallel(int num_preparsed_in_parallel) {
+    num_preparsed_in_parallel_ = num_preparsed_in_parallel;
+  }
+
   DeclarationScope* scope() const;
 
   UnicodeCache* unicode_cache() const { return unicode_cache_; }
@@ -253,6 +261,8 @@ class V8_EXPORT_PRIVATE ParseInfo {
     kOnBackgroundThread = 1 << 13,
     kWrappedAsFunction = 1 << 14,  // Implicitly wrapped as function.
     kAllowEvalCache = 1 << 15,
+    // ---------- Output flags --------------------------
+    kCompiledInParallel = 1 << 16,  // Inner functions compiled on workers.
   };
 
   //------------- Inputs to parsing and scope analysis -----------------------
@@ -290,6 +300,7 @@ class V8_EXPORT_PRIVATE ParseInfo {
   FunctionLiteral* literal_;
   std::shared_ptr<DeferredHandles> deferred_handles_;
   PendingCompilationErrorHandler pending_error_handler_;
+  int num_preparsed_in_parallel_;
 
   void SetFlag(Flag f) { flags_ |= f; }
   void SetFlag(Flag f, bool v) { flags_ = v ? flags_ | f : flags_ & ~f; }
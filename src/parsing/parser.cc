@@ -2744,6 +2744,36 @@ Parser::LazyParsingResult Parser::SkipFunction(
     return kLazyParsingComplete;
   }
 
+  // Large top-level functions of streamed scripts may have been preparsed on
+  // a worker thread already.
+  if (parallel_preparser_ && !is_inner_function &&
+      function_scope->outer_scope()->is_script_scope() &&
+      !IsArrowFunction(kind)) {
+    const ParallelPreParser::Result* result = parallel_preparser_->Lookup(
+        function_scope->start_position(), function_name, kind, function_type,
+        function_scope->language_mode());
+    if (result != nullptr) {
+      *produced_preparsed_scope_data = result->produced_preparsed_scope_data;
+      function_scope->set_end_position(result->end_position);
+      scanner()->SeekForward(result->end_position - 1);
+      Expect(Token::RBRACE, CHECK_OK_VALUE(kLazyParsingComplete));
+      SetLanguageMode(function_scope, result->language_mode);
+      if (!result->allow_eval_cache) {
+        reusable_preparser()->set_allow_eval_cache(false);
+        set_allow_eval_cache(false);
+      }
+      for (int feature = 0; feature < v8::Isolate::kUseCounterFeatureCount;
+           ++feature) {
+        use_counts_[feature] += result->use_counts[feature];
+      }
+      total_preparse_skipped_ +=
+          function_scope->end_position() - function_scope->start_position();
+      *num_parameters = result->num_parameters;
+      SkipFunctionLiterals(result->num_inner_functions);
+      return kLazyParsingComplete;
+    }
+  }
+
   // With no cached data, we partially parse the function, without building an
   // AST. This gathers the data needed to build a lazy function.
   TRACE_EVENT0(TRACE_DISABLED_BY_DEFAULT("v8.compile"), "V8.PreParse");
@@ -3448,7 +3478,18 @@ void Parser::ParseOnBackground(ParseInfo* info) {
   // scopes) and set their end position after we know the script length.
   if (info->is_toplevel()) {
     fni_ = new (zone()) FuncNameInferrer(ast_value_factory(), zone());
+    if (ParallelPreParser::IsEnabled(info)) {
+      parallel_preparser_.reset(
+          new ParallelPreParser(info, reusable_preparser()));
+    }
     result = DoParseProgram(info);
+    // The worker threads must be done with the character stream before it is
+    // reset. Their results stay alive as long as the parser.
+    if (parallel_preparser_) {
+      parallel_preparser_->Finish();
+      info->set_num_preparsed_in_parallel(
+          parallel_preparser_->num_results_used());
+    }
   } else {
     result = DoParseFunction(info, info->function_name());
   }
@@ -6,12 +6,14 @@
 #define V8_PARSING_PARSER_H_
 
 #include <cstddef>
+#include <memory>
 
 #include "src/ast/ast-source-ranges.h"
 #include "src/ast/ast.h"
 #include "src/ast/scopes.h"
 #include "src/base/compiler-specific.h"
 #include "src/globals.h"
+#include "src/parsing/parallel-preparser.h"
 #include "src/parsing/parser-base.h"
 #include "src/parsing/parsing.h"
 #include "src/parsing/preparse-data.h"
@@ -1105,6 +1107,7 @@ class V8_EXPORT_PRIVATE Parser : public NON_EXPORTED_BASE(ParserBase<Parser>) {
   bool allow_lazy_;
   bool temp_zoned_;
   ConsumedPreParsedScopeData* consumed_preparsed_scope_data_;
+  std::unique_ptr<ParallelPreParser> parallel_preparser_;
 
   // If not kNoSourcePosition, indicates that the first function literal
   // encountered is a dynamic function, see CreateDynamicFunction(). This field
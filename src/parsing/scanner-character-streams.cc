@@ -4,7 +4,11 @@
 
 #include "src/parsing/scanner-character-streams.h"
 
+#include <memory>
+
 #include "include/v8.h"
+#include "src/base/platform/condition-variable.h"
+#include "src/base/platform/mutex.h"
 #include "src/counters.h"
 #include "src/globals.h"
 #include "src/handles.h"
@@ -17,6 +21,14 @@ namespace internal {
 
 namespace {
 const unibrow::uchar kUtf8Bom = 0xFEFF;
+
+// Returns the length of a prefix of {data} that consists of ASCII characters
+// only. The result may be shorter than the longest such prefix.
+size_t AsciiPrefixLength(const uint8_t* data, size_t length) {
+  int max_length = static_cast<int>(std::min(length, size_t{kMaxInt}));
+  return static_cast<size_t>(
+      String::NonAsciiStart(reinterpret_cast<const char*>(data), max_length));
+}
 }  // namespace
 
 // ----------------------------------------------------------------------------
@@ -203,15 +215,17 @@ class Utf8ExternalStreamingStream : public BufferedUtf16CharacterStream {
   Utf8ExternalStreamingStream(
       ScriptCompiler::ExternalSourceStream* source_stream,
       RuntimeCallStats* stats)
-      : current_({0, {0, 0, 0, unibrow::Utf8::State::kAccept}}),
-        source_stream_(source_stream),
-        stats_(stats) {}
-  ~Utf8ExternalStreamingStream() override {
-    for (size_t i = 0; i < chunks_.size(); i++) delete[] chunks_[i].data;
-  }
+      : Utf8ExternalStreamingStream(
+            std::make_shared<SourceData>(source_stream), stats, false,
+            false) {}
 
   bool can_access_heap() override { return false; }
 
+  bool can_be_cloned() const override { return true; }
+  std::unique_ptr<Utf16CharacterStream> Clone(
+      bool waits_for_data) const override;
+  void StopClones() override;
+
  protected:
   size_t FillBuffer(size_t position) override;
 
@@ -244,22 +258,75 @@ class Utf8ExternalStreamingStream : public BufferedUtf16CharacterStream {
     StreamPosition start;
   };
 
+  // The chunks fetched so far and the source they are fetched from, shared
+  // by a stream and its clones. Only the original stream fetches chunks. Once
+  // it has been cloned, every access to the chunks must hold the mutex, which
+  // the original stream releases while it waits for the embedder.
+  struct SourceData {
+    explicit SourceData(ScriptCompiler::ExternalSourceStream* source_stream)
+        : source_stream(source_stream), cloned(false), stopped(false) {}
+    ~SourceData() {
+      for (size_t i = 0; i < chunks.size(); i++) delete[] chunks[i].data;
+    }
+
+    std::vector<Chunk> chunks;
+    ScriptCompiler::ExternalSourceStream* source_stream;
+    base::Mutex mutex;
+    base::ConditionVariable fetched;
+    // Only written by the original stream, which may read it without the
+    // mutex.
+    bool cloned;
+    // Whether the clones stopped waiting for the original stream.
+    bool stopped;
+  };
+
+  Utf8ExternalStreamingStream(std::shared_ptr<SourceData> data,
+                              RuntimeCallStats* stats, bool is_clone,
+                              bool waits_for_data)
+      : current_({0, {0, 0, 0, unibrow::Utf8::State::kAccept}}),
+        data_(data),
+        chunks_(data->chunks),
+        stats_(stats),
+        is_clone_(is_clone),
+        waits_for_data_(waits_for_data) {}
+
   // Within the current chunk, skip forward from current_ towards position.
   bool SkipToPosition(size_t position);
   // Within the current chunk, fill the buffer_ (while it has capacity).
   void FillBufferFromCurrentChunk();
   // Fetch a new chunk (assuming current_ is at the end of the current data).
+  // Clones wait for the original stream to fetch it instead, and return false
+  // without a new chunk if they stop waiting.
   bool FetchChunk();
   // Search through the chunks and set current_ to point to the given position.
   // (This call is potentially expensive.)
   void SearchPosition(size_t position);
 
-  std::vector<Chunk> chunks_;
   Position current_;
-  ScriptCompiler::ExternalSourceStream* source_stream_;
+  std::shared_ptr<SourceData> data_;
+  std::vector<Chunk>& chunks_;
   RuntimeCallStats* stats_;
+  const bool is_clone_;
+  const bool waits_for_data_;
 };
 
+std::unique_ptr<Utf16CharacterStream> Utf8ExternalStreamingStream::Clone(
+    bool waits_for_data) const {
+  if (!is_clone_ && !data_->cloned) {
+    base::LockGuard<base::Mutex> guard(&data_->mutex);
+    data_->cloned = true;
+  }
+  return std::unique_ptr<Utf16CharacterStream>(
+      new Utf8ExternalStreamingStream(data_, nullptr, true, waits_for_data));
+}
+
+void Utf8ExternalStreamingStream::StopClones() {
+  DCHECK(!is_clone_);
+  base::LockGuard<base::Mutex> guard(&data_->mutex);
+  data_->stopped = true;
+  data_->fetched.NotifyAll();
+}
+
 bool Utf8ExternalStreamingStream::SkipToPosition(size_t position) {
   DCHECK_LE(current_.pos.chars, position);  // We can only skip forward.
 
@@ -274,6 +341,14 @@ bool Utf8ExternalStreamingStream::SkipToPosition(size_t position) {
   size_t it = current_.pos.bytes - chunk.start.bytes;
   size_t chars = chunk.start.chars;
   while (it < chunk.length && chars < position) {
+    if (state == unibrow::Utf8::State::kAccept) {
+      // Skip runs of ASCII characters without decoding them.
+      size_t ascii_length = AsciiPrefixLength(
+          chunk.data + it, std::min(chunk.length - it, position - chars));
+      it += ascii_length;
+      chars += ascii_length;
+      if (it == chunk.length || chars == position) break;
+    }
     unibrow::uchar t = unibrow::Utf8::ValueOfIncremental(
         chunk.data[it], &it, &state, &incomplete_char);
     if (t == kUtf8Bom && current_.pos.chars == 0) {
@@ -325,6 +400,20 @@ void Utf8ExternalStreamingStream::FillBufferFromCurrentChunk() {
 
   size_t it = current_.pos.bytes - chunk.start.bytes;
   while (it < chunk.length && cursor + 1 < buffer_start_ + kBufferSize) {
+    if (state == unibrow::Utf8::State::kAccept) {
+      // Copy runs of ASCII characters without decoding them. Leave room for
+      // a surrogate pair, like the loop condition.
+      size_t capacity =
+          static_cast<size_t>(buffer_start_ + kBufferSize - 1 - cursor);
+      size_t ascii_length = AsciiPrefixLength(
+          chunk.data + it, std::min(chunk.length - it, capacity));
+      i::CopyCharsUnsigned(cursor, chunk.data + it, ascii_length);
+      cursor += ascii_length;
+      it += ascii_length;
+      if (it == chunk.length || cursor + 1 >= buffer_start_ + kBufferSize) {
+        break;
+      }
+    }
     unibrow::uchar t = unibrow::Utf8::ValueOfIncremental(
         chunk.data[it], &it, &state, &incomplete_char);
     if (V8_LIKELY(t < kUtf8Bom)) {
@@ -351,14 +440,33 @@ void Utf8ExternalStreamingStream::FillBufferFromCurrentChunk() {
 }
 
 bool Utf8ExternalStreamingStream::FetchChunk() {
-  RuntimeCallTimerScope scope(stats_,
-                              RuntimeCallCounterId::kGetMoreDataCallback);
   DCHECK_EQ(current_.chunk_no, chunks_.size());
   DCHECK(chunks_.empty() || chunks_.back().length != 0);
 
+  if (is_clone_) {
+    while (waits_for_data_ && !data_->stopped &&
+           current_.chunk_no == chunks_.size()) {
+      data_->fetched.Wait(&data_->mutex);
+    }
+    return current_.chunk_no < chunks_.size() &&
+           chunks_[current_.chunk_no].length != 0;
+  }
+
+  RuntimeCallTimerScope scope(stats_,
+                              RuntimeCallCounterId::kGetMoreDataCallback);
   const uint8_t* chunk = nullptr;
-  size_t length = source_stream_->GetMoreData(&chunk);
-  chunks_.push_back({chunk, length, current_.pos});
+  size_t length;
+  if (data_->cloned) {
+    // Let the clones read the existing chunks in the meantime.
+    data_->mutex.Unlock();
+    length = data_->source_stream->GetMoreData(&chunk);
+    data_->mutex.Lock();
+    chunks_.push_back({chunk, length, current_.pos});
+    data_->fetched.NotifyAll();
+  } else {
+    length = data_->source_stream->GetMoreData(&chunk);
+    chunks_.push_back({chunk, length, current_.pos});
+  }
   return length > 0;
 }
 
@@ -375,6 +483,8 @@ void Utf8ExternalStreamingStream::SearchPosition(size_t position) {
     DCHECK_EQ(current_.pos.bytes, 0u);
     DCHECK_EQ(current_.pos.chars, 0u);
     FetchChunk();
+    // A clone may stop waiting before the first chunk arrives.
+    if (chunks_.empty()) return;
   }
 
   // Search for the last chunk whose start position is less or equal to
@@ -428,20 +538,23 @@ void Utf8ExternalStreamingStream::SearchPosition(size_t position) {
   bool have_more_data = true;
   bool found = SkipToPosition(position);
   while (have_more_data && !found) {
-    DCHECK_EQ(current_.chunk_no, chunks_.size());
     have_more_data = FetchChunk();
     found = have_more_data && SkipToPosition(position);
   }
 
   // We'll return with a postion != the desired position only if we're out
-  // of data. In that case, we'll point to the terminating chunk.
+  // of data. In that case, we'll point to the terminating chunk, or behind the
+  // last chunk if a clone stopped waiting for data.
   DCHECK_EQ(found, current_.pos.chars == position);
-  DCHECK_EQ(have_more_data, chunks_.back().length != 0);
+  DCHECK_IMPLIES(!have_more_data, is_clone_ || chunks_.back().length == 0);
   DCHECK_IMPLIES(!found, !have_more_data);
-  DCHECK_IMPLIES(!found, current_.chunk_no == chunks_.size() - 1);
+  DCHECK_IMPLIES(!found && !is_clone_,
+                 current_.chunk_no == chunks_.size() - 1);
 }
 
 size_t Utf8ExternalStreamingStream::FillBuffer(size_t position) {
+  base::LockGuard<base::Mutex, base::NullBehavior::kIgnoreIfNull> guard(
+      is_clone_ || data_->cloned ? &data_->mutex : nullptr);
   buffer_cursor_ = buffer_;
   buffer_end_ = buffer_;
 
@@ -452,6 +565,12 @@ size_t Utf8ExternalStreamingStream::FillBuffer(size_t position) {
 
   if (out_of_data) return 0;
 
+  // A clone that stopped waiting for data may not have reached position.
+  if (current_.chunk_no == chunks_.size() && current_.pos.chars != position) {
+    DCHECK(is_clone_);
+    return 0;
+  }
+
   // Fill the buffer, until we have at least one char (or are out of data).
   // (The embedder might give us 1-byte blocks within a utf-8 char, so we
   //  can't guarantee progress with one chunk. Thus we iterate.)
@@ -459,6 +578,8 @@ size_t Utf8ExternalStreamingStream::FillBuffer(size_t position) {
     // At end of current data, but there might be more? Then fetch it.
     if (current_.chunk_no == chunks_.size()) {
       out_of_data = !FetchChunk();
+      // A clone that stopped waiting for data has no chunk to read from.
+      if (current_.chunk_no == chunks_.size()) break;
     }
     FillBufferFromCurrentChunk();
   }
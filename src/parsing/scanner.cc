@@ -72,13 +72,30 @@ int Scanner::LiteralBuffer::NewCapacity(int min_capacity) {
   return new_capacity;
 }
 
-void Scanner::LiteralBuffer::ExpandBuffer() {
-  Vector<byte> new_store = Vector<byte>::New(NewCapacity(kInitialCapacity));
+void Scanner::LiteralBuffer::ExpandBuffer(int min_capacity) {
+  Vector<byte> new_store = Vector<byte>::New(NewCapacity(min_capacity));
   MemCopy(new_store.start(), backing_store_.start(), position_);
   backing_store_.Dispose();
   backing_store_ = new_store;
 }
 
+void Scanner::LiteralBuffer::AddOneByteChars(const uint16_t* chars,
+                                             int length) {
+  if (!is_one_byte_) {
+    for (int i = 0; i < length; i++) AddCharSlow(chars[i]);
+    return;
+  }
+  if (position_ + length > backing_store_.length()) {
+    ExpandBuffer(position_ + length);
+  }
+  uint8_t* dst = backing_store_.start() + position_;
+  for (int i = 0; i < length; i++) {
+    DCHECK_LE(chars[i], unibrow::Latin1::kMaxChar);
+    dst[i] = static_cast<uint8_t>(chars[i]);
+  }
+  position_ += length;
+}
+
 void Scanner::LiteralBuffer::ConvertToTwoByte() {
   DCHECK(is_one_byte_);
   Vector<byte> new_store;
@@ -441,6 +458,13 @@ Token::Value Scanner::SkipWhiteSpace() {
       // Don't skip behind the end of input.
       if (c0_ == kEndOfInput) break;
 
+      // Skip runs of spaces and tabs, e.g. indentation, in one go.
+      if (c0_ == ' ' || c0_ == '\t') {
+        AdvanceUntil([](uc32 c0) { return c0 != ' ' && c0 != '\t'; });
+        HandleLeadSurrogate();
+        continue;
+      }
+
       // Advance as long as character is a WhiteSpace or LineTerminator.
       // Remember if the latter is the case.
       if (unibrow::IsLineTerminator(c0_)) {
@@ -493,16 +517,12 @@ Token::Value Scanner::SkipSingleHTMLComment() {
 }
 
 Token::Value Scanner::SkipSingleLineComment() {
-  Advance();
-
   // The line terminator at the end of the line is not considered
   // to be part of the single-line comment; it is recognized
   // separately by the lexical grammar and becomes part of the
   // stream of input elements for the syntactic grammar (see
   // ECMA-262, section 7.4).
-  while (c0_ != kEndOfInput && !unibrow::IsLineTerminator(c0_)) {
-    Advance();
-  }
+  AdvanceUntil([](uc32 c0) { return unibrow::IsLineTerminator(c0); });
 
   return Token::WHITESPACE;
 }
@@ -510,8 +530,8 @@ Token::Value Scanner::SkipSingleLineComment() {
 
 Token::Value Scanner::SkipSourceURLComment() {
   TryToParseSourceURLComment();
-  while (c0_ != kEndOfInput && !unibrow::IsLineTerminator(c0_)) {
-    Advance();
+  if (c0_ != kEndOfInput && !unibrow::IsLineTerminator(c0_)) {
+    AdvanceUntil([](uc32 c0) { return unibrow::IsLineTerminator(c0); });
   }
 
   return Token::WHITESPACE;
@@ -574,6 +594,14 @@ Token::Value Scanner::SkipMultiLineComment() {
   Advance();
 
   while (c0_ != kEndOfInput) {
+    // Skip the characters that can neither end the comment nor make it
+    // count as a line terminator.
+    if (c0_ != '*' && !unibrow::IsLineTerminator(c0_)) {
+      AdvanceUntil([](uc32 c0) {
+        return c0 == '*' || unibrow::IsLineTerminator(c0);
+      });
+      continue;
+    }
     uc32 ch = c0_;
     Advance();
     if (c0_ != kEndOfInput && unibrow::IsLineTerminator(ch)) {
@@ -1053,25 +1081,21 @@ uc32 Scanner::ScanOctalEscape(uc32 c, int length, bool in_template_literal) {
 
 Token::Value Scanner::ScanString() {
   uc32 quote = c0_;
-  Advance<false, false>();  // consume quote
 
   LiteralScope literal(this);
-  while (true) {
-    if (c0_ > kMaxAscii) {
-      HandleLeadSurrogate();
-      break;
-    }
-    if (c0_ == kEndOfInput || c0_ == '\n' || c0_ == '\r') return Token::ILLEGAL;
-    if (c0_ == quote) {
-      literal.Complete();
-      Advance<false, false>();
-      return Token::STRING;
-    }
-    char c = static_cast<char>(c0_);
-    if (c == '\\') break;
+  // Consume the quote and the ASCII characters that need no special
+  // handling directly from the stream's buffer.
+  AddLiteralCharsUntil([this, quote](uc32 c0) {
+    return c0 > kMaxAscii || c0 == quote || c0 == '\\' || c0 == '\n' ||
+           c0 == '\r';
+  });
+  if (c0_ == quote) {
+    literal.Complete();
     Advance<false, false>();
-    AddLiteralChar(c);
+    return Token::STRING;
   }
+  if (c0_ == kEndOfInput || c0_ == '\n' || c0_ == '\r') return Token::ILLEGAL;
+  HandleLeadSurrogate();
 
   while (c0_ != quote && c0_ != kEndOfInput &&
          !unibrow::IsStringLiteralLineTerminator(c0_)) {
@@ -1689,23 +1713,15 @@ Token::Value Scanner::ScanIdentifierOrKeyword() {
 Token::Value Scanner::ScanIdentifierOrKeywordInner(LiteralScope* literal) {
   DCHECK(unicode_cache_->IsIdentifierStart(c0_));
   if (IsInRange(c0_, 'a', 'z') || c0_ == '_') {
-    do {
-      char first_char = static_cast<char>(c0_);
-      Advance<false, false>();
-      AddLiteralChar(first_char);
-    } while (IsInRange(c0_, 'a', 'z') || c0_ == '_');
+    AddLiteralChar(static_cast<char>(c0_));
+    AddLiteralCharsUntil(
+        [](uc32 c0) { return !IsInRange(c0, 'a', 'z') && c0 != '_'; });
 
     if (IsDecimalDigit(c0_) || IsInRange(c0_, 'A', 'Z') || c0_ == '_' ||
         c0_ == '$') {
       // Identifier starting with lowercase.
-      char first_char = static_cast<char>(c0_);
-      Advance<false, false>();
-      AddLiteralChar(first_char);
-      while (IsAsciiIdentifier(c0_)) {
-        char first_char = static_cast<char>(c0_);
-        Advance<false, false>();
-        AddLiteralChar(first_char);
-      }
+      AddLiteralChar(static_cast<char>(c0_));
+      AddLiteralCharsUntil([](uc32 c0) { return !IsAsciiIdentifier(c0); });
       if (c0_ <= kMaxAscii && c0_ != '\\') {
         literal->Complete();
         return Token::IDENTIFIER;
@@ -1724,11 +1740,8 @@ Token::Value Scanner::ScanIdentifierOrKeywordInner(LiteralScope* literal) {
 
     HandleLeadSurrogate();
   } else if (IsInRange(c0_, 'A', 'Z') || c0_ == '_' || c0_ == '$') {
-    do {
-      char first_char = static_cast<char>(c0_);
-      Advance<false, false>();
-      AddLiteralChar(first_char);
-    } while (IsAsciiIdentifier(c0_));
+    AddLiteralChar(static_cast<char>(c0_));
+    AddLiteralCharsUntil([](uc32 c0) { return !IsAsciiIdentifier(c0); });
 
     if (c0_ <= kMaxAscii && c0_ != '\\') {
       literal->Complete();
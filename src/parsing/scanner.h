@@ -7,6 +7,9 @@
 #ifndef V8_PARSING_SCANNER_H_
 #define V8_PARSING_SCANNER_H_
 
+#include <algorithm>
+#include <memory>
+
 #include "src/allocation.h"
 #include "src/base/logging.h"
 #include "src/char-predicates.h"
@@ -55,6 +58,39 @@ class Utf16CharacterStream {
     }
   }
 
+  // Advances past the next UTF-16 code unit that satisfies {check} and
+  // returns it, or returns kEndOfInput (like Advance()) if there is none.
+  // The code units in between are skipped by scanning the buffer directly,
+  // without going through Advance() for each of them. {check} is called with
+  // single code units, so it does not see combined surrogate pairs.
+  template <typename FunctionType>
+  V8_INLINE uc32 AdvanceUntil(FunctionType check) {
+    return AdvanceUntil(check, [](const uint16_t*, const uint16_t*) {});
+  }
+
+  // Like AdvanceUntil(check), but also passes the skipped code units to
+  // {skipped} as runs of [start, end) within the buffer.
+  template <typename FunctionType, typename SkippedFunctionType>
+  V8_INLINE uc32 AdvanceUntil(FunctionType check, SkippedFunctionType skipped) {
+    while (true) {
+      const uint16_t* next_cursor =
+          std::find_if(buffer_cursor_, buffer_end_, [&check](uint16_t c) {
+            return check(static_cast<uc32>(c));
+          });
+      skipped(buffer_cursor_, next_cursor);
+      if (next_cursor < buffer_end_) {
+        buffer_cursor_ = next_cursor + 1;
+        return static_cast<uc32>(*next_cursor);
+      }
+      buffer_cursor_ = buffer_end_;
+      if (!ReadBlockChecked()) {
+        // See Advance() for why the cursor is moved past the end.
+        buffer_cursor_++;
+        return kEndOfInput;
+      }
+    }
+  }
+
   // Go back one by one character in the input stream.
   // This undoes the most recent Advance().
   inline void Back() {
@@ -95,6 +131,23 @@ class Utf16CharacterStream {
   // Returns true if the stream could access the V8 heap after construction.
   virtual bool can_access_heap() = 0;
 
+  // Returns true if Clone() is supported by this stream.
+  virtual bool can_be_cloned() const { return false; }
+
+  // Returns a new stream over the same source, positioned at its start. The
+  // clone may be used concurrently with this stream, on another thread, but
+  // only reads the data that this stream has fetched. At the end of that
+  // data, a clone that |waits_for_data| blocks until this stream fetches more
+  // or StopClones() is called. Other clones treat it as the end of the input.
+  virtual std::unique_ptr<Utf16CharacterStream> Clone(
+      bool waits_for_data) const {
+    UNREACHABLE();
+  }
+
+  // Makes the clones stop waiting for data, and treat the end of the data
+  // fetched so far as the end of the input.
+  virtual void StopClones() { UNREACHABLE(); }
+
  protected:
   Utf16CharacterStream(const uint16_t* buffer_start,
                        const uint16_t* buffer_cursor,
@@ -417,6 +470,10 @@ class Scanner {
       }
     }
 
+    // Adds {length} code units that are all at most
+    // unibrow::Latin1::kMaxChar.
+    void AddOneByteChars(const uint16_t* chars, int length);
+
     bool is_one_byte() const { return is_one_byte_; }
 
     bool Equals(Vector<const char> keyword) const {
@@ -474,7 +531,7 @@ class Scanner {
 
     void AddCharSlow(uc32 code_unit);
     int NewCapacity(int min_capacity);
-    void ExpandBuffer();
+    void ExpandBuffer(int min_capacity = kInitialCapacity);
     void ConvertToTwoByte();
 
     bool is_one_byte_;
@@ -617,6 +674,26 @@ class Scanner {
     if (check_surrogate) HandleLeadSurrogate();
   }
 
+  // Advances to the next character that satisfies {check}, see
+  // Utf16CharacterStream::AdvanceUntil. Like Advance<false, false>(), this
+  // does not combine surrogate pairs.
+  template <typename FunctionType>
+  V8_INLINE void AdvanceUntil(FunctionType check) {
+    c0_ = source_->AdvanceUntil(check);
+  }
+
+  // Like AdvanceUntil(), but also adds the skipped characters to the current
+  // literal. {check} must be true for all characters above kMaxAscii.
+  template <typename FunctionType>
+  V8_INLINE void AddLiteralCharsUntil(FunctionType check) {
+    DCHECK_NOT_NULL(next_.literal_chars);
+    LiteralBuffer* literal = next_.literal_chars;
+    c0_ = source_->AdvanceUntil(
+        check, [literal](const uint16_t* start, const uint16_t* end) {
+          literal->AddOneByteChars(start, static_cast<int>(end - start));
+        });
+  }
+
   void HandleLeadSurrogate() {
     if (unibrow::Utf16::IsLeadSurrogate(c0_)) {
       uc32 c1 = source_->Advance();
@@ -25,6 +25,11 @@ void CodeMoveEventRecord::UpdateCodeMap(CodeMap* code_map) {
 }
 
 
+void CodeDeleteEventRecord::UpdateCodeMap(CodeMap* code_map) {
+  code_map->DeleteCode(start);
+}
+
+
 void CodeDisableOptEventRecord::UpdateCodeMap(CodeMap* code_map) {
   CodeEntry* entry = code_map->FindEntry(start);
   if (entry != nullptr) {
@@ -233,6 +233,7 @@ void CpuProfiler::CodeEventHandler(const CodeEventsContainer& evt_rec) {
   switch (evt_rec.generic.type) {
     case CodeEventRecord::CODE_CREATION:
     case CodeEventRecord::CODE_MOVE:
+    case CodeEventRecord::CODE_DELETE:
     case CodeEventRecord::CODE_DISABLE_OPT:
       processor_->Enqueue(evt_rec);
       break;
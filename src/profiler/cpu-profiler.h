@@ -31,6 +31,7 @@ class ProfileGenerator;
 #define CODE_EVENTS_TYPE_LIST(V)                         \
   V(CODE_CREATION, CodeCreateEventRecord)                \
   V(CODE_MOVE, CodeMoveEventRecord)                      \
+  V(CODE_DELETE, CodeDeleteEventRecord)                  \
   V(CODE_DISABLE_OPT, CodeDisableOptEventRecord)         \
   V(CODE_DEOPT, CodeDeoptEventRecord)                    \
   V(REPORT_BUILTIN, ReportBuiltinEventRecord)
@@ -70,6 +71,14 @@ class CodeMoveEventRecord : public CodeEventRecord {
 };
 
 
+class CodeDeleteEventRecord : public CodeEventRecord {
+ public:
+  Address start;
+
+  INLINE(void UpdateCodeMap(CodeMap* code_map));
+};
+
+
 class CodeDisableOptEventRecord : public CodeEventRecord {
  public:
   Address start;
@@ -562,6 +562,15 @@ void CodeMap::MoveCode(Address from, Address to) {
   code_map_.emplace(to, info);
 }
 
+void CodeMap::DeleteCode(Address addr) {
+  auto it = code_map_.find(addr);
+  if (it == code_map_.end()) return;
+  if (!entry(it->second.index)->used()) {
+    DeleteCodeEntry(it->second.index);
+  }
+  code_map_.erase(it);
+}
+
 unsigned CodeMap::AddCodeEntry(Address start, CodeEntry* entry) {
   if (free_list_head_ == kNoFreeSlot) {
     code_entries_.push_back(CodeEntrySlotInfo{entry});
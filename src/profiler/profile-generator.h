@@ -365,6 +365,7 @@ class CodeMap {
 
   void AddCode(Address addr, CodeEntry* entry, unsigned size);
   void MoveCode(Address from, Address to);
+  void DeleteCode(Address addr);
   CodeEntry* FindEntry(Address addr);
   void Print();
 
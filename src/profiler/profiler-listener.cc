@@ -133,6 +133,13 @@ void ProfilerListener::CodeMoveEvent(AbstractCode* from, Address to) {
   DispatchCodeEvent(evt_rec);
 }
 
+void ProfilerListener::CodeDeleteEvent(Address start) {
+  CodeEventsContainer evt_rec(CodeEventRecord::CODE_DELETE);
+  CodeDeleteEventRecord* rec = &evt_rec.CodeDeleteEventRecord_;
+  rec->start = start;
+  DispatchCodeEvent(evt_rec);
+}
+
 void ProfilerListener::CodeDisableOptEvent(AbstractCode* code,
                                            SharedFunctionInfo* shared) {
   CodeEventsContainer evt_rec(CodeEventRecord::CODE_DISABLE_OPT);
@@ -45,6 +45,7 @@ class ProfilerListener : public CodeEventListener {
 
   void CodeMovingGCEvent() override {}
   void CodeMoveEvent(AbstractCode* from, Address to) override;
+  void CodeDeleteEvent(Address start) override;
   void CodeDisableOptEvent(AbstractCode* code,
                            SharedFunctionInfo* shared) override;
   void CodeDeoptEvent(Code* code, DeoptKind kind, Address pc,
@@ -22,6 +22,14 @@ namespace internal {
 // optimized.
 static const int kProfilerTicksBeforeOptimization = 2;
 
+// Number of times a function that the HotFunctionProfile knows to be hot has
+// to be seen on the stack before it is optimized. This gives it a chance to
+// collect some type feedback first.
+static const int kProfilerTicksBeforeProfileGuidedOptimization = 1;
+
+// Maximum number of script source hashes cached for the HotFunctionProfile.
+static const size_t kMaxCachedSourceHashes = 256;
+
 // The number of ticks required for optimizing a function increases with
 // the size of the bytecode. This is in addition to the
 // kProfilerTicksBeforeOptimization required for any function.
@@ -42,6 +50,7 @@ static const int kMaxBytecodeSizeForOpt = 60 * KB;
 #define OPTIMIZATION_REASON_LIST(V)                            \
   V(DoNotOptimize, "do not optimize")                          \
   V(HotAndStable, "hot and stable")                            \
+  V(HotInProfile, "hot in profile")                            \
   V(SmallFunction, "small function")
 
 enum class OptimizationReason : uint8_t {
@@ -110,6 +119,42 @@ void RuntimeProfiler::Optimize(JSFunction* function,
   DCHECK_NE(reason, OptimizationReason::kDoNotOptimize);
   TraceRecompile(function, OptimizationReasonToString(reason), "optimized");
   function->MarkForOptimization(ConcurrencyMode::kConcurrent);
+
+  HotFunctionProfile* profile = HotFunctionProfile::Get();
+  HotFunctionProfile::FunctionKey key;
+  if (profile != nullptr && GetHotFunctionKey(function->shared(), &key)) {
+    profile->RecordHot(key);
+  }
+}
+
+bool RuntimeProfiler::GetHotFunctionKey(SharedFunctionInfo* shared,
+                                        HotFunctionProfile::FunctionKey* key) {
+  if (!shared->script()->IsScript()) return false;
+  Script* script = Script::cast(shared->script());
+  if (!script->source()->IsString()) return false;
+  uint32_t source_hash;
+  auto it = source_hashes_.find(script->id());
+  if (it != source_hashes_.end()) {
+    source_hash = it->second;
+  } else {
+    source_hash =
+        HotFunctionProfile::HashSource(String::cast(script->source()));
+    if (source_hashes_.size() >= kMaxCachedSourceHashes) {
+      source_hashes_.clear();
+    }
+    source_hashes_.insert(std::make_pair(script->id(), source_hash));
+  }
+  key->source_hash = source_hash;
+  key->start_position = shared->StartPosition();
+  key->end_position = shared->EndPosition();
+  return true;
+}
+
+bool RuntimeProfiler::IsHotInProfile(SharedFunctionInfo* shared) {
+  HotFunctionProfile* profile = HotFunctionProfile::Get();
+  HotFunctionProfile::FunctionKey key;
+  return profile != nullptr && GetHotFunctionKey(shared, &key) &&
+         profile->IsHot(key);
 }
 
 void RuntimeProfiler::AttemptOnStackReplacement(JavaScriptFrame* frame,
@@ -201,6 +246,11 @@ OptimizationReason RuntimeProfiler::ShouldOptimize(JSFunction* function,
     return OptimizationReason::kDoNotOptimize;
   }
 
+  if (ticks >= kProfilerTicksBeforeProfileGuidedOptimization &&
+      IsHotInProfile(shared)) {
+    return OptimizationReason::kHotInProfile;
+  }
+
   int ticks_for_optimization =
       kProfilerTicksBeforeOptimization +
       (shared->GetBytecodeArray()->length() / kBytecodeSizeAllowancePerTick);
@@ -5,7 +5,10 @@
 #ifndef V8_RUNTIME_PROFILER_H_
 #define V8_RUNTIME_PROFILER_H_
 
+#include <unordered_map>
+
 #include "src/allocation.h"
+#include "src/hot-function-profile.h"
 
 namespace v8 {
 namespace internal {
@@ -13,6 +16,7 @@ namespace internal {
 class Isolate;
 class JavaScriptFrame;
 class JSFunction;
+class SharedFunctionInfo;
 enum class OptimizationReason : uint8_t;
 
 class RuntimeProfiler {
@@ -36,8 +40,17 @@ class RuntimeProfiler {
   void Optimize(JSFunction* function, OptimizationReason reason);
   void Baseline(JSFunction* function, OptimizationReason reason);
 
+  // Computes the key identifying {shared} in the HotFunctionProfile. Returns
+  // false if {shared} has no script source.
+  bool GetHotFunctionKey(SharedFunctionInfo* shared,
+                         HotFunctionProfile::FunctionKey* key);
+  bool IsHotInProfile(SharedFunctionInfo* shared);
+
   Isolate* isolate_;
   bool any_ic_changed_;
+  // Caches HotFunctionProfile::HashSource() by script id. Bounded by
+  // kMaxCachedSourceHashes.
+  std::unordered_map<int, uint32_t> source_hashes_;
 };
 
 }  // namespace internal
@@ -14,6 +14,7 @@
 #include "src/conversions.h"
 #include "src/debug/debug.h"
 #include "src/frames-inl.h"
+#include "src/interpreter/interpreter.h"
 #include "src/isolate-inl.h"
 #include "src/messages.h"
 #include "src/parsing/parse-info.h"
@@ -267,6 +268,9 @@ RUNTIME_FUNCTION(Runtime_StackGuard) {
 RUNTIME_FUNCTION(Runtime_Interrupt) {
   SealHandleScope shs(isolate);
   DCHECK_EQ(0, args.length());
+  // Functions run out of interrupt budget at a rate proportional to the
+  // bytecode they execute, so take dispatch samples at the same rate.
+  isolate->interpreter()->MaybeArmDispatchSampling();
   return isolate->stack_guard()->HandleInterrupts();
 }
 
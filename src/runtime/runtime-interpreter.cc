@@ -24,21 +24,29 @@ namespace internal {
 RUNTIME_FUNCTION(Runtime_InterpreterDeserializeLazy) {
   HandleScope scope(isolate);
 
-  DCHECK(FLAG_lazy_handler_deserialization);
-  DCHECK(FLAG_lazy_deserialization);
   DCHECK_EQ(2, args.length());
   CONVERT_SMI_ARG_CHECKED(bytecode_int, 0);
   CONVERT_SMI_ARG_CHECKED(operand_scale_int, 1);
 
   using interpreter::Bytecode;
   using interpreter::Bytecodes;
+  using interpreter::Interpreter;
   using interpreter::OperandScale;
 
   Bytecode bytecode = Bytecodes::FromByte(bytecode_int);
   OperandScale operand_scale = static_cast<OperandScale>(operand_scale_int);
 
-  return isolate->interpreter()->GetAndMaybeDeserializeBytecodeHandler(
-      bytecode, operand_scale);
+  // Dispatch sampling routes all dispatches through the DeserializeLazy
+  // handlers while it is armed.
+  Interpreter* interpreter = isolate->interpreter();
+  if (interpreter->IsDispatchSamplingArmed()) {
+    return interpreter->SampleDispatch(bytecode, operand_scale);
+  }
+
+  DCHECK(FLAG_lazy_handler_deserialization);
+  DCHECK(FLAG_lazy_deserialization);
+  return interpreter->GetAndMaybeDeserializeBytecodeHandler(bytecode,
+                                                            operand_scale);
 }
 
 #ifdef V8_TRACE_IGNITION
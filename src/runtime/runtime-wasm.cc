@@ -289,6 +289,25 @@ RUNTIME_FUNCTION(Runtime_WasmStackGuard) {
   return isolate->stack_guard()->HandleInterrupts();
 }
 
+RUNTIME_FUNCTION(Runtime_WasmTierUp) {
+  HandleScope scope(isolate);
+  DCHECK_EQ(0, args.length());
+
+  ClearThreadInWasmScope wasm_flag(true);
+
+  StackFrameIterator it(isolate, isolate->thread_local_top());
+  // On top: C entry stub.
+  DCHECK_EQ(StackFrame::EXIT, it.frame()->type());
+  it.Advance();
+  // Next: the Liftoff frame of the function that ran out of budget.
+  WasmCompiledFrame* frame = WasmCompiledFrame::cast(it.frame());
+  Handle<WasmInstanceObject> instance(frame->wasm_instance(), isolate);
+  int func_index = static_cast<int>(frame->function_index());
+
+  wasm::TierUpFunction(isolate, instance, func_index);
+  return isolate->heap()->undefined_value();
+}
+
 RUNTIME_FUNCTION(Runtime_WasmCompileLazy) {
   HandleScope scope(isolate);
   DCHECK_EQ(1, args.length());
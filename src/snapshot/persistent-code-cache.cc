@@ -0,0 +1,369 @@
+// Copyright 2018 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "src/snapshot/persistent-code-cache.h"
+
+#include <stdio.h>
+#include <string.h>
+#include <memory>
+#include <sstream>
+#include <vector>
+
+#include "src/base/lazy-instance.h"
+#include "src/base/platform/condition-variable.h"
+#include "src/base/platform/mutex.h"
+#include "src/base/platform/platform.h"
+#include "src/cancelable-task.h"
+#include "src/debug/debug.h"
+#include "src/isolate.h"
+#include "src/objects-inl.h"
+#include "src/objects/string-inl.h"
+#include "src/snapshot/code-serializer.h"
+#include "src/utils.h"
+#include "src/v8.h"
+
+namespace v8 {
+namespace internal {
+
+namespace {
+
+const char kFileExtension[] = ".v8cache";
+const uint32_t kEntryMagic = 0xC0DECAC5;
+
+// An entry file starts with this header, followed by the full script source
+// in its string encoding, padded to pointer alignment, followed by the code
+// cache. The file name is derived from a hash of the source, and is only used
+// to find the entry: a source that merely shares the hash does not match the
+// stored source and is treated as a miss.
+struct EntryHeader {
+  uint32_t magic;
+  uint32_t version_tag;
+  uint32_t source_length;
+  uint32_t source_is_one_byte;
+};
+
+size_t SourceSize(const EntryHeader* header) {
+  return header->source_is_one_byte
+             ? header->source_length
+             : header->source_length * sizeof(uc16);
+}
+
+size_t CodeCacheOffset(const EntryHeader* header) {
+  return RoundUp(sizeof(EntryHeader) + SourceSize(header), kPointerAlignment);
+}
+
+// Returns the header of the entry in |data|, or nullptr if |data| is not an
+// entry written by this version of V8.
+const EntryHeader* ParseEntry(const void* data, size_t size) {
+  if (size < sizeof(EntryHeader)) return nullptr;
+  const EntryHeader* header = static_cast<const EntryHeader*>(data);
+  if (header->magic != kEntryMagic ||
+      header->version_tag != ScriptCompiler::CachedDataVersionTag() ||
+      size < CodeCacheOffset(header)) {
+    return nullptr;
+  }
+  return header;
+}
+
+int LengthOf(String::FlatContent content) {
+  return content.IsOneByte() ? content.ToOneByteVector().length()
+                             : content.ToUC16Vector().length();
+}
+
+bool SourceMatches(const EntryHeader* header, String::FlatContent content) {
+  DCHECK(content.IsFlat());
+  if (header->source_length != static_cast<uint32_t>(LengthOf(content))) {
+    return false;
+  }
+  const void* stored = header + 1;
+  size_t length = header->source_length;
+  if (header->source_is_one_byte) {
+    const uint8_t* chars = static_cast<const uint8_t*>(stored);
+    return content.IsOneByte()
+               ? CompareChars(chars, content.ToOneByteVector().start(),
+                              length) == 0
+               : CompareChars(chars, content.ToUC16Vector().start(),
+                              length) == 0;
+  }
+  const uc16* chars = static_cast<const uc16*>(stored);
+  return content.IsOneByte()
+             ? CompareChars(chars, content.ToOneByteVector().start(),
+                            length) == 0
+             : CompareChars(chars, content.ToUC16Vector().start(), length) ==
+                   0;
+}
+
+// Returns the header and source part of the entry for |source|.
+std::vector<byte> EncodeEntryPrefix(Handle<String> source) {
+  DisallowHeapAllocation no_gc;
+  String::FlatContent content = source->GetFlatContent();
+  DCHECK(content.IsFlat());
+  EntryHeader header;
+  header.magic = kEntryMagic;
+  header.version_tag = ScriptCompiler::CachedDataVersionTag();
+  header.source_length = static_cast<uint32_t>(LengthOf(content));
+  header.source_is_one_byte = content.IsOneByte();
+  const byte* chars =
+      content.IsOneByte()
+          ? content.ToOneByteVector().start()
+          : reinterpret_cast<const byte*>(content.ToUC16Vector().start());
+  std::vector<byte> prefix(CodeCacheOffset(&header), 0);
+  memcpy(prefix.data(), &header, sizeof(header));
+  memcpy(prefix.data() + sizeof(header), chars, SourceSize(&header));
+  return prefix;
+}
+
+// Writes the entry made of |prefix| and |data| to |file_name|, unless an entry
+// for the same source with at least as much code already exists.
+void WriteEntry(const std::string& file_name, const std::vector<byte>& prefix,
+                const ScriptCompiler::CachedData* data) {
+  {
+    // The code cache grows with the number of compiled functions, so an
+    // existing entry for the same source that is at least as large has
+    // nothing to add.
+    std::unique_ptr<base::OS::MemoryMappedFile> existing(
+        base::OS::MemoryMappedFile::open(
+            file_name.c_str(),
+            base::OS::MemoryMappedFile::FileMode::kReadOnly));
+    if (existing && existing->size() >= prefix.size() &&
+        memcmp(existing->memory(), prefix.data(), prefix.size()) == 0 &&
+        existing->size() - prefix.size() >=
+            static_cast<size_t>(data->length)) {
+      return;
+    }
+  }
+
+  // Write to a process-specific file first and rename it into place, so that
+  // concurrently starting processes never map a partially written entry.
+  std::ostringstream temp_name;
+  temp_name << file_name << '.' << base::OS::GetCurrentProcessId();
+  FILE* file = base::OS::FOpen(temp_name.str().c_str(), "wb");
+  if (file == nullptr) return;
+  bool success =
+      fwrite(prefix.data(), 1, prefix.size(), file) == prefix.size() &&
+      fwrite(data->data, 1, data->length, file) ==
+          static_cast<size_t>(data->length);
+  success = fclose(file) == 0 && success;
+  if (!success || rename(temp_name.str().c_str(), file_name.c_str()) != 0) {
+    remove(temp_name.str().c_str());
+  }
+}
+
+// Tracks the entry writes posted to worker threads, so that the writes at
+// teardown are not overtaken by older, smaller entries.
+struct PendingWrites {
+  base::Mutex mutex;
+  base::ConditionVariable done;
+  int count = 0;
+};
+
+base::LazyInstance<PendingWrites>::type pending_writes =
+    LAZY_INSTANCE_INITIALIZER;
+
+class WriteEntryTask : public v8::Task {
+ public:
+  WriteEntryTask(const std::string& file_name, std::vector<byte> prefix,
+                 std::unique_ptr<ScriptCompiler::CachedData> data)
+      : file_name_(file_name),
+        prefix_(std::move(prefix)),
+        data_(std::move(data)) {
+    base::LockGuard<base::Mutex> guard(&pending_writes.Pointer()->mutex);
+    pending_writes.Pointer()->count++;
+  }
+
+  void Run() override {
+    WriteEntry(file_name_, prefix_, data_.get());
+    PendingWrites* pending = pending_writes.Pointer();
+    base::LockGuard<base::Mutex> guard(&pending->mutex);
+    if (--pending->count == 0) pending->done.NotifyAll();
+  }
+
+ private:
+  const std::string file_name_;
+  const std::vector<byte> prefix_;
+  const std::unique_ptr<ScriptCompiler::CachedData> data_;
+
+  DISALLOW_COPY_AND_ASSIGN(WriteEntryTask);
+};
+
+uint64_t HashSource(String* source) {
+  uint64_t hash = uint64_t{14695981039346656037u};
+  StringCharacterStream stream(source);
+  while (stream.HasMore()) {
+    hash = (hash ^ stream.GetNext()) * uint64_t{1099511628211u};
+  }
+  return hash;
+}
+
+bool IsCacheable(Script* script) {
+  return script->type() == Script::TYPE_NORMAL &&
+         script->compilation_type() == Script::COMPILATION_TYPE_HOST &&
+         !script->is_wrapped() && !script->origin_options().IsModule() &&
+         script->source()->IsString();
+}
+
+MaybeHandle<SharedFunctionInfo> FindToplevel(Isolate* isolate,
+                                             Handle<Script> script) {
+  SharedFunctionInfo::ScriptIterator iterator(script);
+  while (SharedFunctionInfo* info = iterator.Next()) {
+    if (info->is_toplevel()) return handle(info, isolate);
+  }
+  return MaybeHandle<SharedFunctionInfo>();
+}
+
+// Serializes the script with the given id, if it is still alive, and posts
+// the write of its entry to a worker thread.
+class StoreScriptTask : public CancelableTask {
+ public:
+  StoreScriptTask(Isolate* isolate, int script_id)
+      : CancelableTask(isolate), isolate_(isolate), script_id_(script_id) {}
+
+  void RunInternal() override {
+    HandleScope scope(isolate_);
+    Handle<Script> script;
+    {
+      Script::Iterator iterator(isolate_);
+      while (Script* next = iterator.Next()) {
+        if (next->id() == script_id_) {
+          script = handle(next, isolate_);
+          break;
+        }
+      }
+    }
+    Handle<SharedFunctionInfo> toplevel;
+    if (script.is_null() ||
+        !FindToplevel(isolate_, script).ToHandle(&toplevel) ||
+        !toplevel->is_compiled()) {
+      return;
+    }
+    PersistentCodeCache::StoreScript(toplevel, false);
+  }
+
+ private:
+  Isolate* const isolate_;
+  const int script_id_;
+
+  DISALLOW_COPY_AND_ASSIGN(StoreScriptTask);
+};
+
+}  // namespace
+
+// static
+std::string PersistentCodeCache::FileNameFor(String* source) {
+  std::ostringstream name;
+  name << FLAG_code_cache_dir << '/' << std::hex << HashSource(source) << '-'
+       << ScriptCompiler::CachedDataVersionTag() << '-' << std::dec
+       << source->length() << kFileExtension;
+  return name.str();
+}
+
+// static
+MaybeHandle<SharedFunctionInfo> PersistentCodeCache::Lookup(
+    Isolate* isolate, Handle<String> source,
+    ScriptOriginOptions origin_options) {
+  DCHECK(IsEnabled());
+  source = String::Flatten(source);
+  std::string file_name = FileNameFor(*source);
+  std::unique_ptr<base::OS::MemoryMappedFile> file(
+      base::OS::MemoryMappedFile::open(
+          file_name.c_str(), base::OS::MemoryMappedFile::FileMode::kReadOnly));
+  if (!file) return MaybeHandle<SharedFunctionInfo>();
+
+  const EntryHeader* header = ParseEntry(file->memory(), file->size());
+  bool matches;
+  {
+    DisallowHeapAllocation no_gc;
+    matches = header != nullptr &&
+              SourceMatches(header, source->GetFlatContent());
+  }
+  if (!matches) {
+    if (FLAG_trace_serializer) {
+      PrintF("[Persistent code cache %s is for another source]\n",
+             file_name.c_str());
+    }
+    return MaybeHandle<SharedFunctionInfo>();
+  }
+
+  // The mapping is page aligned and the code cache is padded to pointer
+  // alignment, so the deserializer reads it in place.
+  size_t offset = CodeCacheOffset(header);
+  ScriptData script_data(static_cast<const byte*>(file->memory()) + offset,
+                         static_cast<int>(file->size() - offset));
+  MaybeHandle<SharedFunctionInfo> result = CodeSerializer::Deserialize(
+      isolate, &script_data, source, origin_options);
+  if (FLAG_trace_serializer && result.is_null()) {
+    PrintF("[Rejected persistent code cache %s]\n", file_name.c_str());
+  }
+  return result;
+}
+
+// static
+void PersistentCodeCache::ScheduleStoreScript(
+    Isolate* isolate, Handle<SharedFunctionInfo> toplevel) {
+  DCHECK(IsEnabled());
+  DCHECK(toplevel->is_toplevel());
+  Script* script = Script::cast(toplevel->script());
+  if (!IsCacheable(script)) return;
+  V8::GetCurrentPlatform()->CallOnForegroundThread(
+      reinterpret_cast<v8::Isolate*>(isolate),
+      new StoreScriptTask(isolate, script->id()));
+}
+
+// static
+void PersistentCodeCache::StoreScripts(Isolate* isolate) {
+  DCHECK(IsEnabled());
+  if (isolate->debug()->is_loaded()) return;
+  WaitForPendingWrites();
+  HandleScope scope(isolate);
+  std::vector<Handle<Script>> scripts;
+  {
+    Script::Iterator iterator(isolate);
+    while (Script* script = iterator.Next()) {
+      if (IsCacheable(script)) scripts.push_back(handle(script, isolate));
+    }
+  }
+  for (Handle<Script> script : scripts) {
+    HandleScope script_scope(isolate);
+    Handle<SharedFunctionInfo> toplevel;
+    if (FindToplevel(isolate, script).ToHandle(&toplevel) &&
+        toplevel->is_compiled()) {
+      StoreScript(toplevel, true);
+    }
+  }
+}
+
+// static
+void PersistentCodeCache::StoreScript(Handle<SharedFunctionInfo> toplevel,
+                                      bool synchronous) {
+  DCHECK(IsEnabled());
+  DCHECK(toplevel->is_toplevel());
+  Isolate* isolate = toplevel->GetIsolate();
+  Handle<Script> script(Script::cast(toplevel->script()), isolate);
+  if (!IsCacheable(*script) || isolate->debug()->is_loaded()) return;
+  std::unique_ptr<ScriptCompiler::CachedData> data(
+      CodeSerializer::Serialize(toplevel));
+  if (!data) return;
+
+  Handle<String> source =
+      String::Flatten(handle(String::cast(script->source()), isolate));
+  std::string file_name = FileNameFor(*source);
+  std::vector<byte> prefix = EncodeEntryPrefix(source);
+  if (synchronous) {
+    WriteEntry(file_name, prefix, data.get());
+  } else {
+    V8::GetCurrentPlatform()->CallOnWorkerThread(
+        base::make_unique<WriteEntryTask>(file_name, std::move(prefix),
+                                          std::move(data)));
+  }
+}
+
+// static
+void PersistentCodeCache::WaitForPendingWrites() {
+  PendingWrites* pending = pending_writes.Pointer();
+  base::LockGuard<base::Mutex> guard(&pending->mutex);
+  while (pending->count > 0) pending->done.Wait(&pending->mutex);
+}
+
+}  // namespace internal
+}  // namespace v8
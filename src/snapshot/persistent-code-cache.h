@@ -0,0 +1,63 @@
+// Copyright 2018 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef V8_SNAPSHOT_PERSISTENT_CODE_CACHE_H_
+#define V8_SNAPSHOT_PERSISTENT_CODE_CACHE_H_
+
+#include <string>
+
+#include "src/flags.h"
+#include "src/globals.h"
+#include "src/handles.h"
+
+namespace v8 {
+namespace internal {
+
+class Script;
+class SharedFunctionInfo;
+
+// An on-disk cache of code caches, kept in the directory given by
+// --code-cache-dir. Entries are found by a hash of the script source and the
+// code cache version tag, so that they can be shared by all processes running
+// the same V8 with the same flags, and store the full source, which is
+// compared on lookup. An entry is written shortly after its script is
+// compiled, and rewritten when the isolate is torn down so that it also
+// contains the functions that were compiled lazily while the script ran. On
+// the next start, the compiler looks entries up before parsing.
+class V8_EXPORT_PRIVATE PersistentCodeCache final : public AllStatic {
+ public:
+  static bool IsEnabled() { return FLAG_code_cache_dir != nullptr; }
+
+  // Memory-maps and deserializes the cache entry for |source|, if any.
+  static MaybeHandle<SharedFunctionInfo> Lookup(
+      Isolate* isolate, Handle<String> source,
+      ScriptOriginOptions origin_options);
+
+  // Posts a foreground task that stores the script of |toplevel|, so that
+  // serialization stays off the compile path.
+  static void ScheduleStoreScript(Isolate* isolate,
+                                  Handle<SharedFunctionInfo> toplevel);
+
+  // Serializes the script of |toplevel| and writes its cache entry, unless
+  // the script is not cacheable or an entry for the same source that is at
+  // least as large already exists. Unless |synchronous|, the file is written
+  // on a worker thread.
+  static void StoreScript(Handle<SharedFunctionInfo> toplevel,
+                          bool synchronous);
+
+  // Writes cache entries for all cacheable scripts in |isolate| on the
+  // calling thread, after the pending writes.
+  static void StoreScripts(Isolate* isolate);
+
+  // Blocks until the entry writes posted to worker threads are done.
+  static void WaitForPendingWrites();
+
+  // Returns the name of the cache entry file for |source|.
+  static std::string FileNameFor(String* source);
+};
+
+}  // namespace internal
+}  // namespace v8
+
+#endif  // V8_SNAPSHOT_PERSISTENT_CODE_CACHE_H_
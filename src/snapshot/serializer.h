@@ -32,6 +32,10 @@ class CodeAddressMap : public CodeEventLogger {
     address_to_name_map_.Move(from->address(), to);
   }
 
+  void CodeDeleteEvent(Address start) override {
+    address_to_name_map_.Remove(start);
+  }
+
   void CodeDisableOptEvent(AbstractCode* code,
                            SharedFunctionInfo* shared) override {}
 
@@ -14,6 +14,7 @@
 #include "src/deoptimizer.h"
 #include "src/elements.h"
 #include "src/frames.h"
+#include "src/hot-function-profile.h"
 #include "src/isolate.h"
 #include "src/libsampler/sampler.h"
 #include "src/objects-inl.h"
@@ -23,6 +24,7 @@
 #include "src/snapshot/natives.h"
 #include "src/snapshot/snapshot.h"
 #include "src/tracing/tracing-category-observer.h"
+#include "src/wasm/shared-module-cache.h"
 
 namespace v8 {
 namespace internal {
@@ -48,6 +50,8 @@ void V8::TearDown() {
 #endif
   Bootstrapper::TearDownExtensions();
   ElementsAccessor::TearDown();
+  HotFunctionProfile::TearDown();
+  wasm::SharedModuleCache::TearDown();
   RegisteredExtension::UnregisterAll();
   sampler::Sampler::TearDown();
   FlagList::ResetAllFlags();  // Frees memory held by string arguments.
@@ -81,6 +85,8 @@ void V8::InitializeOncePerProcessImpl() {
   CpuFeatures::Probe(false);
   ElementsAccessor::InitializeOncePerProcess();
   Bootstrapper::InitializeOncePerProcess();
+  HotFunctionProfile::InitializeOncePerProcess();
+  wasm::SharedModuleCache::InitializeOncePerProcess();
 }
 
 
@@ -40,14 +40,13 @@ namespace liftoff {
 //       | optional padding slot to keep the stack 16 byte aligned.
 //  -----+--------------------+  <-- stack ptr (sp)
 //
+// Functions which hold s128 values use two of the slots above per frame slot.
 
 constexpr int32_t kInstanceOffset = 2 * kPointerSize;
-constexpr int32_t kFirstStackSlotOffset = kInstanceOffset + kPointerSize;
 constexpr int32_t kConstantStackSpace = 0;
 
-inline MemOperand GetStackSlot(uint32_t index) {
-  int32_t offset =
-      kFirstStackSlotOffset + index * LiftoffAssembler::kStackSlotSize;
+inline MemOperand GetStackSlot(const LiftoffAssembler* assm, uint32_t index) {
+  int32_t offset = kInstanceOffset + (index + 1) * assm->stack_slot_size();
   return MemOperand(fp, -offset);
 }
 
@@ -65,6 +64,8 @@ inline CPURegister GetRegFromType(const LiftoffRegister& reg, ValueType type) {
       return reg.fp().S();
     case kWasmF64:
       return reg.fp().D();
+    case kWasmS128:
+      return reg.fp().Q();
     default:
       UNREACHABLE();
   }
@@ -75,9 +76,9 @@ inline CPURegList PadRegList(RegList list) {
   return CPURegList(CPURegister::kRegister, kXRegSizeInBits, list);
 }
 
-inline CPURegList PadVRegList(RegList list) {
+inline CPURegList PadVRegList(RegList list, int reg_size_in_bits) {
   if ((base::bits::CountPopulation(list) & 1) != 0) list |= fp_scratch.bit();
-  return CPURegList(CPURegister::kVRegister, kDRegSizeInBits, list);
+  return CPURegList(CPURegister::kVRegister, reg_size_in_bits, list);
 }
 
 inline CPURegister AcquireByType(UseScratchRegisterScope* temps,
@@ -91,6 +92,8 @@ inline CPURegister AcquireByType(UseScratchRegisterScope* temps,
       return temps->AcquireS();
     case kWasmF64:
       return temps->AcquireD();
+    case kWasmS128:
+      return temps->AcquireQ();
     default:
       UNREACHABLE();
   }
@@ -242,6 +245,9 @@ void LiftoffAssembler::Load(LiftoffRegister dst, Register src_addr,
     case LoadType::kF64Load:
       Ldr(dst.fp().D(), src_op);
       break;
+    case LoadType::kS128Load:
+      Ldr(dst.fp().Q(), src_op);
+      break;
     default:
       UNREACHABLE();
   }
@@ -277,6 +283,9 @@ void LiftoffAssembler::Store(Register dst_addr, Register offset_reg,
     case StoreType::kF64Store:
       Str(src.fp().D(), dst_op);
       break;
+    case StoreType::kS128Store:
+      Str(src.fp().Q(), dst_op);
+      break;
     default:
       UNREACHABLE();
   }
@@ -304,8 +313,8 @@ void LiftoffAssembler::MoveStackValue(uint32_t dst_index, uint32_t src_index,
                                       ValueType type) {
   UseScratchRegisterScope temps(this);
   CPURegister scratch = liftoff::AcquireByType(&temps, type);
-  Ldr(scratch, liftoff::GetStackSlot(src_index));
-  Str(scratch, liftoff::GetStackSlot(dst_index));
+  Ldr(scratch, liftoff::GetStackSlot(this, src_index));
+  Str(scratch, liftoff::GetStackSlot(this, dst_index));
 }
 
 void LiftoffAssembler::Move(Register dst, Register src, ValueType type) {
@@ -321,22 +330,24 @@ void LiftoffAssembler::Move(DoubleRegister dst, DoubleRegister src,
                             ValueType type) {
   if (type == kWasmF32) {
     Fmov(dst.S(), src.S());
-  } else {
-    DCHECK_EQ(kWasmF64, type);
+  } else if (type == kWasmF64) {
     Fmov(dst.D(), src.D());
+  } else {
+    DCHECK_EQ(kWasmS128, type);
+    Mov(dst.Q(), src.Q());
   }
 }
 
 void LiftoffAssembler::Spill(uint32_t index, LiftoffRegister reg,
                              ValueType type) {
   RecordUsedSpillSlot(index);
-  MemOperand dst = liftoff::GetStackSlot(index);
+  MemOperand dst = liftoff::GetStackSlot(this, index);
   Str(liftoff::GetRegFromType(reg, type), dst);
 }
 
 void LiftoffAssembler::Spill(uint32_t index, WasmValue value) {
   RecordUsedSpillSlot(index);
-  MemOperand dst = liftoff::GetStackSlot(index);
+  MemOperand dst = liftoff::GetStackSlot(this, index);
   UseScratchRegisterScope temps(this);
   CPURegister src = CPURegister::no_reg();
   switch (value.type()) {
@@ -357,7 +368,7 @@ void LiftoffAssembler::Spill(uint32_t index, WasmValue value) {
 
 void LiftoffAssembler::Fill(LiftoffRegister reg, uint32_t index,
                             ValueType type) {
-  MemOperand src = liftoff::GetStackSlot(index);
+  MemOperand src = liftoff::GetStackSlot(this, index);
   Ldr(liftoff::GetRegFromType(reg, type), src);
 }
 
@@ -834,6 +845,176 @@ void LiftoffAssembler::emit_f64_set_cond(Condition cond, Register dst,
   }
 }
 
+void LiftoffAssembler::emit_i8x16_splat(LiftoffRegister dst,
+                                        LiftoffRegister src) {
+  Dup(dst.fp().V16B(), src.gp().W());
+}
+
+void LiftoffAssembler::emit_i16x8_splat(LiftoffRegister dst,
+                                        LiftoffRegister src) {
+  Dup(dst.fp().V8H(), src.gp().W());
+}
+
+void LiftoffAssembler::emit_i32x4_splat(LiftoffRegister dst,
+                                        LiftoffRegister src) {
+  Dup(dst.fp().V4S(), src.gp().W());
+}
+
+void LiftoffAssembler::emit_f32x4_splat(LiftoffRegister dst,
+                                        LiftoffRegister src) {
+  Dup(dst.fp().V4S(), src.fp().S(), 0);
+}
+
+void LiftoffAssembler::emit_i8x16_extract_lane(LiftoffRegister dst,
+                                               LiftoffRegister src,
+                                               uint8_t lane) {
+  Smov(dst.gp().W(), src.fp().V16B(), lane);
+}
+
+void LiftoffAssembler::emit_i16x8_extract_lane(LiftoffRegister dst,
+                                               LiftoffRegister src,
+                                               uint8_t lane) {
+  Smov(dst.gp().W(), src.fp().V8H(), lane);
+}
+
+void LiftoffAssembler::emit_i32x4_extract_lane(LiftoffRegister dst,
+                                               LiftoffRegister src,
+                                               uint8_t lane) {
+  Mov(dst.gp().W(), src.fp().V4S(), lane);
+}
+
+void LiftoffAssembler::emit_f32x4_extract_lane(LiftoffRegister dst,
+                                               LiftoffRegister src,
+                                               uint8_t lane) {
+  Mov(dst.fp().S(), src.fp().V4S(), lane);
+}
+
+void LiftoffAssembler::emit_i8x16_replace_lane(LiftoffRegister dst,
+                                               LiftoffRegister src,
+                                               LiftoffRegister value,
+                                               uint8_t lane) {
+  if (dst != src) Mov(dst.fp().V16B(), src.fp().V16B());
+  Mov(dst.fp().V16B(), lane, value.gp().W());
+}
+
+void LiftoffAssembler::emit_i16x8_replace_lane(LiftoffRegister dst,
+                                               LiftoffRegister src,
+                                               LiftoffRegister value,
+                                               uint8_t lane) {
+  if (dst != src) Mov(dst.fp().V16B(), src.fp().V16B());
+  Mov(dst.fp().V8H(), lane, value.gp().W());
+}
+
+void LiftoffAssembler::emit_i32x4_replace_lane(LiftoffRegister dst,
+                                               LiftoffRegister src,
+                                               LiftoffRegister value,
+                                               uint8_t lane) {
+  if (dst != src) Mov(dst.fp().V16B(), src.fp().V16B());
+  Mov(dst.fp().V4S(), lane, value.gp().W());
+}
+
+void LiftoffAssembler::emit_f32x4_replace_lane(LiftoffRegister dst,
+                                               LiftoffRegister src,
+                                               LiftoffRegister value,
+                                               uint8_t lane) {
+  if (dst != src) Mov(dst.fp().V16B(), src.fp().V16B());
+  Mov(dst.fp().V4S(), lane, value.fp().V4S(), 0);
+}
+
+#define SIMD_BINOP(name, instruction, format)                                  \
+  void LiftoffAssembler::emit_##name(LiftoffRegister dst, LiftoffRegister lhs, \
+                                     LiftoffRegister rhs) {                    \
+    instruction(dst.fp().V##format(), lhs.fp().V##format(),                    \
+                rhs.fp().V##format());                                         \
+  }
+SIMD_BINOP(i8x16_add, Add, 16B)
+SIMD_BINOP(i8x16_sub, Sub, 16B)
+SIMD_BINOP(i16x8_add, Add, 8H)
+SIMD_BINOP(i16x8_sub, Sub, 8H)
+SIMD_BINOP(i32x4_add, Add, 4S)
+SIMD_BINOP(i32x4_sub, Sub, 4S)
+SIMD_BINOP(i32x4_mul, Mul, 4S)
+SIMD_BINOP(f32x4_add, Fadd, 4S)
+SIMD_BINOP(f32x4_sub, Fsub, 4S)
+SIMD_BINOP(f32x4_mul, Fmul, 4S)
+SIMD_BINOP(s128_and, And, 16B)
+SIMD_BINOP(s128_or, Orr, 16B)
+SIMD_BINOP(s128_xor, Eor, 16B)
+SIMD_BINOP(i8x16_eq, Cmeq, 16B)
+SIMD_BINOP(i8x16_gt_s, Cmgt, 16B)
+SIMD_BINOP(i8x16_ge_s, Cmge, 16B)
+SIMD_BINOP(i8x16_gt_u, Cmhi, 16B)
+SIMD_BINOP(i8x16_ge_u, Cmhs, 16B)
+SIMD_BINOP(i16x8_eq, Cmeq, 8H)
+SIMD_BINOP(i16x8_gt_s, Cmgt, 8H)
+SIMD_BINOP(i16x8_ge_s, Cmge, 8H)
+SIMD_BINOP(i16x8_gt_u, Cmhi, 8H)
+SIMD_BINOP(i16x8_ge_u, Cmhs, 8H)
+SIMD_BINOP(i32x4_eq, Cmeq, 4S)
+SIMD_BINOP(i32x4_gt_s, Cmgt, 4S)
+SIMD_BINOP(i32x4_ge_s, Cmge, 4S)
+SIMD_BINOP(i32x4_gt_u, Cmhi, 4S)
+SIMD_BINOP(i32x4_ge_u, Cmhs, 4S)
+SIMD_BINOP(f32x4_eq, Fcmeq, 4S)
+#undef SIMD_BINOP
+
+// Comparisons that NEON only provides with swapped operands.
+#define SIMD_SWAPPED_BINOP(name, instruction, format)                          \
+  void LiftoffAssembler::emit_##name(LiftoffRegister dst, LiftoffRegister lhs, \
+                                     LiftoffRegister rhs) {                    \
+    instruction(dst.fp().V##format(), rhs.fp().V##format(),                    \
+                lhs.fp().V##format());                                         \
+  }
+SIMD_SWAPPED_BINOP(f32x4_lt, Fcmgt, 4S)
+SIMD_SWAPPED_BINOP(f32x4_le, Fcmge, 4S)
+#undef SIMD_SWAPPED_BINOP
+
+#define SIMD_NOT_EQUAL(name, eq_instruction, format)                           \
+  void LiftoffAssembler::emit_##name(LiftoffRegister dst, LiftoffRegister lhs, \
+                                     LiftoffRegister rhs) {                    \
+    eq_instruction(dst.fp().V##format(), lhs.fp().V##format(),                 \
+                   rhs.fp().V##format());                                      \
+    Mvn(dst.fp().V16B(), dst.fp().V16B());                                     \
+  }
+SIMD_NOT_EQUAL(i8x16_ne, Cmeq, 16B)
+SIMD_NOT_EQUAL(i16x8_ne, Cmeq, 8H)
+SIMD_NOT_EQUAL(i32x4_ne, Cmeq, 4S)
+SIMD_NOT_EQUAL(f32x4_ne, Fcmeq, 4S)
+#undef SIMD_NOT_EQUAL
+
+#define SIMD_SHIFT(name, instruction, format)                                  \
+  void LiftoffAssembler::emit_##name(LiftoffRegister dst,                      \
+                                     LiftoffRegister src,                      \
+                                     uint8_t shift) {                          \
+    instruction(dst.fp().V##format(), src.fp().V##format(), shift);            \
+  }
+SIMD_SHIFT(i16x8_shl, Shl, 8H)
+SIMD_SHIFT(i16x8_shr_s, Sshr, 8H)
+SIMD_SHIFT(i16x8_shr_u, Ushr, 8H)
+SIMD_SHIFT(i32x4_shl, Shl, 4S)
+SIMD_SHIFT(i32x4_shr_s, Sshr, 4S)
+SIMD_SHIFT(i32x4_shr_u, Ushr, 4S)
+#undef SIMD_SHIFT
+
+void LiftoffAssembler::emit_s128_select(LiftoffRegister dst,
+                                        LiftoffRegister mask,
+                                        LiftoffRegister if_true,
+                                        LiftoffRegister if_false) {
+  // Bsl selects with the mask in its destination register.
+  if (dst == mask) {
+    Bsl(dst.fp().V16B(), if_true.fp().V16B(), if_false.fp().V16B());
+  } else if (dst != if_true && dst != if_false) {
+    Mov(dst.fp().V16B(), mask.fp().V16B());
+    Bsl(dst.fp().V16B(), if_true.fp().V16B(), if_false.fp().V16B());
+  } else {
+    UseScratchRegisterScope temps(this);
+    VRegister scratch = temps.AcquireV(kFormat16B);
+    Mov(scratch, mask.fp().V16B());
+    Bsl(scratch, if_true.fp().V16B(), if_false.fp().V16B());
+    Mov(dst.fp().V16B(), scratch);
+  }
+}
+
 void LiftoffAssembler::StackCheck(Label* ool_code) {
   ExternalReference stack_limit =
       ExternalReference::address_of_stack_limit(isolate());
@@ -854,12 +1035,15 @@ void LiftoffAssembler::AssertUnreachable(AbortReason reason) {
 }
 
 void LiftoffAssembler::PushRegisters(LiftoffRegList regs) {
+  // Only functions which hold s128 values need the full registers saved.
+  int fp_reg_size = s128_enabled() ? kQRegSizeInBits : kDRegSizeInBits;
   PushCPURegList(liftoff::PadRegList(regs.GetGpList()));
-  PushCPURegList(liftoff::PadVRegList(regs.GetFpList()));
+  PushCPURegList(liftoff::PadVRegList(regs.GetFpList(), fp_reg_size));
 }
 
 void LiftoffAssembler::PopRegisters(LiftoffRegList regs) {
-  PopCPURegList(liftoff::PadVRegList(regs.GetFpList()));
+  int fp_reg_size = s128_enabled() ? kQRegSizeInBits : kDRegSizeInBits;
+  PopCPURegList(liftoff::PadVRegList(regs.GetFpList(), fp_reg_size));
   PopCPURegList(liftoff::PadRegList(regs.GetGpList()));
 }
 
@@ -954,7 +1138,7 @@ void LiftoffStackSlots::Construct() {
       case LiftoffAssembler::VarState::kStack: {
         UseScratchRegisterScope temps(asm_);
         CPURegister scratch = liftoff::AcquireByType(&temps, slot.src_.type());
-        asm_->Ldr(scratch, liftoff::GetStackSlot(slot.src_index_));
+        asm_->Ldr(scratch, liftoff::GetStackSlot(asm_, slot.src_index_));
         asm_->Poke(scratch, poke_offset);
         break;
       }
@@ -27,8 +27,10 @@ struct ModuleEnv;
 
 class LiftoffAssembler : public TurboAssembler {
  public:
-  // Each slot in our stack frame currently has exactly 8 bytes.
+  // Each slot in our stack frame currently has exactly 8 bytes. Functions which
+  // can spill s128 values use 16-byte slots instead, see {EnableS128}.
   static constexpr uint32_t kStackSlotSize = 8;
+  static constexpr uint32_t kS128StackSlotSize = 16;
 
   static constexpr ValueType kWasmIntPtr =
       kPointerSize == 8 ? kWasmI64 : kWasmI32;
@@ -519,6 +521,119 @@ class LiftoffAssembler : public TurboAssembler {
   inline void emit_f64_set_cond(Condition condition, Register dst,
                                 DoubleRegister lhs, DoubleRegister rhs);
 
+  // simd operations. Only implemented if {kSupportsS128}, the other platforms
+  // share the bailout stubs below.
+  inline void emit_i8x16_splat(LiftoffRegister dst, LiftoffRegister src);
+  inline void emit_i16x8_splat(LiftoffRegister dst, LiftoffRegister src);
+  inline void emit_i32x4_splat(LiftoffRegister dst, LiftoffRegister src);
+  inline void emit_f32x4_splat(LiftoffRegister dst, LiftoffRegister src);
+  // Integer lanes are sign-extended to i32.
+  inline void emit_i8x16_extract_lane(LiftoffRegister dst, LiftoffRegister src,
+                                      uint8_t lane);
+  inline void emit_i16x8_extract_lane(LiftoffRegister dst, LiftoffRegister src,
+                                      uint8_t lane);
+  inline void emit_i32x4_extract_lane(LiftoffRegister dst, LiftoffRegister src,
+                                      uint8_t lane);
+  inline void emit_f32x4_extract_lane(LiftoffRegister dst, LiftoffRegister src,
+                                      uint8_t lane);
+  inline void emit_i8x16_replace_lane(LiftoffRegister dst, LiftoffRegister src,
+                                      LiftoffRegister value, uint8_t lane);
+  inline void emit_i16x8_replace_lane(LiftoffRegister dst, LiftoffRegister src,
+                                      LiftoffRegister value, uint8_t lane);
+  inline void emit_i32x4_replace_lane(LiftoffRegister dst, LiftoffRegister src,
+                                      LiftoffRegister value, uint8_t lane);
+  inline void emit_f32x4_replace_lane(LiftoffRegister dst, LiftoffRegister src,
+                                      LiftoffRegister value, uint8_t lane);
+  inline void emit_i8x16_add(LiftoffRegister dst, LiftoffRegister lhs,
+                             LiftoffRegister rhs);
+  inline void emit_i8x16_sub(LiftoffRegister dst, LiftoffRegister lhs,
+                             LiftoffRegister rhs);
+  inline void emit_i16x8_add(LiftoffRegister dst, LiftoffRegister lhs,
+                             LiftoffRegister rhs);
+  inline void emit_i16x8_sub(LiftoffRegister dst, LiftoffRegister lhs,
+                             LiftoffRegister rhs);
+  inline void emit_i32x4_add(LiftoffRegister dst, LiftoffRegister lhs,
+                             LiftoffRegister rhs);
+  inline void emit_i32x4_sub(LiftoffRegister dst, LiftoffRegister lhs,
+                             LiftoffRegister rhs);
+  inline void emit_i32x4_mul(LiftoffRegister dst, LiftoffRegister lhs,
+                             LiftoffRegister rhs);
+  inline void emit_f32x4_add(LiftoffRegister dst, LiftoffRegister lhs,
+                             LiftoffRegister rhs);
+  inline void emit_f32x4_sub(LiftoffRegister dst, LiftoffRegister lhs,
+                             LiftoffRegister rhs);
+  inline void emit_f32x4_mul(LiftoffRegister dst, LiftoffRegister lhs,
+                             LiftoffRegister rhs);
+  inline void emit_s128_and(LiftoffRegister dst, LiftoffRegister lhs,
+                            LiftoffRegister rhs);
+  inline void emit_s128_or(LiftoffRegister dst, LiftoffRegister lhs,
+                           LiftoffRegister rhs);
+  inline void emit_s128_xor(LiftoffRegister dst, LiftoffRegister lhs,
+                            LiftoffRegister rhs);
+  // Lanes compare to all ones if true and to zero if false. The remaining
+  // comparisons swap the operands.
+  inline void emit_i8x16_eq(LiftoffRegister dst, LiftoffRegister lhs,
+                            LiftoffRegister rhs);
+  inline void emit_i8x16_ne(LiftoffRegister dst, LiftoffRegister lhs,
+                            LiftoffRegister rhs);
+  inline void emit_i8x16_gt_s(LiftoffRegister dst, LiftoffRegister lhs,
+                              LiftoffRegister rhs);
+  inline void emit_i8x16_ge_s(LiftoffRegister dst, LiftoffRegister lhs,
+                              LiftoffRegister rhs);
+  inline void emit_i8x16_gt_u(LiftoffRegister dst, LiftoffRegister lhs,
+                              LiftoffRegister rhs);
+  inline void emit_i8x16_ge_u(LiftoffRegister dst, LiftoffRegister lhs,
+                              LiftoffRegister rhs);
+  inline void emit_i16x8_eq(LiftoffRegister dst, LiftoffRegister lhs,
+                            LiftoffRegister rhs);
+  inline void emit_i16x8_ne(LiftoffRegister dst, LiftoffRegister lhs,
+                            LiftoffRegister rhs);
+  inline void emit_i16x8_gt_s(LiftoffRegister dst, LiftoffRegister lhs,
+                              LiftoffRegister rhs);
+  inline void emit_i16x8_ge_s(LiftoffRegister dst, LiftoffRegister lhs,
+                              LiftoffRegister rhs);
+  inline void emit_i16x8_gt_u(LiftoffRegister dst, LiftoffRegister lhs,
+                              LiftoffRegister rhs);
+  inline void emit_i16x8_ge_u(LiftoffRegister dst, LiftoffRegister lhs,
+                              LiftoffRegister rhs);
+  inline void emit_i32x4_eq(LiftoffRegister dst, LiftoffRegister lhs,
+                            LiftoffRegister rhs);
+  inline void emit_i32x4_ne(LiftoffRegister dst, LiftoffRegister lhs,
+                            LiftoffRegister rhs);
+  inline void emit_i32x4_gt_s(LiftoffRegister dst, LiftoffRegister lhs,
+                              LiftoffRegister rhs);
+  inline void emit_i32x4_ge_s(LiftoffRegister dst, LiftoffRegister lhs,
+                              LiftoffRegister rhs);
+  inline void emit_i32x4_gt_u(LiftoffRegister dst, LiftoffRegister lhs,
+                              LiftoffRegister rhs);
+  inline void emit_i32x4_ge_u(LiftoffRegister dst, LiftoffRegister lhs,
+                              LiftoffRegister rhs);
+  inline void emit_f32x4_eq(LiftoffRegister dst, LiftoffRegister lhs,
+                            LiftoffRegister rhs);
+  inline void emit_f32x4_ne(LiftoffRegister dst, LiftoffRegister lhs,
+                            LiftoffRegister rhs);
+  inline void emit_f32x4_lt(LiftoffRegister dst, LiftoffRegister lhs,
+                            LiftoffRegister rhs);
+  inline void emit_f32x4_le(LiftoffRegister dst, LiftoffRegister lhs,
+                            LiftoffRegister rhs);
+  inline void emit_i16x8_shl(LiftoffRegister dst, LiftoffRegister src,
+                             uint8_t shift);
+  inline void emit_i16x8_shr_s(LiftoffRegister dst, LiftoffRegister src,
+                               uint8_t shift);
+  inline void emit_i16x8_shr_u(LiftoffRegister dst, LiftoffRegister src,
+                               uint8_t shift);
+  inline void emit_i32x4_shl(LiftoffRegister dst, LiftoffRegister src,
+                             uint8_t shift);
+  inline void emit_i32x4_shr_s(LiftoffRegister dst, LiftoffRegister src,
+                               uint8_t shift);
+  inline void emit_i32x4_shr_u(LiftoffRegister dst, LiftoffRegister src,
+                               uint8_t shift);
+  // Takes the bits of {if_true} where {mask} is set, and of {if_false}
+  // elsewhere.
+  inline void emit_s128_select(LiftoffRegister dst, LiftoffRegister mask,
+                               LiftoffRegister if_true,
+                               LiftoffRegister if_false);
+
   inline void StackCheck(Label* ool_code);
 
   inline void CallTrapCallbackForTesting();
@@ -557,8 +672,22 @@ class LiftoffAssembler : public TurboAssembler {
   uint32_t num_locals() const { return num_locals_; }
   void set_num_locals(uint32_t num_locals);
 
+  // Switch to 16-byte stack slots and full fp register saves, such that s128
+  // values can be spilled. Must be called before any code is emitted.
+  void EnableS128() {
+    DCHECK(kSupportsS128);
+    DCHECK_EQ(0, pc_offset());
+    s128_enabled_ = true;
+  }
+  bool s128_enabled() const { return s128_enabled_; }
+  uint32_t stack_slot_size() const {
+    return s128_enabled_ ? kS128StackSlotSize : kStackSlotSize;
+  }
+
+  // The frame size in units of {kStackSlotSize}.
   uint32_t GetTotalFrameSlotCount() const {
-    return num_locals_ + num_used_spill_slots_;
+    return (num_locals_ + num_used_spill_slots_) *
+           (stack_slot_size() / kStackSlotSize);
   }
 
   ValueType local_type(uint32_t index) {
@@ -594,6 +723,7 @@ class LiftoffAssembler : public TurboAssembler {
                 "Reconsider this inlining if ValueType gets bigger");
   CacheState cache_state_;
   uint32_t num_used_spill_slots_ = 0;
+  bool s128_enabled_ = false;
   const char* bailout_reason_ = nullptr;
 
   LiftoffRegister SpillOneRegister(LiftoffRegList candidates,
@@ -656,6 +786,107 @@ void LiftoffAssembler::emit_i64_xor(LiftoffRegister dst, LiftoffRegister lhs,
 
 #endif  // V8_TARGET_ARCH_32_BIT
 
+#if !V8_TARGET_ARCH_X64 && !V8_TARGET_ARCH_ARM64
+
+static_assert(!kSupportsS128, "platforms supporting s128 implement simd ops");
+
+#define LIFTOFF_UNIMPLEMENTED_SIMD_SPLAT(name)                               \
+  void LiftoffAssembler::emit_##name(LiftoffRegister dst,                    \
+                                     LiftoffRegister src) {                  \
+    bailout("simd splat: " #name);                                           \
+  }
+#define LIFTOFF_UNIMPLEMENTED_SIMD_EXTRACT_LANE(name)                        \
+  void LiftoffAssembler::emit_##name(LiftoffRegister dst,                    \
+                                     LiftoffRegister src, uint8_t lane) {    \
+    bailout("simd extract lane: " #name);                                    \
+  }
+#define LIFTOFF_UNIMPLEMENTED_SIMD_REPLACE_LANE(name)                        \
+  void LiftoffAssembler::emit_##name(LiftoffRegister dst,                    \
+                                     LiftoffRegister src,                    \
+                                     LiftoffRegister value, uint8_t lane) {  \
+    bailout("simd replace lane: " #name);                                    \
+  }
+#define LIFTOFF_UNIMPLEMENTED_SIMD_BINOP(name)                               \
+  void LiftoffAssembler::emit_##name(LiftoffRegister dst,                    \
+                                     LiftoffRegister lhs,                    \
+                                     LiftoffRegister rhs) {                  \
+    bailout("simd binop: " #name);                                           \
+  }
+#define LIFTOFF_UNIMPLEMENTED_SIMD_SHIFT(name)                               \
+  void LiftoffAssembler::emit_##name(LiftoffRegister dst,                    \
+                                     LiftoffRegister src, uint8_t shift) {   \
+    bailout("simd shift: " #name);                                           \
+  }
+
+LIFTOFF_UNIMPLEMENTED_SIMD_SPLAT(i8x16_splat)
+LIFTOFF_UNIMPLEMENTED_SIMD_SPLAT(i16x8_splat)
+LIFTOFF_UNIMPLEMENTED_SIMD_SPLAT(i32x4_splat)
+LIFTOFF_UNIMPLEMENTED_SIMD_SPLAT(f32x4_splat)
+LIFTOFF_UNIMPLEMENTED_SIMD_EXTRACT_LANE(i8x16_extract_lane)
+LIFTOFF_UNIMPLEMENTED_SIMD_EXTRACT_LANE(i16x8_extract_lane)
+LIFTOFF_UNIMPLEMENTED_SIMD_EXTRACT_LANE(i32x4_extract_lane)
+LIFTOFF_UNIMPLEMENTED_SIMD_EXTRACT_LANE(f32x4_extract_lane)
+LIFTOFF_UNIMPLEMENTED_SIMD_REPLACE_LANE(i8x16_replace_lane)
+LIFTOFF_UNIMPLEMENTED_SIMD_REPLACE_LANE(i16x8_replace_lane)
+LIFTOFF_UNIMPLEMENTED_SIMD_REPLACE_LANE(i32x4_replace_lane)
+LIFTOFF_UNIMPLEMENTED_SIMD_REPLACE_LANE(f32x4_replace_lane)
+LIFTOFF_UNIMPLEMENTED_SIMD_BINOP(i8x16_add)
+LIFTOFF_UNIMPLEMENTED_SIMD_BINOP(i8x16_sub)
+LIFTOFF_UNIMPLEMENTED_SIMD_BINOP(i16x8_add)
+LIFTOFF_UNIMPLEMENTED_SIMD_BINOP(i16x8_sub)
+LIFTOFF_UNIMPLEMENTED_SIMD_BINOP(i32x4_add)
+LIFTOFF_UNIMPLEMENTED_SIMD_BINOP(i32x4_sub)
+LIFTOFF_UNIMPLEMENTED_SIMD_BINOP(i32x4_mul)
+LIFTOFF_UNIMPLEMENTED_SIMD_BINOP(f32x4_add)
+LIFTOFF_UNIMPLEMENTED_SIMD_BINOP(f32x4_sub)
+LIFTOFF_UNIMPLEMENTED_SIMD_BINOP(f32x4_mul)
+LIFTOFF_UNIMPLEMENTED_SIMD_BINOP(s128_and)
+LIFTOFF_UNIMPLEMENTED_SIMD_BINOP(s128_or)
+LIFTOFF_UNIMPLEMENTED_SIMD_BINOP(s128_xor)
+LIFTOFF_UNIMPLEMENTED_SIMD_BINOP(i8x16_eq)
+LIFTOFF_UNIMPLEMENTED_SIMD_BINOP(i8x16_ne)
+LIFTOFF_UNIMPLEMENTED_SIMD_BINOP(i8x16_gt_s)
+LIFTOFF_UNIMPLEMENTED_SIMD_BINOP(i8x16_ge_s)
+LIFTOFF_UNIMPLEMENTED_SIMD_BINOP(i8x16_gt_u)
+LIFTOFF_UNIMPLEMENTED_SIMD_BINOP(i8x16_ge_u)
+LIFTOFF_UNIMPLEMENTED_SIMD_BINOP(i16x8_eq)
+LIFTOFF_UNIMPLEMENTED_SIMD_BINOP(i16x8_ne)
+LIFTOFF_UNIMPLEMENTED_SIMD_BINOP(i16x8_gt_s)
+LIFTOFF_UNIMPLEMENTED_SIMD_BINOP(i16x8_ge_s)
+LIFTOFF_UNIMPLEMENTED_SIMD_BINOP(i16x8_gt_u)
+LIFTOFF_UNIMPLEMENTED_SIMD_BINOP(i16x8_ge_u)
+LIFTOFF_UNIMPLEMENTED_SIMD_BINOP(i32x4_eq)
+LIFTOFF_UNIMPLEMENTED_SIMD_BINOP(i32x4_ne)
+LIFTOFF_UNIMPLEMENTED_SIMD_BINOP(i32x4_gt_s)
+LIFTOFF_UNIMPLEMENTED_SIMD_BINOP(i32x4_ge_s)
+LIFTOFF_UNIMPLEMENTED_SIMD_BINOP(i32x4_gt_u)
+LIFTOFF_UNIMPLEMENTED_SIMD_BINOP(i32x4_ge_u)
+LIFTOFF_UNIMPLEMENTED_SIMD_BINOP(f32x4_eq)
+LIFTOFF_UNIMPLEMENTED_SIMD_BINOP(f32x4_ne)
+LIFTOFF_UNIMPLEMENTED_SIMD_BINOP(f32x4_lt)
+LIFTOFF_UNIMPLEMENTED_SIMD_BINOP(f32x4_le)
+LIFTOFF_UNIMPLEMENTED_SIMD_SHIFT(i16x8_shl)
+LIFTOFF_UNIMPLEMENTED_SIMD_SHIFT(i16x8_shr_s)
+LIFTOFF_UNIMPLEMENTED_SIMD_SHIFT(i16x8_shr_u)
+LIFTOFF_UNIMPLEMENTED_SIMD_SHIFT(i32x4_shl)
+LIFTOFF_UNIMPLEMENTED_SIMD_SHIFT(i32x4_shr_s)
+LIFTOFF_UNIMPLEMENTED_SIMD_SHIFT(i32x4_shr_u)
+
+void LiftoffAssembler::emit_s128_select(LiftoffRegister dst,
+                                        LiftoffRegister mask,
+                                        LiftoffRegister if_true,
+                                        LiftoffRegister if_false) {
+  bailout("simd select");
+}
+
+#undef LIFTOFF_UNIMPLEMENTED_SIMD_SPLAT
+#undef LIFTOFF_UNIMPLEMENTED_SIMD_EXTRACT_LANE
+#undef LIFTOFF_UNIMPLEMENTED_SIMD_REPLACE_LANE
+#undef LIFTOFF_UNIMPLEMENTED_SIMD_BINOP
+#undef LIFTOFF_UNIMPLEMENTED_SIMD_SHIFT
+
+#endif  // !V8_TARGET_ARCH_X64 && !V8_TARGET_ARCH_ARM64
+
 // End of the partially platform-independent implementations of the
 // platform-dependent part.
 // =======================================================================
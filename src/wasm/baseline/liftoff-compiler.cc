@@ -55,6 +55,16 @@ namespace {
 constexpr LoadType::LoadTypeValue kPointerLoadType =
     kPointerSize == 8 ? LoadType::kI64Load : LoadType::kI32Load;
 
+// After tier-up, only the tier-up prologue of Liftoff code stays reachable, so
+// the rest can be freed. This requires the prologue not to reference anything
+// emitted after it, which does not hold on platforms that place constants in
+// pools behind the code.
+#if V8_TARGET_ARCH_X64 || V8_TARGET_ARCH_IA32
+constexpr bool kTierUpPrologueIsSelfContained = true;
+#else
+constexpr bool kTierUpPrologueIsSelfContained = false;
+#endif
+
 #if V8_TARGET_ARCH_ARM64
 // On ARM64, the Assembler keeps track of pointers to Labels to resolve
 // branches to distant targets. Moving labels would confuse the Assembler,
@@ -86,6 +96,12 @@ compiler::CallDescriptor* GetLoweredCallDescriptor(
 
 constexpr ValueType kTypesArr_ilfd[] = {kWasmI32, kWasmI64, kWasmF32, kWasmF64};
 constexpr Vector<const ValueType> kTypes_ilfd = ArrayVector(kTypesArr_ilfd);
+// Values which can live on the value stack and in locals, but cannot be passed
+// as parameters or returned yet. s128 is only supported on some platforms.
+constexpr ValueType kTypesArr_ilfds[] = {kWasmI32, kWasmI64, kWasmF32,
+                                         kWasmF64, kWasmS128};
+constexpr Vector<const ValueType> kTypes_ilfds =
+    kSupportsS128 ? ArrayVector(kTypesArr_ilfds) : kTypes_ilfd;
 
 class LiftoffCompiler {
  public:
@@ -129,6 +145,9 @@ class LiftoffCompiler {
     static OutOfLineCode StackCheck(WasmCodePosition pos, LiftoffRegList regs) {
       return {{}, {}, Builtins::kWasmStackGuard, pos, regs, 0};
     }
+    static OutOfLineCode TierUp(WasmCodePosition pos, LiftoffRegList regs) {
+      return {{}, {}, Builtins::kWasmTierUp, pos, regs, 0};
+    }
   };
 
   LiftoffCompiler(LiftoffAssembler* liftoff_asm,
@@ -137,7 +156,7 @@ class LiftoffCompiler {
                   std::vector<trap_handler::ProtectedInstructionData>*
                       protected_instructions,
                   Zone* compilation_zone, std::unique_ptr<Zone>* codegen_zone,
-                  WasmCode* const* code_table_entry)
+                  uint32_t func_index, WasmCode* const* code_table_entry)
       : asm_(liftoff_asm),
         descriptor_(
             GetLoweredCallDescriptor(compilation_zone, call_descriptor)),
@@ -152,6 +171,7 @@ class LiftoffCompiler {
         compilation_zone_(compilation_zone),
         codegen_zone_(codegen_zone),
         safepoint_table_builder_(compilation_zone_),
+        func_index_(func_index),
         code_table_entry_(code_table_entry) {}
 
   ~LiftoffCompiler() { BindUnboundLabels(nullptr); }
@@ -184,10 +204,21 @@ class LiftoffCompiler {
     return false;
   }
 
+  bool CheckSupportedParameters(Decoder* decoder, FunctionSig* sig) {
+    for (ValueType type : sig->parameters()) {
+      if (!CheckSupportedType(decoder, kTypes_ilfd, type, "param")) {
+        return false;
+      }
+    }
+    return true;
+  }
+
   int GetSafepointTableOffset() const {
     return safepoint_table_builder_.GetCodeOffset();
   }
 
+  int GetTierUpPrologueSize() const { return tier_up_prologue_size_; }
+
   void BindUnboundLabels(Decoder* decoder) {
 #ifdef DEBUG
     // Bind all labels now, otherwise their destructor will fire a DCHECK error
@@ -297,6 +328,34 @@ class LiftoffCompiler {
     __ bind(ool.continuation.get());
   }
 
+  // Decrements the tiering budget of this function and calls the WasmTierUp
+  // builtin once it is used up (see --wasm-dynamic-tiering).
+  void TierUpCheck(WasmCodePosition position) {
+    if (!FLAG_wasm_dynamic_tiering || !env_->runtime_exception_support ||
+        env_->module->origin != kWasmOrigin) {
+      return;
+    }
+    DEBUG_CODE_COMMENT("tier-up check");
+    LiftoffRegList pinned;
+    LiftoffRegister budgets = pinned.set(__ GetUnusedRegister(kGpReg, pinned));
+    LiftoffRegister budget = pinned.set(__ GetUnusedRegister(kGpReg, pinned));
+    LiftoffRegister one = pinned.set(__ GetUnusedRegister(kGpReg, pinned));
+    uint32_t offset =
+        (func_index_ - env_->module->num_imported_functions) * kInt32Size;
+    LOAD_INSTANCE_FIELD(budgets, TieringBudgets, kPointerLoadType);
+    __ Load(budget, budgets.gp(), Register::no_reg(), offset,
+            LoadType::kI32Load, pinned);
+    __ LoadConstant(one, WasmValue(int32_t{1}));
+    __ emit_i32_sub(budget.gp(), budget.gp(), one.gp());
+    __ Store(budgets.gp(), Register::no_reg(), offset, budget,
+             StoreType::kI32Store, pinned);
+    out_of_line_code_.push_back(
+        OutOfLineCode::TierUp(position, __ cache_state()->used_registers));
+    OutOfLineCode& ool = out_of_line_code_.back();
+    __ emit_cond_jump(kSignedLessThan, ool.label.get(), kWasmI32, budget.gp());
+    __ bind(ool.continuation.get());
+  }
+
   // Inserts a check whether the optimized version of this code already exists.
   // If so, it redirects execution to the optimized code.
   void JumpToOptimizedCodeIfExisting(LiftoffRegList param_regs) {
@@ -353,9 +412,18 @@ class LiftoffCompiler {
   }
 
   void StartFunctionBody(Decoder* decoder, Control* block) {
+    uint32_t num_params =
+        static_cast<uint32_t>(decoder->sig_->parameter_count());
     for (uint32_t i = 0; i < __ num_locals(); ++i) {
-      if (!CheckSupportedType(decoder, kTypes_ilfd, __ local_type(i), "param"))
+      if (i < num_params) {
+        if (!CheckSupportedType(decoder, kTypes_ilfd, __ local_type(i),
+                                "param")) {
+          return;
+        }
+      } else if (!CheckSupportedType(decoder, kTypes_ilfds, __ local_type(i),
+                                     "local")) {
         return;
+      }
     }
 
     // Input 0 is the call target, the instance is at 1.
@@ -368,10 +436,6 @@ class LiftoffCompiler {
     Register instance_reg = Register::from_code(instance_loc.AsRegister());
     DCHECK_EQ(kWasmInstanceRegister, instance_reg);
 
-    // Parameter 0 is the instance parameter.
-    uint32_t num_params =
-        static_cast<uint32_t>(decoder->sig_->parameter_count());
-
     if (FLAG_wasm_tier_up) {
       if (!kNoParamRegister.is_valid()) {
         unsupported(decoder, "Please define kNoParamRegister.");
@@ -385,6 +449,9 @@ class LiftoffCompiler {
       CollectReservedRegsForParameters(kInstanceParameterIndex + 1, num_params,
                                        param_regs);
       JumpToOptimizedCodeIfExisting(param_regs);
+      if (kTierUpPrologueIsSelfContained) {
+        tier_up_prologue_size_ = __ pc_offset();
+      }
     }
 
     __ EnterFrame(StackFrame::WASM_COMPILED);
@@ -420,11 +487,13 @@ class LiftoffCompiler {
           break;
         case kWasmF32:
         case kWasmF64:
+        case kWasmS128:
           if (zero_double_reg.is_gp()) {
             // Note: This might spill one of the registers used to hold
             // parameters.
             zero_double_reg = __ GetUnusedRegister(kFpReg);
-            // Zero is represented by the bit pattern 0 for both f32 and f64.
+            // Zero is represented by the bit pattern 0 for f32, f64 and s128.
+            // Loading the f64 zero clears the full register.
             __ LoadConstant(zero_double_reg, WasmValue(0.));
           }
           __ PushRegister(type, zero_double_reg);
@@ -438,13 +507,16 @@ class LiftoffCompiler {
     // The function-prologue stack check is associated with position 0, which
     // is never a position of any instruction in the function.
     StackCheck(0);
+    TierUpCheck(0);
 
     DCHECK_EQ(__ num_locals(), __ cache_state()->stack_height());
   }
 
   void GenerateOutOfLineCode(OutOfLineCode& ool) {
     __ bind(ool.label.get());
-    const bool is_stack_check = ool.builtin == Builtins::kWasmStackGuard;
+    // Stack checks and tier-up checks return to the code, traps do not.
+    const bool is_stack_check = ool.builtin == Builtins::kWasmStackGuard ||
+                                ool.builtin == Builtins::kWasmTierUp;
     const bool is_mem_out_of_bounds =
         ool.builtin == Builtins::kThrowWasmTrapMemOutOfBounds;
 
@@ -529,6 +601,7 @@ class LiftoffCompiler {
 
     // Execute a stack check in the loop header.
     StackCheck(decoder->position());
+    TierUpCheck(decoder->position());
   }
 
   void Try(Decoder* decoder, Control* block) { unsupported(decoder, "try"); }
@@ -1101,6 +1174,9 @@ class LiftoffCompiler {
     }
     if (!values.is_empty()) {
       if (values.size() > 1) return unsupported(decoder, "multi-return");
+      if (!CheckSupportedType(decoder, kTypes_ilfd, values[0].type, "return")) {
+        return;
+      }
       LiftoffRegister reg = __ PopToRegister();
       LiftoffRegister return_reg =
           kNeedI64RegPair && values[0].type == kWasmI64
@@ -1522,7 +1598,7 @@ class LiftoffCompiler {
                const MemoryAccessImmediate<validate>& imm,
                const Value& index_val, Value* result) {
     ValueType value_type = type.value_type();
-    if (!CheckSupportedType(decoder, kTypes_ilfd, value_type, "load")) return;
+    if (!CheckSupportedType(decoder, kTypes_ilfds, value_type, "load")) return;
     LiftoffRegList pinned;
     LiftoffRegister index = pinned.set(__ PopToRegister());
     if (BoundsCheckMem(decoder, type.size(), imm.offset, index.gp(), pinned)) {
@@ -1555,7 +1631,9 @@ class LiftoffCompiler {
                 const MemoryAccessImmediate<validate>& imm,
                 const Value& index_val, const Value& value_val) {
     ValueType value_type = type.value_type();
-    if (!CheckSupportedType(decoder, kTypes_ilfd, value_type, "store")) return;
+    if (!CheckSupportedType(decoder, kTypes_ilfds, value_type, "store")) {
+      return;
+    }
     LiftoffRegList pinned;
     LiftoffRegister value = pinned.set(__ PopToRegister());
     LiftoffRegister index = pinned.set(__ PopToRegister(pinned));
@@ -1672,6 +1750,7 @@ class LiftoffCompiler {
         !CheckSupportedType(decoder, kTypes_ilfd, imm.sig->GetReturn(0),
                             "return"))
       return;
+    if (!CheckSupportedParameters(decoder, imm.sig)) return;
 
     auto call_descriptor =
         compiler::GetWasmCallDescriptor(compilation_zone_, imm.sig);
@@ -1739,6 +1818,7 @@ class LiftoffCompiler {
                             "return")) {
       return;
     }
+    if (!CheckSupportedParameters(decoder, imm.sig)) return;
 
     // Pop the index.
     LiftoffRegister index = __ PopToRegister();
@@ -1854,17 +1934,180 @@ class LiftoffCompiler {
 
   void SimdOp(Decoder* decoder, WasmOpcode opcode, Vector<Value> args,
               Value* result) {
-    unsupported(decoder, "simd");
+    if (!kSupportsS128) return unsupported(decoder, "simd");
+    DCHECK(__ s128_enabled());
+#define CASE_SIMD_SPLAT(opcode, type, fn)                                    \
+  case WasmOpcode::kExpr##opcode:                                            \
+    return EmitUnOp<kWasm##type, kWasmS128>(                                 \
+        [=](LiftoffRegister dst, LiftoffRegister src) {                      \
+          __ emit_##fn(dst, src);                                            \
+        });
+#define CASE_SIMD_BINOP(opcode, fn)                                          \
+  case WasmOpcode::kExpr##opcode:                                            \
+    return EmitBinOp<kWasmS128, kWasmS128>(                                  \
+        [=](LiftoffRegister dst, LiftoffRegister lhs, LiftoffRegister rhs) { \
+          __ emit_##fn(dst, lhs, rhs);                                       \
+        });
+#define CASE_SIMD_SWAPPED_BINOP(opcode, fn)                                  \
+  case WasmOpcode::kExpr##opcode:                                            \
+    return EmitBinOp<kWasmS128, kWasmS128>(                                  \
+        [=](LiftoffRegister dst, LiftoffRegister lhs, LiftoffRegister rhs) { \
+          __ emit_##fn(dst, rhs, lhs);                                       \
+        });
+    switch (opcode) {
+      CASE_SIMD_SPLAT(I8x16Splat, I32, i8x16_splat)
+      CASE_SIMD_SPLAT(I16x8Splat, I32, i16x8_splat)
+      CASE_SIMD_SPLAT(I32x4Splat, I32, i32x4_splat)
+      CASE_SIMD_SPLAT(F32x4Splat, F32, f32x4_splat)
+      CASE_SIMD_BINOP(I8x16Add, i8x16_add)
+      CASE_SIMD_BINOP(I8x16Sub, i8x16_sub)
+      CASE_SIMD_BINOP(I16x8Add, i16x8_add)
+      CASE_SIMD_BINOP(I16x8Sub, i16x8_sub)
+      CASE_SIMD_BINOP(I32x4Add, i32x4_add)
+      CASE_SIMD_BINOP(I32x4Sub, i32x4_sub)
+      CASE_SIMD_BINOP(I32x4Mul, i32x4_mul)
+      CASE_SIMD_BINOP(F32x4Add, f32x4_add)
+      CASE_SIMD_BINOP(F32x4Sub, f32x4_sub)
+      CASE_SIMD_BINOP(F32x4Mul, f32x4_mul)
+      CASE_SIMD_BINOP(S128And, s128_and)
+      CASE_SIMD_BINOP(S128Or, s128_or)
+      CASE_SIMD_BINOP(S128Xor, s128_xor)
+      CASE_SIMD_BINOP(I8x16Eq, i8x16_eq)
+      CASE_SIMD_BINOP(I8x16Ne, i8x16_ne)
+      CASE_SIMD_BINOP(I8x16GtS, i8x16_gt_s)
+      CASE_SIMD_BINOP(I8x16GeS, i8x16_ge_s)
+      CASE_SIMD_BINOP(I8x16GtU, i8x16_gt_u)
+      CASE_SIMD_BINOP(I8x16GeU, i8x16_ge_u)
+      CASE_SIMD_SWAPPED_BINOP(I8x16LtS, i8x16_gt_s)
+      CASE_SIMD_SWAPPED_BINOP(I8x16LeS, i8x16_ge_s)
+      CASE_SIMD_SWAPPED_BINOP(I8x16LtU, i8x16_gt_u)
+      CASE_SIMD_SWAPPED_BINOP(I8x16LeU, i8x16_ge_u)
+      CASE_SIMD_BINOP(I16x8Eq, i16x8_eq)
+      CASE_SIMD_BINOP(I16x8Ne, i16x8_ne)
+      CASE_SIMD_BINOP(I16x8GtS, i16x8_gt_s)
+      CASE_SIMD_BINOP(I16x8GeS, i16x8_ge_s)
+      CASE_SIMD_BINOP(I16x8GtU, i16x8_gt_u)
+      CASE_SIMD_BINOP(I16x8GeU, i16x8_ge_u)
+      CASE_SIMD_SWAPPED_BINOP(I16x8LtS, i16x8_gt_s)
+      CASE_SIMD_SWAPPED_BINOP(I16x8LeS, i16x8_ge_s)
+      CASE_SIMD_SWAPPED_BINOP(I16x8LtU, i16x8_gt_u)
+      CASE_SIMD_SWAPPED_BINOP(I16x8LeU, i16x8_ge_u)
+      CASE_SIMD_BINOP(I32x4Eq, i32x4_eq)
+      CASE_SIMD_BINOP(I32x4Ne, i32x4_ne)
+      CASE_SIMD_BINOP(I32x4GtS, i32x4_gt_s)
+      CASE_SIMD_BINOP(I32x4GeS, i32x4_ge_s)
+      CASE_SIMD_BINOP(I32x4GtU, i32x4_gt_u)
+      CASE_SIMD_BINOP(I32x4GeU, i32x4_ge_u)
+      CASE_SIMD_SWAPPED_BINOP(I32x4LtS, i32x4_gt_s)
+      CASE_SIMD_SWAPPED_BINOP(I32x4LeS, i32x4_ge_s)
+      CASE_SIMD_SWAPPED_BINOP(I32x4LtU, i32x4_gt_u)
+      CASE_SIMD_SWAPPED_BINOP(I32x4LeU, i32x4_ge_u)
+      CASE_SIMD_BINOP(F32x4Eq, f32x4_eq)
+      CASE_SIMD_BINOP(F32x4Ne, f32x4_ne)
+      CASE_SIMD_BINOP(F32x4Lt, f32x4_lt)
+      CASE_SIMD_BINOP(F32x4Le, f32x4_le)
+      CASE_SIMD_SWAPPED_BINOP(F32x4Gt, f32x4_lt)
+      CASE_SIMD_SWAPPED_BINOP(F32x4Ge, f32x4_le)
+      case WasmOpcode::kExprS128Select: {
+        LiftoffRegList pinned;
+        LiftoffRegister if_false = pinned.set(__ PopToRegister());
+        LiftoffRegister if_true = pinned.set(__ PopToRegister(pinned));
+        LiftoffRegister mask = pinned.set(__ PopToRegister(pinned));
+        LiftoffRegister dst =
+            __ GetUnusedRegister(kFpReg, {mask, if_true, if_false});
+        __ emit_s128_select(dst, mask, if_true, if_false);
+        __ PushRegister(kWasmS128, dst);
+        return;
+      }
+      default:
+        return unsupported(decoder, WasmOpcodes::OpcodeName(opcode));
+    }
+#undef CASE_SIMD_SPLAT
+#undef CASE_SIMD_BINOP
+#undef CASE_SIMD_SWAPPED_BINOP
   }
+
+  void EmitReplaceLane(void (LiftoffAssembler::*emit_fn)(LiftoffRegister,
+                                                         LiftoffRegister,
+                                                         LiftoffRegister,
+                                                         uint8_t),
+                       uint8_t lane) {
+    LiftoffRegList pinned;
+    LiftoffRegister value = pinned.set(__ PopToRegister());
+    LiftoffRegister src = __ PopToRegister(pinned);
+    // {value} stays pinned, so {dst} only aliases it if {src} does as well.
+    LiftoffRegister dst = __ GetUnusedRegister(kFpReg, {src}, pinned);
+    (asm_->*emit_fn)(dst, src, value, lane);
+    __ PushRegister(kWasmS128, dst);
+  }
+
   void SimdLaneOp(Decoder* decoder, WasmOpcode opcode,
                   const SimdLaneImmediate<validate>& imm,
                   const Vector<Value> inputs, Value* result) {
-    unsupported(decoder, "simd");
+    if (!kSupportsS128) return unsupported(decoder, "simd");
+    DCHECK(__ s128_enabled());
+    uint8_t lane = imm.lane;
+    switch (opcode) {
+      case WasmOpcode::kExprI8x16ExtractLane:
+        return EmitUnOp<kWasmS128, kWasmI32>(
+            [=](LiftoffRegister dst, LiftoffRegister src) {
+              __ emit_i8x16_extract_lane(dst, src, lane);
+            });
+      case WasmOpcode::kExprI16x8ExtractLane:
+        return EmitUnOp<kWasmS128, kWasmI32>(
+            [=](LiftoffRegister dst, LiftoffRegister src) {
+              __ emit_i16x8_extract_lane(dst, src, lane);
+            });
+      case WasmOpcode::kExprI32x4ExtractLane:
+        return EmitUnOp<kWasmS128, kWasmI32>(
+            [=](LiftoffRegister dst, LiftoffRegister src) {
+              __ emit_i32x4_extract_lane(dst, src, lane);
+            });
+      case WasmOpcode::kExprF32x4ExtractLane:
+        return EmitUnOp<kWasmS128, kWasmF32>(
+            [=](LiftoffRegister dst, LiftoffRegister src) {
+              __ emit_f32x4_extract_lane(dst, src, lane);
+            });
+      case WasmOpcode::kExprI8x16ReplaceLane:
+        return EmitReplaceLane(&LiftoffAssembler::emit_i8x16_replace_lane,
+                               lane);
+      case WasmOpcode::kExprI16x8ReplaceLane:
+        return EmitReplaceLane(&LiftoffAssembler::emit_i16x8_replace_lane,
+                               lane);
+      case WasmOpcode::kExprI32x4ReplaceLane:
+        return EmitReplaceLane(&LiftoffAssembler::emit_i32x4_replace_lane,
+                               lane);
+      case WasmOpcode::kExprF32x4ReplaceLane:
+        return EmitReplaceLane(&LiftoffAssembler::emit_f32x4_replace_lane,
+                               lane);
+      default:
+        return unsupported(decoder, WasmOpcodes::OpcodeName(opcode));
+    }
   }
   void SimdShiftOp(Decoder* decoder, WasmOpcode opcode,
                    const SimdShiftImmediate<validate>& imm, const Value& input,
                    Value* result) {
-    unsupported(decoder, "simd");
+    if (!kSupportsS128) return unsupported(decoder, "simd");
+    DCHECK(__ s128_enabled());
+    uint8_t shift = imm.shift;
+#define CASE_SIMD_SHIFT(opcode, fn)                                          \
+  case WasmOpcode::kExpr##opcode:                                            \
+    return EmitUnOp<kWasmS128, kWasmS128>(                                   \
+        [=](LiftoffRegister dst, LiftoffRegister src) {                      \
+          __ emit_##fn(dst, src, shift);                                     \
+        });
+    switch (opcode) {
+      CASE_SIMD_SHIFT(I16x8Shl, i16x8_shl)
+      CASE_SIMD_SHIFT(I16x8ShrS, i16x8_shr_s)
+      CASE_SIMD_SHIFT(I16x8ShrU, i16x8_shr_u)
+      CASE_SIMD_SHIFT(I32x4Shl, i32x4_shl)
+      CASE_SIMD_SHIFT(I32x4ShrS, i32x4_shr_s)
+      CASE_SIMD_SHIFT(I32x4ShrU, i32x4_shr_u)
+      default:
+        // i8x16 shifts have no SSE equivalent.
+        return unsupported(decoder, WasmOpcodes::OpcodeName(opcode));
+    }
+#undef CASE_SIMD_SHIFT
   }
   void Simd8x16ShuffleOp(Decoder* decoder,
                          const Simd8x16ShuffleImmediate<validate>& imm,
@@ -1908,6 +2151,12 @@ class LiftoffCompiler {
   // The pc offset of the instructions to reserve the stack frame. Needed to
   // patch the actually needed stack size in the end.
   uint32_t pc_offset_stack_frame_construction_ = 0;
+  // The size of the tier-up prologue, or 0 if it cannot be separated from the
+  // rest of the code.
+  int tier_up_prologue_size_ = 0;
+
+  // The index of the compiled function within the module.
+  const uint32_t func_index_;
 
   // Points to the cell within the {code_table_} of the NativeModule,
   // which  corresponds to the currently compiled function
@@ -1935,6 +2184,24 @@ class LiftoffCompiler {
   }
 };
 
+// Whether the function can hold s128 values, i.e. whether it has s128 locals or
+// any simd instruction. Only such functions pay for 16-byte stack slots.
+// Invalid bodies are reported by the actual decoder, this scan just stops.
+bool UsesS128(Zone* zone, const FunctionBody& body) {
+  BodyLocalDecls decls(zone);
+  if (!DecodeLocalDecls(&decls, body.start, body.end)) return false;
+  for (ValueType type : decls.type_list) {
+    if (type == kWasmS128) return true;
+  }
+  Decoder decoder(body.start, body.end);
+  for (const byte* pc = body.start + decls.encoded_size;
+       pc < body.end && decoder.ok();
+       pc += WasmDecoder<Decoder::kValidate>::OpcodeLength(&decoder, pc)) {
+    if (*pc == kSimdPrefix) return true;
+  }
+  return false;
+}
+
 }  // namespace
 
 bool LiftoffCompilationUnit::ExecuteCompilation() {
@@ -1958,10 +2225,15 @@ bool LiftoffCompilationUnit::ExecuteCompilation() {
   DCHECK(!protected_instructions_);
   protected_instructions_.reset(
       new std::vector<trap_handler::ProtectedInstructionData>());
+  if (kSupportsS128 && FLAG_experimental_wasm_simd &&
+      UsesS128(&zone, wasm_unit_->func_body_)) {
+    asm_.EnableS128();
+  }
   wasm::WasmFullDecoder<wasm::Decoder::kValidate, wasm::LiftoffCompiler>
       decoder(&zone, module, wasm_unit_->func_body_, &asm_, call_descriptor,
               wasm_unit_->env_, &source_position_table_builder_,
               protected_instructions_.get(), &zone, &codegen_zone_,
+              static_cast<uint32_t>(wasm_unit_->func_index_),
               code_table_entry);
   decoder.Decode();
   liftoff_compile_time_scope.reset();
@@ -1993,6 +2265,7 @@ bool LiftoffCompilationUnit::ExecuteCompilation() {
       (codegen_zone_ ? codegen_zone_->allocation_size() : 0);
 
   safepoint_table_offset_ = decoder.interface().GetSafepointTableOffset();
+  tier_up_prologue_size_ = decoder.interface().GetTierUpPrologueSize();
   wasm_unit_->isolate_->counters()->liftoff_compiled_functions()->Increment();
   return true;
 }
@@ -2010,6 +2283,7 @@ wasm::WasmCode* LiftoffCompilationUnit::FinishCompilation(
       desc, asm_.GetTotalFrameSlotCount(), wasm_unit_->func_index_,
       safepoint_table_offset_, 0, std::move(protected_instructions_),
       source_positions, wasm::WasmCode::kLiftoff);
+  code->set_tier_up_prologue_size(static_cast<size_t>(tier_up_prologue_size_));
 
   return code;
 }
@@ -28,6 +28,7 @@ class LiftoffCompilationUnit final {
   WasmCompilationUnit* const wasm_unit_;
   wasm::LiftoffAssembler asm_;
   int safepoint_table_offset_;
+  int tier_up_prologue_size_ = 0;
   SourcePositionTableBuilder source_position_table_builder_;
   std::unique_ptr<std::vector<trap_handler::ProtectedInstructionData>>
       protected_instructions_;
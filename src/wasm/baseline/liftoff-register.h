@@ -18,6 +18,14 @@ namespace wasm {
 
 static constexpr bool kNeedI64RegPair = kPointerSize == 4;
 
+// Whether s128 values can be held in fp registers (and stack slots) on this
+// platform. Other platforms bail out to TurboFan for SIMD code.
+#if V8_TARGET_ARCH_X64 || V8_TARGET_ARCH_ARM64
+static constexpr bool kSupportsS128 = true;
+#else
+static constexpr bool kSupportsS128 = false;
+#endif
+
 enum RegClass : uint8_t {
   kGpReg,
   kFpReg,
@@ -38,7 +46,8 @@ static inline constexpr RegClass reg_class_for(ValueType type) {
              ? kGpRegPair
              : type == kWasmI32 || type == kWasmI64  // int types
                    ? kGpReg
-                   : type == kWasmF32 || type == kWasmF64  // float types
+                   : type == kWasmF32 || type == kWasmF64 ||  // float types
+                             (kSupportsS128 && type == kWasmS128)  // simd
                          ? kFpReg
                          : kNoReg;  // other (unsupported) types
 }
@@ -24,14 +24,12 @@ namespace wasm {
 namespace liftoff {
 
 // rbp-8 holds the stack marker, rbp-16 is the instance parameter, first stack
-// slot is located at rbp-24.
+// slot is located at rbp-24 (rbp-32 with 16-byte slots).
 constexpr int32_t kConstantStackSpace = 16;
-constexpr int32_t kFirstStackSlotOffset =
-    kConstantStackSpace + LiftoffAssembler::kStackSlotSize;
 
-inline Operand GetStackSlot(uint32_t index) {
-  int32_t offset = index * LiftoffAssembler::kStackSlotSize;
-  return Operand(rbp, -kFirstStackSlotOffset - offset);
+inline Operand GetStackSlot(const LiftoffAssembler* assm, uint32_t index) {
+  int32_t offset = kConstantStackSpace + (index + 1) * assm->stack_slot_size();
+  return Operand(rbp, -offset);
 }
 
 // TODO(clemensh): Make this a constexpr variable once Operand is constexpr.
@@ -62,6 +60,9 @@ inline void Load(LiftoffAssembler* assm, LiftoffRegister dst, Operand src,
     case kWasmF64:
       assm->Movsd(dst.fp(), src);
       break;
+    case kWasmS128:
+      assm->Movups(dst.fp(), src);
+      break;
     default:
       UNREACHABLE();
   }
@@ -82,6 +83,9 @@ inline void Store(LiftoffAssembler* assm, Operand dst, LiftoffRegister src,
     case kWasmF64:
       assm->Movsd(dst, src.fp());
       break;
+    case kWasmS128:
+      assm->Movups(dst, src.fp());
+      break;
     default:
       UNREACHABLE();
   }
@@ -231,6 +235,9 @@ void LiftoffAssembler::Load(LiftoffRegister dst, Register src_addr,
     case LoadType::kF64Load:
       Movsd(dst.fp(), src_op);
       break;
+    case LoadType::kS128Load:
+      Movups(dst.fp(), src_op);
+      break;
     default:
       UNREACHABLE();
   }
@@ -268,6 +275,9 @@ void LiftoffAssembler::Store(Register dst_addr, Register offset_reg,
     case StoreType::kF64Store:
       Movsd(dst_op, src.fp());
       break;
+    case StoreType::kS128Store:
+      Movups(dst_op, src.fp());
+      break;
     default:
       UNREACHABLE();
   }
@@ -294,13 +304,18 @@ void LiftoffAssembler::LoadCallerFrameSlot(LiftoffRegister dst,
 void LiftoffAssembler::MoveStackValue(uint32_t dst_index, uint32_t src_index,
                                       ValueType type) {
   DCHECK_NE(dst_index, src_index);
+  if (type == kWasmS128) {
+    Movups(kScratchDoubleReg, liftoff::GetStackSlot(this, src_index));
+    Movups(liftoff::GetStackSlot(this, dst_index), kScratchDoubleReg);
+    return;
+  }
   if (cache_state_.has_unused_register(kGpReg)) {
     LiftoffRegister reg = GetUnusedRegister(kGpReg);
     Fill(reg, src_index, type);
     Spill(dst_index, reg, type);
   } else {
-    pushq(liftoff::GetStackSlot(src_index));
-    popq(liftoff::GetStackSlot(dst_index));
+    pushq(liftoff::GetStackSlot(this, src_index));
+    popq(liftoff::GetStackSlot(this, dst_index));
   }
 }
 
@@ -319,16 +334,18 @@ void LiftoffAssembler::Move(DoubleRegister dst, DoubleRegister src,
   DCHECK_NE(dst, src);
   if (type == kWasmF32) {
     Movss(dst, src);
-  } else {
-    DCHECK_EQ(kWasmF64, type);
+  } else if (type == kWasmF64) {
     Movsd(dst, src);
+  } else {
+    DCHECK_EQ(kWasmS128, type);
+    Movaps(dst, src);
   }
 }
 
 void LiftoffAssembler::Spill(uint32_t index, LiftoffRegister reg,
                              ValueType type) {
   RecordUsedSpillSlot(index);
-  Operand dst = liftoff::GetStackSlot(index);
+  Operand dst = liftoff::GetStackSlot(this, index);
   switch (type) {
     case kWasmI32:
       movl(dst, reg.gp());
@@ -342,6 +359,9 @@ void LiftoffAssembler::Spill(uint32_t index, LiftoffRegister reg,
     case kWasmF64:
       Movsd(dst, reg.fp());
       break;
+    case kWasmS128:
+      Movups(dst, reg.fp());
+      break;
     default:
       UNREACHABLE();
   }
@@ -349,7 +369,7 @@ void LiftoffAssembler::Spill(uint32_t index, LiftoffRegister reg,
 
 void LiftoffAssembler::Spill(uint32_t index, WasmValue value) {
   RecordUsedSpillSlot(index);
-  Operand dst = liftoff::GetStackSlot(index);
+  Operand dst = liftoff::GetStackSlot(this, index);
   switch (value.type()) {
     case kWasmI32:
       movl(dst, Immediate(value.to_i32()));
@@ -376,7 +396,7 @@ void LiftoffAssembler::Spill(uint32_t index, WasmValue value) {
 
 void LiftoffAssembler::Fill(LiftoffRegister reg, uint32_t index,
                             ValueType type) {
-  Operand src = liftoff::GetStackSlot(index);
+  Operand src = liftoff::GetStackSlot(this, index);
   switch (type) {
     case kWasmI32:
       movl(reg.gp(), src);
@@ -390,6 +410,9 @@ void LiftoffAssembler::Fill(LiftoffRegister reg, uint32_t index,
     case kWasmF64:
       Movsd(reg.fp(), src);
       break;
+    case kWasmS128:
+      Movups(reg.fp(), src);
+      break;
     default:
       UNREACHABLE();
   }
@@ -1306,6 +1329,417 @@ void LiftoffAssembler::emit_f64_set_cond(Condition cond, Register dst,
                                                       rhs);
 }
 
+void LiftoffAssembler::emit_i8x16_splat(LiftoffRegister dst,
+                                        LiftoffRegister src) {
+  REQUIRE_CPU_FEATURE(SSSE3);
+  movd(dst.fp(), src.gp());
+  xorps(kScratchDoubleReg, kScratchDoubleReg);
+  pshufb(dst.fp(), kScratchDoubleReg);
+}
+
+void LiftoffAssembler::emit_i16x8_splat(LiftoffRegister dst,
+                                        LiftoffRegister src) {
+  movd(dst.fp(), src.gp());
+  pshuflw(dst.fp(), dst.fp(), 0);
+  pshufd(dst.fp(), dst.fp(), 0);
+}
+
+void LiftoffAssembler::emit_i32x4_splat(LiftoffRegister dst,
+                                        LiftoffRegister src) {
+  movd(dst.fp(), src.gp());
+  pshufd(dst.fp(), dst.fp(), 0);
+}
+
+void LiftoffAssembler::emit_f32x4_splat(LiftoffRegister dst,
+                                        LiftoffRegister src) {
+  if (dst != src) movaps(dst.fp(), src.fp());
+  shufps(dst.fp(), dst.fp(), 0);
+}
+
+void LiftoffAssembler::emit_i8x16_extract_lane(LiftoffRegister dst,
+                                               LiftoffRegister src,
+                                               uint8_t lane) {
+  DCHECK_GT(16, lane);
+  REQUIRE_CPU_FEATURE(SSE4_1);
+  pextrb(dst.gp(), src.fp(), lane);
+  movsxbl(dst.gp(), dst.gp());
+}
+
+void LiftoffAssembler::emit_i16x8_extract_lane(LiftoffRegister dst,
+                                               LiftoffRegister src,
+                                               uint8_t lane) {
+  DCHECK_GT(8, lane);
+  REQUIRE_CPU_FEATURE(SSE4_1);
+  pextrw(dst.gp(), src.fp(), lane);
+  movsxwl(dst.gp(), dst.gp());
+}
+
+void LiftoffAssembler::emit_i32x4_extract_lane(LiftoffRegister dst,
+                                               LiftoffRegister src,
+                                               uint8_t lane) {
+  DCHECK_GT(4, lane);
+  pshufd(kScratchDoubleReg, src.fp(), lane);
+  movd(dst.gp(), kScratchDoubleReg);
+}
+
+void LiftoffAssembler::emit_f32x4_extract_lane(LiftoffRegister dst,
+                                               LiftoffRegister src,
+                                               uint8_t lane) {
+  DCHECK_GT(4, lane);
+  // Only the lowest lane of {dst} is observable as an f32 value.
+  pshufd(dst.fp(), src.fp(), lane);
+}
+
+void LiftoffAssembler::emit_i8x16_replace_lane(LiftoffRegister dst,
+                                               LiftoffRegister src,
+                                               LiftoffRegister value,
+                                               uint8_t lane) {
+  DCHECK_GT(16, lane);
+  REQUIRE_CPU_FEATURE(SSE4_1);
+  if (dst != src) movaps(dst.fp(), src.fp());
+  pinsrb(dst.fp(), value.gp(), lane);
+}
+
+void LiftoffAssembler::emit_i16x8_replace_lane(LiftoffRegister dst,
+                                               LiftoffRegister src,
+                                               LiftoffRegister value,
+                                               uint8_t lane) {
+  DCHECK_GT(8, lane);
+  if (dst != src) movaps(dst.fp(), src.fp());
+  pinsrw(dst.fp(), value.gp(), lane);
+}
+
+void LiftoffAssembler::emit_i32x4_replace_lane(LiftoffRegister dst,
+                                               LiftoffRegister src,
+                                               LiftoffRegister value,
+                                               uint8_t lane) {
+  DCHECK_GT(4, lane);
+  REQUIRE_CPU_FEATURE(SSE4_1);
+  if (dst != src) movaps(dst.fp(), src.fp());
+  pinsrd(dst.fp(), value.gp(), lane);
+}
+
+void LiftoffAssembler::emit_f32x4_replace_lane(LiftoffRegister dst,
+                                               LiftoffRegister src,
+                                               LiftoffRegister value,
+                                               uint8_t lane) {
+  DCHECK_GT(4, lane);
+  REQUIRE_CPU_FEATURE(SSE4_1);
+  if (dst != src) movaps(dst.fp(), src.fp());
+  insertps(dst.fp(), value.fp(), lane << 4);
+}
+
+namespace liftoff {
+template <void (Assembler::*op)(XMMRegister, XMMRegister)>
+void EmitSimdCommutativeBinOp(LiftoffAssembler* assm, LiftoffRegister dst,
+                              LiftoffRegister lhs, LiftoffRegister rhs) {
+  if (dst == rhs) {
+    (assm->*op)(dst.fp(), lhs.fp());
+  } else {
+    if (dst != lhs) assm->movaps(dst.fp(), lhs.fp());
+    (assm->*op)(dst.fp(), rhs.fp());
+  }
+}
+
+template <void (Assembler::*op)(XMMRegister, XMMRegister)>
+void EmitSimdSubOp(LiftoffAssembler* assm, LiftoffRegister dst,
+                   LiftoffRegister lhs, LiftoffRegister rhs) {
+  if (dst == rhs) {
+    assm->movaps(kScratchDoubleReg, rhs.fp());
+    assm->movaps(dst.fp(), lhs.fp());
+    (assm->*op)(dst.fp(), kScratchDoubleReg);
+  } else {
+    if (dst != lhs) assm->movaps(dst.fp(), lhs.fp());
+    (assm->*op)(dst.fp(), rhs.fp());
+  }
+}
+}  // namespace liftoff
+
+void LiftoffAssembler::emit_i8x16_add(LiftoffRegister dst, LiftoffRegister lhs,
+                                      LiftoffRegister rhs) {
+  liftoff::EmitSimdCommutativeBinOp<&Assembler::paddb>(this, dst, lhs, rhs);
+}
+
+void LiftoffAssembler::emit_i8x16_sub(LiftoffRegister dst, LiftoffRegister lhs,
+                                      LiftoffRegister rhs) {
+  liftoff::EmitSimdSubOp<&Assembler::psubb>(this, dst, lhs, rhs);
+}
+
+void LiftoffAssembler::emit_i16x8_add(LiftoffRegister dst, LiftoffRegister lhs,
+                                      LiftoffRegister rhs) {
+  liftoff::EmitSimdCommutativeBinOp<&Assembler::paddw>(this, dst, lhs, rhs);
+}
+
+void LiftoffAssembler::emit_i16x8_sub(LiftoffRegister dst, LiftoffRegister lhs,
+                                      LiftoffRegister rhs) {
+  liftoff::EmitSimdSubOp<&Assembler::psubw>(this, dst, lhs, rhs);
+}
+
+void LiftoffAssembler::emit_i32x4_add(LiftoffRegister dst, LiftoffRegister lhs,
+                                      LiftoffRegister rhs) {
+  liftoff::EmitSimdCommutativeBinOp<&Assembler::paddd>(this, dst, lhs, rhs);
+}
+
+void LiftoffAssembler::emit_i32x4_sub(LiftoffRegister dst, LiftoffRegister lhs,
+                                      LiftoffRegister rhs) {
+  liftoff::EmitSimdSubOp<&Assembler::psubd>(this, dst, lhs, rhs);
+}
+
+void LiftoffAssembler::emit_i32x4_mul(LiftoffRegister dst, LiftoffRegister lhs,
+                                      LiftoffRegister rhs) {
+  REQUIRE_CPU_FEATURE(SSE4_1);
+  liftoff::EmitSimdCommutativeBinOp<&Assembler::pmulld>(this, dst, lhs, rhs);
+}
+
+void LiftoffAssembler::emit_f32x4_add(LiftoffRegister dst, LiftoffRegister lhs,
+                                      LiftoffRegister rhs) {
+  liftoff::EmitSimdCommutativeBinOp<&Assembler::addps>(this, dst, lhs, rhs);
+}
+
+void LiftoffAssembler::emit_f32x4_sub(LiftoffRegister dst, LiftoffRegister lhs,
+                                      LiftoffRegister rhs) {
+  liftoff::EmitSimdSubOp<&Assembler::subps>(this, dst, lhs, rhs);
+}
+
+void LiftoffAssembler::emit_f32x4_mul(LiftoffRegister dst, LiftoffRegister lhs,
+                                      LiftoffRegister rhs) {
+  liftoff::EmitSimdCommutativeBinOp<&Assembler::mulps>(this, dst, lhs, rhs);
+}
+
+void LiftoffAssembler::emit_s128_and(LiftoffRegister dst, LiftoffRegister lhs,
+                                     LiftoffRegister rhs) {
+  liftoff::EmitSimdCommutativeBinOp<&Assembler::pand>(this, dst, lhs, rhs);
+}
+
+void LiftoffAssembler::emit_s128_or(LiftoffRegister dst, LiftoffRegister lhs,
+                                    LiftoffRegister rhs) {
+  liftoff::EmitSimdCommutativeBinOp<&Assembler::por>(this, dst, lhs, rhs);
+}
+
+void LiftoffAssembler::emit_s128_xor(LiftoffRegister dst, LiftoffRegister lhs,
+                                     LiftoffRegister rhs) {
+  liftoff::EmitSimdCommutativeBinOp<&Assembler::pxor>(this, dst, lhs, rhs);
+}
+
+namespace liftoff {
+// Sets all bits of {dst} to the inverse of their current value.
+inline void EmitSimdNot(LiftoffAssembler* assm, LiftoffRegister dst) {
+  assm->pcmpeqd(kScratchDoubleReg, kScratchDoubleReg);
+  assm->pxor(dst.fp(), kScratchDoubleReg);
+}
+
+// Computes {lhs >= rhs} as {min(lhs, rhs) == rhs}.
+template <void (Assembler::*min)(XMMRegister, XMMRegister),
+          void (Assembler::*eq)(XMMRegister, XMMRegister)>
+void EmitSimdGeOp(LiftoffAssembler* assm, LiftoffRegister dst,
+                  LiftoffRegister lhs, LiftoffRegister rhs) {
+  if (dst == rhs) {
+    assm->movaps(kScratchDoubleReg, lhs.fp());
+    (assm->*min)(kScratchDoubleReg, rhs.fp());
+    (assm->*eq)(dst.fp(), kScratchDoubleReg);
+  } else {
+    if (dst != lhs) assm->movaps(dst.fp(), lhs.fp());
+    (assm->*min)(dst.fp(), rhs.fp());
+    (assm->*eq)(dst.fp(), rhs.fp());
+  }
+}
+
+template <void (Assembler::*op)(XMMRegister, byte)>
+void EmitSimdShiftOp(LiftoffAssembler* assm, LiftoffRegister dst,
+                     LiftoffRegister src, uint8_t shift) {
+  if (dst != src) assm->movaps(dst.fp(), src.fp());
+  (assm->*op)(dst.fp(), shift);
+}
+}  // namespace liftoff
+
+void LiftoffAssembler::emit_i8x16_eq(LiftoffRegister dst, LiftoffRegister lhs,
+                                     LiftoffRegister rhs) {
+  liftoff::EmitSimdCommutativeBinOp<&Assembler::pcmpeqb>(this, dst, lhs, rhs);
+}
+
+void LiftoffAssembler::emit_i8x16_ne(LiftoffRegister dst, LiftoffRegister lhs,
+                                     LiftoffRegister rhs) {
+  liftoff::EmitSimdCommutativeBinOp<&Assembler::pcmpeqb>(this, dst, lhs, rhs);
+  liftoff::EmitSimdNot(this, dst);
+}
+
+void LiftoffAssembler::emit_i8x16_gt_s(LiftoffRegister dst,
+                                       LiftoffRegister lhs,
+                                       LiftoffRegister rhs) {
+  liftoff::EmitSimdSubOp<&Assembler::pcmpgtb>(this, dst, lhs, rhs);
+}
+
+void LiftoffAssembler::emit_i8x16_ge_s(LiftoffRegister dst,
+                                       LiftoffRegister lhs,
+                                       LiftoffRegister rhs) {
+  REQUIRE_CPU_FEATURE(SSE4_1);
+  liftoff::EmitSimdGeOp<&Assembler::pminsb, &Assembler::pcmpeqb>(this, dst,
+                                                                  lhs, rhs);
+}
+
+void LiftoffAssembler::emit_i8x16_gt_u(LiftoffRegister dst,
+                                       LiftoffRegister lhs,
+                                       LiftoffRegister rhs) {
+  // {lhs > rhs} is {!(rhs >= lhs)}.
+  liftoff::EmitSimdGeOp<&Assembler::pminub, &Assembler::pcmpeqb>(this, dst,
+                                                                  rhs, lhs);
+  liftoff::EmitSimdNot(this, dst);
+}
+
+void LiftoffAssembler::emit_i8x16_ge_u(LiftoffRegister dst,
+                                       LiftoffRegister lhs,
+                                       LiftoffRegister rhs) {
+  liftoff::EmitSimdGeOp<&Assembler::pminub, &Assembler::pcmpeqb>(this, dst,
+                                                                  lhs, rhs);
+}
+
+void LiftoffAssembler::emit_i16x8_eq(LiftoffRegister dst, LiftoffRegister lhs,
+                                     LiftoffRegister rhs) {
+  liftoff::EmitSimdCommutativeBinOp<&Assembler::pcmpeqw>(this, dst, lhs, rhs);
+}
+
+void LiftoffAssembler::emit_i16x8_ne(LiftoffRegister dst, LiftoffRegister lhs,
+                                     LiftoffRegister rhs) {
+  liftoff::EmitSimdCommutativeBinOp<&Assembler::pcmpeqw>(this, dst, lhs, rhs);
+  liftoff::EmitSimdNot(this, dst);
+}
+
+void LiftoffAssembler::emit_i16x8_gt_s(LiftoffRegister dst,
+                                       LiftoffRegister lhs,
+                                       LiftoffRegister rhs) {
+  liftoff::EmitSimdSubOp<&Assembler::pcmpgtw>(this, dst, lhs, rhs);
+}
+
+void LiftoffAssembler::emit_i16x8_ge_s(LiftoffRegister dst,
+                                       LiftoffRegister lhs,
+                                       LiftoffRegister rhs) {
+  liftoff::EmitSimdGeOp<&Assembler::pminsw, &Assembler::pcmpeqw>(this, dst,
+                                                                  lhs, rhs);
+}
+
+void LiftoffAssembler::emit_i16x8_gt_u(LiftoffRegister dst,
+                                       LiftoffRegister lhs,
+                                       LiftoffRegister rhs) {
+  REQUIRE_CPU_FEATURE(SSE4_1);
+  liftoff::EmitSimdGeOp<&Assembler::pminuw, &Assembler::pcmpeqw>(this, dst,
+                                                                  rhs, lhs);
+  liftoff::EmitSimdNot(this, dst);
+}
+
+void LiftoffAssembler::emit_i16x8_ge_u(LiftoffRegister dst,
+                                       LiftoffRegister lhs,
+                                       LiftoffRegister rhs) {
+  REQUIRE_CPU_FEATURE(SSE4_1);
+  liftoff::EmitSimdGeOp<&Assembler::pminuw, &Assembler::pcmpeqw>(this, dst,
+                                                                  lhs, rhs);
+}
+
+void LiftoffAssembler::emit_i32x4_eq(LiftoffRegister dst, LiftoffRegister lhs,
+                                     LiftoffRegister rhs) {
+  liftoff::EmitSimdCommutativeBinOp<&Assembler::pcmpeqd>(this, dst, lhs, rhs);
+}
+
+void LiftoffAssembler::emit_i32x4_ne(LiftoffRegister dst, LiftoffRegister lhs,
+                                     LiftoffRegister rhs) {
+  liftoff::EmitSimdCommutativeBinOp<&Assembler::pcmpeqd>(this, dst, lhs, rhs);
+  liftoff::EmitSimdNot(this, dst);
+}
+
+void LiftoffAssembler::emit_i32x4_gt_s(LiftoffRegister dst,
+                                       LiftoffRegister lhs,
+                                       LiftoffRegister rhs) {
+  liftoff::EmitSimdSubOp<&Assembler::pcmpgtd>(this, dst, lhs, rhs);
+}
+
+void LiftoffAssembler::emit_i32x4_ge_s(LiftoffRegister dst,
+                                       LiftoffRegister lhs,
+                                       LiftoffRegister rhs) {
+  REQUIRE_CPU_FEATURE(SSE4_1);
+  liftoff::EmitSimdGeOp<&Assembler::pminsd, &Assembler::pcmpeqd>(this, dst,
+                                                                  lhs, rhs);
+}
+
+void LiftoffAssembler::emit_i32x4_gt_u(LiftoffRegister dst,
+                                       LiftoffRegister lhs,
+                                       LiftoffRegister rhs) {
+  REQUIRE_CPU_FEATURE(SSE4_1);
+  liftoff::EmitSimdGeOp<&Assembler::pminud, &Assembler::pcmpeqd>(this, dst,
+                                                                  rhs, lhs);
+  liftoff::EmitSimdNot(this, dst);
+}
+
+void LiftoffAssembler::emit_i32x4_ge_u(LiftoffRegister dst,
+                                       LiftoffRegister lhs,
+                                       LiftoffRegister rhs) {
+  REQUIRE_CPU_FEATURE(SSE4_1);
+  liftoff::EmitSimdGeOp<&Assembler::pminud, &Assembler::pcmpeqd>(this, dst,
+                                                                  lhs, rhs);
+}
+
+void LiftoffAssembler::emit_f32x4_eq(LiftoffRegister dst, LiftoffRegister lhs,
+                                     LiftoffRegister rhs) {
+  liftoff::EmitSimdCommutativeBinOp<&Assembler::cmpeqps>(this, dst, lhs, rhs);
+}
+
+void LiftoffAssembler::emit_f32x4_ne(LiftoffRegister dst, LiftoffRegister lhs,
+                                     LiftoffRegister rhs) {
+  liftoff::EmitSimdCommutativeBinOp<&Assembler::cmpneqps>(this, dst, lhs,
+                                                          rhs);
+}
+
+void LiftoffAssembler::emit_f32x4_lt(LiftoffRegister dst, LiftoffRegister lhs,
+                                     LiftoffRegister rhs) {
+  liftoff::EmitSimdSubOp<&Assembler::cmpltps>(this, dst, lhs, rhs);
+}
+
+void LiftoffAssembler::emit_f32x4_le(LiftoffRegister dst, LiftoffRegister lhs,
+                                     LiftoffRegister rhs) {
+  liftoff::EmitSimdSubOp<&Assembler::cmpleps>(this, dst, lhs, rhs);
+}
+
+void LiftoffAssembler::emit_i16x8_shl(LiftoffRegister dst, LiftoffRegister src,
+                                      uint8_t shift) {
+  liftoff::EmitSimdShiftOp<&Assembler::psllw>(this, dst, src, shift);
+}
+
+void LiftoffAssembler::emit_i16x8_shr_s(LiftoffRegister dst,
+                                        LiftoffRegister src, uint8_t shift) {
+  liftoff::EmitSimdShiftOp<&Assembler::psraw>(this, dst, src, shift);
+}
+
+void LiftoffAssembler::emit_i16x8_shr_u(LiftoffRegister dst,
+                                        LiftoffRegister src, uint8_t shift) {
+  liftoff::EmitSimdShiftOp<&Assembler::psrlw>(this, dst, src, shift);
+}
+
+void LiftoffAssembler::emit_i32x4_shl(LiftoffRegister dst, LiftoffRegister src,
+                                      uint8_t shift) {
+  liftoff::EmitSimdShiftOp<&Assembler::pslld>(this, dst, src, shift);
+}
+
+void LiftoffAssembler::emit_i32x4_shr_s(LiftoffRegister dst,
+                                        LiftoffRegister src, uint8_t shift) {
+  liftoff::EmitSimdShiftOp<&Assembler::psrad>(this, dst, src, shift);
+}
+
+void LiftoffAssembler::emit_i32x4_shr_u(LiftoffRegister dst,
+                                        LiftoffRegister src, uint8_t shift) {
+  liftoff::EmitSimdShiftOp<&Assembler::psrld>(this, dst, src, shift);
+}
+
+void LiftoffAssembler::emit_s128_select(LiftoffRegister dst,
+                                        LiftoffRegister mask,
+                                        LiftoffRegister if_true,
+                                        LiftoffRegister if_false) {
+  // dst = if_false ^ ((if_true ^ if_false) & mask). All inputs except
+  // {if_false} are read before {dst} is written.
+  movaps(kScratchDoubleReg, if_true.fp());
+  xorps(kScratchDoubleReg, if_false.fp());
+  andps(kScratchDoubleReg, mask.fp());
+  if (dst != if_false) movaps(dst.fp(), if_false.fp());
+  xorps(dst.fp(), kScratchDoubleReg);
+}
+
 void LiftoffAssembler::StackCheck(Label* ool_code) {
   Operand stack_limit = ExternalOperand(
       ExternalReference::address_of_stack_limit(isolate()), kScratchRegister);
@@ -1332,26 +1766,37 @@ void LiftoffAssembler::PushRegisters(LiftoffRegList regs) {
   LiftoffRegList fp_regs = regs & kFpCacheRegList;
   unsigned num_fp_regs = fp_regs.GetNumRegsSet();
   if (num_fp_regs) {
-    subp(rsp, Immediate(num_fp_regs * kStackSlotSize));
+    // Only functions which hold s128 values need the full registers saved.
+    unsigned reg_size = s128_enabled() ? kSimd128Size : sizeof(double);
+    subp(rsp, Immediate(num_fp_regs * reg_size));
     unsigned offset = 0;
     while (!fp_regs.is_empty()) {
       LiftoffRegister reg = fp_regs.GetFirstRegSet();
-      Movsd(Operand(rsp, offset), reg.fp());
+      if (s128_enabled()) {
+        Movups(Operand(rsp, offset), reg.fp());
+      } else {
+        Movsd(Operand(rsp, offset), reg.fp());
+      }
       fp_regs.clear(reg);
-      offset += sizeof(double);
+      offset += reg_size;
     }
-    DCHECK_EQ(offset, num_fp_regs * sizeof(double));
+    DCHECK_EQ(offset, num_fp_regs * reg_size);
   }
 }
 
 void LiftoffAssembler::PopRegisters(LiftoffRegList regs) {
   LiftoffRegList fp_regs = regs & kFpCacheRegList;
+  unsigned reg_size = s128_enabled() ? kSimd128Size : sizeof(double);
   unsigned fp_offset = 0;
   while (!fp_regs.is_empty()) {
     LiftoffRegister reg = fp_regs.GetFirstRegSet();
-    Movsd(reg.fp(), Operand(rsp, fp_offset));
+    if (s128_enabled()) {
+      Movups(reg.fp(), Operand(rsp, fp_offset));
+    } else {
+      Movsd(reg.fp(), Operand(rsp, fp_offset));
+    }
     fp_regs.clear(reg);
-    fp_offset += sizeof(double);
+    fp_offset += reg_size;
   }
   if (fp_offset) addp(rsp, Immediate(fp_offset));
   LiftoffRegList gp_regs = regs & kGpCacheRegList;
@@ -1453,7 +1898,7 @@ void LiftoffStackSlots::Construct() {
     const LiftoffAssembler::VarState& src = slot.src_;
     switch (src.loc()) {
       case LiftoffAssembler::VarState::kStack:
-        asm_->pushq(liftoff::GetStackSlot(slot.src_index_));
+        asm_->pushq(liftoff::GetStackSlot(asm_, slot.src_index_));
         break;
       case LiftoffAssembler::VarState::kRegister:
         liftoff::push(asm_, src.reg(), src.type());
@@ -77,6 +77,9 @@ void WasmCompilationUnit::ExecuteCompilation() {
   switch (mode_) {
     case WasmCompilationUnit::CompilationMode::kLiftoff:
       if (liftoff_unit_->ExecuteCompilation()) break;
+      if (FLAG_liftoff_no_fallback) {
+        FATAL("liftoff could not compile wasm function #%d", func_index_);
+      }
       // Otherwise, fall back to turbofan.
       SwitchMode(CompilationMode::kTurbofan);
       V8_FALLTHROUGH;
@@ -8,6 +8,8 @@
 #include "src/asmjs/asm-js.h"
 #include "src/assembler-inl.h"
 #include "src/base/optional.h"
+#include "src/base/platform/condition-variable.h"
+#include "src/base/platform/mutex.h"
 #include "src/base/template-utils.h"
 #include "src/base/utils/random-number-generator.h"
 #include "src/compiler/wasm-compiler.h"
@@ -16,6 +18,7 @@
 #include "src/property-descriptor.h"
 #include "src/trap-handler/trap-handler.h"
 #include "src/wasm/module-decoder.h"
+#include "src/wasm/shared-module-cache.h"
 #include "src/wasm/streaming-decoder.h"
 #include "src/wasm/wasm-code-manager.h"
 #include "src/wasm/wasm-code-specialization.h"
@@ -24,6 +27,7 @@
 #include "src/wasm/wasm-memory.h"
 #include "src/wasm/wasm-objects-inl.h"
 #include "src/wasm/wasm-result.h"
+#include "src/wasm/wasm-serialization.h"
 
 #define TRACE(...)                                      \
   do {                                                  \
@@ -106,6 +110,18 @@ class CompilationState {
 
   Isolate* isolate() const { return isolate_; }
 
+  // Task managers and runner for the tier-up of single hot functions (see
+  // --wasm-dynamic-tiering), which happens after compilation has finished.
+  CancelableTaskManager* tier_up_task_manager() {
+    return &tier_up_task_manager_;
+  }
+  CancelableTaskManager* foreground_task_manager() {
+    return &foreground_task_manager_;
+  }
+  const std::shared_ptr<v8::TaskRunner>& foreground_task_runner() const {
+    return foreground_task_runner_;
+  }
+
   bool failed() const {
     base::LockGuard<base::Mutex> guard(&mutex_);
     return failed_;
@@ -180,6 +196,7 @@ class CompilationState {
   // the CompilationState in order to cleanly clean up.
   CancelableTaskManager background_task_manager_;
   CancelableTaskManager foreground_task_manager_;
+  CancelableTaskManager tier_up_task_manager_;
   std::shared_ptr<v8::TaskRunner> foreground_task_runner_;
 
   const size_t max_background_tasks_ = 0;
@@ -502,6 +519,19 @@ const wasm::WasmCode* LazyCompileFunction(
     return existing_code;
   }
 
+  if (wasm::WasmCode* code = DeserializeFunctionLazily(
+          isolate, native_module, static_cast<uint32_t>(func_index))) {
+    TRACE_LAZY("Deserialized function %d.\n", func_index);
+    if (wasm::WasmCode::ShouldBeLogged(isolate)) code->LogCode(isolate);
+    CodeSpecialization code_specialization;
+    code_specialization.RelocateDirectCalls(native_module);
+    code_specialization.ApplyToWasmCode(code, SKIP_ICACHE_FLUSH);
+    Assembler::FlushICache(code->instructions().start(),
+                           code->instructions().size());
+    if (trap_handler::IsTrapHandlerEnabled()) code->RegisterTrapHandlerData();
+    return code;
+  }
+
   compilation_timer.Start();
   // TODO(wasm): Refactor this to only get the name if it is really needed for
   // tracing / debugging.
@@ -572,6 +602,148 @@ const wasm::WasmCode* LazyCompileFunction(
 
 namespace {
 
+// A single hot function to compile with TurboFan (see --wasm-dynamic-tiering).
+// It owns a copy of the function body, because the wire bytes on the heap may
+// move while the function is compiled in the background.
+struct TierUpUnit {
+  int func_index;
+  std::unique_ptr<byte[]> body_copy;
+  std::string name;
+  // Keeps the counters alive for the background compilation.
+  std::shared_ptr<Counters> counters;
+  std::unique_ptr<WasmCompilationUnit> unit;
+};
+
+// Installs the TurboFan code of a tiered-up function in the foreground.
+class TierUpFinishTask : public CancelableTask {
+ public:
+  TierUpFinishTask(CompilationState* compilation_state,
+                   std::unique_ptr<TierUpUnit> unit)
+      : CancelableTask(compilation_state->foreground_task_manager()),
+        compilation_state_(compilation_state),
+        unit_(std::move(unit)) {}
+
+  void RunInternal() override {
+    Isolate* isolate = compilation_state_->isolate();
+    HandleScope scope(isolate);
+    SaveContext saved_context(isolate);
+    isolate->set_context(nullptr);
+
+    TRACE_COMPILE("Finishing tier-up of function #%d...\n",
+                  unit_->func_index);
+    NativeModule* native_module = unit_->unit->native_module();
+    NativeModuleModificationScope native_module_modification_scope(
+        native_module);
+    ErrorThrower thrower(isolate, "WasmTierUp");
+    wasm::WasmCode* wasm_code = unit_->unit->FinishCompilation(&thrower);
+    // The function was validated by Liftoff already.
+    CHECK(!thrower.error());
+
+    if (wasm::WasmCode::ShouldBeLogged(isolate)) wasm_code->LogCode(isolate);
+
+    // Link the direct calls of the new code. Callers keep calling the Liftoff
+    // code, which jumps to the code table entry in its prologue.
+    CodeSpecialization code_specialization;
+    code_specialization.RelocateDirectCalls(native_module);
+    code_specialization.ApplyToWasmCode(wasm_code, SKIP_ICACHE_FLUSH);
+    Assembler::FlushICache(wasm_code->instructions().start(),
+                           wasm_code->instructions().size());
+    isolate->counters()->wasm_generated_code_size()->Increment(
+        static_cast<int>(wasm_code->instructions().size()));
+    isolate->counters()->wasm_reloc_size()->Increment(
+        static_cast<int>(wasm_code->reloc_info().size()));
+
+    if (trap_handler::IsTrapHandlerEnabled()) {
+      wasm_code->RegisterTrapHandlerData();
+    }
+
+    // The code of functions tiered up earlier may have become unreachable in
+    // the meantime.
+    native_module->FreeSupersededCode(isolate);
+  }
+
+ private:
+  CompilationState* compilation_state_;
+  std::unique_ptr<TierUpUnit> unit_;
+};
+
+// Compiles a hot function with TurboFan in the background.
+class TierUpCompileTask : public CancelableTask {
+ public:
+  TierUpCompileTask(CompilationState* compilation_state,
+                    std::unique_ptr<TierUpUnit> unit)
+      : CancelableTask(compilation_state->tier_up_task_manager()),
+        compilation_state_(compilation_state),
+        unit_(std::move(unit)) {}
+
+  void RunInternal() override {
+    TRACE_COMPILE("Tiering up function #%d...\n", unit_->func_index);
+    unit_->unit->ExecuteCompilation();
+    compilation_state_->foreground_task_runner()->PostTask(
+        base::make_unique<TierUpFinishTask>(compilation_state_,
+                                            std::move(unit_)));
+  }
+
+ private:
+  CompilationState* compilation_state_;
+  std::unique_ptr<TierUpUnit> unit_;
+};
+
+}  // namespace
+
+void TierUpFunction(Isolate* isolate, Handle<WasmInstanceObject> instance,
+                    int func_index) {
+  Handle<WasmModuleObject> module_object(instance->module_object(), isolate);
+  NativeModule* native_module =
+      module_object->compiled_module()->GetNativeModule();
+  uint32_t index = static_cast<uint32_t>(func_index);
+  // Never request tier-up for this function again, even if compilation
+  // happens to fail or if this activation keeps running in Liftoff code.
+  native_module->tiering_budgets()[index -
+                                   native_module->num_imported_functions()] =
+      kMaxInt;
+  if (native_module->code(index)->tier() == WasmCode::kTurbofan) return;
+
+  CompilationState* compilation_state = native_module->compilation_state();
+  const WasmFunction* func =
+      &compilation_state->module_env()->module->functions[func_index];
+  std::unique_ptr<TierUpUnit> tier_up(new TierUpUnit());
+  tier_up->func_index = func_index;
+  tier_up->counters = isolate->async_counters();
+  size_t body_size = func->code.end_offset() - func->code.offset();
+  tier_up->body_copy.reset(new byte[body_size]);
+  memcpy(tier_up->body_copy.get(),
+         module_object->shared()->module_bytes()->GetChars() +
+             func->code.offset(),
+         body_size);
+  {
+    WasmName name = Vector<const char>::cast(
+        module_object->shared()->GetRawFunctionName(func_index));
+    tier_up->name.assign(name.start(), static_cast<size_t>(name.length()));
+  }
+  FunctionBody body{func->sig, func->code.offset(), tier_up->body_copy.get(),
+                    tier_up->body_copy.get() + body_size};
+  tier_up->unit.reset(new WasmCompilationUnit(
+      isolate, compilation_state->module_env(), native_module, body,
+      CStrVector(tier_up->name.c_str()), func_index,
+      WasmCompilationUnit::CompilationMode::kTurbofan,
+      tier_up->counters.get()));
+
+  // The calling activation keeps running in Liftoff code; later calls switch
+  // to the TurboFan code once it is installed.
+  auto task = base::make_unique<TierUpCompileTask>(compilation_state,
+                                                   std::move(tier_up));
+  // If --wasm-num-compilation-tasks=0 is passed, do only spawn foreground
+  // tasks. This is used to make timing deterministic.
+  if (FLAG_wasm_num_compilation_tasks > 0) {
+    V8::GetCurrentPlatform()->CallOnWorkerThread(std::move(task));
+  } else {
+    compilation_state->foreground_task_runner()->PostTask(std::move(task));
+  }
+}
+
+namespace {
+
 int AdvanceSourcePositionTableIterator(SourcePositionTableIterator& iterator,
                                        int offset) {
   DCHECK(!iterator.done());
@@ -1100,6 +1272,8 @@ void UpdateAllCompiledModulesWithTopTierCode(
   CodeSpecialization code_specialization;
   code_specialization.RelocateDirectCalls(native_module);
   code_specialization.ApplyToWholeModule(native_module, module_object);
+
+  native_module->FreeSupersededCode(module_object->GetIsolate());
 }
 
 void CompileInParallel(Isolate* isolate, NativeModule* native_module,
@@ -1257,29 +1431,195 @@ void CompileSequentially(Isolate* isolate, NativeModule* native_module,
   }
 }
 
-void ValidateSequentially(Isolate* isolate, const ModuleWireBytes& wire_bytes,
-                          ModuleEnv* module_env, ErrorThrower* thrower) {
-  DCHECK(!thrower->error());
+// The number of function bodies validated together by one thread.
+constexpr size_t kFunctionsPerValidationUnit = 64;
+
+// Validates function bodies on the platform's worker threads. Functions are
+// added in units of consecutive functions, and every unit is validated either
+// by a background task or by the thread calling {Wait}, so waiting never
+// depends on a worker thread becoming available. Does not access the heap.
+// Only used for lazily compiled modules: eagerly compiled functions are
+// validated by the compilation units, which already run on worker threads.
+class ParallelValidation
+    : public std::enable_shared_from_this<ParallelValidation> {
+ public:
+  struct Function {
+    const WasmFunction* function;
+    FunctionBody body;
+  };
+  typedef std::vector<Function> Unit;
+
+  ParallelValidation(AccountingAllocator* allocator, const WasmModule* module,
+                     std::shared_ptr<Counters> counters)
+      : allocator_(allocator),
+        module_(module),
+        counters_(std::move(counters)),
+        max_tasks_(FLAG_wasm_parallel_validation && !FLAG_trace_wasm_decoder
+                       ? std::min(FLAG_wasm_num_compilation_tasks,
+                                  V8::GetCurrentPlatform()
+                                      ->NumberOfWorkerThreads())
+                       : 0) {}
+
+  // Queues {unit} for validation. Units must be added in the order of their
+  // function indexes.
+  void AddUnit(Unit unit) {
+    DCHECK(!unit.empty());
+    bool spawn_task;
+    {
+      base::LockGuard<base::Mutex> guard(&mutex_);
+      units_.push_back(std::move(unit));
+      // A single queued unit is left to the thread calling {Wait}: posting a
+      // task for it costs more than it saves.
+      spawn_task = units_.size() > 1 && num_tasks_ < max_tasks_;
+      if (spawn_task) ++num_tasks_;
+    }
+    if (spawn_task) {
+      V8::GetCurrentPlatform()->CallOnWorkerThread(
+          base::make_unique<ValidationTask>(shared_from_this()));
+    }
+  }
 
-  const WasmModule* module = module_env->module;
-  for (uint32_t i = 0; i < module->functions.size(); ++i) {
-    const WasmFunction& func = module->functions[i];
+  // Returns whether an invalid function was found so far.
+  bool failed() {
+    base::LockGuard<base::Mutex> guard(&mutex_);
+    return invalid_function_ != nullptr;
+  }
+
+  // Finishes validating all units added so far and returns the invalid
+  // function with the lowest index, or nullptr. The decoder error is stored in
+  // {result}.
+  const WasmFunction* Wait(DecodeResult* result) {
+    while (ExecuteUnit(false)) {
+    }
+    base::LockGuard<base::Mutex> guard(&mutex_);
+    while (num_running_units_ > 0) units_done_.Wait(&mutex_);
+    if (invalid_function_ != nullptr) *result = std::move(error_);
+    return invalid_function_;
+  }
+
+  // Drops all units which did not start yet and waits for the running ones,
+  // such that the function bodies are not accessed any more.
+  void Cancel() {
+    base::LockGuard<base::Mutex> guard(&mutex_);
+    units_.clear();
+    while (num_running_units_ > 0) units_done_.Wait(&mutex_);
+  }
+
+ private:
+  class ValidationTask : public v8::Task {
+   public:
+    explicit ValidationTask(std::shared_ptr<ParallelValidation> validation)
+        : validation_(std::move(validation)) {}
+
+    void Run() override {
+      while (validation_->ExecuteUnit(true)) {
+      }
+    }
+
+   private:
+    std::shared_ptr<ParallelValidation> validation_;
+  };
+
+  // Validates the next queued unit, and returns false if there is none.
+  bool ExecuteUnit(bool on_background_task) {
+    Unit unit;
+    {
+      base::LockGuard<base::Mutex> guard(&mutex_);
+      if (units_.empty()) {
+        // Stop the task under the lock, such that {AddUnit} spawns a new one.
+        if (on_background_task) --num_tasks_;
+        return false;
+      }
+      unit = std::move(units_.front());
+      units_.pop_front();
+      // Units after an invalid function do not change the result.
+      if (invalid_function_ != nullptr &&
+          invalid_function_->func_index < unit.front().function->func_index) {
+        return true;
+      }
+      ++num_running_units_;
+    }
+
+    const WasmFunction* invalid_function = nullptr;
+    DecodeResult result;
+    for (Function& func : unit) {
+      result = VerifyWasmCodeWithStats(allocator_, module_, func.body,
+                                       module_->origin, counters_.get());
+      if (result.failed()) {
+        invalid_function = func.function;
+        break;
+      }
+    }
+
+    base::LockGuard<base::Mutex> guard(&mutex_);
+    if (invalid_function != nullptr &&
+        (invalid_function_ == nullptr ||
+         invalid_function->func_index < invalid_function_->func_index)) {
+      invalid_function_ = invalid_function;
+      error_ = std::move(result);
+    }
+    if (--num_running_units_ == 0) units_done_.NotifyAll();
+    return true;
+  }
+
+  AccountingAllocator* const allocator_;
+  const WasmModule* const module_;
+  const std::shared_ptr<Counters> counters_;
+  const int max_tasks_;
+
+  // Protects all fields below.
+  base::Mutex mutex_;
+  std::deque<Unit> units_;
+  int num_tasks_ = 0;
+  int num_running_units_ = 0;
+  base::ConditionVariable units_done_;
+  const WasmFunction* invalid_function_ = nullptr;
+  DecodeResult error_;
+
+  DISALLOW_COPY_AND_ASSIGN(ParallelValidation);
+};
+
+// Validates the bodies of all functions in {module} and returns the first
+// invalid one, or nullptr. The decoder error is stored in {result}. Does not
+// access the heap, so it can be called on a background thread.
+const WasmFunction* FindInvalidFunction(AccountingAllocator* allocator,
+                                        const WasmModule* module,
+                                        const ModuleWireBytes& wire_bytes,
+                                        std::shared_ptr<Counters> counters,
+                                        DecodeResult* result) {
+  auto validation = std::make_shared<ParallelValidation>(allocator, module,
+                                                         std::move(counters));
+  ParallelValidation::Unit unit;
+  for (const WasmFunction& func : module->functions) {
     if (func.imported) continue;
 
     const byte* base = wire_bytes.start();
     FunctionBody body{func.sig, func.code.offset(), base + func.code.offset(),
                       base + func.code.end_offset()};
-    DecodeResult result = VerifyWasmCodeWithStats(
-        isolate->allocator(), module, body, module->origin,
-        isolate->async_counters().get());
-    if (result.failed()) {
-      TruncatedUserString<> name(wire_bytes.GetName(&func, module));
-      thrower->CompileError("Compiling function #%d:%.*s failed: %s @+%u", i,
-                            name.length(), name.start(),
-                            result.error_msg().c_str(), result.error_offset());
-      break;
+    unit.push_back({&func, body});
+    if (unit.size() == kFunctionsPerValidationUnit) {
+      validation->AddUnit(std::move(unit));
+      unit.clear();
     }
   }
+  if (!unit.empty()) validation->AddUnit(std::move(unit));
+  return validation->Wait(result);
+}
+
+void ValidateFunctions(Isolate* isolate, const ModuleWireBytes& wire_bytes,
+                       ModuleEnv* module_env, ErrorThrower* thrower) {
+  DCHECK(!thrower->error());
+
+  const WasmModule* module = module_env->module;
+  DecodeResult result;
+  const WasmFunction* func =
+      FindInvalidFunction(isolate->allocator(), module, wire_bytes,
+                          isolate->async_counters(), &result);
+  if (func == nullptr) return;
+  TruncatedUserString<> name(wire_bytes.GetName(func, module));
+  thrower->CompileError("Compiling function #%d:%.*s failed: %s @+%u",
+                        func->func_index, name.length(), name.start(),
+                        result.error_msg().c_str(), result.error_offset());
 }
 
 MaybeHandle<WasmModuleObject> CompileToModuleObjectInternal(
@@ -1365,7 +1705,7 @@ MaybeHandle<WasmModuleObject> CompileToModuleObjectInternal(
       // TODO(clemensh): According to the spec, we can actually skip validation
       // at module creation time, and return a function that always traps at
       // (lazy) compilation time.
-      ValidateSequentially(isolate, wire_bytes, &env, thrower);
+      ValidateFunctions(isolate, wire_bytes, &env, thrower);
       if (thrower->error()) return {};
     }
 
@@ -2756,6 +3096,7 @@ void AsyncCompileJob::Abort() {
 class AsyncStreamingProcessor final : public StreamingProcessor {
  public:
   explicit AsyncStreamingProcessor(AsyncCompileJob* job);
+  ~AsyncStreamingProcessor() override;
 
   bool ProcessModuleHeader(Vector<const uint8_t> bytes,
                            uint32_t offset) override;
@@ -2784,10 +3125,25 @@ class AsyncStreamingProcessor final : public StreamingProcessor {
 
   void CommitCompilationUnits();
 
+  // Passes the functions received since the last call to {validation_}.
+  void CommitValidationUnit();
+
+  // Waits for the validation of all received functions and finishes the
+  // AsyncCompileJob with an error if one of them is invalid.
+  bool FinishValidation();
+
   ModuleDecoder decoder_;
   AsyncCompileJob* job_;
   std::unique_ptr<CompilationUnitBuilder> compilation_unit_builder_;
   uint32_t next_function_ = 0;
+  // Whether function bodies are validated instead of compiled, see
+  // {compile_lazy}.
+  bool lazy_compile_ = false;
+  // Validates function bodies on background threads if {lazy_compile_} is set.
+  // The function bodies are owned by the StreamingDecoder, which outlives this
+  // processor.
+  std::shared_ptr<ParallelValidation> validation_;
+  ParallelValidation::Unit validation_unit_;
 };
 
 std::shared_ptr<StreamingDecoder> AsyncCompileJob::CreateStreamingDecoder() {
@@ -2966,19 +3322,44 @@ void AsyncCompileJob::NextStep(Args&&... args) {
 //==========================================================================
 class AsyncCompileJob::DecodeModule : public AsyncCompileJob::CompileStep {
  public:
-  DecodeModule() : CompileStep(1) {}
+  explicit DecodeModule(bool use_shared_cache = true)
+      : CompileStep(1), use_shared_cache_(use_shared_cache) {}
 
   void RunInBackground() override {
     ModuleResult result;
+    std::shared_ptr<const SharedModuleCache::SerializedModule> cached;
     {
       DisallowHandleAllocation no_handle;
       DisallowHeapAllocation no_allocation;
+      SharedModuleCache* cache = SharedModuleCache::Get();
+      if (use_shared_cache_ && cache != nullptr) {
+        cached = cache->LookupSerialized(job_->wire_bytes_.module_bytes());
+      }
       // Decode the module bytes.
       TRACE_COMPILE("(1) Decoding module...\n");
       result = AsyncDecodeWasmModule(job_->isolate_, job_->wire_bytes_.start(),
                                      job_->wire_bytes_.end(), false,
                                      kWasmOrigin, job_->async_counters());
     }
+    if (result.ok() && cached) {
+      // Another isolate compiled the same module; only its code has to be
+      // deserialized, which needs the heap.
+      job_->module_ = std::move(result.val);
+      job_->DoSync<DeserializeCachedModule>(std::move(cached));
+      return;
+    }
+    if (result.ok() && compile_lazy(result.val.get())) {
+      // Functions are not compiled before their first call, so validate them
+      // here, still off the main thread.
+      TRACE_COMPILE("(1) Validating module for lazy compilation...\n");
+      DecodeResult validation;
+      if (FindInvalidFunction(job_->isolate_->allocator(), result.val.get(),
+                              job_->wire_bytes_, job_->async_counters(),
+                              &validation) != nullptr) {
+        result = ModuleResult(nullptr);
+        result.MoveErrorFrom(validation);
+      }
+    }
     if (result.failed()) {
       // Decoding failure; reject the promise and clean up.
       job_->DoSync<DecodeFail>(std::move(result));
@@ -2988,6 +3369,39 @@ class AsyncCompileJob::DecodeModule : public AsyncCompileJob::CompileStep {
       job_->DoSync<PrepareAndStartCompile>(job_->module_.get(), true);
     }
   }
+
+ private:
+  const bool use_shared_cache_;
+};
+
+//==========================================================================
+// Step 1c: (sync) Deserialize a module found in the shared module cache.
+//==========================================================================
+class AsyncCompileJob::DeserializeCachedModule : public CompileStep {
+ public:
+  explicit DeserializeCachedModule(
+      std::shared_ptr<const SharedModuleCache::SerializedModule> serialized)
+      : serialized_(std::move(serialized)) {}
+
+ private:
+  std::shared_ptr<const SharedModuleCache::SerializedModule> serialized_;
+
+  void RunInForeground() override {
+    TRACE_COMPILE("(1c) Deserializing cached module...\n");
+    job_->background_task_manager_.CancelAndWait();
+    Handle<WasmModuleObject> module_object;
+    if (!DeserializeNativeModule(job_->isolate_,
+                                 {serialized_->data(), serialized_->size()},
+                                 job_->wire_bytes_.module_bytes(),
+                                 std::move(job_->module_))
+             .ToHandle(&module_object)) {
+      // The entry cannot be used in this isolate; compile the module instead.
+      job_->DoAsync<DecodeModule>(false);
+      return;
+    }
+    job_->AsyncCompileSucceeded(module_object);
+    job_->isolate_->wasm_engine()->RemoveCompileJob(job_);
+  }
 };
 
 //==========================================================================
@@ -3052,6 +3466,17 @@ class AsyncCompileJob::PrepareAndStartCompile : public CompileStep {
       return;
     }
 
+    if (compile_lazy(module_)) {
+      // All functions were validated already (during decoding, or while
+      // streaming the code section), and are compiled on their first call.
+      job_->compiled_module_->GetNativeModule()->SetLazyBuiltin(
+          BUILTIN_CODE(job_->isolate_, WasmCompileLazy));
+      job_->tiering_completed_ = true;
+      // When streaming, {OnFinishedStream} finishes compilation.
+      if (start_compilation_) job_->FinishCompile();
+      return;
+    }
+
     CompilationState* compilation_state =
         job_->compiled_module_->GetNativeModule()->compilation_state();
     {
@@ -3174,7 +3599,7 @@ class AsyncCompileJob::FinishModule : public CompileStep {
     if (job_->compiled_module_->GetNativeModule()
                 ->compilation_state()
                 ->compile_mode() == CompileMode::kRegular ||
-        num_functions == 0) {
+        num_functions == 0 || compile_lazy(module)) {
       // If we do not tier up, the async compile job is done here and
       // can be deleted.
       job_->isolate_->wasm_engine()->RemoveCompileJob(job_);
@@ -3214,7 +3639,15 @@ class AsyncCompileJob::AbortCompilation : public CompileStep {
 AsyncStreamingProcessor::AsyncStreamingProcessor(AsyncCompileJob* job)
     : job_(job), compilation_unit_builder_(nullptr) {}
 
+AsyncStreamingProcessor::~AsyncStreamingProcessor() {
+  if (validation_) validation_->Cancel();
+}
+
 void AsyncStreamingProcessor::FinishAsyncCompileJobWithError(ResultBase error) {
+  if (validation_) {
+    validation_->Cancel();
+    validation_.reset();
+  }
   // Make sure all background tasks stopped executing before we change the state
   // of the AsyncCompileJob to DecodeFail.
   job_->background_task_manager_.CancelAndWait();
@@ -3309,6 +3742,16 @@ bool AsyncStreamingProcessor::ProcessCodeSectionHeader(size_t functions_count,
   constexpr bool on_foreground = true;
   job_->step_->Run(on_foreground);
 
+  if (compile_lazy(decoder_.module())) {
+    // Function bodies are only validated as they arrive, so only the
+    // AsyncStreamingProcessor has to finish.
+    lazy_compile_ = true;
+    validation_ = std::make_shared<ParallelValidation>(
+        job_->isolate_->allocator(), decoder_.module(),
+        job_->async_counters());
+    return true;
+  }
+
   NativeModule* native_module = job_->compiled_module_->GetNativeModule();
   native_module->compilation_state()->SetNumberOfFunctionsToCompile(
       functions_count);
@@ -3325,16 +3768,26 @@ bool AsyncStreamingProcessor::ProcessFunctionBody(Vector<const uint8_t> bytes,
                                                   uint32_t offset) {
   TRACE_STREAMING("Process function body %d ...\n", next_function_);
 
-    decoder_.DecodeFunctionBody(
-        next_function_, static_cast<uint32_t>(bytes.length()), offset, false);
+  decoder_.DecodeFunctionBody(
+      next_function_, static_cast<uint32_t>(bytes.length()), offset, false);
 
-    uint32_t index = next_function_ + decoder_.module()->num_imported_functions;
-    const WasmFunction* func = &decoder_.module()->functions[index];
+  uint32_t index = next_function_ + decoder_.module()->num_imported_functions;
+  const WasmFunction* func = &decoder_.module()->functions[index];
+  ++next_function_;
+  if (lazy_compile_) {
+    // Validate the function in the background, it is compiled on its first
+    // call.
+    FunctionBody body{func->sig, offset, bytes.start(), bytes.end()};
+    validation_unit_.push_back({func, body});
+    if (validation_unit_.size() == kFunctionsPerValidationUnit) {
+      CommitValidationUnit();
+    }
+    // Report errors as soon as they are found.
+    if (validation_->failed()) return FinishValidation();
+  } else {
     WasmName name = {nullptr, 0};
     compilation_unit_builder_->AddUnit(func, offset, bytes, name);
-  ++next_function_;
-  // This method always succeeds. The return value is necessary to comply with
-  // the StreamingProcessor interface.
+  }
   return true;
 }
 
@@ -3343,15 +3796,37 @@ void AsyncStreamingProcessor::CommitCompilationUnits() {
   compilation_unit_builder_->Commit();
 }
 
+void AsyncStreamingProcessor::CommitValidationUnit() {
+  DCHECK(validation_);
+  if (validation_unit_.empty()) return;
+  validation_->AddUnit(std::move(validation_unit_));
+  validation_unit_.clear();
+}
+
+bool AsyncStreamingProcessor::FinishValidation() {
+  CommitValidationUnit();
+  DecodeResult result;
+  // All functions before an invalid one have been received already, so the
+  // reported function does not depend on how the bytes were chunked.
+  if (validation_->Wait(&result) != nullptr) {
+    FinishAsyncCompileJobWithError(std::move(result));
+    return false;
+  }
+  validation_.reset();
+  return true;
+}
+
 void AsyncStreamingProcessor::OnFinishedChunk() {
   TRACE_STREAMING("FinishChunk...\n");
   if (compilation_unit_builder_) CommitCompilationUnits();
+  if (validation_) CommitValidationUnit();
 }
 
 // Finish the processing of the stream.
 void AsyncStreamingProcessor::OnFinishedStream(std::unique_ptr<uint8_t[]> bytes,
                                                size_t length) {
   TRACE_STREAMING("Finish stream...\n");
+  if (validation_ && !FinishValidation()) return;
   job_->bytes_copy_ = std::move(bytes);
   job_->wire_bytes_ = ModuleWireBytes(job_->bytes_copy_.get(),
                                       job_->bytes_copy_.get() + length);
@@ -3380,6 +3855,10 @@ void AsyncStreamingProcessor::OnError(DecodeResult result) {
 
 void AsyncStreamingProcessor::OnAbort() {
   TRACE_STREAMING("Abort stream...\n");
+  if (validation_) {
+    validation_->Cancel();
+    validation_.reset();
+  }
   job_->Abort();
 }
 
@@ -3403,7 +3882,9 @@ CompilationState::CompilationState(internal::Isolate* isolate, ModuleEnv& env)
       module_env_(env),
       max_memory_(GetMaxUsableMemorySize(isolate) / 2),
       // TODO(clemensh): Fix fuzzers such that {env.module} is always non-null.
-      compile_mode_(FLAG_wasm_tier_up &&
+      // With --wasm-dynamic-tiering, functions are compiled with Liftoff
+      // only and tiered up individually once they get hot.
+      compile_mode_(FLAG_wasm_tier_up && !FLAG_wasm_dynamic_tiering &&
                             (!env.module || env.module->origin == kWasmOrigin)
                         ? CompileMode::kTiering
                         : CompileMode::kRegular),
@@ -3419,10 +3900,13 @@ CompilationState::CompilationState(internal::Isolate* isolate, ModuleEnv& env)
   // Register task manager for clean shutdown in case of an isolate shutdown.
   isolate_->wasm_engine()->Register(&background_task_manager_);
   isolate_->wasm_engine()->Register(&foreground_task_manager_);
+  isolate_->wasm_engine()->Register(&tier_up_task_manager_);
 }
 
 CompilationState::~CompilationState() {
   CancelAndWait();
+  tier_up_task_manager_.CancelAndWait();
+  isolate_->wasm_engine()->Unregister(&tier_up_task_manager_);
   foreground_task_manager_.CancelAndWait();
   isolate_->wasm_engine()->Unregister(&foreground_task_manager_);
   NotifyOnEvent(CompilationEvent::kDestroyed, nullptr);
@@ -75,6 +75,14 @@ V8_EXPORT_PRIVATE Handle<Script> CreateWasmScript(
 // Illegal builtin will never be called.
 Address CompileLazy(Isolate* isolate, Handle<WasmInstanceObject> instance);
 
+// Triggered by the WasmTierUp builtin once the Liftoff code of {func_index}
+// used up its tiering budget (see --wasm-dynamic-tiering). Compiles the
+// function with TurboFan on a background thread; a foreground task then
+// installs the result in the code table, from where the prologue of the
+// Liftoff code redirects subsequent calls to it.
+void TierUpFunction(Isolate* isolate, Handle<WasmInstanceObject> instance,
+                    int func_index);
+
 // Encapsulates all the state and steps of an asynchronous compilation.
 // An asynchronous compile job consists of a number of tasks that are executed
 // as foreground and background tasks. Any phase that touches the V8 heap or
@@ -103,6 +111,7 @@ class AsyncCompileJob {
   // States of the AsyncCompileJob.
   class DecodeModule;
   class DecodeFail;
+  class DeserializeCachedModule;
   class PrepareAndStartCompile;
   class CompileFailed;
   class CompileWrappers;
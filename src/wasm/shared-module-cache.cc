@@ -0,0 +1,145 @@
+// Copyright 2018 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "src/wasm/shared-module-cache.h"
+
+#include <string.h>
+#include <iterator>
+
+#include "src/base/functional.h"
+#include "src/flags.h"
+#include "src/objects-inl.h"
+#include "src/wasm/module-decoder.h"
+#include "src/wasm/wasm-objects-inl.h"
+#include "src/wasm/wasm-serialization.h"
+
+namespace v8 {
+namespace internal {
+namespace wasm {
+
+SharedModuleCache* SharedModuleCache::cache_ = nullptr;
+
+void SharedModuleCache::InitializeOncePerProcess() {
+  if (FLAG_wasm_shared_module_cache_size == 0) return;
+  DCHECK_NULL(cache_);
+  cache_ = new SharedModuleCache(size_t{FLAG_wasm_shared_module_cache_size} *
+                                 MB);
+}
+
+void SharedModuleCache::TearDown() {
+  delete cache_;
+  cache_ = nullptr;
+}
+
+// static
+bool SharedModuleCache::IsCacheable() {
+  // Lazily compiled or tiered-up modules would be serialized before their
+  // code is complete, and the interpreter does not produce code at all.
+  return !FLAG_wasm_lazy_compilation && !FLAG_wasm_tier_up &&
+         !FLAG_wasm_interpret_all;
+}
+
+SharedModuleCache::EntryList::iterator SharedModuleCache::Find(
+    size_t hash, Vector<const byte> bytes) {
+  auto range = index_.equal_range(hash);
+  for (auto it = range.first; it != range.second; ++it) {
+    const std::vector<byte>& wire_bytes = it->second->wire_bytes;
+    if (wire_bytes.size() == bytes.size() &&
+        memcmp(wire_bytes.data(), bytes.start(), bytes.size()) == 0) {
+      return it->second;
+    }
+  }
+  return entries_.end();
+}
+
+std::shared_ptr<const SharedModuleCache::SerializedModule>
+SharedModuleCache::LookupSerialized(Vector<const byte> bytes) {
+  if (!IsCacheable()) return nullptr;
+  size_t hash = base::hash_range(bytes.begin(), bytes.end());
+  base::LockGuard<base::Mutex> guard(&mutex_);
+  EntryList::iterator entry = Find(hash, bytes);
+  if (entry == entries_.end()) return nullptr;
+  ++num_hits_;
+  // Move the entry to the front of the LRU list.
+  entries_.splice(entries_.begin(), entries_, entry);
+  return entry->serialized;
+}
+
+MaybeHandle<WasmModuleObject> SharedModuleCache::Lookup(
+    Isolate* isolate, const ModuleWireBytes& bytes) {
+  std::shared_ptr<const SerializedModule> serialized =
+      LookupSerialized(bytes.module_bytes());
+  if (!serialized) return {};
+  // {serialized} stays alive even if the entry is evicted concurrently.
+  return DeserializeNativeModule(
+      isolate, {serialized->data(), serialized->size()}, bytes.module_bytes());
+}
+
+void SharedModuleCache::EvictFor(size_t size) {
+  while (!entries_.empty() && size_ + size > max_size_) {
+    EntryList::iterator entry = std::prev(entries_.end());
+    size_ -= entry->size();
+    auto range = index_.equal_range(entry->hash);
+    for (auto it = range.first; it != range.second; ++it) {
+      if (it->second == entry) {
+        index_.erase(it);
+        break;
+      }
+    }
+    entries_.pop_back();
+  }
+}
+
+void SharedModuleCache::Insert(Isolate* isolate,
+                               Handle<WasmModuleObject> module_object) {
+  if (!IsCacheable()) return;
+  SeqOneByteString* module_bytes = module_object->shared()->module_bytes();
+  std::vector<byte> wire_bytes;
+  {
+    DisallowHeapAllocation no_gc;
+    wire_bytes.assign(module_bytes->GetChars(),
+                      module_bytes->GetChars() + module_bytes->length());
+  }
+  Vector<const byte> bytes(wire_bytes.data(), wire_bytes.size());
+  size_t hash = base::hash_range(bytes.begin(), bytes.end());
+  {
+    base::LockGuard<base::Mutex> guard(&mutex_);
+    if (Find(hash, bytes) != entries_.end()) return;
+  }
+
+  Handle<WasmCompiledModule> compiled_module(
+      WasmCompiledModule::cast(module_object->compiled_module()), isolate);
+  size_t serialized_length =
+      GetSerializedNativeModuleSize(isolate, compiled_module);
+  size_t entry_size = wire_bytes.size() + serialized_length;
+  if (entry_size > max_size_) return;
+  std::shared_ptr<SerializedModule> serialized =
+      std::make_shared<SerializedModule>(serialized_length);
+  if (!SerializeNativeModule(isolate, compiled_module,
+                             {serialized->data(), serialized_length})) {
+    return;
+  }
+
+  base::LockGuard<base::Mutex> guard(&mutex_);
+  // Another isolate may have inserted the same module in the meantime.
+  if (Find(hash, bytes) != entries_.end()) return;
+  EvictFor(entry_size);
+  size_ += entry_size;
+  entries_.push_front({hash, std::move(wire_bytes), std::move(serialized)});
+  index_.emplace(hash, entries_.begin());
+}
+
+size_t SharedModuleCache::size() {
+  base::LockGuard<base::Mutex> guard(&mutex_);
+  return size_;
+}
+
+size_t SharedModuleCache::num_hits() {
+  base::LockGuard<base::Mutex> guard(&mutex_);
+  return num_hits_;
+}
+
+}  // namespace wasm
+}  // namespace internal
+}  // namespace v8
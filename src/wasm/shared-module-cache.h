@@ -0,0 +1,112 @@
+// Copyright 2018 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef V8_WASM_SHARED_MODULE_CACHE_H_
+#define V8_WASM_SHARED_MODULE_CACHE_H_
+
+#include <list>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+#include "src/base/macros.h"
+#include "src/base/platform/mutex.h"
+#include "src/handles.h"
+#include "src/vector.h"
+
+namespace v8 {
+namespace internal {
+
+class WasmModuleObject;
+
+namespace wasm {
+
+struct ModuleWireBytes;
+
+// A process-wide cache of compiled wasm modules. The first isolate to compile
+// a module serializes it into the cache, and any other isolate that compiles
+// the same bytes deserializes the code instead of compiling it again.
+// This shares compile work, not code memory: a {NativeModule} still belongs
+// to a single isolate, because its code refers to isolate-specific stubs and
+// trampolines and is accounted by that isolate's {WasmCodeManager}. Each
+// isolate keeps its own copy of the machine code, and the cache adds the
+// serialized copy on top, up to --wasm-shared-module-cache-size.
+// Entries keep the wire bytes they were compiled from, which are compared on
+// lookup; the hash only selects candidates. The wire bytes count towards the
+// size limit. Once the cache is full, the least recently used entries are
+// evicted.
+class V8_EXPORT_PRIVATE SharedModuleCache final {
+ public:
+  using SerializedModule = std::vector<byte>;
+
+  explicit SharedModuleCache(size_t max_size) : max_size_(max_size) {}
+
+  // Creates the process-wide cache if --wasm-shared-module-cache-size is
+  // non-zero.
+  static void InitializeOncePerProcess();
+  static void TearDown();
+
+  // Returns the process-wide cache, or nullptr if it is disabled.
+  static SharedModuleCache* Get() { return cache_; }
+
+  // Whether modules compiled with the current flags can be cached, i.e. their
+  // code is complete and final once compilation finishes.
+  static bool IsCacheable();
+
+  // Returns the serialized module for {bytes}, or nullptr if there is none.
+  // Does not touch the heap, so it can be called from background threads.
+  std::shared_ptr<const SerializedModule> LookupSerialized(
+      Vector<const byte> bytes);
+
+  // Returns a new module object deserialized from the entry for {bytes}, or
+  // an empty handle if there is none.
+  MaybeHandle<WasmModuleObject> Lookup(Isolate* isolate,
+                                       const ModuleWireBytes& bytes);
+
+  // Serializes {module_object} into the cache, unless its wire bytes are
+  // already cached or the entry alone would exceed the size limit.
+  void Insert(Isolate* isolate, Handle<WasmModuleObject> module_object);
+
+  // The total size of all entries, in bytes.
+  size_t size();
+
+  // The number of successful lookups so far.
+  size_t num_hits();
+
+ private:
+  struct Entry {
+    size_t hash;
+    std::vector<byte> wire_bytes;
+    std::shared_ptr<const SerializedModule> serialized;
+
+    size_t size() const { return wire_bytes.size() + serialized->size(); }
+  };
+  using EntryList = std::list<Entry>;
+
+  // Returns the entry whose wire bytes equal {bytes}, or {entries_.end()}.
+  // Requires {mutex_} to be held.
+  EntryList::iterator Find(size_t hash, Vector<const byte> bytes);
+
+  // Drops least recently used entries until {size} more bytes fit. Requires
+  // {mutex_} to be held.
+  void EvictFor(size_t size);
+
+  static SharedModuleCache* cache_;
+
+  base::Mutex mutex_;
+  // All entries, most recently used first.
+  EntryList entries_;
+  std::unordered_multimap<size_t, EntryList::iterator> index_;
+  const size_t max_size_;
+  size_t size_ = 0;
+  size_t num_hits_ = 0;
+
+  DISALLOW_COPY_AND_ASSIGN(SharedModuleCache);
+};
+
+}  // namespace wasm
+}  // namespace internal
+}  // namespace v8
+
+#endif  // V8_WASM_SHARED_MODULE_CACHE_H_
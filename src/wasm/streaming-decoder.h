@@ -249,10 +249,12 @@ class V8_EXPORT_PRIVATE StreamingDecoder {
 
   uint32_t module_offset() const { return module_offset_; }
 
+  // The section buffers are declared before the {processor_}, which may
+  // still access function bodies while it is being destroyed.
+  std::vector<std::unique_ptr<SectionBuffer>> section_buffers_;
   std::unique_ptr<StreamingProcessor> processor_;
   bool ok_ = true;
   std::unique_ptr<DecodingState> state_;
-  std::vector<std::unique_ptr<SectionBuffer>> section_buffers_;
   uint32_t module_offset_ = 0;
   size_t total_size_ = 0;
   uint8_t next_section_id_ = kFirstSectionInModule;
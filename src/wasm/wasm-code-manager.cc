@@ -4,7 +4,9 @@
 
 #include "src/wasm/wasm-code-manager.h"
 
+#include <algorithm>
 #include <iomanip>
+#include <unordered_set>
 
 #include "src/assembler-inl.h"
 #include "src/base/atomic-utils.h"
@@ -12,10 +14,12 @@
 #include "src/base/platform/platform.h"
 #include "src/codegen.h"
 #include "src/disassembler.h"
+#include "src/frames-inl.h"
 #include "src/globals.h"
 #include "src/macro-assembler-inl.h"
 #include "src/macro-assembler.h"
 #include "src/objects-inl.h"
+#include "src/v8threads.h"
 #include "src/wasm/function-compiler.h"
 #include "src/wasm/wasm-module.h"
 #include "src/wasm/wasm-objects-inl.h"
@@ -216,6 +220,45 @@ bool WasmCode::HasTrapHandlerIndex() const { return trap_handler_index_ >= 0; }
 
 void WasmCode::ResetTrapHandlerIndex() { trap_handler_index_ = -1; }
 
+void WasmCode::TrimToTierUpPrologue() {
+  DCHECK(is_liftoff());
+  DCHECK_LT(0, tier_up_prologue_size_);
+  size_t new_size = tier_up_prologue_size_;
+  Address new_end = instruction_start() + new_size;
+
+  // The prologue contains no protected instructions, so the trap handler does
+  // not need to know about the trimmed code at all.
+  if (HasTrapHandlerIndex()) {
+    trap_handler::ReleaseHandlerData(static_cast<int>(trap_handler_index()));
+    ResetTrapHandlerIndex();
+  }
+  protected_instructions_.reset(new ProtectedInstructions());
+
+  // Relocation info is ordered by pc, so re-encoding the entries within the
+  // prologue yields a prefix of the original (backwards written) stream.
+  if (reloc_size_ > 0) {
+    std::unique_ptr<byte[]> reloc_info(new byte[reloc_size_]);
+    byte* reloc_end = reloc_info.get() + reloc_size_;
+    RelocInfoWriter writer;
+    writer.Reposition(reloc_end, instructions_.start());
+    for (RelocIterator it(instructions(), this->reloc_info(), constant_pool());
+         !it.done() && it.rinfo()->pc() < new_end; it.next()) {
+      writer.Write(it.rinfo());
+    }
+    size_t new_reloc_size = static_cast<size_t>(reloc_end - writer.pos());
+    memmove(reloc_info.get(), writer.pos(), new_reloc_size);
+    reloc_info_ = std::move(reloc_info);
+    reloc_size_ = new_reloc_size;
+  }
+
+  source_position_table_.reset();
+  source_position_size_ = 0;
+  instructions_ = instructions_.SubVector(0, new_size);
+  constant_pool_offset_ = new_size;
+  safepoint_table_offset_ = 0;
+  handler_table_offset_ = 0;
+}
+
 bool WasmCode::ShouldBeLogged(Isolate* isolate) {
   return isolate->logger()->is_listening_to_code_events() ||
          isolate->is_profiling() || FLAG_print_wasm_code || FLAG_print_code;
@@ -385,6 +428,13 @@ NativeModule::NativeModule(uint32_t num_functions, uint32_t num_imports,
     uint32_t num_wasm_functions = num_functions - num_imports;
     code_table_.reset(new WasmCode*[num_wasm_functions]);
     memset(code_table_.get(), 0, num_wasm_functions * sizeof(WasmCode*));
+    // Liftoff does not tier up asm.js code, see {TierUpCheck}.
+    if (FLAG_wasm_dynamic_tiering &&
+        (env.module == nullptr || env.module->origin == kWasmOrigin)) {
+      tiering_budgets_.reset(new int32_t[num_wasm_functions]);
+      std::fill_n(tiering_budgets_.get(), num_wasm_functions,
+                  FLAG_wasm_tiering_budget);
+    }
   }
   VirtualMemory my_mem;
   owned_code_space_.push_back(my_mem);
@@ -590,6 +640,13 @@ WasmCode* NativeModule::AddCode(
       safepoint_table_offset, handler_table_offset,
       std::move(protected_instructions), tier, WasmCode::kNoFlushICache);
 
+  WasmCode* prior_code = code(index);
+  if (FLAG_wasm_free_superseded_code && tier == WasmCode::kTurbofan &&
+      prior_code != nullptr && prior_code->is_liftoff() &&
+      prior_code->tier_up_prologue_size() > 0) {
+    base::LockGuard<base::Mutex> lock(&allocation_mutex_);
+    superseded_code_.push_back(prior_code);
+  }
   set_code(index, ret);
 
   // Apply the relocation delta by iterating over the RelocInfo.
@@ -681,6 +738,16 @@ Address NativeModule::GetLocalAddressFor(Handle<Code> code) {
 Address NativeModule::AllocateForCode(size_t size) {
   // this happens under a lock assumed by the caller.
   size = RoundUp(size, kCodeAlignment);
+  // Memory freed by {FreeSupersededCode} is still committed and accounted for
+  // in {allocated_code_space_}, so it can be handed out directly.
+  DisjointAllocationPool freed_mem = freed_code_space_.Allocate(size);
+  if (!freed_mem.IsEmpty()) {
+    Address ret = freed_mem.ranges().front().first;
+    DCHECK(IsAligned(ret, kCodeAlignment));
+    TRACE_HEAP("ID: %zu. Code alloc (reused): %p,+%zu\n", instance_id,
+               reinterpret_cast<void*>(ret), size);
+    return ret;
+  }
   DisjointAllocationPool mem = free_code_space_.Allocate(size);
   if (mem.IsEmpty()) {
     if (!can_request_more_memory_) return kNullAddress;
@@ -748,6 +815,76 @@ Address NativeModule::AllocateForCode(size_t size) {
   return ret;
 }
 
+namespace {
+
+// Collects the wasm code of all compiled wasm frames on the stacks of an
+// isolate, including the stacks of archived threads.
+class WasmCodeActivationsFinder : public ThreadVisitor {
+ public:
+  explicit WasmCodeActivationsFinder(std::unordered_set<WasmCode*>* codes)
+      : codes_(codes) {}
+
+  void VisitThread(Isolate* isolate, ThreadLocalTop* top) override {
+    for (StackFrameIterator it(isolate, top); !it.done(); it.Advance()) {
+      if (!it.frame()->is_wasm_compiled()) continue;
+      codes_->insert(WasmCompiledFrame::cast(it.frame())->wasm_code());
+    }
+  }
+
+ private:
+  std::unordered_set<WasmCode*>* codes_;
+};
+
+}  // namespace
+
+size_t NativeModule::FreeSupersededCode(Isolate* isolate) {
+  {
+    base::LockGuard<base::Mutex> lock(&allocation_mutex_);
+    if (superseded_code_.empty()) return 0;
+  }
+  std::unordered_set<WasmCode*> live_code;
+  WasmCodeActivationsFinder finder(&live_code);
+  finder.VisitThread(isolate, isolate->thread_local_top());
+  isolate->thread_manager()->IterateArchivedThreads(&finder);
+
+  size_t freed_size = 0;
+  std::vector<WasmCode*> trimmed_code;
+  {
+    base::LockGuard<base::Mutex> lock(&allocation_mutex_);
+    auto still_superseded = std::remove_if(
+        superseded_code_.begin(), superseded_code_.end(), [&](WasmCode* code) {
+          if (live_code.count(code)) return false;
+          Address start = code->instruction_start();
+          Address old_end =
+              start + RoundUp(code->instructions().size(), kCodeAlignment);
+          Address new_end =
+              start + RoundUp(code->tier_up_prologue_size(), kCodeAlignment);
+          code->TrimToTierUpPrologue();
+          trimmed_code.push_back(code);
+          if (new_end < old_end) {
+            TRACE_HEAP("ID: %zu. Code free: %p,+%zu\n", instance_id,
+                       reinterpret_cast<void*>(new_end),
+                       static_cast<size_t>(old_end - new_end));
+            freed_code_space_.Merge(DisjointAllocationPool(new_end, old_end));
+            freed_size += static_cast<size_t>(old_end - new_end);
+          }
+          return true;
+        });
+    superseded_code_.erase(still_superseded, superseded_code_.end());
+  }
+
+  // Code listeners still know the trimmed code with its full size. Replace
+  // their entries by the prologue before the freed space is reused, so that
+  // the code map never contains overlapping entries.
+  if (WasmCode::ShouldBeLogged(isolate)) {
+    for (WasmCode* code : trimmed_code) {
+      PROFILE(isolate, CodeDeleteEvent(code->instruction_start()));
+      code->LogCode(isolate);
+    }
+  }
+  return freed_size;
+}
+
 WasmCode* NativeModule::Lookup(Address pc) {
   if (owned_code_.empty()) return nullptr;
   auto iter = std::upper_bound(owned_code_.begin(), owned_code_.end(), pc,
@@ -131,6 +131,15 @@ class V8_EXPORT_PRIVATE WasmCode final {
   size_t handler_table_offset() const { return handler_table_offset_; }
   uint32_t stack_slots() const { return stack_slots_; }
   bool is_liftoff() const { return tier_ == kLiftoff; }
+  // Size of the prologue of Liftoff code that jumps to the optimized code once
+  // it exists. Callers keep entering the Liftoff code after tier-up, so only
+  // this part must be kept alive. Zero if the code cannot be trimmed.
+  size_t tier_up_prologue_size() const { return tier_up_prologue_size_; }
+  void set_tier_up_prologue_size(size_t size) {
+    DCHECK(is_liftoff());
+    DCHECK_LE(size, instructions().size());
+    tier_up_prologue_size_ = size;
+  }
   bool contains(Address pc) const {
     return reinterpret_cast<Address>(instructions_.start()) <= pc &&
            pc < reinterpret_cast<Address>(instructions_.end());
@@ -202,6 +211,10 @@ class V8_EXPORT_PRIVATE WasmCode final {
   bool HasTrapHandlerIndex() const;
   void ResetTrapHandlerIndex();
 
+  // Drops everything but the tier-up prologue from superseded Liftoff code.
+  // The caller is responsible for the memory after the new end.
+  void TrimToTierUpPrologue();
+
   Vector<byte> instructions_;
   std::unique_ptr<const byte[]> reloc_info_;
   size_t reloc_size_ = 0;
@@ -220,6 +233,7 @@ class V8_EXPORT_PRIVATE WasmCode final {
   intptr_t trap_handler_index_ = -1;
   std::unique_ptr<ProtectedInstructions> protected_instructions_;
   Tier tier_;
+  size_t tier_up_prologue_size_ = 0;
 
   DISALLOW_COPY_AND_ASSIGN(WasmCode);
 };
@@ -285,6 +299,12 @@ class V8_EXPORT_PRIVATE NativeModule final {
   void UnpackAndRegisterProtectedInstructions();
   void ReleaseProtectedInstructions();
 
+  // Frees the code of Liftoff functions that have been replaced by TurboFan
+  // code, except for their tier-up prologue, unless they are still executing
+  // on a stack of {isolate}. The memory is reused for code added later.
+  // Returns the number of bytes freed.
+  size_t FreeSupersededCode(Isolate* isolate);
+
   // Returns the instruction start of code suitable for indirect or import calls
   // for the given function index. If the code at the given index is the lazy
   // compile stub, it will clone a non-anonymous lazy compile stub for the
@@ -311,9 +331,16 @@ class V8_EXPORT_PRIVATE NativeModule final {
   Vector<WasmCode*> code_table() const {
     return {code_table_.get(), num_functions_ - num_imported_functions_};
   }
+  // With --wasm-dynamic-tiering, Liftoff code decrements the budget of its
+  // function on every call and loop iteration and requests tier-up once it
+  // drops below zero. Indexed by function index minus the number of imports.
+  int32_t* tiering_budgets() const { return tiering_budgets_.get(); }
   bool use_trap_handler() const { return use_trap_handler_; }
   void set_lazy_compile_frozen(bool frozen) { lazy_compile_frozen_ = frozen; }
   bool lazy_compile_frozen() const { return lazy_compile_frozen_; }
+  // Whether functions are still waiting to be deserialized on their first
+  // call (see --wasm-lazy-deserialization).
+  bool has_serialized_code() const { return !serialized_code_.empty(); }
 
   const size_t instance_id = 0;
   ~NativeModule();
@@ -362,10 +389,20 @@ class V8_EXPORT_PRIVATE NativeModule final {
   // according to the codes instruction start address to allow lookups.
   std::vector<std::unique_ptr<WasmCode>> owned_code_;
 
+  // Liftoff code that has been replaced by TurboFan code and has not been
+  // trimmed by {FreeSupersededCode} yet.
+  std::vector<WasmCode*> superseded_code_;
+
   uint32_t num_functions_;
   uint32_t num_imported_functions_;
   std::unique_ptr<WasmCode* []> code_table_;
   std::unique_ptr<WasmCode* []> lazy_compile_stubs_;
+  std::unique_ptr<int32_t[]> tiering_budgets_;
+  // With --wasm-lazy-deserialization, a copy of the serialized module from
+  // which functions are deserialized on their first call. It is released once
+  // {num_serialized_functions_} drops to zero.
+  std::vector<byte> serialized_code_;
+  uint32_t num_serialized_functions_ = 0;
 
   WasmCode* runtime_stub_table_[WasmCode::kRuntimeStubCount] = {nullptr};
 
@@ -382,6 +419,9 @@ class V8_EXPORT_PRIVATE NativeModule final {
 
   DisjointAllocationPool free_code_space_;
   DisjointAllocationPool allocated_code_space_;
+  // Committed memory within {allocated_code_space_} that was released by
+  // {FreeSupersededCode}. Allocated from before {free_code_space_}.
+  DisjointAllocationPool freed_code_space_;
   std::list<VirtualMemory> owned_code_space_;
 
   WasmCodeManager* wasm_code_manager_;
@@ -8,6 +8,7 @@
 #include "src/objects/js-promise.h"
 #include "src/wasm/module-compiler.h"
 #include "src/wasm/module-decoder.h"
+#include "src/wasm/shared-module-cache.h"
 #include "src/wasm/streaming-decoder.h"
 #include "src/wasm/wasm-objects.h"
 
@@ -15,6 +16,32 @@ namespace v8 {
 namespace internal {
 namespace wasm {
 
+namespace {
+
+// Adds successfully compiled modules to the shared module cache before
+// passing them on to the wrapped resolver.
+class SharedModuleCacheResolver : public CompilationResultResolver {
+ public:
+  SharedModuleCacheResolver(Isolate* isolate,
+                            std::unique_ptr<CompilationResultResolver> next)
+      : isolate_(isolate), next_(std::move(next)) {}
+
+  void OnCompilationSucceeded(Handle<WasmModuleObject> result) override {
+    SharedModuleCache::Get()->Insert(isolate_, result);
+    next_->OnCompilationSucceeded(result);
+  }
+
+  void OnCompilationFailed(Handle<Object> error_reason) override {
+    next_->OnCompilationFailed(error_reason);
+  }
+
+ private:
+  Isolate* isolate_;
+  std::unique_ptr<CompilationResultResolver> next_;
+};
+
+}  // namespace
+
 bool WasmEngine::SyncValidate(Isolate* isolate, const ModuleWireBytes& bytes) {
   // TODO(titzer): remove dependency on the isolate.
   if (bytes.start() == nullptr || bytes.length() == 0) return false;
@@ -39,6 +66,13 @@ MaybeHandle<WasmModuleObject> WasmEngine::SyncCompileTranslatedAsmJs(
 
 MaybeHandle<WasmModuleObject> WasmEngine::SyncCompile(
     Isolate* isolate, ErrorThrower* thrower, const ModuleWireBytes& bytes) {
+  SharedModuleCache* cache = SharedModuleCache::Get();
+  Handle<WasmModuleObject> module_object;
+  if (cache != nullptr &&
+      cache->Lookup(isolate, bytes).ToHandle(&module_object)) {
+    return module_object;
+  }
+
   ModuleResult result = SyncDecodeWasmModule(isolate, bytes.start(),
                                              bytes.end(), false, kWasmOrigin);
   if (result.failed()) {
@@ -48,8 +82,13 @@ MaybeHandle<WasmModuleObject> WasmEngine::SyncCompile(
 
   // Transfer ownership of the WasmModule to the {Managed<WasmModule>} generated
   // in {CompileToModuleObject}.
-  return CompileToModuleObject(isolate, thrower, std::move(result.val), bytes,
-                               Handle<Script>(), Vector<const byte>());
+  MaybeHandle<WasmModuleObject> maybe_module_object =
+      CompileToModuleObject(isolate, thrower, std::move(result.val), bytes,
+                            Handle<Script>(), Vector<const byte>());
+  if (cache != nullptr && maybe_module_object.ToHandle(&module_object)) {
+    cache->Insert(isolate, module_object);
+  }
+  return maybe_module_object;
 }
 
 MaybeHandle<WasmInstanceObject> WasmEngine::SyncInstantiate(
@@ -141,6 +180,9 @@ AsyncCompileJob* WasmEngine::CreateAsyncCompileJob(
     Isolate* isolate, std::unique_ptr<byte[]> bytes_copy, size_t length,
     Handle<Context> context,
     std::unique_ptr<CompilationResultResolver> resolver) {
+  if (SharedModuleCache::Get() != nullptr) {
+    resolver.reset(new SharedModuleCacheResolver(isolate, std::move(resolver)));
+  }
   AsyncCompileJob* job = new AsyncCompileJob(
       isolate, std::move(bytes_copy), length, context, std::move(resolver));
   // Pass ownership to the unique_ptr in {jobs_}.
@@ -179,6 +179,40 @@ namespace wasm {
   V(F32Sqrt, float)              \
   V(F64Sqrt, double)
 
+#define FOREACH_SIGN_EXTENSION_OP(V) \
+  V(I32SExtendI8, int32_t, int8_t)   \
+  V(I32SExtendI16, int32_t, int16_t) \
+  V(I64SExtendI8, int64_t, int8_t)   \
+  V(I64SExtendI16, int64_t, int16_t) \
+  V(I64SExtendI32, int64_t, int32_t)
+
+#define FOREACH_LOAD_MEM_OP(V)                  \
+  V(I32LoadMem8S, int32_t, int8_t, kWord8)      \
+  V(I32LoadMem8U, int32_t, uint8_t, kWord8)     \
+  V(I32LoadMem16S, int32_t, int16_t, kWord16)   \
+  V(I32LoadMem16U, int32_t, uint16_t, kWord16)  \
+  V(I64LoadMem8S, int64_t, int8_t, kWord8)      \
+  V(I64LoadMem8U, int64_t, uint8_t, kWord16)    \
+  V(I64LoadMem16S, int64_t, int16_t, kWord16)   \
+  V(I64LoadMem16U, int64_t, uint16_t, kWord16)  \
+  V(I64LoadMem32S, int64_t, int32_t, kWord32)   \
+  V(I64LoadMem32U, int64_t, uint32_t, kWord32)  \
+  V(I32LoadMem, int32_t, int32_t, kWord32)      \
+  V(I64LoadMem, int64_t, int64_t, kWord64)      \
+  V(F32LoadMem, Float32, uint32_t, kFloat32)    \
+  V(F64LoadMem, Float64, uint64_t, kFloat64)
+
+#define FOREACH_STORE_MEM_OP(V)                 \
+  V(I32StoreMem8, int32_t, int8_t, kWord8)      \
+  V(I32StoreMem16, int32_t, int16_t, kWord16)   \
+  V(I64StoreMem8, int64_t, int8_t, kWord8)      \
+  V(I64StoreMem16, int64_t, int16_t, kWord16)   \
+  V(I64StoreMem32, int64_t, int32_t, kWord32)   \
+  V(I32StoreMem, int32_t, int32_t, kWord32)     \
+  V(I64StoreMem, int64_t, int64_t, kWord64)     \
+  V(F32StoreMem, Float32, uint32_t, kFloat32)   \
+  V(F64StoreMem, Float64, uint64_t, kFloat64)
+
 namespace {
 
 constexpr uint32_t kFloat32SignBitMask = uint32_t{1} << 31;
@@ -636,6 +670,7 @@ const char* OpcodeName(uint32_t val) {
 }
 
 class SideTable;
+class RegisterCode;
 
 // Code and metadata needed to execute a function.
 struct InterpreterCode {
@@ -646,6 +681,7 @@ struct InterpreterCode {
   byte* start;                   // start of (maybe altered) code
   byte* end;                     // end of (maybe altered) code
   SideTable* side_table;         // precomputed side table for control flow.
+  RegisterCode* register_code;   // translated code, or nullptr.
 
   const byte* at(pc_t pc) { return start + pc; }
 };
@@ -655,11 +691,14 @@ struct InterpreterCode {
 // be directly executed without the need to dynamically track blocks.
 class SideTable : public ZoneObject {
  public:
-  ControlTransferMap map_;
+  // The control transfers of the function, sorted by pc. Only branching
+  // bytecodes have an entry, so this is small compared to the code itself.
+  using Transfer = std::pair<uint32_t, ControlTransferEntry>;
+  ZoneVector<Transfer> transfers_;
   uint32_t max_stack_height_ = 0;
 
   SideTable(Zone* zone, const WasmModule* module, InterpreterCode* code)
-      : map_(zone) {
+      : transfers_(zone) {
     // Create a zone for all temporary objects.
     Zone control_transfer_zone(zone->allocator(), ZONE_NAME);
 
@@ -698,7 +737,7 @@ class SideTable : public ZoneObject {
         refs.push_back({from_pc, stack_height});
       }
 
-      void Finish(ControlTransferMap* map, const byte* start) {
+      void Finish(ZoneVector<Transfer>* transfers, const byte* start) {
         DCHECK_NOT_NULL(target);
         for (auto ref : refs) {
           size_t offset = static_cast<size_t>(ref.from_pc - start);
@@ -708,10 +747,8 @@ class SideTable : public ZoneObject {
               static_cast<spdiff_t>(ref.stack_height - target_stack_height);
           TRACE("control transfer @%zu: Δpc %d, stack %u->%u = -%u\n", offset,
                 pcdiff, ref.stack_height, target_stack_height, spdiff);
-          ControlTransferEntry& entry = (*map)[offset];
-          entry.pc_diff = pcdiff;
-          entry.sp_diff = spdiff;
-          entry.target_arity = arity;
+          transfers->push_back({static_cast<uint32_t>(offset),
+                                {pcdiff, spdiff, arity}});
         }
       }
     };
@@ -737,9 +774,9 @@ class SideTable : public ZoneObject {
       Control(const byte* pc, CLabel* end_label, uint32_t exit_arity)
           : Control(pc, end_label, nullptr, exit_arity) {}
 
-      void Finish(ControlTransferMap* map, const byte* start) {
-        end_label->Finish(map, start);
-        if (else_label) else_label->Finish(map, start);
+      void Finish(ZoneVector<Transfer>* transfers, const byte* start) {
+        end_label->Finish(transfers, start);
+        if (else_label) else_label->Finish(transfers, start);
       }
     };
 
@@ -826,7 +863,7 @@ class SideTable : public ZoneObject {
           }
           DCHECK_NOT_NULL(c->else_label);
           c->else_label->Bind(i.pc() + 1);
-          c->else_label->Finish(&map_, code->orig_start);
+          c->else_label->Finish(&transfers_, code->orig_start);
           c->else_label = nullptr;
           DCHECK_GE(stack_height, c->end_label->target_stack_height);
           stack_height = c->end_label->target_stack_height;
@@ -841,7 +878,7 @@ class SideTable : public ZoneObject {
             if (c->else_label) c->else_label->Bind(i.pc());
             c->end_label->Bind(i.pc() + 1);
           }
-          c->Finish(&map_, code->orig_start);
+          c->Finish(&transfers_, code->orig_start);
           DCHECK_GE(stack_height, c->end_label->target_stack_height);
           stack_height = c->end_label->target_stack_height + c->exit_arity;
           control_stack.pop_back();
@@ -885,15 +922,540 @@ class SideTable : public ZoneObject {
     }
     DCHECK_EQ(0, control_stack.size());
     DCHECK_EQ(func_arity, stack_height);
+
+
+    // Labels are finished at the end of their block, so the transfers were
+    // collected out of order.
+    std::sort(transfers_.begin(), transfers_.end(),
+              [](const Transfer& a, const Transfer& b) {
+                return a.first < b.first;
+              });
   }
 
   ControlTransferEntry& Lookup(pc_t from) {
-    auto result = map_.find(from);
-    DCHECK(result != map_.end());
-    return result->second;
+    auto it = std::lower_bound(transfers_.begin(), transfers_.end(), from,
+                               [](const Transfer& transfer, pc_t pc) {
+                                 return transfer.first < pc;
+                               });
+    DCHECK(it != transfers_.end() && it->first == from);
+    return it->second;
   }
 };
 
+// Register code is a translation of a function body which the interpreter can
+// execute without decoding the wire bytes and without pushing every value
+// through the value stack. Registers {[0, num_locals)} hold the parameters and
+// locals of the function, and register {num_locals + h} holds the value stack
+// entry at height {h}. This is the layout of an interpreter frame, so register
+// code and bytecode can hand over execution to each other at every bytecode
+// where all values of the stack are in their stack slots.
+// Reads of locals are not copied to the stack; the instruction using the value
+// reads the register of the local directly. An instruction whose result is
+// immediately written to a local stores it there directly. Branch targets are
+// resolved to instruction indexes.
+// Instructions which are not translated (e.g. calls, grow_memory, atomics or
+// SIMD) exit to the bytecode, which executes them and then re-enters the
+// register code at the next bytecode.
+
+// Opcodes of register code instructions which do not correspond to a wasm
+// opcode. All other instructions use the opcode they were translated from.
+enum RegisterOpcode : uint16_t {
+  kRegMove = 0x100,   // dst = a
+  kRegJump,           // goto imm
+  kRegJumpIfZero,     // if (a == 0) goto imm
+  kRegJumpIfNotZero,  // if (a != 0) goto imm
+  kRegJumpTable,      // goto jump_table[imm + min(a, b)]
+  kRegReturn,         // return the b values starting at register a
+  kRegExit            // continue with the bytecode at pc, stack height b
+};
+
+struct RegisterInstr {
+  uint16_t opcode;
+  // Register operands.
+  uint32_t dst;
+  uint32_t a;
+  uint32_t b;
+  // Offset of the bytecode this instruction was translated from.
+  uint32_t pc;
+  // Constant, memory offset, global index, jump target, or the condition
+  // register of a select.
+  uint64_t imm;
+};
+
+class RegisterCode : public ZoneObject {
+ public:
+  static constexpr uint32_t kNoResumePoint = kMaxUInt32;
+
+  // Translates the body of {code}, which must already have a side table.
+  // Returns nullptr if the function cannot be translated.
+  static RegisterCode* New(Zone* zone, const WasmModule* module,
+                           InterpreterCode* code);
+
+  RegisterCode(Zone* zone, uint32_t num_locals,
+               const ZoneVector<RegisterInstr>& instrs,
+               const ZoneVector<uint32_t>& jump_table,
+               const ZoneVector<std::pair<uint32_t, uint32_t>>& resume_points)
+      : num_locals_(num_locals),
+        instrs_(instrs.begin(), instrs.end(), zone),
+        jump_table_(jump_table.begin(), jump_table.end(), zone),
+        resume_points_(resume_points.begin(), resume_points.end(), zone) {}
+
+  // Returns the index of the instruction at which execution can continue
+  // with register code at bytecode offset {pc}, or {kNoResumePoint}.
+  uint32_t ResumePoint(pc_t pc) const {
+    auto it = std::lower_bound(resume_points_.begin(), resume_points_.end(),
+                               pc, [](const std::pair<uint32_t, uint32_t>& p,
+                                      pc_t pc) { return p.first < pc; });
+    if (it == resume_points_.end() || it->first != pc) return kNoResumePoint;
+    return it->second;
+  }
+
+  const uint32_t num_locals_;
+  const ZoneVector<RegisterInstr> instrs_;
+  const ZoneVector<uint32_t> jump_table_;
+  // Pairs of bytecode offset and instruction index, sorted by offset.
+  const ZoneVector<std::pair<uint32_t, uint32_t>> resume_points_;
+};
+
+class RegisterCodeBuilder {
+ public:
+  RegisterCodeBuilder(Zone* zone, const WasmModule* module,
+                      InterpreterCode* code)
+      : zone_(zone),
+        module_(module),
+        code_(code),
+        num_locals_(static_cast<uint32_t>(
+            code->function->sig->parameter_count() +
+            code->locals.type_list.size())),
+        instrs_(zone),
+        jump_table_(zone),
+        resume_points_(zone),
+        stack_(zone),
+        control_(zone) {}
+
+  // Translates the function body. Returns false if it uses a construct the
+  // register code does not support.
+  bool Build() {
+    uint32_t return_count =
+        static_cast<uint32_t>(code_->function->sig->return_count());
+    control_.emplace_back(zone_, 0, return_count, return_count, false);
+    bool add_resume_point = true;
+    for (BytecodeIterator i(code_->orig_start + code_->locals.encoded_size,
+                            code_->orig_end);
+         i.has_next(); i.next()) {
+      pc_ = static_cast<uint32_t>(i.pc() - code_->orig_start);
+      if (add_resume_point) {
+        resume_points_.emplace_back(pc_, NextIndex());
+        last_result_ = kNoInstr;
+        add_resume_point = false;
+      }
+      WasmOpcode opcode = i.current();
+      if (control_.back().unreachable) {
+        // Only track the nesting of blocks in unreachable code.
+        if (opcode == kExprBlock || opcode == kExprLoop || opcode == kExprIf) {
+          control_.emplace_back(zone_, height(), 0, 0, false);
+          control_.back().unreachable = true;
+          control_.back().dead = true;
+          continue;
+        }
+        if (opcode != kExprElse && opcode != kExprEnd) continue;
+        if (control_.back().dead) {
+          if (opcode == kExprEnd) control_.pop_back();
+          continue;
+        }
+      }
+      switch (opcode) {
+        case kExprNop:
+          break;
+        case kExprBlock:
+        case kExprLoop:
+        case kExprIf: {
+          BlockTypeImmediate<Decoder::kNoValidate> imm(&i, i.pc());
+          // Blocks with parameters are not supported.
+          if (imm.type == kWasmVar) return false;
+          uint32_t cond = opcode == kExprIf ? Pop() : 0;
+          // Branches to the block only move the values they carry, so all
+          // other values must already be in their stack slots.
+          MaterializeAll();
+          bool is_loop = opcode == kExprLoop;
+          control_.emplace_back(zone_, height(), is_loop ? 0 : imm.out_arity(),
+                                imm.out_arity(), is_loop);
+          Control* c = &control_.back();
+          if (is_loop) {
+            c->loop_start = NextIndex();
+            last_result_ = kNoInstr;
+          }
+          if (opcode == kExprIf) c->else_jump = Emit(kRegJumpIfZero, cond, 0);
+          break;
+        }
+        case kExprElse: {
+          Control* c = &control_.back();
+          if (!c->unreachable) {
+            MaterializeEnd(c);
+            c->end_jumps.push_back(Emit(kRegJump, 0, 0));
+          }
+          Bind(c->else_jump);
+          c->else_jump = kNoInstr;
+          c->unreachable = false;
+          stack_.resize(c->height);
+          break;
+        }
+        case kExprEnd: {
+          Control* c = &control_.back();
+          if (!c->unreachable) MaterializeEnd(c);
+          if (c->else_jump != kNoInstr) Bind(c->else_jump);
+          for (uint32_t jump : c->end_jumps) Bind(jump);
+          last_result_ = kNoInstr;
+          uint32_t end_height = c->height;
+          uint32_t end_arity = c->end_arity;
+          control_.pop_back();
+          stack_.resize(end_height);
+          for (uint32_t k = 0; k < end_arity; ++k) PushSlot();
+          if (control_.empty()) Emit(kRegReturn, StackSlot(0), end_arity);
+          break;
+        }
+        case kExprBr: {
+          BreakDepthImmediate<Decoder::kNoValidate> imm(&i, i.pc());
+          EmitBranch(imm.depth, kRegJump, 0);
+          control_.back().unreachable = true;
+          break;
+        }
+        case kExprBrIf: {
+          BreakDepthImmediate<Decoder::kNoValidate> imm(&i, i.pc());
+          uint32_t cond = Pop();
+          if (!NeedsBranchMoves(imm.depth)) {
+            EmitBranch(imm.depth, kRegJumpIfNotZero, cond);
+            break;
+          }
+          uint32_t skip = Emit(kRegJumpIfZero, cond, 0);
+          EmitBranch(imm.depth, kRegJump, 0);
+          Bind(skip);
+          break;
+        }
+        case kExprBrTable: {
+          BranchTableImmediate<Decoder::kNoValidate> imm(&i, i.pc());
+          BranchTableIterator<Decoder::kNoValidate> iterator(&i, imm);
+          uint32_t key = Pop();
+          uint32_t table = static_cast<uint32_t>(jump_table_.size());
+          Emit(kRegJumpTable, key, imm.table_count, table);
+          jump_table_.resize(table + imm.table_count + 1);
+          // Each entry jumps to its own branch, which moves the values the
+          // branch carries to the stack slots of the target.
+          while (iterator.has_next()) {
+            uint32_t index = iterator.cur_index();
+            uint32_t depth = iterator.next();
+            jump_table_[table + index] = NextIndex();
+            EmitBranch(depth, kRegJump, 0);
+          }
+          control_.back().unreachable = true;
+          break;
+        }
+        case kExprReturn: {
+          uint32_t arity = control_[0].end_arity;
+          uint32_t first = 0;
+          if (arity == 1) {
+            first = stack_.back();
+          } else if (arity > 1) {
+            for (uint32_t h = height() - arity; h < height(); ++h) {
+              Materialize(h);
+            }
+            first = StackSlot(height() - arity);
+          }
+          Emit(kRegReturn, first, arity);
+          control_.back().unreachable = true;
+          break;
+        }
+        case kExprUnreachable: {
+          Emit(kExprUnreachable, 0, 0);
+          control_.back().unreachable = true;
+          break;
+        }
+        case kExprI32Const: {
+          ImmI32Immediate<Decoder::kNoValidate> imm(&i, i.pc());
+          EmitResult(opcode, PushSlot(), 0, 0,
+                     static_cast<uint32_t>(imm.value));
+          break;
+        }
+        case kExprI64Const: {
+          ImmI64Immediate<Decoder::kNoValidate> imm(&i, i.pc());
+          EmitResult(opcode, PushSlot(), 0, 0,
+                     static_cast<uint64_t>(imm.value));
+          break;
+        }
+        case kExprF32Const: {
+          ImmF32Immediate<Decoder::kNoValidate> imm(&i, i.pc());
+          EmitResult(opcode, PushSlot(), 0, 0, bit_cast<uint32_t>(imm.value));
+          break;
+        }
+        case kExprF64Const: {
+          ImmF64Immediate<Decoder::kNoValidate> imm(&i, i.pc());
+          EmitResult(opcode, PushSlot(), 0, 0, bit_cast<uint64_t>(imm.value));
+          break;
+        }
+        case kExprGetLocal: {
+          LocalIndexImmediate<Decoder::kNoValidate> imm(&i, i.pc());
+          stack_.push_back(imm.index);
+          break;
+        }
+        case kExprSetLocal:
+        case kExprTeeLocal: {
+          LocalIndexImmediate<Decoder::kNoValidate> imm(&i, i.pc());
+          SetLocal(imm.index, Pop());
+          if (opcode == kExprTeeLocal) stack_.push_back(imm.index);
+          break;
+        }
+        case kExprDrop:
+          Pop();
+          break;
+        case kExprSelect: {
+          uint32_t cond = Pop();
+          uint32_t fval = Pop();
+          uint32_t tval = Pop();
+          EmitResult(opcode, PushSlot(), tval, fval, cond);
+          break;
+        }
+        case kExprGetGlobal: {
+          GlobalIndexImmediate<Decoder::kNoValidate> imm(&i, i.pc());
+          EmitResult(opcode, PushSlot(), 0, 0, imm.index);
+          break;
+        }
+        case kExprSetGlobal: {
+          GlobalIndexImmediate<Decoder::kNoValidate> imm(&i, i.pc());
+          Emit(opcode, Pop(), 0, imm.index);
+          break;
+        }
+        case kExprMemorySize:
+          EmitResult(opcode, PushSlot(), 0, 0);
+          break;
+
+#define TRANSLATE_LOAD(name, ctype, mtype, rep)                     \
+  case kExpr##name: {                                               \
+    MemoryAccessImmediate<Decoder::kNoValidate> imm(&i, i.pc(),     \
+                                                    sizeof(ctype)); \
+    uint32_t index = Pop();                                         \
+    EmitResult(opcode, PushSlot(), index, 0, imm.offset);           \
+    break;                                                          \
+  }
+          FOREACH_LOAD_MEM_OP(TRANSLATE_LOAD)
+#undef TRANSLATE_LOAD
+
+#define TRANSLATE_STORE(name, ctype, mtype, rep)                    \
+  case kExpr##name: {                                               \
+    MemoryAccessImmediate<Decoder::kNoValidate> imm(&i, i.pc(),     \
+                                                    sizeof(ctype)); \
+    uint32_t value = Pop();                                         \
+    uint32_t index = Pop();                                         \
+    Emit(opcode, index, value, imm.offset);                         \
+    break;                                                          \
+  }
+          FOREACH_STORE_MEM_OP(TRANSLATE_STORE)
+#undef TRANSLATE_STORE
+
+#define CASE_OPCODE(name, ...) case kExpr##name:
+          FOREACH_SIMPLE_BINOP(CASE_OPCODE)
+          FOREACH_OTHER_BINOP(CASE_OPCODE) {
+            uint32_t rval = Pop();
+            uint32_t lval = Pop();
+            EmitResult(opcode, PushSlot(), lval, rval);
+            break;
+          }
+          FOREACH_OTHER_UNOP(CASE_OPCODE)
+          FOREACH_I32CONV_FLOATOP(CASE_OPCODE)
+          FOREACH_SIGN_EXTENSION_OP(CASE_OPCODE)
+        case kExprI32ReinterpretF32:
+        case kExprI64ReinterpretF64: {
+          uint32_t val = Pop();
+          EmitResult(opcode, PushSlot(), val, 0);
+          break;
+        }
+#undef CASE_OPCODE
+
+        default: {
+          // Everything else is executed by the bytecode.
+          MaterializeAll();
+          Emit(kRegExit, 0, height());
+          std::pair<uint32_t, uint32_t> stack_effect =
+              StackEffect(module_, code_->function->sig, i.pc(), i.end());
+          DCHECK_GE(height(), stack_effect.first);
+          stack_.resize(height() - stack_effect.first);
+          for (uint32_t k = 0; k < stack_effect.second; ++k) PushSlot();
+          add_resume_point = true;
+          break;
+        }
+      }
+    }
+    DCHECK(control_.empty());
+    return true;
+  }
+
+  RegisterCode* Finish(Zone* zone) {
+    return new (zone) RegisterCode(zone, num_locals_, instrs_, jump_table_,
+                                   resume_points_);
+  }
+
+ private:
+  static constexpr uint32_t kNoInstr = kMaxUInt32;
+
+  // An entry in the control stack.
+  struct Control {
+    // Stack height at the start of the block.
+    uint32_t height;
+    // Number of values carried by a branch to this block.
+    uint32_t br_arity;
+    // Number of values on the stack after the end of the block.
+    uint32_t end_arity;
+    bool is_loop;
+    // Whether the rest of the block is unreachable.
+    bool unreachable = false;
+    // Whether the whole block is unreachable and thus not translated.
+    bool dead = false;
+    uint32_t loop_start = 0;
+    // The jump of an if to its else branch, until that is bound.
+    uint32_t else_jump = kNoInstr;
+    // The jumps to the end of the block.
+    ZoneVector<uint32_t> end_jumps;
+
+    Control(Zone* zone, uint32_t height, uint32_t br_arity, uint32_t end_arity,
+            bool is_loop)
+        : height(height),
+          br_arity(br_arity),
+          end_arity(end_arity),
+          is_loop(is_loop),
+          end_jumps(zone) {}
+  };
+
+  uint32_t height() const { return static_cast<uint32_t>(stack_.size()); }
+  uint32_t StackSlot(uint32_t height) const { return num_locals_ + height; }
+  uint32_t NextIndex() const { return static_cast<uint32_t>(instrs_.size()); }
+
+  uint32_t Pop() {
+    DCHECK(!stack_.empty());
+    uint32_t reg = stack_.back();
+    stack_.pop_back();
+    return reg;
+  }
+
+  uint32_t PushSlot() {
+    uint32_t reg = StackSlot(height());
+    stack_.push_back(reg);
+    return reg;
+  }
+
+  uint32_t Emit(uint16_t opcode, uint32_t a, uint32_t b, uint64_t imm = 0) {
+    instrs_.push_back({opcode, 0, a, b, pc_, imm});
+    last_result_ = kNoInstr;
+    return NextIndex() - 1;
+  }
+
+  // Emits an instruction writing {dst}, which a following set_local can make
+  // write the local directly.
+  void EmitResult(uint16_t opcode, uint32_t dst, uint32_t a, uint32_t b,
+                  uint64_t imm = 0) {
+    instrs_.push_back({opcode, dst, a, b, pc_, imm});
+    last_result_ = NextIndex() - 1;
+  }
+
+  // Makes the jump at index {jump} target the next instruction.
+  void Bind(uint32_t jump) {
+    instrs_[jump].imm = NextIndex();
+    last_result_ = kNoInstr;
+  }
+
+  // Copies the value at stack height {h} into its stack slot, if it is still
+  // read from a local.
+  void Materialize(uint32_t h) {
+    uint32_t slot = StackSlot(h);
+    if (stack_[h] == slot) return;
+    EmitResult(kRegMove, slot, stack_[h], 0);
+    stack_[h] = slot;
+  }
+
+  void MaterializeAll() {
+    for (uint32_t h = 0; h < height(); ++h) Materialize(h);
+  }
+
+  void MaterializeEnd(Control* c) {
+    DCHECK_EQ(c->height + c->end_arity, height());
+    for (uint32_t h = c->height; h < height(); ++h) Materialize(h);
+  }
+
+  Control* BranchTarget(uint32_t depth) {
+    DCHECK_GT(control_.size(), depth);
+    return &control_[control_.size() - depth - 1];
+  }
+
+  bool NeedsBranchMoves(uint32_t depth) {
+    Control* target = BranchTarget(depth);
+    uint32_t first = height() - target->br_arity;
+    for (uint32_t k = 0; k < target->br_arity; ++k) {
+      if (stack_[first + k] != StackSlot(target->height + k)) return true;
+    }
+    return false;
+  }
+
+  // Moves the values carried by the branch to the stack slots of the target,
+  // then emits the jump.
+  void EmitBranch(uint32_t depth, uint16_t opcode, uint32_t cond) {
+    Control* target = BranchTarget(depth);
+    uint32_t first = height() - target->br_arity;
+    for (uint32_t k = 0; k < target->br_arity; ++k) {
+      uint32_t slot = StackSlot(target->height + k);
+      if (stack_[first + k] != slot) {
+        EmitResult(kRegMove, slot, stack_[first + k], 0);
+      }
+    }
+    if (target->is_loop) {
+      Emit(opcode, cond, 0, target->loop_start);
+    } else {
+      target->end_jumps.push_back(Emit(opcode, cond, 0));
+    }
+  }
+
+  void SetLocal(uint32_t local, uint32_t value) {
+    if (value == local) return;
+    bool local_on_stack =
+        std::find(stack_.begin(), stack_.end(), local) != stack_.end();
+    if (!local_on_stack && value == StackSlot(height()) &&
+        last_result_ != kNoInstr && instrs_[last_result_].dst == value) {
+      // Let the instruction which computed the value write the local.
+      instrs_[last_result_].dst = local;
+      last_result_ = kNoInstr;
+      return;
+    }
+    // Values read from the local before must keep the old value.
+    for (uint32_t h = 0; h < height(); ++h) {
+      if (stack_[h] == local) Materialize(h);
+    }
+    EmitResult(kRegMove, local, value, 0);
+    last_result_ = kNoInstr;
+  }
+
+  Zone* zone_;
+  const WasmModule* module_;
+  InterpreterCode* code_;
+  const uint32_t num_locals_;
+  ZoneVector<RegisterInstr> instrs_;
+  ZoneVector<uint32_t> jump_table_;
+  ZoneVector<std::pair<uint32_t, uint32_t>> resume_points_;
+  // The register holding each value of the stack.
+  ZoneVector<uint32_t> stack_;
+  ZoneVector<Control> control_;
+  // Offset of the bytecode being translated.
+  uint32_t pc_ = 0;
+  // The last instruction, if it wrote a result that can be retargeted.
+  uint32_t last_result_ = kNoInstr;
+};
+
+// static
+RegisterCode* RegisterCode::New(Zone* zone, const WasmModule* module,
+                                InterpreterCode* code) {
+  DCHECK_NOT_NULL(code->side_table);
+  Zone translation_zone(zone->allocator(), ZONE_NAME);
+  RegisterCodeBuilder builder(&translation_zone, module, code);
+  if (!builder.Build()) return nullptr;
+  return builder.Finish(zone);
+}
+
 struct ExternalCallResult {
   enum Type {
     // The function should be executed inside this interpreter.
@@ -1003,16 +1565,23 @@ class CodeMap {
     if (!code->side_table && code->start) {
       // Compute the control targets map and the local declarations.
       code->side_table = new (zone_) SideTable(zone_, module_, code);
+      if (FLAG_wasm_interpreter_register_code && !FLAG_wasm_trace_memory) {
+        code->register_code = RegisterCode::New(zone_, module_, code);
+      }
     }
     return code;
   }
 
   void AddFunction(const WasmFunction* function, const byte* code_start,
                    const byte* code_end) {
-    InterpreterCode code = {
-        function, BodyLocalDecls(zone_),         code_start,
-        code_end, const_cast<byte*>(code_start), const_cast<byte*>(code_end),
-        nullptr};
+    InterpreterCode code = {function,
+                            BodyLocalDecls(zone_),
+                            code_start,
+                            code_end,
+                            const_cast<byte*>(code_start),
+                            const_cast<byte*>(code_end),
+                            nullptr,
+                            nullptr};
 
     DCHECK_EQ(interpreter_code_.size(), function->func_index);
     interpreter_code_.push_back(code);
@@ -1028,6 +1597,7 @@ class CodeMap {
     code->start = const_cast<byte*>(start);
     code->end = const_cast<byte*>(end);
     code->side_table = nullptr;
+    code->register_code = nullptr;
     Preprocess(code);
   }
 };
@@ -1162,6 +1732,8 @@ class ThreadImpl {
 
   uint64_t NumInterpretedCalls() { return num_interpreted_calls_; }
 
+  uint64_t NumRegisterCodeCalls() { return num_register_code_calls_; }
+
   void AddBreakFlags(uint8_t flags) { break_flags_ |= flags; }
 
   void ClearBreakFlags() { break_flags_ = WasmInterpreter::BreakFlag::None; }
@@ -1252,6 +1824,7 @@ class ThreadImpl {
   bool possible_nondeterminism_ = false;
   uint8_t break_flags_ = 0;  // a combination of WasmInterpreter::BreakFlag
   uint64_t num_interpreted_calls_ = 0;
+  uint64_t num_register_code_calls_ = 0;
   // Store the stack height of each activation (for unwind and frame
   // inspection).
   ZoneVector<Activation> activations_;
@@ -1319,7 +1892,7 @@ class ThreadImpl {
     return static_cast<int>(code->side_table->Lookup(pc).pc_diff);
   }
 
-  int DoBreak(InterpreterCode* code, pc_t pc, size_t depth) {
+  int DoBreak(InterpreterCode* code, pc_t pc) {
     ControlTransferEntry& control_transfer_entry = code->side_table->Lookup(pc);
     DoStackTransfer(sp_ - control_transfer_entry.sp_diff,
                     control_transfer_entry.target_arity);
@@ -1622,6 +2195,35 @@ class ThreadImpl {
     }
   }
 
+  WasmValue GetGlobalValue(uint32_t index) {
+    const WasmGlobal* global = &module()->globals[index];
+    byte* ptr = GetGlobalPtr(global);
+    switch (global->type) {
+#define CASE_TYPE(wasm, ctype) \
+  case kWasm##wasm:            \
+    return WasmValue(*reinterpret_cast<ctype*>(ptr));
+      WASM_CTYPES(CASE_TYPE)
+#undef CASE_TYPE
+      default:
+        UNREACHABLE();
+    }
+  }
+
+  void SetGlobalValue(uint32_t index, WasmValue val) {
+    const WasmGlobal* global = &module()->globals[index];
+    byte* ptr = GetGlobalPtr(global);
+    switch (global->type) {
+#define CASE_TYPE(wasm, ctype)                        \
+  case kWasm##wasm:                                   \
+    *reinterpret_cast<ctype*>(ptr) = val.to<ctype>(); \
+    break;
+      WASM_CTYPES(CASE_TYPE)
+#undef CASE_TYPE
+      default:
+        UNREACHABLE();
+    }
+  }
+
   bool ExecuteSimdOp(WasmOpcode opcode, Decoder* decoder, InterpreterCode* code,
                      pc_t pc, int& len) {
     switch (opcode) {
@@ -1847,6 +2449,214 @@ class ThreadImpl {
     return HandleException(isolate) == WasmInterpreter::Thread::HANDLED;
   }
 
+  enum RegisterCodeResult {
+    // The current activation finished or trapped.
+    kRegisterCodeStopped,
+    // The bytecode at {pc} must execute an instruction the register code does
+    // not implement. The register code continues after it.
+    kRegisterCodeExited,
+    // Continue with the bytecode at {pc}.
+    kRegisterCodeUnavailable
+  };
+
+  // Single stepping, break flags and breakpoints all need the bytecode.
+  bool CanUseRegisterCode(InterpreterCode* code, int max) {
+    return code->register_code != nullptr && max < 0 && break_flags_ == 0 &&
+           code->start == code->orig_start;
+  }
+
+  RegisterCodeResult ExecuteRegisterCode(Decoder* decoder,
+                                         InterpreterCode** code, pc_t* pc,
+                                         pc_t* limit) {
+    RegisterCode* register_code = (*code)->register_code;
+    uint32_t index = register_code->ResumePoint(*pc);
+    if (index == RegisterCode::kNoResumePoint) return kRegisterCodeUnavailable;
+    if (index == 0) ++num_register_code_calls_;
+    TRACE("  => register code #%u @%zu\n", (*code)->function->func_index, *pc);
+    WasmValue* regs = stack_start_ + frames_.back().sp;
+    const RegisterInstr* instrs = register_code->instrs_.data();
+
+    while (true) {
+      const RegisterInstr& instr = instrs[index++];
+      switch (instr.opcode) {
+        case kRegMove:
+          regs[instr.dst] = regs[instr.a];
+          break;
+        case kRegJump:
+          index = static_cast<uint32_t>(instr.imm);
+          break;
+        case kRegJumpIfZero:
+          if (regs[instr.a].to<uint32_t>() == 0) {
+            index = static_cast<uint32_t>(instr.imm);
+          }
+          break;
+        case kRegJumpIfNotZero:
+          if (regs[instr.a].to<uint32_t>() != 0) {
+            index = static_cast<uint32_t>(instr.imm);
+          }
+          break;
+        case kRegJumpTable: {
+          uint32_t key = regs[instr.a].to<uint32_t>();
+          if (key > instr.b) key = instr.b;
+          index = register_code->jump_table_[instr.imm + key];
+          break;
+        }
+        case kRegReturn: {
+          // {DoReturn} expects the results on top of the stack.
+          sp_ = regs + instr.a + instr.b;
+          if (!DoReturn(decoder, code, pc, limit, instr.b)) {
+            return kRegisterCodeStopped;
+          }
+          if (!CanUseRegisterCode(*code, -1)) return kRegisterCodeUnavailable;
+          register_code = (*code)->register_code;
+          index = register_code->ResumePoint(*pc);
+          if (index == RegisterCode::kNoResumePoint) {
+            return kRegisterCodeUnavailable;
+          }
+          regs = stack_start_ + frames_.back().sp;
+          instrs = register_code->instrs_.data();
+          break;
+        }
+        case kRegExit:
+          sp_ = regs + register_code->num_locals_ + instr.b;
+          *pc = instr.pc;
+          return kRegisterCodeExited;
+        case kExprUnreachable:
+          DoTrap(kTrapUnreachable, instr.pc);
+          return kRegisterCodeStopped;
+        case kExprI32Const:
+          regs[instr.dst] =
+              WasmValue(static_cast<int32_t>(static_cast<uint32_t>(instr.imm)));
+          break;
+        case kExprI64Const:
+          regs[instr.dst] = WasmValue(static_cast<int64_t>(instr.imm));
+          break;
+        case kExprF32Const:
+          regs[instr.dst] =
+              WasmValue(bit_cast<float>(static_cast<uint32_t>(instr.imm)));
+          break;
+        case kExprF64Const:
+          regs[instr.dst] = WasmValue(bit_cast<double>(instr.imm));
+          break;
+        case kExprSelect: {
+          WasmValue result = regs[instr.imm].to<int32_t>() != 0
+                                 ? regs[instr.a]
+                                 : regs[instr.b];
+          regs[instr.dst] = result;
+          break;
+        }
+        case kExprGetGlobal:
+          regs[instr.dst] = GetGlobalValue(static_cast<uint32_t>(instr.imm));
+          break;
+        case kExprSetGlobal:
+          SetGlobalValue(static_cast<uint32_t>(instr.imm), regs[instr.a]);
+          break;
+        case kExprMemorySize:
+          regs[instr.dst] =
+              WasmValue(static_cast<uint32_t>(instance_object_->memory_size() /
+                                              kWasmPageSize));
+          break;
+        case kExprI32ReinterpretF32:
+          regs[instr.dst] = WasmValue(ExecuteI32ReinterpretF32(regs[instr.a]));
+          break;
+        case kExprI64ReinterpretF64:
+          regs[instr.dst] = WasmValue(ExecuteI64ReinterpretF64(regs[instr.a]));
+          break;
+
+#define LOAD_CASE(name, ctype, mtype, rep)                                 \
+  case kExpr##name: {                                                      \
+    Address addr = BoundsCheckMem<mtype>(static_cast<uint32_t>(instr.imm), \
+                                         regs[instr.a].to<uint32_t>());    \
+    if (!addr) {                                                           \
+      DoTrap(kTrapMemOutOfBounds, instr.pc);                               \
+      return kRegisterCodeStopped;                                         \
+    }                                                                      \
+    regs[instr.dst] = WasmValue(                                           \
+        converter<ctype, mtype>{}(ReadLittleEndianValue<mtype>(addr)));    \
+    break;                                                                 \
+  }
+          FOREACH_LOAD_MEM_OP(LOAD_CASE)
+#undef LOAD_CASE
+
+#define STORE_CASE(name, ctype, mtype, rep)                                \
+  case kExpr##name: {                                                      \
+    Address addr = BoundsCheckMem<mtype>(static_cast<uint32_t>(instr.imm), \
+                                         regs[instr.a].to<uint32_t>());    \
+    if (!addr) {                                                           \
+      DoTrap(kTrapMemOutOfBounds, instr.pc);                               \
+      return kRegisterCodeStopped;                                         \
+    }                                                                      \
+    WriteLittleEndianValue<mtype>(                                         \
+        addr, converter<mtype, ctype>{}(regs[instr.b].to<ctype>()));       \
+    break;                                                                 \
+  }
+          FOREACH_STORE_MEM_OP(STORE_CASE)
+#undef STORE_CASE
+
+#define SIGN_EXTENSION_CASE(name, wtype, ntype)                \
+  case kExpr##name: {                                          \
+    ntype val = static_cast<ntype>(regs[instr.a].to<wtype>()); \
+    regs[instr.dst] = WasmValue(static_cast<wtype>(val));      \
+    break;                                                     \
+  }
+          FOREACH_SIGN_EXTENSION_OP(SIGN_EXTENSION_CASE)
+#undef SIGN_EXTENSION_CASE
+
+#define EXECUTE_SIMPLE_BINOP(name, ctype, op)                             \
+  case kExpr##name: {                                                     \
+    auto result = regs[instr.a].to<ctype>() op regs[instr.b].to<ctype>(); \
+    possible_nondeterminism_ |= has_nondeterminism(result);               \
+    regs[instr.dst] = WasmValue(result);                                  \
+    break;                                                                \
+  }
+          FOREACH_SIMPLE_BINOP(EXECUTE_SIMPLE_BINOP)
+#undef EXECUTE_SIMPLE_BINOP
+
+#define EXECUTE_OTHER_BINOP(name, ctype)                           \
+  case kExpr##name: {                                              \
+    TrapReason trap = kTrapCount;                                  \
+    auto result = Execute##name(regs[instr.a].to<ctype>(),         \
+                                regs[instr.b].to<ctype>(), &trap); \
+    possible_nondeterminism_ |= has_nondeterminism(result);        \
+    if (trap != kTrapCount) {                                      \
+      DoTrap(trap, instr.pc);                                      \
+      return kRegisterCodeStopped;                                 \
+    }                                                              \
+    regs[instr.dst] = WasmValue(result);                           \
+    break;                                                         \
+  }
+          FOREACH_OTHER_BINOP(EXECUTE_OTHER_BINOP)
+#undef EXECUTE_OTHER_BINOP
+
+#define EXECUTE_UNOP(name, ctype, exec_fn)                   \
+  case kExpr##name: {                                        \
+    TrapReason trap = kTrapCount;                            \
+    auto result = exec_fn(regs[instr.a].to<ctype>(), &trap); \
+    possible_nondeterminism_ |= has_nondeterminism(result);  \
+    if (trap != kTrapCount) {                                \
+      DoTrap(trap, instr.pc);                                \
+      return kRegisterCodeStopped;                           \
+    }                                                        \
+    regs[instr.dst] = WasmValue(result);                     \
+    break;                                                   \
+  }
+
+#define EXECUTE_OTHER_UNOP(name, ctype) EXECUTE_UNOP(name, ctype, Execute##name)
+          FOREACH_OTHER_UNOP(EXECUTE_OTHER_UNOP)
+#undef EXECUTE_OTHER_UNOP
+
+#define EXECUTE_I32CONV_FLOATOP(name, out_type, in_type) \
+  EXECUTE_UNOP(name, in_type, ExecuteConvert<out_type>)
+          FOREACH_I32CONV_FLOATOP(EXECUTE_I32CONV_FLOATOP)
+#undef EXECUTE_I32CONV_FLOATOP
+#undef EXECUTE_UNOP
+
+        default:
+          UNREACHABLE();
+      }
+    }
+  }
+
   void Execute(InterpreterCode* code, pc_t pc, int max) {
     DCHECK_NOT_NULL(code->side_table);
     DCHECK(!frames_.empty());
@@ -1860,6 +2670,10 @@ class ThreadImpl {
     Decoder decoder(code->start, code->end);
     pc_t limit = code->end - code->start;
     bool hit_break = false;
+    // Whether to try to continue with the register code of {code} at {pc}.
+    // This is set whenever the current function changes, and after executing
+    // an instruction the register code exited for.
+    bool try_register_code = true;
 
     while (true) {
 #define PAUSE_IF_BREAK_FLAG(flag)                                     \
@@ -1868,6 +2682,21 @@ class ThreadImpl {
     max = 0;                                                          \
   }
 
+      if (V8_UNLIKELY(try_register_code)) {
+        try_register_code = false;
+        if (CanUseRegisterCode(code, max)) {
+          switch (ExecuteRegisterCode(&decoder, &code, &pc, &limit)) {
+            case kRegisterCodeStopped:
+              return;
+            case kRegisterCodeExited:
+              try_register_code = true;
+              break;
+            case kRegisterCodeUnavailable:
+              break;
+          }
+        }
+      }
+
       DCHECK_GT(limit, pc);
       DCHECK_NOT_NULL(code->start);
 
@@ -1956,8 +2785,7 @@ class ThreadImpl {
           break;
         }
         case kExprBr: {
-          BreakDepthImmediate<Decoder::kNoValidate> imm(&decoder, code->at(pc));
-          len = DoBreak(code, pc, imm.depth);
+          len = DoBreak(code, pc);
           TRACE("  br => @%zu\n", pc + len);
           break;
         }
@@ -1966,7 +2794,7 @@ class ThreadImpl {
           WasmValue cond = Pop();
           bool is_true = cond.to<uint32_t>() != 0;
           if (is_true) {
-            len = DoBreak(code, pc, imm.depth);
+            len = DoBreak(code, pc);
             TRACE("  br_if => @%zu\n", pc + len);
           } else {
             TRACE("  false => fallthrough\n");
@@ -1977,21 +2805,18 @@ class ThreadImpl {
         case kExprBrTable: {
           BranchTableImmediate<Decoder::kNoValidate> imm(&decoder,
                                                          code->at(pc));
-          BranchTableIterator<Decoder::kNoValidate> iterator(&decoder, imm);
           uint32_t key = Pop().to<uint32_t>();
-          uint32_t depth = 0;
           if (key >= imm.table_count) key = imm.table_count;
-          for (uint32_t i = 0; i <= key; i++) {
-            DCHECK(iterator.has_next());
-            depth = iterator.next();
-          }
-          len = key + DoBreak(code, pc + key, static_cast<size_t>(depth));
+          // The side table has an entry for every table index at {pc + key},
+          // so there is no need to decode the table up to {key}.
+          len = key + DoBreak(code, pc + key);
           TRACE("  br[%u] => @%zu\n", key, pc + key + len);
           break;
         }
         case kExprReturn: {
           size_t arity = code->function->sig->return_count();
           if (!DoReturn(&decoder, &code, &pc, &limit, arity)) return;
+          try_register_code = true;
           PAUSE_IF_BREAK_FLAG(AfterReturn);
           continue;
         }
@@ -2080,6 +2905,7 @@ class ThreadImpl {
           // Execute an internal call.
           if (!DoCall(&decoder, target, &pc, &limit)) return;
           code = target;
+          try_register_code = true;
           PAUSE_IF_BREAK_FLAG(AfterCall);
           continue;  // don't bump pc
         } break;
@@ -2097,6 +2923,7 @@ class ThreadImpl {
               if (!DoCall(&decoder, result.interpreter_code, &pc, &limit))
                 return;
               code = result.interpreter_code;
+              try_register_code = true;
               PAUSE_IF_BREAK_FLAG(AfterCall);
               continue;  // don't bump pc
             case ExternalCallResult::INVALID_FUNC:
@@ -2114,39 +2941,14 @@ class ThreadImpl {
         case kExprGetGlobal: {
           GlobalIndexImmediate<Decoder::kNoValidate> imm(&decoder,
                                                          code->at(pc));
-          const WasmGlobal* global = &module()->globals[imm.index];
-          byte* ptr = GetGlobalPtr(global);
-          WasmValue val;
-          switch (global->type) {
-#define CASE_TYPE(wasm, ctype)                       \
-  case kWasm##wasm:                                  \
-    val = WasmValue(*reinterpret_cast<ctype*>(ptr)); \
-    break;
-            WASM_CTYPES(CASE_TYPE)
-#undef CASE_TYPE
-            default:
-              UNREACHABLE();
-          }
-          Push(val);
+          Push(GetGlobalValue(imm.index));
           len = 1 + imm.length;
           break;
         }
         case kExprSetGlobal: {
           GlobalIndexImmediate<Decoder::kNoValidate> imm(&decoder,
                                                          code->at(pc));
-          const WasmGlobal* global = &module()->globals[imm.index];
-          byte* ptr = GetGlobalPtr(global);
-          WasmValue val = Pop();
-          switch (global->type) {
-#define CASE_TYPE(wasm, ctype)                        \
-  case kWasm##wasm:                                   \
-    *reinterpret_cast<ctype*>(ptr) = val.to<ctype>(); \
-    break;
-            WASM_CTYPES(CASE_TYPE)
-#undef CASE_TYPE
-            default:
-              UNREACHABLE();
-          }
+          SetGlobalValue(imm.index, Pop());
           len = 1 + imm.length;
           break;
         }
@@ -2159,20 +2961,7 @@ class ThreadImpl {
     break;                                                      \
   }
 
-          LOAD_CASE(I32LoadMem8S, int32_t, int8_t, kWord8);
-          LOAD_CASE(I32LoadMem8U, int32_t, uint8_t, kWord8);
-          LOAD_CASE(I32LoadMem16S, int32_t, int16_t, kWord16);
-          LOAD_CASE(I32LoadMem16U, int32_t, uint16_t, kWord16);
-          LOAD_CASE(I64LoadMem8S, int64_t, int8_t, kWord8);
-          LOAD_CASE(I64LoadMem8U, int64_t, uint8_t, kWord16);
-          LOAD_CASE(I64LoadMem16S, int64_t, int16_t, kWord16);
-          LOAD_CASE(I64LoadMem16U, int64_t, uint16_t, kWord16);
-          LOAD_CASE(I64LoadMem32S, int64_t, int32_t, kWord32);
-          LOAD_CASE(I64LoadMem32U, int64_t, uint32_t, kWord32);
-          LOAD_CASE(I32LoadMem, int32_t, int32_t, kWord32);
-          LOAD_CASE(I64LoadMem, int64_t, int64_t, kWord64);
-          LOAD_CASE(F32LoadMem, Float32, uint32_t, kFloat32);
-          LOAD_CASE(F64LoadMem, Float64, uint64_t, kFloat64);
+          FOREACH_LOAD_MEM_OP(LOAD_CASE)
 #undef LOAD_CASE
 
 #define STORE_CASE(name, ctype, mtype, rep)                      \
@@ -2183,15 +2972,7 @@ class ThreadImpl {
     break;                                                       \
   }
 
-          STORE_CASE(I32StoreMem8, int32_t, int8_t, kWord8);
-          STORE_CASE(I32StoreMem16, int32_t, int16_t, kWord16);
-          STORE_CASE(I64StoreMem8, int64_t, int8_t, kWord8);
-          STORE_CASE(I64StoreMem16, int64_t, int16_t, kWord16);
-          STORE_CASE(I64StoreMem32, int64_t, int32_t, kWord32);
-          STORE_CASE(I32StoreMem, int32_t, int32_t, kWord32);
-          STORE_CASE(I64StoreMem, int64_t, int64_t, kWord64);
-          STORE_CASE(F32StoreMem, Float32, uint32_t, kFloat32);
-          STORE_CASE(F64StoreMem, Float64, uint64_t, kFloat64);
+          FOREACH_STORE_MEM_OP(STORE_CASE)
 #undef STORE_CASE
 
 #define ASMJS_LOAD_CASE(name, ctype, mtype, defval)                 \
@@ -2278,11 +3059,7 @@ class ThreadImpl {
     Push(WasmValue(static_cast<wtype>(val)));          \
     break;                                             \
   }
-          SIGN_EXTENSION_CASE(I32SExtendI8, int32_t, int8_t);
-          SIGN_EXTENSION_CASE(I32SExtendI16, int32_t, int16_t);
-          SIGN_EXTENSION_CASE(I64SExtendI8, int64_t, int8_t);
-          SIGN_EXTENSION_CASE(I64SExtendI16, int64_t, int16_t);
-          SIGN_EXTENSION_CASE(I64SExtendI32, int64_t, int32_t);
+          FOREACH_SIGN_EXTENSION_OP(SIGN_EXTENSION_CASE)
 #undef SIGN_EXTENSION_CASE
         case kNumericPrefix: {
           ++len;
@@ -2365,6 +3142,7 @@ class ThreadImpl {
         if (!DoReturn(&decoder, &code, &pc, &limit,
                       code->function->sig->return_count()))
           return;
+        try_register_code = true;
         PAUSE_IF_BREAK_FLAG(AfterReturn);
       }
 #undef PAUSE_IF_BREAK_FLAG
@@ -2810,6 +3588,9 @@ bool WasmInterpreter::Thread::PossibleNondeterminism() {
 uint64_t WasmInterpreter::Thread::NumInterpretedCalls() {
   return ToImpl(this)->NumInterpretedCalls();
 }
+uint64_t WasmInterpreter::Thread::NumRegisterCodeCalls() {
+  return ToImpl(this)->NumRegisterCodeCalls();
+}
 void WasmInterpreter::Thread::AddBreakFlags(uint8_t flags) {
   ToImpl(this)->AddBreakFlags(flags);
 }
@@ -2950,12 +3731,18 @@ ControlTransferMap WasmInterpreter::ComputeControlTransfersForTesting(
   // just for testing.
   FunctionSig sig(0, 0, nullptr);
   WasmFunction function{&sig, 0, 0, {0, 0}, false, false};
-  InterpreterCode code{
-      &function, BodyLocalDecls(zone), start, end, nullptr, nullptr, nullptr};
+  InterpreterCode code{&function, BodyLocalDecls(zone), start,   end,
+                       nullptr,   nullptr,              nullptr, nullptr};
 
   // Now compute and return the control transfers.
   SideTable side_table(zone, module, &code);
-  return side_table.map_;
+  ControlTransferMap map(zone);
+  for (auto& transfer : side_table.transfers_) {
+    // Check that the binary search finds every entry.
+    CHECK_EQ(&transfer.second, &side_table.Lookup(transfer.first));
+    map.insert(transfer);
+  }
+  return map;
 }
 
 //============================================================================
@@ -2991,6 +3778,9 @@ void InterpretedFrameDeleter::operator()(InterpretedFrame* ptr) {
 #undef FOREACH_OTHER_BINOP
 #undef FOREACH_I32CONV_FLOATOP
 #undef FOREACH_OTHER_UNOP
+#undef FOREACH_SIGN_EXTENSION_OP
+#undef FOREACH_LOAD_MEM_OP
+#undef FOREACH_STORE_MEM_OP
 
 }  // namespace wasm
 }  // namespace internal
@@ -144,6 +144,8 @@ class V8_EXPORT_PRIVATE WasmInterpreter {
 
     // Returns the number of calls / function frames executed on this thread.
     uint64_t NumInterpretedCalls();
+    // Returns how many of these calls executed register code.
+    uint64_t NumRegisterCodeCalls();
 
     // Thread-specific breakpoints.
     // TODO(wasm): Implement this once we support multiple threads.
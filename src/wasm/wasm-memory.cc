@@ -14,36 +14,27 @@ namespace wasm {
 
 namespace {
 
-void* TryAllocateBackingStore(WasmMemoryTracker* memory_tracker, Heap* heap,
-                              size_t size, bool require_full_guard_regions,
-                              void** allocation_base,
-                              size_t* allocation_length) {
+// Reserves {allocation_length} bytes of inaccessible address space, collecting
+// garbage if the address space limit is reached. Returns nullptr on failure.
+void* TryReserveBackingStore(WasmMemoryTracker* memory_tracker, Heap* heap,
+                             size_t allocation_length, bool* did_retry) {
   using AllocationStatus = WasmMemoryTracker::AllocationStatus;
-#if V8_TARGET_ARCH_32_BIT
-  DCHECK(!require_full_guard_regions);
-#endif
-  // We always allocate the largest possible offset into the heap, so the
-  // addressable memory after the guard page can be made inaccessible.
-  *allocation_length =
-      require_full_guard_regions
-          ? RoundUp(kWasmMaxHeapOffset, CommitPageSize())
-          : RoundUp(
-                base::bits::RoundUpToPowerOfTwo32(static_cast<uint32_t>(size)),
-                kWasmPageSize);
-  DCHECK_GE(*allocation_length, size);
-  DCHECK_GE(*allocation_length, kWasmPageSize);
-
   // Let the WasmMemoryTracker know we are going to reserve a bunch of
   // address space.
   // Try up to three times; getting rid of dead JSArrayBuffer allocations might
   // require two GCs.
   // TODO(gc): Fix this to only require one GC (crbug.com/v8/7621).
-  bool did_retry = false;
   for (int trial = 0;; ++trial) {
-    if (memory_tracker->ReserveAddressSpace(*allocation_length)) break;
+    if (memory_tracker->ReserveAddressSpace(allocation_length)) break;
+    // Pooled reservations count against the limit, so give them up first.
+    // This does not count as one of the trials.
+    if (memory_tracker->FreePooledReservations() &&
+        memory_tracker->ReserveAddressSpace(allocation_length)) {
+      break;
+    }
     // Collect garbage and retry.
     heap->MemoryPressureNotification(MemoryPressureLevel::kCritical, true);
-    did_retry = true;
+    *did_retry = true;
     // After first and second GC: retry.
     if (trial < 2) continue;
     // We are over the address space limit. Fail.
@@ -61,13 +52,43 @@ void* TryAllocateBackingStore(WasmMemoryTracker* memory_tracker, Heap* heap,
   }
 
   // The Reserve makes the whole region inaccessible by default.
-  *allocation_base = AllocatePages(nullptr, *allocation_length, kWasmPageSize,
-                                   PageAllocator::kNoAccess);
-  if (*allocation_base == nullptr) {
-    memory_tracker->ReleaseReservation(*allocation_length);
+  void* allocation_base = AllocatePages(
+      nullptr, allocation_length, kWasmPageSize, PageAllocator::kNoAccess);
+  if (allocation_base == nullptr) {
+    memory_tracker->ReleaseReservation(allocation_length);
     memory_tracker->AddAllocationStatusSample(AllocationStatus::kOtherFailure);
     return nullptr;
   }
+  return allocation_base;
+}
+
+void* TryAllocateBackingStore(WasmMemoryTracker* memory_tracker, Heap* heap,
+                              size_t size, bool require_full_guard_regions,
+                              void** allocation_base,
+                              size_t* allocation_length) {
+  using AllocationStatus = WasmMemoryTracker::AllocationStatus;
+#if V8_TARGET_ARCH_32_BIT
+  DCHECK(!require_full_guard_regions);
+#endif
+  // We always allocate the largest possible offset into the heap, so the
+  // addressable memory after the guard page can be made inaccessible.
+  *allocation_length =
+      require_full_guard_regions
+          ? RoundUp(kWasmMaxHeapOffset, CommitPageSize())
+          : RoundUp(
+                base::bits::RoundUpToPowerOfTwo32(static_cast<uint32_t>(size)),
+                kWasmPageSize);
+  DCHECK_GE(*allocation_length, size);
+  DCHECK_GE(*allocation_length, kWasmPageSize);
+
+  bool did_retry = false;
+  *allocation_base =
+      memory_tracker->TryTakePooledReservation(*allocation_length);
+  if (*allocation_base == nullptr) {
+    *allocation_base = TryReserveBackingStore(memory_tracker, heap,
+                                              *allocation_length, &did_retry);
+    if (*allocation_base == nullptr) return nullptr;
+  }
   void* memory = *allocation_base;
 
   // Make the part we care about accessible.
@@ -91,6 +112,7 @@ void* TryAllocateBackingStore(WasmMemoryTracker* memory_tracker, Heap* heap,
 }  // namespace
 
 WasmMemoryTracker::~WasmMemoryTracker() {
+  FreePooledReservations();
   // All reserved address space should be released before the allocation tracker
   // is destroyed.
   DCHECK_EQ(reserved_address_space_, 0u);
@@ -142,7 +164,9 @@ void WasmMemoryTracker::RegisterAllocation(void* allocation_base,
 
 WasmMemoryTracker::AllocationData WasmMemoryTracker::ReleaseAllocation(
     const void* buffer_start) {
-  return InternalReleaseAllocation(buffer_start);
+  AllocationData allocation_data = InternalReleaseAllocation(buffer_start);
+  ReleaseReservation(allocation_data.allocation_length);
+  return allocation_data;
 }
 
 WasmMemoryTracker::AllocationData WasmMemoryTracker::InternalReleaseAllocation(
@@ -156,7 +180,6 @@ WasmMemoryTracker::AllocationData WasmMemoryTracker::InternalReleaseAllocation(
     size_t num_bytes = find_result->second.allocation_length;
     DCHECK_LE(num_bytes, reserved_address_space_);
     DCHECK_LE(num_bytes, allocated_address_space_);
-    reserved_address_space_ -= num_bytes;
     allocated_address_space_ -= num_bytes;
     AddAddressSpaceSample();
 
@@ -184,13 +207,76 @@ bool WasmMemoryTracker::IsWasmMemory(const void* buffer_start) {
 
 bool WasmMemoryTracker::FreeMemoryIfIsWasmMemory(const void* buffer_start) {
   if (IsWasmMemory(buffer_start)) {
-    const AllocationData allocation = ReleaseAllocation(buffer_start);
-    CHECK(FreePages(allocation.allocation_base, allocation.allocation_length));
+    // Keep the address space reserved in case the memory is pooled.
+    const AllocationData allocation = InternalReleaseAllocation(buffer_start);
+    if (!TryAddToPool(allocation)) {
+      CHECK(
+          FreePages(allocation.allocation_base, allocation.allocation_length));
+      ReleaseReservation(allocation.allocation_length);
+    }
     return true;
   }
   return false;
 }
 
+void WasmMemoryTracker::UpdateBufferLength(const void* buffer_start,
+                                           size_t buffer_length) {
+  base::LockGuard<base::Mutex> scope_lock(&mutex_);
+  auto find_result = allocations_.find(buffer_start);
+  if (find_result == allocations_.end()) return;
+  DCHECK_LE(buffer_length, find_result->second.allocation_length);
+  find_result->second.buffer_length = buffer_length;
+}
+
+bool WasmMemoryTracker::TryAddToPool(const AllocationData& allocation) {
+  if (allocation.allocation_base != allocation.buffer_start) return false;
+  {
+    base::LockGuard<base::Mutex> scope_lock(&mutex_);
+    if (pooled_reservations_.size() >= FLAG_wasm_memory_pool_size) {
+      return false;
+    }
+  }
+  // New memories must be zeroed. Decommitting what has been accessible makes
+  // it inaccessible again and zeroes it without touching every page.
+  if (allocation.buffer_length > 0) {
+    size_t accessible_length = RoundUp(allocation.buffer_length, kWasmPageSize);
+    if (!DecommitPages(allocation.buffer_start, accessible_length)) {
+      return false;
+    }
+  }
+  base::LockGuard<base::Mutex> scope_lock(&mutex_);
+  // Another memory may have been pooled in the meantime.
+  if (pooled_reservations_.size() >= FLAG_wasm_memory_pool_size) return false;
+  pooled_reservations_.emplace_back(allocation.allocation_base,
+                                    allocation.allocation_length);
+  return true;
+}
+
+void* WasmMemoryTracker::TryTakePooledReservation(size_t allocation_length) {
+  base::LockGuard<base::Mutex> scope_lock(&mutex_);
+  for (auto it = pooled_reservations_.begin(), end = pooled_reservations_.end();
+       it != end; ++it) {
+    if (it->second != allocation_length) continue;
+    void* allocation_base = it->first;
+    pooled_reservations_.erase(it);
+    return allocation_base;
+  }
+  return nullptr;
+}
+
+bool WasmMemoryTracker::FreePooledReservations() {
+  std::vector<std::pair<void*, size_t>> reservations;
+  {
+    base::LockGuard<base::Mutex> scope_lock(&mutex_);
+    reservations.swap(pooled_reservations_);
+  }
+  for (auto& reservation : reservations) {
+    CHECK(FreePages(reservation.first, reservation.second));
+    ReleaseReservation(reservation.second);
+  }
+  return !reservations.empty();
+}
+
 void WasmMemoryTracker::AddAllocationStatusSample(AllocationStatus status) {
   if (allocation_result_) {
     allocation_result_->AddSample(static_cast<int>(status));
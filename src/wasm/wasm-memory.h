@@ -7,6 +7,8 @@
 
 #include <atomic>
 #include <unordered_map>
+#include <utility>
+#include <vector>
 
 #include "src/base/platform/mutex.h"
 #include "src/flags.h"
@@ -64,6 +66,19 @@ class WasmMemoryTracker {
   // Decreases the amount of reserved address space
   void ReleaseReservation(size_t num_bytes);
 
+  // Returns the base of a pooled reservation of {allocation_length} bytes, or
+  // nullptr if there is none. The returned reservation is inaccessible and
+  // zeroed, and its address space is already reserved.
+  void* TryTakePooledReservation(size_t allocation_length);
+
+  // Frees all pooled reservations and releases their address space. Returns
+  // whether there were any.
+  bool FreePooledReservations();
+
+  // Records that the buffer starting at {buffer_start} has been grown in
+  // place to {buffer_length} bytes.
+  void UpdateBufferLength(const void* buffer_start, size_t buffer_length);
+
   // Removes an allocation from the tracker
   AllocationData ReleaseAllocation(const void* buffer_start);
 
@@ -102,9 +117,14 @@ class WasmMemoryTracker {
   void AddAllocationStatusSample(AllocationStatus status);
 
  private:
+  // Like {ReleaseAllocation}, but keeps the address space reserved.
   AllocationData InternalReleaseAllocation(const void* buffer_start);
   void AddAddressSpaceSample();
 
+  // Resets a released allocation and adds it to the pool, keeping its address
+  // space reserved. Returns false if the pool is full.
+  bool TryAddToPool(const AllocationData& allocation);
+
   // Clients use a two-part process. First they "reserve" the address space,
   // which signifies an intent to actually allocate it. This determines whether
   // doing the allocation would put us over our limit. Once there is a
@@ -125,6 +145,13 @@ class WasmMemoryTracker {
   // buffer, rather than by the start of the allocation.
   std::unordered_map<const void*, AllocationData> allocations_;
 
+  // Base and length of the reservations of freed memories that are kept for
+  // reuse, up to --wasm-memory-pool-size. Creating a guarded memory otherwise
+  // needs a fresh mapping of the whole reservation, which is expensive when
+  // instances are short-lived. Pooled reservations count towards
+  // {reserved_address_space_}, but not towards {allocated_address_space_}.
+  std::vector<std::pair<void*, size_t>> pooled_reservations_;
+
   // Keep pointers to
   Histogram* allocation_result_;
   Histogram* address_space_usage_mb_;  // in MiB
@@ -483,6 +483,8 @@ MaybeHandle<JSArrayBuffer> GrowMemoryBuffer(Isolate* isolate,
                              PageAllocator::kReadWrite)) {
         return {};
       }
+      isolate->wasm_engine()->memory_tracker()->UpdateBufferLength(
+          old_mem_start, new_size);
       reinterpret_cast<v8::Isolate*>(isolate)
           ->AdjustAmountOfExternalAllocatedMemory(pages * wasm::kWasmPageSize);
     }
@@ -805,6 +807,8 @@ Handle<WasmInstanceObject> WasmInstanceObject::New(
   instance->set_indirect_function_table_size(0);
   instance->set_indirect_function_table_sig_ids(nullptr);
   instance->set_indirect_function_table_targets(nullptr);
+  instance->set_tiering_budgets(
+      compiled_module->GetNativeModule()->tiering_budgets());
   instance->set_compiled_module(*compiled_module);
   instance->set_native_context(*isolate->native_context());
   instance->set_module_object(*module_object);
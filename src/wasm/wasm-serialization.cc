@@ -4,6 +4,8 @@
 
 #include "src/wasm/wasm-serialization.h"
 
+#include <limits>
+
 #include "src/assembler-inl.h"
 #include "src/external-reference-table.h"
 #include "src/objects-inl.h"
@@ -117,7 +119,10 @@ class Reader {
   const byte* pos_;
 };
 
-constexpr size_t kVersionSize = 4 * sizeof(uint32_t);
+// Bumped whenever the layout below the version changes.
+constexpr uint32_t kFormatVersion = 1;
+
+constexpr size_t kVersionSize = 5 * sizeof(uint32_t);
 
 void WriteVersion(Isolate* isolate, Writer* writer) {
   writer->Write(SerializedData::ComputeMagicNumber(
@@ -125,6 +130,7 @@ void WriteVersion(Isolate* isolate, Writer* writer) {
   writer->Write(Version::Hash());
   writer->Write(static_cast<uint32_t>(CpuFeatures::SupportedFeatures()));
   writer->Write(FlagList::Hash());
+  writer->Write(kFormatVersion);
 }
 
 bool IsSupportedVersion(Isolate* isolate, const Vector<const byte> version) {
@@ -190,10 +196,17 @@ uint32_t GetWasmCalleeTag(RelocInfo* rinfo) {
 #endif
 }
 
+// The header is followed by a table with one entry per non-imported function,
+// holding the offset of the function's code (relative to the start of the
+// header) or {kNoCode} if the function was not compiled when serializing. The
+// serialized code only contains tags instead of addresses, so each function
+// can be deserialized on its own and in any order.
 constexpr size_t kHeaderSize =
     sizeof(uint32_t) +  // total wasm function count
     sizeof(uint32_t);  // imported functions - i.e. index of first wasm function
 
+constexpr size_t kNoCode = std::numeric_limits<size_t>::max();
+
 constexpr size_t kCodeHeaderSize =
     sizeof(size_t) +         // size of code section
     sizeof(size_t) +         // offset of constant pool
@@ -206,6 +219,29 @@ constexpr size_t kCodeHeaderSize =
     sizeof(size_t) +         // protected instructions size
     sizeof(WasmCode::Tier);  // tier
 
+size_t OffsetTableSize(uint32_t num_wasm_functions) {
+  return num_wasm_functions * sizeof(size_t);
+}
+
+// Looks up the code of the {index}th non-imported function in {data}, which
+// starts with the header. Sets {entry} to an empty vector if the function has
+// no code. Returns false if the entry does not lie within {data}.
+bool FindCodeEntry(Vector<const byte> data, uint32_t index,
+                   Vector<const byte>* entry) {
+  Reader reader(data);
+  reader.Skip(kHeaderSize + OffsetTableSize(index));
+  size_t offset = reader.Read<size_t>();
+  *entry = {};
+  if (offset == kNoCode) return true;
+  if (offset > data.size() || data.size() - offset < kCodeHeaderSize) {
+    return false;
+  }
+  size_t code_section_size = Reader(data + offset).Read<size_t>();
+  if (code_section_size > data.size() - offset - kCodeHeaderSize) return false;
+  *entry = data.SubVector(offset, offset + kCodeHeaderSize + code_section_size);
+  return true;
+}
+
 }  // namespace
 
 class V8_EXPORT_PRIVATE NativeModuleSerializer {
@@ -218,6 +254,9 @@ class V8_EXPORT_PRIVATE NativeModuleSerializer {
 
  private:
   size_t MeasureCode(const WasmCode*) const;
+  size_t MeasureEntry(uint32_t index) const;
+  const WasmCode* GetCompiledCode(uint32_t index) const;
+  Vector<const byte> GetSerializedCode(uint32_t index) const;
 
   void WriteHeader(Writer* writer);
   void WriteCode(const WasmCode*, Writer* writer);
@@ -274,20 +313,53 @@ size_t NativeModuleSerializer::MeasureCode(const WasmCode* code) const {
              sizeof(trap_handler::ProtectedInstructionData);
 }
 
+const WasmCode* NativeModuleSerializer::GetCompiledCode(uint32_t index) const {
+  const WasmCode* code = native_module_->code(index);
+  // Functions that were not compiled yet are serialized without code.
+  if (code == nullptr || code->kind() != WasmCode::kFunction) return nullptr;
+  return code;
+}
+
+Vector<const byte> NativeModuleSerializer::GetSerializedCode(
+    uint32_t index) const {
+  // With lazy deserialization, functions which were not called yet still have
+  // their serialized code, which can be copied as is.
+  const std::vector<byte>& serialized = native_module_->serialized_code_;
+  if (serialized.empty()) return {};
+  Vector<const byte> entry;
+  CHECK(FindCodeEntry({serialized.data(), serialized.size()},
+                      index - native_module_->num_imported_functions(),
+                      &entry));
+  return entry;
+}
+
+size_t NativeModuleSerializer::MeasureEntry(uint32_t index) const {
+  const WasmCode* code = GetCompiledCode(index);
+  if (code != nullptr) return kCodeHeaderSize + MeasureCode(code);
+  return GetSerializedCode(index).size();
+}
+
 size_t NativeModuleSerializer::Measure() const {
-  size_t size = kHeaderSize;
   uint32_t first_wasm_fn = native_module_->num_imported_functions();
   uint32_t total_fns = native_module_->num_functions();
+  size_t size = kHeaderSize + OffsetTableSize(total_fns - first_wasm_fn);
   for (uint32_t i = first_wasm_fn; i < total_fns; ++i) {
-    size += kCodeHeaderSize;
-    size += MeasureCode(native_module_->code(i));
+    size += MeasureEntry(i);
   }
   return size;
 }
 
 void NativeModuleSerializer::WriteHeader(Writer* writer) {
-  writer->Write(native_module_->num_functions());
-  writer->Write(native_module_->num_imported_functions());
+  uint32_t first_wasm_fn = native_module_->num_imported_functions();
+  uint32_t total_fns = native_module_->num_functions();
+  writer->Write(total_fns);
+  writer->Write(first_wasm_fn);
+  size_t offset = kHeaderSize + OffsetTableSize(total_fns - first_wasm_fn);
+  for (uint32_t i = first_wasm_fn; i < total_fns; ++i) {
+    size_t size = MeasureEntry(i);
+    writer->Write(size == 0 ? kNoCode : offset);
+    offset += size;
+  }
 }
 
 void NativeModuleSerializer::WriteCode(const WasmCode* code, Writer* writer) {
@@ -388,8 +460,12 @@ bool NativeModuleSerializer::Write(Writer* writer) {
   uint32_t total_fns = native_module_->num_functions();
   uint32_t first_wasm_fn = native_module_->num_imported_functions();
   for (uint32_t i = first_wasm_fn; i < total_fns; ++i) {
-    const WasmCode* code = native_module_->code(i);
-    WriteCode(code, writer);
+    const WasmCode* code = GetCompiledCode(i);
+    if (code != nullptr) {
+      WriteCode(code, writer);
+    } else {
+      writer->WriteVector(GetSerializedCode(i));
+    }
   }
   return true;
 }
@@ -420,7 +496,8 @@ class V8_EXPORT_PRIVATE NativeModuleDeserializer {
   NativeModuleDeserializer() = delete;
   NativeModuleDeserializer(Isolate*, NativeModule*);
 
-  bool Read(Reader* reader);
+  bool Read(Vector<const byte> data);
+  WasmCode* ReadLazily(uint32_t fn_index);
 
  private:
   bool ReadHeader(Reader* reader);
@@ -438,24 +515,70 @@ NativeModuleDeserializer::NativeModuleDeserializer(Isolate* isolate,
                                                    NativeModule* native_module)
     : isolate_(isolate), native_module_(native_module), read_called_(false) {}
 
-bool NativeModuleDeserializer::Read(Reader* reader) {
+bool NativeModuleDeserializer::Read(Vector<const byte> data) {
   DCHECK(!read_called_);
   read_called_ = true;
 
-  if (!ReadHeader(reader)) return false;
+  Reader reader(data);
+  if (!ReadHeader(&reader)) return false;
   uint32_t total_fns = native_module_->num_functions();
   uint32_t first_wasm_fn = native_module_->num_imported_functions();
+  uint32_t num_serialized_functions = 0;
   for (uint32_t i = first_wasm_fn; i < total_fns; ++i) {
-    if (!ReadCode(i, reader)) return false;
+    Vector<const byte> entry;
+    if (!FindCodeEntry(data, i - first_wasm_fn, &entry)) return false;
+    if (!entry.is_empty()) ++num_serialized_functions;
   }
-  return reader->current_size() == 0;
+  if (num_serialized_functions < total_fns - first_wasm_fn ||
+      FLAG_wasm_lazy_deserialization) {
+    native_module_->SetLazyBuiltin(BUILTIN_CODE(isolate_, WasmCompileLazy));
+  }
+  if (FLAG_wasm_lazy_deserialization) {
+    // Keep a copy of the data, because the embedder owns {data}. Relocating
+    // the code of each function is deferred to its first call.
+    if (num_serialized_functions > 0) {
+      native_module_->serialized_code_.assign(data.begin(), data.end());
+      native_module_->num_serialized_functions_ = num_serialized_functions;
+    }
+    return true;
+  }
+  for (uint32_t i = first_wasm_fn; i < total_fns; ++i) {
+    Vector<const byte> entry;
+    FindCodeEntry(data, i - first_wasm_fn, &entry);
+    if (entry.is_empty()) continue;
+    Reader entry_reader(entry);
+    if (!ReadCode(i, &entry_reader)) return false;
+  }
+  return true;
+}
+
+WasmCode* NativeModuleDeserializer::ReadLazily(uint32_t fn_index) {
+  const std::vector<byte>& serialized = native_module_->serialized_code_;
+  if (serialized.empty()) return nullptr;
+  Vector<const byte> entry;
+  CHECK(FindCodeEntry({serialized.data(), serialized.size()},
+                      fn_index - native_module_->num_imported_functions(),
+                      &entry));
+  if (entry.is_empty()) return nullptr;
+  Reader reader(entry);
+  bool success = ReadCode(fn_index, &reader);
+  // Each function is materialized only once, either from its entry or by
+  // compiling it if the entry is unusable. Release the serialized data after
+  // the last one.
+  DCHECK_LT(0, native_module_->num_serialized_functions_);
+  if (--native_module_->num_serialized_functions_ == 0) {
+    std::vector<byte>().swap(native_module_->serialized_code_);
+  }
+  return success ? native_module_->code(fn_index) : nullptr;
 }
 
 bool NativeModuleDeserializer::ReadHeader(Reader* reader) {
+  if (reader->current_size() < kHeaderSize) return false;
   size_t functions = reader->Read<uint32_t>();
   size_t imports = reader->Read<uint32_t>();
   return functions == native_module_->num_functions() &&
-         imports == native_module_->num_imported_functions();
+         imports == native_module_->num_imported_functions() &&
+         reader->current_size() >= OffsetTableSize(functions - imports);
 }
 
 bool NativeModuleDeserializer::ReadCode(uint32_t fn_index, Reader* reader) {
@@ -564,6 +687,13 @@ Address NativeModuleDeserializer::GetBuiltinTrampolineFromTag(uint32_t tag) {
   return native_module_->GetLocalAddressFor(handle(builtin));
 }
 
+WasmCode* DeserializeFunctionLazily(Isolate* isolate,
+                                    NativeModule* native_module,
+                                    uint32_t func_index) {
+  NativeModuleDeserializer deserializer(isolate, native_module);
+  return deserializer.ReadLazily(func_index);
+}
+
 MaybeHandle<WasmModuleObject> DeserializeNativeModule(
     Isolate* isolate, Vector<const byte> data, Vector<const byte> wire_bytes) {
   if (!IsWasmCodegenAllowed(isolate, isolate->native_context())) {
@@ -577,6 +707,20 @@ MaybeHandle<WasmModuleObject> DeserializeNativeModule(
                            i::wasm::kWasmOrigin);
   if (!decode_result.ok()) return {};
   CHECK_NOT_NULL(decode_result.val);
+  return DeserializeNativeModule(isolate, data, wire_bytes,
+                                 std::move(decode_result.val));
+}
+
+MaybeHandle<WasmModuleObject> DeserializeNativeModule(
+    Isolate* isolate, Vector<const byte> data, Vector<const byte> wire_bytes,
+    std::unique_ptr<WasmModule> decoded_module) {
+  DCHECK_NOT_NULL(decoded_module);
+  if (!IsWasmCodegenAllowed(isolate, isolate->native_context())) {
+    return {};
+  }
+  if (!IsSupportedVersion(isolate, data)) {
+    return {};
+  }
   Handle<String> module_bytes =
       isolate->factory()
           ->NewStringFromOneByte(
@@ -589,7 +733,7 @@ MaybeHandle<WasmModuleObject> DeserializeNativeModule(
   size_t module_size = 0;  // TODO(titzer): estimate size properly.
   Handle<Managed<WasmModule>> managed_module =
       Managed<WasmModule>::FromUniquePtr(isolate, module_size,
-                                         std::move(decode_result.val));
+                                         std::move(decoded_module));
   Handle<Script> script = CreateWasmScript(isolate, wire_bytes);
   Handle<WasmSharedModuleData> shared = WasmSharedModuleData::New(
       isolate, managed_module, Handle<SeqOneByteString>::cast(module_bytes),
@@ -611,8 +755,7 @@ MaybeHandle<WasmModuleObject> DeserializeNativeModule(
   NativeModuleDeserializer deserializer(isolate,
                                         compiled_module->GetNativeModule());
 
-  Reader reader(data + kVersionSize);
-  if (!deserializer.Read(&reader)) return {};
+  if (!deserializer.Read(data + kVersionSize)) return {};
 
   Handle<WasmModuleObject> module_object =
       WasmModuleObject::New(isolate, compiled_module, export_wrappers, shared);
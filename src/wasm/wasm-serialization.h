@@ -18,9 +18,22 @@ bool SerializeNativeModule(Isolate* isolate,
                            Handle<WasmCompiledModule> compiled_module,
                            Vector<byte> buffer);
 
+// With --wasm-lazy-deserialization, deserializes the code of {func_index}
+// from the serialized module kept by {native_module}. Returns nullptr if there
+// is no serialized code for the function, which then has to be compiled.
+WasmCode* DeserializeFunctionLazily(Isolate* isolate,
+                                    NativeModule* native_module,
+                                    uint32_t func_index);
+
 MaybeHandle<WasmModuleObject> DeserializeNativeModule(
     Isolate* isolate, Vector<const byte> data, Vector<const byte> wire_bytes);
 
+// Like above, but takes the module already decoded from {wire_bytes}, e.g. on
+// a background thread.
+MaybeHandle<WasmModuleObject> DeserializeNativeModule(
+    Isolate* isolate, Vector<const byte> data, Vector<const byte> wire_bytes,
+    std::unique_ptr<WasmModule> decoded_module);
+
 }  // namespace wasm
 }  // namespace internal
 }  // namespace v8
@@ -0,0 +1,78 @@
+// Copyright 2018 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "src/objects-inl.h"
+#include "test/cctest/cctest.h"
+#include "test/common/wasm/flag-utils.h"
+
+namespace v8 {
+namespace internal {
+namespace compiler {
+
+namespace {
+
+const char* kSumSource =
+    "function sum(a) {"
+    "  var s = 0;"
+    "  for (var i = 0; i < a.length; ++i) s += a[i];"
+    "  return s;"
+    "}"
+    "var a = [1, 2, 3, 4];"
+    "sum(a);"
+    "sum(a);"
+    "%OptimizeFunctionOnNextCall(sum);"
+    "sum(a);";
+
+// Optimizes the loop in {kSumSource} and returns the number of
+// deoptimization points in its code.
+int OptimizeSum(bool eliminate_bounds_checks) {
+  FlagScope<bool> flag(&FLAG_turbo_bounds_check_elimination,
+                       eliminate_bounds_checks);
+  LocalContext env;
+  v8::HandleScope scope(env->GetIsolate());
+  CHECK_EQ(10, CompileRun(kSumSource)->Int32Value(env.local()).FromJust());
+  Handle<JSFunction> sum = GetGlobal<JSFunction>("sum");
+  CHECK(sum->IsOptimized());
+  return DeoptimizationData::cast(sum->code()->deoptimization_data())
+      ->DeoptCount();
+}
+
+}  // namespace
+
+TEST(EliminateBoundsChecksInLoop) {
+  if (!FLAG_opt || FLAG_always_opt) return;
+  FLAG_allow_natives_syntax = true;
+  // The loop condition dominates the element access, so the optimized code
+  // does not need to check the bounds of the index again.
+  CHECK_LT(OptimizeSum(true), OptimizeSum(false));
+}
+
+TEST(KeepBoundsChecksOutsideLoopCondition) {
+  if (!FLAG_opt || FLAG_always_opt) return;
+  FLAG_allow_natives_syntax = true;
+  LocalContext env;
+  v8::HandleScope scope(env->GetIsolate());
+  // The loop condition does not compare against the length of the array,
+  // so the optimized code must still deoptimize when the loop reads past
+  // its end.
+  CompileRun(
+      "function sumTo(a, n) {"
+      "  var s = 0;"
+      "  for (var i = 0; i < n; ++i) s += a[i] | 0;"
+      "  return s;"
+      "}"
+      "var a = [1, 2, 3];"
+      "sumTo(a, 3);"
+      "sumTo(a, 3);"
+      "%OptimizeFunctionOnNextCall(sumTo);"
+      "sumTo(a, 3);");
+  Handle<JSFunction> sum_to = GetGlobal<JSFunction>("sumTo");
+  CHECK(sum_to->IsOptimized());
+  CHECK_EQ(6, CompileRun("sumTo(a, 4)")->Int32Value(env.local()).FromJust());
+  CHECK(!sum_to->IsOptimized());
+}
+
+}  // namespace compiler
+}  // namespace internal
+}  // namespace v8
@@ -2,6 +2,7 @@
 // Use of this source code is governed by a BSD-style license that can be
 // found in the LICENSE file.
 
+#include <set>
 #include <tuple>
 
 #include "src/v8.h"
@@ -18,6 +19,7 @@
 #include "test/cctest/cctest.h"
 #include "test/cctest/interpreter/interpreter-tester.h"
 #include "test/cctest/test-feedback-vector.h"
+#include "test/common/wasm/flag-utils.h"
 
 namespace v8 {
 namespace internal {
@@ -1821,6 +1823,113 @@ TEST(InterpreterSmiComparisons) {
   }
 }
 
+TEST(InterpreterSmiComparisonsWithJumps) {
+  // The handlers of the Test bytecodes inline a directly following
+  // JumpIfTrue or JumpIfFalse, check both outcomes of both jumps.
+  int inputs[] = {-42, -1, 0, +1, 42};
+  bool jump_if_true[] = {true, false};
+
+  for (size_t c = 0; c < arraysize(kComparisonTypes); c++) {
+    Token::Value comparison = kComparisonTypes[c];
+    for (bool jump_on : jump_if_true) {
+      for (size_t i = 0; i < arraysize(inputs); i++) {
+        for (size_t j = 0; j < arraysize(inputs); j++) {
+          HandleAndZoneScope handles;
+          Isolate* isolate = handles.main_isolate();
+          Zone* zone = handles.main_zone();
+          FeedbackVectorSpec feedback_spec(zone);
+          BytecodeArrayBuilder builder(zone, 1, 1, &feedback_spec);
+
+          FeedbackSlot slot = feedback_spec.AddCompareICSlot();
+          Handle<i::FeedbackMetadata> metadata =
+              NewFeedbackMetadata(isolate, &feedback_spec);
+
+          Register r0(0);
+          BytecodeLabel jumped;
+          builder.LoadLiteral(Smi::FromInt(inputs[i]))
+              .StoreAccumulatorInRegister(r0)
+              .LoadLiteral(Smi::FromInt(inputs[j]))
+              .CompareOperation(comparison, r0, GetIndex(slot));
+          if (jump_on) {
+            builder.JumpIfTrue(ToBooleanMode::kAlreadyBoolean, &jumped);
+          } else {
+            builder.JumpIfFalse(ToBooleanMode::kAlreadyBoolean, &jumped);
+          }
+          builder.LoadLiteral(Smi::FromInt(1))
+              .Return()
+              .Bind(&jumped)
+              .LoadLiteral(Smi::FromInt(2))
+              .Return();
+
+          Handle<BytecodeArray> bytecode_array =
+              builder.ToBytecodeArray(isolate);
+
+          // Make sure the bytecode takes the lookahead path.
+          BytecodeArrayIterator iterator(bytecode_array);
+          while (!Bytecodes::IsJumpIfLookahead(
+              iterator.current_bytecode(), iterator.current_operand_scale())) {
+            iterator.Advance();
+          }
+          iterator.Advance();
+          CHECK_EQ(jump_on ? Bytecode::kJumpIfTrue : Bytecode::kJumpIfFalse,
+                   iterator.current_bytecode());
+          CHECK_EQ(OperandScale::kSingle, iterator.current_operand_scale());
+
+          InterpreterTester tester(isolate, bytecode_array, metadata);
+          auto callable = tester.GetCallable<>();
+          Handle<Object> return_value = callable().ToHandleChecked();
+          bool result = CompareC(comparison, inputs[i], inputs[j]);
+          CHECK_EQ(result == jump_on ? 2 : 1, Smi::ToInt(*return_value));
+        }
+      }
+    }
+  }
+}
+
+TEST(InterpreterLoopWithComparisonJump) {
+  // A loop whose condition is a Test bytecode followed by JumpIfFalse, taking
+  // the inlined jump on the last iteration only.
+  HandleAndZoneScope handles;
+  Isolate* isolate = handles.main_isolate();
+  Zone* zone = handles.main_zone();
+  FeedbackVectorSpec feedback_spec(zone);
+  BytecodeArrayBuilder builder(zone, 1, 3, &feedback_spec);
+
+  FeedbackSlot compare_slot = feedback_spec.AddCompareICSlot();
+  FeedbackSlot add_slot = feedback_spec.AddBinaryOpICSlot();
+  FeedbackSlot increment_slot = feedback_spec.AddBinaryOpICSlot();
+  Handle<i::FeedbackMetadata> metadata =
+      NewFeedbackMetadata(isolate, &feedback_spec);
+
+  Register i(0), sum(1), limit(2);
+  BytecodeLabel loop_header, done;
+  builder.LoadLiteral(Smi::kZero)
+      .StoreAccumulatorInRegister(i)
+      .StoreAccumulatorInRegister(sum)
+      .LoadLiteral(Smi::FromInt(100))
+      .StoreAccumulatorInRegister(limit)
+      .Bind(&loop_header)
+      .LoadAccumulatorWithRegister(limit)
+      .CompareOperation(Token::Value::LT, i, GetIndex(compare_slot))
+      .JumpIfFalse(ToBooleanMode::kAlreadyBoolean, &done)
+      .LoadAccumulatorWithRegister(i)
+      .BinaryOperation(Token::Value::ADD, sum, GetIndex(add_slot))
+      .StoreAccumulatorInRegister(sum)
+      .LoadLiteral(Smi::FromInt(1))
+      .BinaryOperation(Token::Value::ADD, i, GetIndex(increment_slot))
+      .StoreAccumulatorInRegister(i)
+      .JumpLoop(&loop_header, 0)
+      .Bind(&done)
+      .LoadAccumulatorWithRegister(sum)
+      .Return();
+
+  Handle<BytecodeArray> bytecode_array = builder.ToBytecodeArray(isolate);
+  InterpreterTester tester(isolate, bytecode_array, metadata);
+  auto callable = tester.GetCallable<>();
+  Handle<Object> return_value = callable().ToHandleChecked();
+  CHECK_EQ(4950, Smi::ToInt(*return_value));
+}
+
 TEST(InterpreterHeapNumberComparisons) {
   double inputs[] = {std::numeric_limits<double>::min(),
                      std::numeric_limits<double>::max(),
@@ -5043,6 +5152,130 @@ TEST(InterpreterWithNativeStack) {
            interpreter_entry_trampoline->InstructionStart());
 }
 
+TEST(InterpreterDispatchSamples) {
+  HandleAndZoneScope handles;
+  Isolate* isolate = handles.main_isolate();
+  v8::Isolate* v8_isolate = reinterpret_cast<v8::Isolate*>(isolate);
+  FlagScope<bool> sampling(&FLAG_ignition_dispatch_sampling, true);
+  FlagScope<int> buffer(&FLAG_ignition_dispatch_sampling_buffer, 2);
+
+  Handle<JSFunction> f = Handle<JSFunction>::cast(v8::Utils::OpenHandle(
+      *CompileRun("function f() { return 1; }; f")));
+  Interpreter* interpreter = isolate->interpreter();
+  interpreter->RecordDispatchSample(*f, Bytecode::kLdaZero, Bytecode::kStar);
+  interpreter->RecordDispatchSample(*f, Bytecode::kStar, Bytecode::kAdd);
+  interpreter->RecordDispatchSample(*f, Bytecode::kAdd, Bytecode::kReturn);
+
+  // Only the two most recent samples are kept, oldest first.
+  v8::BytecodeDispatchSample samples[3];
+  CHECK_EQ(2u, v8_isolate->GetBytecodeDispatchSamples(samples, 3));
+  CHECK_EQ(0, strcmp("Star", samples[0].bytecode));
+  CHECK_EQ(0, strcmp("Add", samples[0].next_bytecode));
+  CHECK_EQ(0, strcmp("Add", samples[1].bytecode));
+  CHECK_EQ(0, strcmp("Return", samples[1].next_bytecode));
+  CHECK_EQ(f->shared()->StartPosition(), samples[1].function_position);
+  CHECK_EQ(Script::cast(f->shared()->script())->id(), samples[1].script_id);
+
+  // The buffer passed in may be smaller than the number of samples.
+  CHECK_EQ(1u, v8_isolate->GetBytecodeDispatchSamples(samples, 1));
+  CHECK_EQ(0, strcmp("Add", samples[0].bytecode));
+}
+
+TEST(InterpreterDispatchSamplingFirstDispatch) {
+  HandleAndZoneScope handles;
+  Isolate* isolate = handles.main_isolate();
+  v8::Isolate* v8_isolate = reinterpret_cast<v8::Isolate*>(isolate);
+  FlagScope<bool> sampling(&FLAG_ignition_dispatch_sampling, true);
+  FlagScope<int> window(&FLAG_ignition_dispatch_sampling_window, 1);
+
+  Handle<JSFunction> f = Handle<JSFunction>::cast(v8::Utils::OpenHandle(
+      *CompileRun("function f(a, b) { return a + b; }; f(1, 2); f")));
+  Handle<BytecodeArray> bytecode_array(f->shared()->GetBytecodeArray(),
+                                       isolate);
+  BytecodeArrayIterator iterator(bytecode_array);
+  Bytecode first = iterator.current_bytecode();
+  iterator.Advance();
+  Bytecode second = iterator.current_bytecode();
+
+  // With a window of 1, the dispatch from the entry trampoline to the first
+  // bytecode starts the sample, and the dispatch from the handler of the
+  // first bytecode is sampled.
+  Interpreter* interpreter = isolate->interpreter();
+  interpreter->MaybeArmDispatchSampling();
+  CHECK(interpreter->IsDispatchSamplingArmed());
+  Handle<Object> args[] = {handle(Smi::FromInt(1), isolate),
+                           handle(Smi::FromInt(2), isolate)};
+  Handle<Object> result =
+      Execution::Call(isolate, f, isolate->factory()->undefined_value(),
+                      arraysize(args), args)
+          .ToHandleChecked();
+  CHECK_EQ(3, Smi::ToInt(*result));
+  CHECK(!interpreter->IsDispatchSamplingArmed());
+
+  v8::BytecodeDispatchSample sample;
+  CHECK_EQ(1u, v8_isolate->GetBytecodeDispatchSamples(&sample, 1));
+  CHECK_EQ(0, strcmp(Bytecodes::ToString(first), sample.bytecode));
+  CHECK_EQ(0, strcmp(Bytecodes::ToString(second), sample.next_bytecode));
+  CHECK_EQ(f->shared()->StartPosition(), sample.function_position);
+  CHECK_EQ(Script::cast(f->shared()->script())->id(), sample.script_id);
+}
+
+TEST(InterpreterDispatchSamplingLoop) {
+  HandleAndZoneScope handles;
+  Isolate* isolate = handles.main_isolate();
+  FlagScope<bool> sampling(&FLAG_ignition_dispatch_sampling, true);
+  // Arm the sampling by hand only, running out of interrupt budget at the end
+  // of a call would leave it armed.
+  FlagScope<int> budget(&FLAG_interrupt_budget, kMaxInt / 2);
+
+  Handle<JSFunction> f = Handle<JSFunction>::cast(v8::Utils::OpenHandle(
+      *CompileRun("function f(n) {\n"
+                  "  var s = 0;\n"
+                  "  for (var i = 0; i < n; i++) s += i;\n"
+                  "  return s;\n"
+                  "}\n"
+                  "f(1);\n"
+                  "f")));
+  Handle<BytecodeArray> bytecode_array(f->shared()->GetBytecodeArray(),
+                                       isolate);
+  std::set<Bytecode> bytecodes;
+  for (BytecodeArrayIterator iterator(bytecode_array); !iterator.done();
+       iterator.Advance()) {
+    bytecodes.insert(iterator.current_bytecode());
+  }
+  CHECK_EQ(1u, bytecodes.count(Bytecode::kTestLessThan));
+
+  Interpreter* interpreter = isolate->interpreter();
+  const int kSamples = 200;
+  Handle<Object> args[] = {handle(Smi::FromInt(100), isolate)};
+  for (int i = 0; i < kSamples; i++) {
+    interpreter->MaybeArmDispatchSampling();
+    Execution::Call(isolate, f, isolate->factory()->undefined_value(),
+                    arraysize(args), args)
+        .ToHandleChecked();
+    CHECK(!interpreter->IsDispatchSamplingArmed());
+  }
+
+  std::vector<Interpreter::DispatchSample> samples(2 * kSamples);
+  size_t count = interpreter->GetDispatchSamples(samples.data(),
+                                                 samples.size());
+  CHECK_EQ(static_cast<size_t>(kSamples), count);
+  int test_samples = 0;
+  for (size_t i = 0; i < count; i++) {
+    const Interpreter::DispatchSample& sample = samples[i];
+    CHECK_EQ(f->shared()->StartPosition(), sample.function_position);
+    CHECK_EQ(1u, bytecodes.count(sample.from));
+    CHECK_EQ(1u, bytecodes.count(sample.to));
+    // The JumpIfFalse that the TestLessThan handler executes inline still
+    // shows up as the target of its dispatch.
+    if (sample.from == Bytecode::kTestLessThan) {
+      CHECK_EQ(Bytecode::kJumpIfFalse, sample.to);
+      test_samples++;
+    }
+  }
+  CHECK_LT(0, test_samples);
+}
+
 }  // namespace interpreter
 }  // namespace internal
 }  // namespace v8
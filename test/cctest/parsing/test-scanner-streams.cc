@@ -2,6 +2,7 @@
 // Use of this source code is governed by a BSD-style license that can be
 // found in the LICENSE file.
 
+#include "src/base/platform/elapsed-timer.h"
 #include "src/heap/factory-inl.h"
 #include "src/objects-inl.h"
 #include "src/parsing/scanner-character-streams.h"
@@ -183,6 +184,43 @@ TEST(Utf8SplitBOM) {
   }
 }
 
+void CheckCloneReads(v8::internal::Utf16CharacterStream* stream,
+                     bool waits_for_data, const char* expected) {
+  std::unique_ptr<v8::internal::Utf16CharacterStream> clone(
+      stream->Clone(waits_for_data));
+  for (size_t i = 0; expected[i]; i++) {
+    CHECK_EQ(expected[i], clone->Advance());
+  }
+  CHECK_EQ(v8::internal::Utf16CharacterStream::kEndOfInput, clone->Advance());
+}
+
+TEST(Utf8StreamClones) {
+  // Clones only read the chunks that the original stream has fetched.
+  const char* chunks[] = {"abc", "def", ""};
+  ChunkSource chunk_source(chunks);
+  std::unique_ptr<v8::internal::Utf16CharacterStream> stream(
+      v8::internal::ScannerStream::For(
+          &chunk_source, v8::ScriptCompiler::StreamedSource::UTF8, nullptr));
+  CHECK(stream->can_be_cloned());
+
+  CHECK_EQ('a', stream->Advance());
+  CheckCloneReads(stream.get(), false, "abc");
+
+  // A clone that waits for data sees the end of the input once the clones
+  // are stopped.
+  stream->StopClones();
+  CheckCloneReads(stream.get(), true, "abc");
+
+  for (const char* c = "bcdef"; *c; c++) CHECK_EQ(*c, stream->Advance());
+  CHECK_EQ(v8::internal::Utf16CharacterStream::kEndOfInput, stream->Advance());
+  CheckCloneReads(stream.get(), false, "abcdef");
+  CheckCloneReads(stream.get(), true, "abcdef");
+
+  // The original stream still reads from the start after being cloned.
+  stream->Seek(1);
+  CHECK_EQ('b', stream->Advance());
+}
+
 TEST(Utf8ChunkBoundaries) {
   // Test utf-8 parsing at chunk boundaries.
 
@@ -213,6 +251,121 @@ TEST(Utf8ChunkBoundaries) {
   }
 }
 
+TEST(Utf8LongAsciiRuns) {
+  // Runs of ASCII characters longer than the stream's buffer, interrupted by
+  // multi-byte characters, so that the fast path for ASCII characters ends
+  // at buffer, chunk and character boundaries.
+  std::string utf8;
+  std::vector<uint16_t> utf16;
+  for (int run = 0; run < 8; run++) {
+    for (int i = 0; i < 700 + 37 * run; i++) {
+      char c = static_cast<char>('a' + (i + run) % 26);
+      utf8.push_back(c);
+      utf16.push_back(c);
+    }
+    if (run % 2 == 0) {
+      utf8.append("\xc3\xa4");  // U+00E4, two bytes.
+      utf16.push_back(0xE4);
+    } else {
+      utf8.append("\xf0\x9f\x98\x80");  // U+1F600, a surrogate pair.
+      utf16.push_back(0xD83D);
+      utf16.push_back(0xDE00);
+    }
+  }
+  const uint8_t* data = reinterpret_cast<const uint8_t*>(utf8.data());
+
+  for (bool extra_chunky : {false, true}) {
+    ChunkSource chunk_source(data, utf8.size(), extra_chunky);
+    std::unique_ptr<v8::internal::Utf16CharacterStream> stream(
+        v8::internal::ScannerStream::For(
+            &chunk_source, v8::ScriptCompiler::StreamedSource::UTF8, nullptr));
+    for (size_t i = 0; i < utf16.size(); i++) {
+      CHECK_EQ(utf16[i], stream->Advance());
+    }
+    CHECK_EQ(v8::internal::Utf16CharacterStream::kEndOfInput,
+             stream->Advance());
+
+    // Seeking skips over the ASCII runs without filling the buffer.
+    for (size_t pos = 0; pos < utf16.size(); pos += 251) {
+      // Don't seek into the middle of a surrogate pair.
+      if (unibrow::Utf16::IsTrailSurrogate(utf16[pos])) continue;
+      stream->Seek(pos);
+      CHECK_EQ(utf16[pos], stream->Advance());
+    }
+    stream->Seek(utf16.size() - 1);
+    CHECK_EQ(utf16.back(), stream->Advance());
+  }
+}
+
+TEST(Utf8StreamingParseTime) {
+  // Timing harness for streamed UTF-8 scripts that are mostly ASCII, like
+  // most scripts on the web. It reports the time spent in the character
+  // stream alone and in a full streaming parse, to compare revisions of
+  // Utf8ExternalStreamingStream. Run it on its own in a release build:
+  //   cctest test-scanner-streams/Utf8StreamingParseTime
+  std::string source;
+  for (int i = 0; source.size() < 1 * i::MB; i++) {
+    source += "function f" + std::to_string(i) +
+              "(a, b) {\n"
+              "  // Adds two numbers, unless the first one is negative.\n"
+              "  if (a < 0) return 'n\xc3\xa9gatif';\n"
+              "  var result = a + b * " +
+              std::to_string(i) +
+              ";\n"
+              "  return result;\n"
+              "}\n";
+  }
+  source += "13;\n";
+  const uint8_t* data = reinterpret_cast<const uint8_t*>(source.data());
+  constexpr int kRuns = 5;
+
+  double stream_ms = std::numeric_limits<double>::infinity();
+  for (int run = 0; run < kRuns; run++) {
+    v8::base::ElapsedTimer timer;
+    timer.Start();
+    ChunkSource chunk_source(data, source.size(), false);
+    std::unique_ptr<v8::internal::Utf16CharacterStream> stream(
+        v8::internal::ScannerStream::For(
+            &chunk_source, v8::ScriptCompiler::StreamedSource::UTF8, nullptr));
+    size_t chars = 0;
+    while (stream->Advance() != i::Utf16CharacterStream::kEndOfInput) chars++;
+    stream_ms = std::min(stream_ms, timer.Elapsed().InMillisecondsF());
+    CHECK_LT(chars, source.size());
+  }
+
+  LocalContext env;
+  v8::Isolate* isolate = env->GetIsolate();
+  v8::HandleScope scope(isolate);
+  v8::Local<v8::String> source_string =
+      v8::String::NewFromUtf8(isolate, source.c_str(),
+                              v8::NewStringType::kNormal)
+          .ToLocalChecked();
+  double parse_ms = std::numeric_limits<double>::infinity();
+  for (int run = 0; run < kRuns; run++) {
+    v8::base::ElapsedTimer timer;
+    timer.Start();
+    v8::ScriptCompiler::StreamedSource streamed_source(
+        new ChunkSource(data, source.size(), false),
+        v8::ScriptCompiler::StreamedSource::UTF8);
+    std::unique_ptr<v8::ScriptCompiler::ScriptStreamingTask> task(
+        v8::ScriptCompiler::StartStreamingScript(isolate, &streamed_source));
+    task->Run();
+    parse_ms = std::min(parse_ms, timer.Elapsed().InMillisecondsF());
+    v8::ScriptOrigin origin(v8_str("parse-time.js"));
+    v8::Local<v8::Script> script =
+        v8::ScriptCompiler::Compile(env.local(), &streamed_source,
+                                    source_string, origin)
+            .ToLocalChecked();
+    CHECK_EQ(13, script->Run(env.local())
+                     .ToLocalChecked()
+                     ->Int32Value(env.local())
+                     .FromJust());
+  }
+  i::PrintF("Utf8StreamingParseTime: %zu bytes, stream %.2f ms, "
+            "parse %.2f ms\n",
+            source.size(), stream_ms, parse_ms);
+}
+
 TEST(Utf8SingleByteChunks) {
   // Have each byte as a single-byte chunk.
   size_t len = strlen(unicode_utf8);
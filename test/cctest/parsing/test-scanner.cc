@@ -131,5 +131,75 @@ TEST(ContextualKeywordTokens) {
   CHECK_TOK(Token::UNINITIALIZED, scanner->current_contextual_token());
 }
 
+TEST(LongTokens) {
+  // Whitespace, comments, identifiers and strings that span several of the
+  // stream's buffers, which the scanner skips over in bulk.
+  std::string indentation(600, ' ');
+  std::string comment(1000, 'x');
+  std::string identifier(900, 'a');
+  std::string upper_identifier = "Foo" + std::string(700, 'A');
+  std::string string_contents(1300, 's');
+  std::string src = indentation + "/*" + comment + "*/\t" + identifier +
+                    "//" + comment + "\n/*" + comment + "\n" + comment +
+                    "**/'" + string_contents + "' " + upper_identifier + ";";
+
+  auto scanner = make_scanner(src.c_str());
+  CHECK(!scanner->HasAnyLineTerminatorBeforeNext());
+  CHECK_TOK(Token::IDENTIFIER, scanner->Next());
+  int pos = static_cast<int>(indentation.size() + comment.size() + 5);
+  CHECK_EQ(pos, scanner->location().beg_pos);
+  pos += static_cast<int>(identifier.size());
+  CHECK_EQ(pos, scanner->location().end_pos);
+
+  CHECK(scanner->HasAnyLineTerminatorBeforeNext());
+  CHECK_TOK(Token::STRING, scanner->Next());
+  pos += static_cast<int>(3 * comment.size() + 9);
+  CHECK_EQ(pos, scanner->location().beg_pos);
+  pos += static_cast<int>(string_contents.size() + 2);
+  CHECK_EQ(pos, scanner->location().end_pos);
+
+  CHECK_TOK(Token::IDENTIFIER, scanner->Next());
+  pos += 1;
+  CHECK_EQ(pos, scanner->location().beg_pos);
+  pos += static_cast<int>(upper_identifier.size());
+  CHECK_EQ(pos, scanner->location().end_pos);
+
+  CHECK_TOK(Token::SEMICOLON, scanner->Next());
+  CHECK_TOK(Token::EOS, scanner->Next());
+}
+
+TEST(UnterminatedLongTokens) {
+  std::string contents(1000, 'x');
+  const std::string sources[] = {"/*" + contents + "*", "'" + contents,
+                                 "'" + contents + "\n'"};
+  for (const std::string& src : sources) {
+    auto scanner = make_scanner(src.c_str());
+    CHECK_TOK(Token::ILLEGAL, scanner->Next());
+  }
+}
+
+TEST(LongLiterals) {
+  // Literals whose ASCII runs are collected from several of the stream's
+  // buffers, followed by characters that take the slow path.
+  AccountingAllocator allocator;
+  Zone zone(&allocator, ZONE_NAME);
+  std::string identifier(900, 'a');
+  std::string string_contents(1300, 's');
+  std::string src = identifier + "_Z '" + string_contents + "\\x41' '" +
+                    string_contents + "'";
+
+  auto scanner = make_scanner(src.c_str());
+  CHECK_TOK(Token::IDENTIFIER, scanner->Next());
+  CHECK_EQ(identifier + "_Z",
+           std::string(scanner->CurrentLiteralAsCString(&zone)));
+  CHECK_TOK(Token::STRING, scanner->Next());
+  CHECK_EQ(string_contents + "A",
+           std::string(scanner->CurrentLiteralAsCString(&zone)));
+  CHECK_TOK(Token::STRING, scanner->Next());
+  CHECK_EQ(string_contents,
+           std::string(scanner->CurrentLiteralAsCString(&zone)));
+  CHECK_TOK(Token::EOS, scanner->Next());
+}
+
 }  // namespace internal
 }  // namespace v8
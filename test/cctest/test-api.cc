@@ -43,6 +43,7 @@
 #include "src/base/platform/platform.h"
 #include "src/code-stubs.h"
 #include "src/compilation-cache.h"
+#include "src/compiler.h"
 #include "src/debug/debug.h"
 #include "src/execution.h"
 #include "src/futex-emulation.h"
@@ -53,6 +54,7 @@
 #include "src/objects-inl.h"
 #include "src/objects/hash-table-inl.h"
 #include "src/objects/js-promise-inl.h"
+#include "src/parsing/parse-info.h"
 #include "src/parsing/preparse-data.h"
 #include "src/profiler/cpu-profiler.h"
 #include "src/unicode-inl.h"
@@ -60,6 +62,7 @@
 #include "src/vm-state.h"
 #include "test/cctest/heap/heap-tester.h"
 #include "test/cctest/heap/heap-utils.h"
+#include "test/common/wasm/flag-utils.h"
 
 static const bool kLogThreading = false;
 
@@ -25473,6 +25476,185 @@ TEST(StreamingBiggerScript) {
   RunStreamingTest(chunks);
 }
 
+TEST(StreamingScriptWithParallelCompileTasks) {
+  // Tests that the eagerly compiled inner functions of a streamed script can
+  // be compiled on worker threads.
+  i::FlagScope<bool> flag(&i::FLAG_parallel_compile_tasks, true);
+  const char* chunk1 =
+      "var a = (function() { return 1; })();\n"
+      "var b = (function() { var x = 2; return x; })();\n"
+      "var c = (function() {\n"
+      "  return (function() { return 3; })();\n"
+      "})();\n"
+      "var d = (function(y) { return y + 1; })(6);\n";
+  const char* chunks[] = {chunk1, "a + b + c + d; ", nullptr};
+
+  LocalContext env;
+  v8::Isolate* isolate = env->GetIsolate();
+  v8::HandleScope scope(isolate);
+  v8::ScriptCompiler::StreamedSource source(
+      new TestSourceStream(chunks),
+      v8::ScriptCompiler::StreamedSource::ONE_BYTE);
+  v8::ScriptCompiler::ScriptStreamingTask* task =
+      v8::ScriptCompiler::StartStreamingScript(isolate, &source);
+  task->Run();
+  delete task;
+  // The inner functions were handed to the worker threads.
+  CHECK(source.impl()->info->compiled_in_parallel());
+
+  v8::ScriptOrigin origin(v8_str("http://foo.com"));
+  char* full_source = TestSourceStream::FullSourceString(chunks);
+  v8::Local<Script> script =
+      v8::ScriptCompiler::Compile(env.local(), &source, v8_str(full_source),
+                                  origin)
+          .ToLocalChecked();
+  CHECK_EQ(13, script->Run(env.local())
+                   .ToLocalChecked()
+                   ->Int32Value(env.local())
+                   .FromJust());
+  delete[] full_source;
+}
+
+// Returns statements that make a function large enough to be preparsed on a
+// worker thread with --parallel-preparse.
+std::string LargeFunctionBody() {
+  std::string body;
+  for (int i = 0; i < 50; i++) {
+    body += "  x = x + `${x}`.length / 2 + /a+/.exec('aa')[0].length;\n";
+  }
+  return body;
+}
+
+// Streams |source| in a single chunk, letting the parser wait for the worker
+// threads to preparse every function they find, and checks how many of the
+// results the parser used.
+void RunParallelPreparseTest(const std::string& source, int expected_used,
+                             bool expected_success = true) {
+  i::FlagScope<bool> parallel_preparse(&i::FLAG_parallel_preparse, true);
+  i::FlagScope<bool> wait(&i::FLAG_parallel_preparse_wait_for_testing, true);
+  const char* chunks[] = {source.c_str(), nullptr};
+
+  LocalContext env;
+  v8::Isolate* isolate = env->GetIsolate();
+  v8::HandleScope scope(isolate);
+  v8::TryCatch try_catch(isolate);
+  v8::ScriptCompiler::StreamedSource streamed_source(
+      new TestSourceStream(chunks), v8::ScriptCompiler::StreamedSource::UTF8);
+  v8::ScriptCompiler::ScriptStreamingTask* task =
+      v8::ScriptCompiler::StartStreamingScript(isolate, &streamed_source);
+  task->Run();
+  delete task;
+  CHECK_EQ(expected_used,
+           streamed_source.impl()->info->num_preparsed_in_parallel());
+
+  v8::ScriptOrigin origin(v8_str("http://foo.com"));
+  v8::MaybeLocal<Script> script = v8::ScriptCompiler::Compile(
+      env.local(), &streamed_source, v8_str(source.c_str()), origin);
+  if (expected_success) {
+    CHECK_EQ(13, script.ToLocalChecked()
+                     ->Run(env.local())
+                     .ToLocalChecked()
+                     ->Int32Value(env.local())
+                     .FromJust());
+  } else {
+    CHECK(script.IsEmpty());
+    CHECK(try_catch.HasCaught());
+  }
+}
+
+TEST(StreamingScriptWithParallelPreparse) {
+  // Tests that the large top-level functions of a streamed script can be
+  // preparsed on worker threads.
+  i::FlagScope<bool> flag(&i::FLAG_parallel_preparse, true);
+  std::string body = LargeFunctionBody();
+  std::string source = "function f() {\n  var x = 0;\n" + body +
+                       "  return function() { return x; };\n"
+                       "}\n"
+                       "var g = function*(y) {\n  var x = y;\n" +
+                       body +
+                       "  yield 4;\n"
+                       "};\n"
+                       "var h = async function() {\n  var x = 0;\n" +
+                       body +
+                       "  return x;\n"
+                       "};\n";
+  // Split the functions across chunks, so that the worker threads share
+  // chunks with the parser.
+  std::string chunk1 = source.substr(0, source.length() / 2);
+  std::string chunk2 = source.substr(source.length() / 2);
+  const char* chunks[] = {
+      chunk1.c_str(), chunk2.c_str(),
+      "f()() > 0 && g(0).next().value === 4 && h() instanceof Promise ? 13 : 0",
+      nullptr};
+  RunStreamingTest(chunks, v8::ScriptCompiler::StreamedSource::UTF8);
+}
+
+TEST(StreamingScriptParallelPreparseResultsUsed) {
+  // Tests that the parser uses the results of the worker threads for the
+  // large top-level functions, and preparses the small ones itself.
+  std::string body = LargeFunctionBody();
+  std::string source = "function f() {\n  var x = 0;\n" + body +
+                       "  return function() { return x; };\n"
+                       "}\n"
+                       "function small() { return 1; }\n"
+                       "var g = function*(y) {\n  var x = y;\n" +
+                       body +
+                       "  yield 4;\n"
+                       "};\n"
+                       "var h = async function() {\n  var x = 0;\n" +
+                       body +
+                       "  return x;\n"
+                       "};\n"
+                       "f()() > 0 && g(0).next().value === 4 && "
+                       "small() === 1 && h() instanceof Promise ? 13 : 0";
+  RunParallelPreparseTest(source, 3);
+}
+
+TEST(StreamingScriptParallelPreparseMismatch) {
+  // Tests that the parser preparses the functions itself when the worker
+  // threads guessed wrong about them.
+  std::string statements;
+  for (int i = 0; i < 250; i++) statements += "x = x + 1; ";
+  std::string body = LargeFunctionBody();
+  // The function in the regular expression looks like a function expression
+  // to the worker threads, since they take the '/' after ')' for a division.
+  // The labelled function looks like a function expression as well, but is a
+  // declaration.
+  std::string source = "var s = '';\n"
+                       "if (s) /function r() { " +
+                       statements +
+                       "}/.test(s);\n"
+                       "l: function k() {\n  var x = 0;\n" +
+                       body +
+                       "  return x;\n"
+                       "}\n"
+                       "function f() {\n  var x = 0;\n" +
+                       body +
+                       "  return x;\n"
+                       "}\n"
+                       "k() > 0 && f() > 0 ? 13 : 0";
+  RunParallelPreparseTest(source, 1);
+}
+
+TEST(StreamingScriptParallelPreparseErrors) {
+  // Tests that syntax errors inside functions preparsed on worker threads are
+  // reported by the parser.
+  std::string body = LargeFunctionBody();
+  RunParallelPreparseTest("function f() {\n  var x = 0;\n" + body +
+                              "  var if = x;\n"
+                              "}\n"
+                              "13",
+                          0, false);
+  // An error after a preparsed function stops the parser before it fetched
+  // all data, which the worker threads must not wait for.
+  RunParallelPreparseTest("function f() {\n  var x = 0;\n" + body +
+                              "  return x;\n"
+                              "}\n"
+                              "var if = f();\n"
+                              "13",
+                          1, false);
+}
+
 
 TEST(StreamingScriptWithParseError) {
   // Test that parse errors from streamed scripts are propagated correctly.
@@ -0,0 +1,172 @@
+// Copyright 2018 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <stdio.h>
+
+#include <string>
+
+#include "src/api.h"
+#include "src/hot-function-profile.h"
+#include "src/objects-inl.h"
+#include "src/runtime-profiler.h"
+#include "src/v8.h"
+#include "test/cctest/cctest.h"
+#include "test/common/wasm/flag-utils.h"
+
+namespace v8 {
+namespace internal {
+
+namespace {
+
+HotFunctionProfile::FunctionKey KeyFor(Handle<String> source, int start,
+                                       int end) {
+  HotFunctionProfile::FunctionKey key;
+  key.source_hash = HotFunctionProfile::HashSource(*source);
+  key.start_position = start;
+  key.end_position = end;
+  return key;
+}
+
+// Runs a profiler tick, as if the interrupt budget ran out.
+void Tick(const v8::FunctionCallbackInfo<v8::Value>& args) {
+  Isolate* isolate = reinterpret_cast<Isolate*>(args.GetIsolate());
+  isolate->runtime_profiler()->MarkCandidatesForOptimization();
+}
+
+// A function that runs {n} profiler ticks, with enough (unreachable) bytecode
+// that the profiler only optimizes it after several ticks.
+std::string HotFunctionSource() {
+  std::string source =
+      "var x = 0;"
+      "function f(n) {"
+      "  for (var i = 0; i < n; i++) tick();"
+      "  if (n < 0) {";
+  for (int i = 0; i < 500; i++) source += "x = x + 1;";
+  source += "  }}";
+  return source;
+}
+
+// Creates a new isolate, calls f(ticks) from HotFunctionSource() in it, and
+// returns whether f got marked for optimization.
+bool RunTicksInNewIsolate(int ticks) {
+  v8::Isolate::CreateParams create_params;
+  create_params.array_buffer_allocator = CcTest::array_buffer_allocator();
+  v8::Isolate* isolate = v8::Isolate::New(create_params);
+  bool marked;
+  {
+    v8::Isolate::Scope isolate_scope(isolate);
+    v8::HandleScope scope(isolate);
+    v8::Local<v8::ObjectTemplate> global = v8::ObjectTemplate::New(isolate);
+    global->Set(v8_str("tick"), v8::FunctionTemplate::New(isolate, Tick));
+    v8::Local<v8::Context> context = v8::Context::New(isolate, nullptr, global);
+    v8::Context::Scope context_scope(context);
+
+    CompileRun(HotFunctionSource().c_str());
+    std::string call = "f(" + std::to_string(ticks) + ")";
+    CompileRun(call.c_str());
+    Handle<JSFunction> f = Handle<JSFunction>::cast(v8::Utils::OpenHandle(
+        *context->Global()->Get(context, v8_str("f")).ToLocalChecked()));
+    marked = f->IsMarkedForOptimization() ||
+             f->IsMarkedForConcurrentOptimization();
+  }
+  isolate->Dispose();
+  return marked;
+}
+
+}  // namespace
+
+TEST(HotFunctionProfileOptimizesEarly) {
+  FlagScope<bool> opt(&FLAG_opt, true);
+  FlagScope<bool> always_opt(&FLAG_always_opt, false);
+  FlagScope<bool> concurrent(&FLAG_concurrent_recompilation, false);
+  FlagScope<bool> osr(&FLAG_use_osr, false);
+  const char* filename = "test-hot-function-profile-early.txt";
+
+  // Without a profile, two ticks are not enough to optimize f.
+  CHECK_NULL(HotFunctionProfile::Get());
+  CHECK(!RunTicksInNewIsolate(2));
+
+  // Record a profile in which f becomes hot the usual way.
+  {
+    FlagScope<const char*> dump(&FLAG_dump_hot_function_profile, filename);
+    HotFunctionProfile::InitializeOncePerProcess();
+    CHECK(RunTicksInNewIsolate(20));
+    CHECK_LT(0u, HotFunctionProfile::Get()->size());
+    HotFunctionProfile::TearDown();
+  }
+
+  // A later run that reads the profile optimizes f on its second tick.
+  {
+    FlagScope<const char*> read(&FLAG_hot_function_profile, filename);
+    HotFunctionProfile::InitializeOncePerProcess();
+    CHECK_LT(0u, HotFunctionProfile::Get()->size());
+    CHECK(!RunTicksInNewIsolate(1));
+    CHECK(RunTicksInNewIsolate(2));
+    HotFunctionProfile::TearDown();
+  }
+  remove(filename);
+}
+
+TEST(HotFunctionProfileSourceHash) {
+  CcTest::InitializeVM();
+  v8::HandleScope scope(CcTest::isolate());
+  Factory* factory = CcTest::i_isolate()->factory();
+
+  Handle<String> one = factory->NewStringFromAsciiChecked("function f() {}");
+  Handle<String> two = factory->NewStringFromAsciiChecked("function f() {}");
+  Handle<String> other = factory->NewStringFromAsciiChecked("function g() {}");
+  CHECK_EQ(HotFunctionProfile::HashSource(*one),
+           HotFunctionProfile::HashSource(*two));
+  CHECK_NE(HotFunctionProfile::HashSource(*one),
+           HotFunctionProfile::HashSource(*other));
+
+  // Cons strings hash like their flat contents.
+  Handle<String> left = factory->NewStringFromAsciiChecked("function ");
+  Handle<String> right = factory->NewStringFromAsciiChecked("f() {}");
+  Handle<String> cons = factory->NewConsString(left, right).ToHandleChecked();
+  CHECK_EQ(HotFunctionProfile::HashSource(*one),
+           HotFunctionProfile::HashSource(*cons));
+}
+
+TEST(HotFunctionProfileRoundTrip) {
+  CcTest::InitializeVM();
+  v8::HandleScope scope(CcTest::isolate());
+  Factory* factory = CcTest::i_isolate()->factory();
+  Handle<String> source =
+      factory->NewStringFromAsciiChecked("function f() {} function g() {}");
+
+  HotFunctionProfile profile;
+  profile.RecordHot(KeyFor(source, 10, 15));
+  profile.RecordHot(KeyFor(source, 26, 31));
+  CHECK_EQ(2u, profile.size());
+  CHECK(profile.IsHot(KeyFor(source, 10, 15)));
+  CHECK(!profile.IsHot(KeyFor(source, 0, 15)));
+
+  const char* filename = "test-hot-function-profile.txt";
+  CHECK(profile.WriteToFile(filename));
+
+  HotFunctionProfile loaded;
+  CHECK(loaded.ReadFromFile(filename));
+  remove(filename);
+  CHECK_EQ(2u, loaded.size());
+  CHECK(loaded.IsHot(KeyFor(source, 10, 15)));
+  CHECK(loaded.IsHot(KeyFor(source, 26, 31)));
+  CHECK(!loaded.IsHot(KeyFor(source, 10, 31)));
+}
+
+TEST(HotFunctionProfileRejectsMalformedFile) {
+  const char* filename = "test-hot-function-profile-malformed.txt";
+  FILE* file = fopen(filename, "w");
+  CHECK_NOT_NULL(file);
+  fprintf(file, "not-a-profile 1\n");
+  fclose(file);
+
+  HotFunctionProfile profile;
+  CHECK(!profile.ReadFromFile(filename));
+  remove(filename);
+  CHECK_EQ(0u, profile.size());
+}
+
+}  // namespace internal
+}  // namespace v8
@@ -352,6 +352,10 @@ TEST(CodeMapMoveAndDeleteCode) {
   code_map.AddCode(ToAddress(0x1750), entry3, 0x100);
   CHECK(!code_map.FindEntry(ToAddress(0x1700)));
   CHECK_EQ(entry3, code_map.FindEntry(ToAddress(0x1750)));
+  code_map.DeleteCode(ToAddress(0x1750));
+  CHECK(!code_map.FindEntry(ToAddress(0x1750)));
+  CHECK(!code_map.FindEntry(ToAddress(0x1800)));
+  code_map.DeleteCode(ToAddress(0x1750));  // Unknown code is ignored.
 }
 
 namespace {
@@ -47,6 +47,7 @@
 #include "src/snapshot/natives.h"
 #include "src/snapshot/partial-deserializer.h"
 #include "src/snapshot/partial-serializer.h"
+#include "src/snapshot/persistent-code-cache.h"
 #include "src/snapshot/snapshot.h"
 #include "src/snapshot/startup-deserializer.h"
 #include "src/snapshot/startup-serializer.h"
@@ -54,6 +55,11 @@
 #include "test/cctest/heap/heap-utils.h"
 #include "test/cctest/setup-isolate-for-tests.h"
 
+#if V8_OS_POSIX
+#include <stdlib.h>  // NOLINT
+#include <unistd.h>  // NOLINT
+#endif
+
 namespace v8 {
 namespace internal {
 
@@ -2095,6 +2101,111 @@ TEST(CodeSerializerIsolatesEager) {
   isolate2->Dispose();
 }
 
+int CompileAndRunWithPersistentCodeCache(v8::Isolate* isolate,
+                                         const char* source) {
+  v8::Isolate::Scope iscope(isolate);
+  v8::HandleScope scope(isolate);
+  v8::Local<v8::Context> context = v8::Context::New(isolate);
+  v8::Context::Scope context_scope(context);
+
+  v8::ScriptOrigin origin(v8_str("test"));
+  v8::ScriptCompiler::Source script_source(v8_str(source), origin);
+  v8::Local<v8::UnboundScript> script =
+      v8::ScriptCompiler::CompileUnboundScript(isolate, &script_source)
+          .ToLocalChecked();
+
+  // Count the functions that are compiled before the script runs.
+  i::Handle<i::SharedFunctionInfo> sfi = v8::Utils::OpenHandle(*script);
+  i::Handle<i::Script> i_script(Script::cast(sfi->script()));
+  i::SharedFunctionInfo::ScriptIterator iterator(i_script);
+  int compiled = 0;
+  while (SharedFunctionInfo* next = iterator.Next()) {
+    if (next->is_compiled()) compiled++;
+  }
+
+  v8::Local<v8::Value> result =
+      script->BindToCurrentContext()->Run(context).ToLocalChecked();
+  CHECK(result->ToString(context)
+            .ToLocalChecked()
+            ->Equals(context, v8_str("abcdef"))
+            .FromJust());
+  return compiled;
+}
+
+#if V8_OS_POSIX
+TEST(PersistentCodeCache) {
+  FLAG_always_opt = false;
+  FLAG_opt = false;
+  char dir_name[] = "/tmp/v8-code-cache-XXXXXX";
+  CHECK_NOT_NULL(mkdtemp(dir_name));
+  FLAG_code_cache_dir = dir_name;
+  const char* source =
+      "function persisted() { return 'abc'; }; persisted() + 'def'";
+  std::string file_name;
+  {
+    v8::HandleScope scope(CcTest::isolate());
+    file_name = PersistentCodeCache::FileNameFor(
+        *v8::Utils::OpenHandle(*v8_str(source)));
+  }
+
+  v8::Isolate::CreateParams create_params;
+  create_params.array_buffer_allocator = CcTest::array_buffer_allocator();
+
+  // The first isolate compiles only the top-level function eagerly, and
+  // writes the entry from a posted task, so that it survives an abrupt exit.
+  v8::Isolate* isolate1 = v8::Isolate::New(create_params);
+  CHECK_EQ(1, CompileAndRunWithPersistentCodeCache(isolate1, source));
+  {
+    v8::Isolate::Scope iscope(isolate1);
+    EmptyMessageQueues(isolate1);
+  }
+  PersistentCodeCache::WaitForPendingWrites();
+  FILE* entry = base::OS::FOpen(file_name.c_str(), "rb");
+  CHECK_NOT_NULL(entry);
+  fseek(entry, 0, SEEK_END);
+  long initial_size = ftell(entry);  // NOLINT(runtime/int)
+  fclose(entry);
+
+  // On teardown, the entry is rewritten to include the lazily compiled
+  // function.
+  isolate1->Dispose();
+  entry = base::OS::FOpen(file_name.c_str(), "rb");
+  CHECK_NOT_NULL(entry);
+  fseek(entry, 0, SEEK_END);
+  CHECK_LT(initial_size, ftell(entry));
+  fclose(entry);
+
+  // The second isolate finds both functions in the cache.
+  v8::Isolate* isolate2 = v8::Isolate::New(create_params);
+  CHECK_EQ(2, CompileAndRunWithPersistentCodeCache(isolate2, source));
+  isolate2->Dispose();
+
+  // A different source of the same length that is made to map to the same
+  // file is rejected, because the entry stores and compares the full source.
+  const char* other_source =
+      "function persisted() { return 'xyz'; }; persisted() + 'def'";
+  std::string other_file_name;
+  {
+    v8::HandleScope scope(CcTest::isolate());
+    other_file_name = PersistentCodeCache::FileNameFor(
+        *v8::Utils::OpenHandle(*v8_str(other_source)));
+  }
+  CHECK_EQ(0, rename(file_name.c_str(), other_file_name.c_str()));
+  {
+    v8::HandleScope scope(CcTest::isolate());
+    v8::ScriptOriginOptions origin_options;
+    CHECK(PersistentCodeCache::Lookup(
+              CcTest::i_isolate(), v8::Utils::OpenHandle(*v8_str(other_source)),
+              origin_options)
+              .is_null());
+  }
+
+  remove(other_file_name.c_str());
+  rmdir(dir_name);
+  FLAG_code_cache_dir = nullptr;
+}
+#endif  // V8_OS_POSIX
+
 TEST(CodeSerializerAfterExecute) {
   // We test that no compilations happen when running this code. Forcing
   // to always optimize breaks this test.
@@ -2157,6 +2268,89 @@ TEST(CodeSerializerAfterExecute) {
   FLAG_opt = prev_opt_value;
 }
 
+namespace {
+
+SharedFunctionInfo* FindSharedFunctionInfo(v8::Local<v8::UnboundScript> script,
+                                           const char* name) {
+  i::Handle<i::SharedFunctionInfo> sfi = v8::Utils::OpenHandle(*script);
+  i::Handle<i::Script> i_script(Script::cast(sfi->script()));
+  i::SharedFunctionInfo::ScriptIterator iterator(i_script);
+  while (SharedFunctionInfo* next = iterator.Next()) {
+    if (next->Name()->IsUtf8EqualTo(CStrVector(name))) return next;
+  }
+  return nullptr;
+}
+
+}  // namespace
+
+TEST(CodeSerializerPreParsedScopeData) {
+  // The preparsed scope data of lazy functions is serialized along with them,
+  // so that compiling them after deserialization can still skip their inner
+  // functions instead of preparsing them again.
+  if (!FLAG_lazy || !FLAG_preparser_scope_analysis) return;
+  bool prev_always_opt_value = FLAG_always_opt;
+  FLAG_always_opt = false;
+  const char* source =
+      "function f() {"
+      "  var x = 'abc';"
+      "  function g() { return function h() { return x; }; }"
+      "  return g()();"
+      "}"
+      "function unused() {"
+      "  var y = 1;"
+      "  return function inner() { return y; };"
+      "}"
+      "f() + 'def'";
+  v8::ScriptCompiler::CachedData* cache = CompileRunAndProduceCache(source);
+
+  v8::Isolate::CreateParams create_params;
+  create_params.array_buffer_allocator = CcTest::array_buffer_allocator();
+  v8::Isolate* isolate2 = v8::Isolate::New(create_params);
+  {
+    v8::Isolate::Scope iscope(isolate2);
+    v8::HandleScope scope(isolate2);
+    v8::Local<v8::Context> context = v8::Context::New(isolate2);
+    v8::Context::Scope context_scope(context);
+
+    v8::Local<v8::String> source_str = v8_str(source);
+    v8::ScriptOrigin origin(v8_str("test"));
+    v8::ScriptCompiler::Source source(source_str, origin, cache);
+    v8::Local<v8::UnboundScript> script =
+        v8::ScriptCompiler::CompileUnboundScript(
+            isolate2, &source, v8::ScriptCompiler::kConsumeCodeCache)
+            .ToLocalChecked();
+    CHECK(!cache->rejected);
+
+    // The lazy functions come out of the cache with the scope data of their
+    // inner functions.
+    SharedFunctionInfo* f = FindSharedFunctionInfo(script, "f");
+    SharedFunctionInfo* unused = FindSharedFunctionInfo(script, "unused");
+    CHECK(!f->is_compiled());
+    CHECK(f->HasPreParsedScopeData());
+    CHECK(!unused->is_compiled());
+    CHECK(unused->HasPreParsedScopeData());
+
+    v8::Local<v8::Value> result = script->BindToCurrentContext()
+                                      ->Run(isolate2->GetCurrentContext())
+                                      .ToLocalChecked();
+    CHECK(result->ToString(isolate2->GetCurrentContext())
+              .ToLocalChecked()
+              ->Equals(isolate2->GetCurrentContext(), v8_str("abcdef"))
+              .FromJust());
+
+    // Compiling f consumed its data, and h, which was skipped when compiling
+    // g, still resolves x correctly.
+    f = FindSharedFunctionInfo(script, "f");
+    CHECK(f->is_compiled());
+    CHECK(!f->HasPreParsedScopeData());
+    CHECK(FindSharedFunctionInfo(script, "unused")->HasPreParsedScopeData());
+  }
+  isolate2->Dispose();
+  delete cache;
+
+  FLAG_always_opt = prev_always_opt_value;
+}
+
 TEST(CodeSerializerFlagChange) {
   const char* source = "function f() { return 'abc'; }; f() + 'def'";
   v8::ScriptCompiler::CachedData* cache = CompileRunAndProduceCache(source);
@@ -13,6 +13,7 @@
 #include "test/cctest/cctest.h"
 #include "test/cctest/compiler/value-helper.h"
 #include "test/cctest/wasm/wasm-run-utils.h"
+#include "test/common/wasm/flag-utils.h"
 #include "test/common/wasm/test-signatures.h"
 #include "test/common/wasm/wasm-macro-gen.h"
 
@@ -472,6 +473,169 @@ TEST(InterpreterLoadWithoutMemory) {
   CHECK_TRAP32(r.Call(0));
 }
 
+TEST(RegisterCode_Loop) {
+  FLAG_SCOPE(wasm_interpreter_register_code);
+  WasmRunner<int32_t, int32_t> r(kExecuteInterpreter);
+  uint32_t sum = r.AllocateLocal(kWasmI32);
+  BUILD(r,
+        WASM_WHILE(
+            WASM_GET_LOCAL(0),
+            WASM_BLOCK(
+                WASM_SET_LOCAL(sum, WASM_I32_ADD(WASM_GET_LOCAL(sum),
+                                                 WASM_GET_LOCAL(0))),
+                WASM_SET_LOCAL(0, WASM_I32_SUB(WASM_GET_LOCAL(0), WASM_ONE)))),
+        WASM_GET_LOCAL(sum));
+
+  WasmInterpreter::Thread* thread = r.interpreter()->GetThread(0);
+  uint64_t calls_before = thread->NumRegisterCodeCalls();
+  CHECK_EQ(0, r.Call(0));
+  CHECK_EQ(1, r.Call(1));
+  CHECK_EQ(5050, r.Call(100));
+  CHECK_EQ(calls_before + 3, thread->NumRegisterCodeCalls());
+}
+
+TEST(RegisterCode_LocalsReadBeforeWrite) {
+  FLAG_SCOPE(wasm_interpreter_register_code);
+  {
+    // The first operand must see the value before the tee_local.
+    WasmRunner<int32_t, int32_t> r(kExecuteInterpreter);
+    BUILD(r, WASM_I32_SUB(WASM_GET_LOCAL(0),
+                          WASM_TEE_LOCAL(0, WASM_I32V_1(5))));
+    CHECK_EQ(10 - 5, r.Call(10));
+    CHECK_EQ(-7 - 5, r.Call(-7));
+  }
+  {
+    // Same, but the local is only written in a block.
+    WasmRunner<int32_t, int32_t> r(kExecuteInterpreter);
+    BUILD(r, WASM_I32_SUB(WASM_GET_LOCAL(0),
+                          WASM_BLOCK_I(WASM_SET_LOCAL(0, WASM_I32V_1(7)),
+                                       WASM_GET_LOCAL(0))));
+    CHECK_EQ(10 - 7, r.Call(10));
+    CHECK_EQ(-7 - 7, r.Call(-7));
+  }
+  {
+    // The result of the add is written to the local directly, after both
+    // operands were read.
+    WasmRunner<int32_t, int32_t> r(kExecuteInterpreter);
+    BUILD(r,
+          WASM_SET_LOCAL(0, WASM_I32_ADD(WASM_GET_LOCAL(0), WASM_GET_LOCAL(0))),
+          WASM_GET_LOCAL(0));
+    CHECK_EQ(20, r.Call(10));
+  }
+}
+
+TEST(RegisterCode_Branches) {
+  FLAG_SCOPE(wasm_interpreter_register_code);
+  {
+    // br_if carrying a value read from a local.
+    WasmRunner<int32_t, int32_t, int32_t> r(kExecuteInterpreter);
+    BUILD(r, WASM_BLOCK_I(WASM_BRV_IF(0, WASM_GET_LOCAL(1), WASM_GET_LOCAL(0)),
+                          WASM_DROP, WASM_I32V_1(-1)));
+    CHECK_EQ(17, r.Call(1, 17));
+    CHECK_EQ(-1, r.Call(0, 17));
+  }
+  {
+    WasmRunner<int32_t, int32_t> r(kExecuteInterpreter);
+    BUILD(r,
+          WASM_BLOCK(
+              WASM_BLOCK(WASM_BLOCK(WASM_BR_TABLE(WASM_GET_LOCAL(0), 2,
+                                                  BR_TARGET(0), BR_TARGET(1),
+                                                  BR_TARGET(2))),
+                         WASM_RETURN1(WASM_I32V_1(1))),
+              WASM_RETURN1(WASM_I32V_1(2))),
+          WASM_I32V_1(3));
+    CHECK_EQ(1, r.Call(0));
+    CHECK_EQ(2, r.Call(1));
+    CHECK_EQ(3, r.Call(2));
+    CHECK_EQ(3, r.Call(100));
+    CHECK_EQ(3, r.Call(-1));
+  }
+  {
+    WasmRunner<int32_t, int32_t> r(kExecuteInterpreter);
+    BUILD(r, WASM_IF_ELSE_I(WASM_GET_LOCAL(0), WASM_I32V_1(9),
+                            WASM_SELECT(WASM_I32V_1(10), WASM_I32V_1(11),
+                                        WASM_I32V_1(0))));
+    CHECK_EQ(9, r.Call(1));
+    CHECK_EQ(11, r.Call(0));
+  }
+}
+
+TEST(RegisterCode_Traps) {
+  FLAG_SCOPE(wasm_interpreter_register_code);
+  {
+    WasmRunner<int32_t, int32_t, int32_t> r(kExecuteInterpreter);
+    BUILD(r, WASM_I32_DIVS(WASM_GET_LOCAL(0), WASM_GET_LOCAL(1)));
+    CHECK_EQ(3, r.Call(7, 2));
+    CHECK_TRAP32(r.Call(7, 0));
+  }
+  {
+    WasmRunner<int32_t, int32_t> r(kExecuteInterpreter);
+    r.builder().AddMemoryElems<int32_t>(8);
+    BUILD(r,
+          WASM_STORE_MEM(MachineType::Int32(), WASM_GET_LOCAL(0),
+                         WASM_GET_LOCAL(0)),
+          WASM_LOAD_MEM(MachineType::Int32(), WASM_GET_LOCAL(0)));
+    CHECK_EQ(0, r.Call(0));
+    CHECK_EQ(4, r.Call(4));
+    CHECK_EQ(28, r.Call(28));
+    CHECK_TRAP32(r.Call(32));
+  }
+}
+
+TEST(RegisterCode_Calls) {
+  FLAG_SCOPE(wasm_interpreter_register_code);
+  WasmRunner<int32_t, int32_t> r(kExecuteInterpreter);
+  WasmFunctionCompiler& square = r.NewFunction<int32_t, int32_t>();
+  BUILD(square, WASM_I32_MUL(WASM_GET_LOCAL(0), WASM_GET_LOCAL(0)));
+  uint32_t sum = r.AllocateLocal(kWasmI32);
+  // The call exits the register code of the caller while the value of {sum}
+  // is on the stack.
+  BUILD(r,
+        WASM_WHILE(
+            WASM_GET_LOCAL(0),
+            WASM_BLOCK(
+                WASM_SET_LOCAL(
+                    sum, WASM_I32_ADD(WASM_GET_LOCAL(sum),
+                                      WASM_CALL_FUNCTION(
+                                          square.function_index(),
+                                          WASM_GET_LOCAL(0)))),
+                WASM_SET_LOCAL(0, WASM_I32_SUB(WASM_GET_LOCAL(0), WASM_ONE)))),
+        WASM_GET_LOCAL(sum));
+
+  WasmInterpreter::Thread* thread = r.interpreter()->GetThread(0);
+  uint64_t calls_before = thread->NumRegisterCodeCalls();
+  CHECK_EQ(1 + 4 + 9 + 16, r.Call(4));
+  // The caller and all four calls of {square}.
+  CHECK_EQ(calls_before + 5, thread->NumRegisterCodeCalls());
+}
+
+TEST(RegisterCode_NotUsedWithBreakpoints) {
+  FLAG_SCOPE(wasm_interpreter_register_code);
+  static const int kLocalsDeclSize = 1;
+  byte code[] = {WASM_I32_ADD(WASM_GET_LOCAL(0), WASM_GET_LOCAL(1))};
+  std::unique_ptr<int[]> offsets = Find(code, sizeof(code), 1, kExprI32Add);
+
+  WasmRunner<int32_t, uint32_t, uint32_t> r(kExecuteInterpreter);
+  r.Build(code, code + arraysize(code));
+
+  WasmInterpreter* interpreter = r.interpreter();
+  WasmInterpreter::Thread* thread = interpreter->GetThread(0);
+  CHECK_EQ(3, r.Call(1, 2));
+  uint64_t calls_before = thread->NumRegisterCodeCalls();
+  CHECK_LT(0u, calls_before);
+
+  interpreter->SetBreakpoint(r.function(), kLocalsDeclSize + offsets[0], true);
+  thread->Reset();
+  WasmValue args[] = {WasmValue(1u), WasmValue(2u)};
+  thread->InitFrame(r.function(), args);
+  CHECK_EQ(WasmInterpreter::PAUSED, thread->Run());
+  CHECK_EQ(static_cast<size_t>(kLocalsDeclSize + offsets[0]),
+           thread->GetBreakpointPc());
+  CHECK_EQ(WasmInterpreter::FINISHED, thread->Run());
+  CHECK_EQ(3u, thread->GetReturnValue().to<uint32_t>());
+  CHECK_EQ(calls_before, thread->NumRegisterCodeCalls());
+}
+
 }  // namespace test_run_wasm_interpreter
 }  // namespace wasm
 }  // namespace internal
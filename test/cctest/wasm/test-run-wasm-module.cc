@@ -10,12 +10,14 @@
 #include "src/snapshot/code-serializer.h"
 #include "src/version.h"
 #include "src/wasm/module-decoder.h"
+#include "src/wasm/shared-module-cache.h"
 #include "src/wasm/wasm-engine.h"
 #include "src/wasm/wasm-memory.h"
 #include "src/wasm/wasm-module-builder.h"
 #include "src/wasm/wasm-module.h"
 #include "src/wasm/wasm-objects-inl.h"
 #include "src/wasm/wasm-opcodes.h"
+#include "src/wasm/wasm-serialization.h"
 
 #include "test/cctest/cctest.h"
 #include "test/common/wasm/flag-utils.h"
@@ -217,6 +219,120 @@ TEST(Run_WasmModule_Global) {
   Cleanup();
 }
 
+TEST(Run_WasmModule_DynamicTiering) {
+  FLAG_SCOPE(liftoff);
+  FLAG_SCOPE(wasm_tier_up);
+  FLAG_SCOPE(wasm_dynamic_tiering);
+  FlagScope<int> budget(&FLAG_wasm_tiering_budget, 10);
+  // Run the tier-up compilation on the main thread, so that emptying the
+  // message queue installs the TurboFan code.
+  FlagScope<int> no_background_tasks(&FLAG_wasm_num_compilation_tasks, 0);
+  {
+    TestSignatures sigs;
+    v8::internal::AccountingAllocator allocator;
+    Zone zone(&allocator, ZONE_NAME);
+    WasmModuleBuilder* builder = new (&zone) WasmModuleBuilder(&zone);
+    byte code[] = {WASM_GET_LOCAL(0), kExprI32Const, 1, kExprI32Add};
+    WasmFunctionBuilder* hot = builder->AddFunction(sigs.i_i());
+    EMIT_CODE_WITH_END(hot, code);
+    builder->AddExport(CStrVector("hot"), hot);
+    WasmFunctionBuilder* cold = builder->AddFunction(sigs.i_i());
+    EMIT_CODE_WITH_END(cold, code);
+    builder->AddExport(CStrVector("cold"), cold);
+    ZoneBuffer buffer(&zone);
+    builder->WriteTo(buffer);
+
+    Isolate* isolate = CcTest::InitIsolateOnce();
+    HandleScope scope(isolate);
+    testing::SetupIsolateForWasmModule(isolate);
+    ErrorThrower thrower(isolate, "");
+    Handle<WasmInstanceObject> instance =
+        CompileAndInstantiateForTesting(
+            isolate, &thrower, ModuleWireBytes(buffer.begin(), buffer.end()))
+            .ToHandleChecked();
+    NativeModule* native_module =
+        instance->compiled_module()->GetNativeModule();
+    WasmCode::Tier cold_tier = native_module->code(cold->func_index())->tier();
+
+    // Only the function that runs out of budget is tiered up. It is compiled
+    // in a task, not in the runtime call that requests the tier-up.
+    Handle<Object> params[1] = {handle(Smi::FromInt(41), isolate)};
+    for (int i = 0; i < 20; ++i) {
+      CHECK_EQ(42, testing::CallWasmFunctionForTesting(
+                       isolate, instance, &thrower, "hot", 1, params));
+    }
+    CHECK(native_module->code(hot->func_index())->is_liftoff());
+    EmptyMessageQueues(reinterpret_cast<v8::Isolate*>(isolate));
+    CHECK_EQ(WasmCode::kTurbofan,
+             native_module->code(hot->func_index())->tier());
+    CHECK_EQ(cold_tier, native_module->code(cold->func_index())->tier());
+    CHECK_EQ(42, testing::CallWasmFunctionForTesting(isolate, instance,
+                                                     &thrower, "cold", 1,
+                                                     params));
+  }
+  Cleanup();
+}
+
+TEST(Run_WasmModule_FreeSupersededCode) {
+  FLAG_SCOPE(liftoff);
+  FLAG_SCOPE(wasm_tier_up);
+  FLAG_SCOPE(wasm_dynamic_tiering);
+  FLAG_SCOPE(wasm_free_superseded_code);
+  FlagScope<int> budget(&FLAG_wasm_tiering_budget, 10);
+  // Run the tier-up compilation on the main thread, so that emptying the
+  // message queue installs the TurboFan code.
+  FlagScope<int> no_background_tasks(&FLAG_wasm_num_compilation_tasks, 0);
+  {
+    TestSignatures sigs;
+    v8::internal::AccountingAllocator allocator;
+    Zone zone(&allocator, ZONE_NAME);
+    WasmModuleBuilder* builder = new (&zone) WasmModuleBuilder(&zone);
+    byte code[] = {WASM_GET_LOCAL(0), kExprI32Const, 1, kExprI32Add};
+    WasmFunctionBuilder* hot = builder->AddFunction(sigs.i_i());
+    EMIT_CODE_WITH_END(hot, code);
+    builder->AddExport(CStrVector("hot"), hot);
+    ZoneBuffer buffer(&zone);
+    builder->WriteTo(buffer);
+
+    Isolate* isolate = CcTest::InitIsolateOnce();
+    HandleScope scope(isolate);
+    testing::SetupIsolateForWasmModule(isolate);
+    ErrorThrower thrower(isolate, "");
+    Handle<WasmInstanceObject> instance =
+        CompileAndInstantiateForTesting(
+            isolate, &thrower, ModuleWireBytes(buffer.begin(), buffer.end()))
+            .ToHandleChecked();
+    NativeModule* native_module =
+        instance->compiled_module()->GetNativeModule();
+    WasmCode* liftoff_code = native_module->code(hot->func_index());
+    CHECK(liftoff_code->is_liftoff());
+    size_t prologue_size = liftoff_code->tier_up_prologue_size();
+
+    // The Liftoff code is freed once the TurboFan code is installed, which
+    // happens in a task while no wasm code is on the stack.
+    Handle<Object> params[1] = {handle(Smi::FromInt(41), isolate)};
+    for (int i = 0; i < 20; ++i) {
+      CHECK_EQ(42, testing::CallWasmFunctionForTesting(
+                       isolate, instance, &thrower, "hot", 1, params));
+    }
+    size_t liftoff_size = liftoff_code->instructions().size();
+    EmptyMessageQueues(reinterpret_cast<v8::Isolate*>(isolate));
+    CHECK_EQ(WasmCode::kTurbofan,
+             native_module->code(hot->func_index())->tier());
+    if (prologue_size == 0) {
+      CHECK_EQ(liftoff_size, liftoff_code->instructions().size());
+    } else {
+      CHECK_EQ(prologue_size, liftoff_code->instructions().size());
+    }
+    // Nothing is left to free, and callers still enter through the prologue.
+    CHECK_EQ(0u, native_module->FreeSupersededCode(isolate));
+    CHECK_EQ(42, testing::CallWasmFunctionForTesting(isolate, instance,
+                                                     &thrower, "hot", 1,
+                                                     params));
+  }
+  Cleanup();
+}
+
 // Approximate gtest TEST_F style, in case we adopt gtest.
 class WasmSerializationTest {
  public:
@@ -402,6 +518,113 @@ TEST(DeserializeValidModule) {
   Cleanup();
 }
 
+TEST(DeserializeLazily) {
+  FLAG_SCOPE(wasm_lazy_deserialization);
+  WasmSerializationTest test;
+  {
+    HandleScope scope(test.current_isolate());
+    v8::Local<v8::WasmCompiledModule> deserialized_module;
+    CHECK(test.Deserialize().ToLocal(&deserialized_module));
+    Handle<WasmModuleObject> module_object = Handle<WasmModuleObject>::cast(
+        v8::Utils::OpenHandle(*deserialized_module));
+    NativeModule* native_module =
+        module_object->compiled_module()->GetNativeModule();
+    // The function is only deserialized when it is first called.
+    CHECK_EQ(WasmCode::kLazyStub, native_module->code(0)->kind());
+    CHECK(native_module->has_serialized_code());
+    ErrorThrower thrower(test.current_isolate(), "");
+    Handle<WasmInstanceObject> instance =
+        test.current_isolate()
+            ->wasm_engine()
+            ->SyncInstantiate(test.current_isolate(), &thrower, module_object,
+                              Handle<JSReceiver>::null(),
+                              MaybeHandle<JSArrayBuffer>())
+            .ToHandleChecked();
+    Handle<Object> params[1] = {
+        Handle<Object>(Smi::FromInt(41), test.current_isolate())};
+    CHECK_EQ(42, testing::CallWasmFunctionForTesting(test.current_isolate(),
+                                                     instance, &thrower,
+                                                     "increment", 1, params));
+    // All functions are materialized, so the serialized copy is released.
+    CHECK_EQ(WasmCode::kFunction, native_module->code(0)->kind());
+    CHECK(!native_module->has_serialized_code());
+  }
+  Cleanup(test.current_isolate());
+  Cleanup();
+}
+
+TEST(SerializeLazilyCompiledModule) {
+  FLAG_SCOPE(wasm_lazy_compilation);
+  {
+    TestSignatures sigs;
+    v8::internal::AccountingAllocator allocator;
+    Zone zone(&allocator, ZONE_NAME);
+    WasmModuleBuilder* builder = new (&zone) WasmModuleBuilder(&zone);
+    WasmFunctionBuilder* called = builder->AddFunction(sigs.i_i());
+    byte code1[] = {WASM_GET_LOCAL(0), kExprI32Const, 1, kExprI32Add};
+    EMIT_CODE_WITH_END(called, code1);
+    builder->AddExport(CStrVector("called"), called);
+    WasmFunctionBuilder* uncalled = builder->AddFunction(sigs.i_i());
+    byte code2[] = {WASM_GET_LOCAL(0), kExprI32Const, 2, kExprI32Add};
+    EMIT_CODE_WITH_END(uncalled, code2);
+    builder->AddExport(CStrVector("uncalled"), uncalled);
+    ZoneBuffer buffer(&zone);
+    builder->WriteTo(buffer);
+
+    Isolate* isolate = CcTest::InitIsolateOnce();
+    HandleScope scope(isolate);
+    testing::SetupIsolateForWasmModule(isolate);
+    ErrorThrower thrower(isolate, "");
+    Handle<Object> params[1] = {handle(Smi::FromInt(41), isolate)};
+
+    // Only one of the functions is compiled before serializing.
+    Handle<WasmInstanceObject> instance =
+        CompileAndInstantiateForTesting(
+            isolate, &thrower, ModuleWireBytes(buffer.begin(), buffer.end()))
+            .ToHandleChecked();
+    CHECK_EQ(42, testing::CallWasmFunctionForTesting(
+                     isolate, instance, &thrower, "called", 1, params));
+    Handle<WasmCompiledModule> compiled_module(instance->compiled_module(),
+                                               isolate);
+    NativeModule* native_module = compiled_module->GetNativeModule();
+    CHECK_EQ(WasmCode::kFunction,
+             native_module->code(called->func_index())->kind());
+    CHECK_EQ(WasmCode::kLazyStub,
+             native_module->code(uncalled->func_index())->kind());
+
+    std::vector<byte> serialized(
+        GetSerializedNativeModuleSize(isolate, compiled_module));
+    CHECK(SerializeNativeModule(isolate, compiled_module,
+                                {serialized.data(), serialized.size()}));
+
+    // The uncompiled function is deserialized as a lazy-compile stub and
+    // compiled on its first call.
+    Handle<WasmModuleObject> module_object =
+        DeserializeNativeModule(isolate, {serialized.data(), serialized.size()},
+                                {buffer.begin(), buffer.size()})
+            .ToHandleChecked();
+    NativeModule* deserialized =
+        module_object->compiled_module()->GetNativeModule();
+    CHECK_EQ(WasmCode::kFunction,
+             deserialized->code(called->func_index())->kind());
+    CHECK_EQ(WasmCode::kLazyStub,
+             deserialized->code(uncalled->func_index())->kind());
+    Handle<WasmInstanceObject> deserialized_instance =
+        isolate->wasm_engine()
+            ->SyncInstantiate(isolate, &thrower, module_object,
+                              Handle<JSReceiver>::null(),
+                              MaybeHandle<JSArrayBuffer>())
+            .ToHandleChecked();
+    CHECK_EQ(42, testing::CallWasmFunctionForTesting(
+                     isolate, deserialized_instance, &thrower, "called", 1,
+                     params));
+    CHECK_EQ(43, testing::CallWasmFunctionForTesting(
+                     isolate, deserialized_instance, &thrower, "uncalled", 1,
+                     params));
+  }
+  Cleanup();
+}
+
 TEST(DeserializeMismatchingVersion) {
   WasmSerializationTest test;
   {
@@ -505,6 +728,263 @@ TEST(TransferrableWasmModules) {
   }
 }
 
+TEST(SharedModuleCacheAcrossIsolates) {
+  v8::internal::AccountingAllocator allocator;
+  Zone zone(&allocator, ZONE_NAME);
+
+  ZoneBuffer buffer(&zone);
+  WasmSerializationTest::BuildWireBytes(&zone, &buffer);
+  ModuleWireBytes wire_bytes(buffer.begin(), buffer.end());
+
+  SharedModuleCache cache(MB);
+  SharedModuleCache full_cache(0);
+  Isolate* from_isolate = CcTest::InitIsolateOnce();
+  {
+    HandleScope scope(from_isolate);
+    testing::SetupIsolateForWasmModule(from_isolate);
+    ErrorThrower thrower(from_isolate, "");
+    Handle<WasmModuleObject> module_object =
+        from_isolate->wasm_engine()
+            ->SyncCompile(from_isolate, &thrower, wire_bytes)
+            .ToHandleChecked();
+    cache.Insert(from_isolate, module_object);
+    full_cache.Insert(from_isolate, module_object);
+  }
+  CHECK_LT(buffer.size(), cache.size());
+  CHECK_EQ(0u, full_cache.size());
+
+  v8::Isolate::CreateParams create_params;
+  create_params.array_buffer_allocator = from_isolate->array_buffer_allocator();
+  v8::Isolate* to_isolate = v8::Isolate::New(create_params);
+  {
+    v8::HandleScope new_scope(to_isolate);
+    v8::Local<v8::Context> context = v8::Context::New(to_isolate);
+    context->Enter();
+    Isolate* isolate = reinterpret_cast<Isolate*>(to_isolate);
+    ErrorThrower thrower(isolate, "");
+    Handle<WasmModuleObject> module_object =
+        cache.Lookup(isolate, wire_bytes).ToHandleChecked();
+    Handle<WasmInstanceObject> instance =
+        isolate->wasm_engine()
+            ->SyncInstantiate(isolate, &thrower, module_object,
+                              Handle<JSReceiver>::null(),
+                              MaybeHandle<JSArrayBuffer>())
+            .ToHandleChecked();
+    Handle<Object> params[1] = {Handle<Object>(Smi::FromInt(41), isolate)};
+    CHECK_EQ(42, testing::CallWasmFunctionForTesting(
+                     isolate, instance, &thrower, "increment", 1, params));
+
+    // Different wire bytes miss the cache.
+    std::vector<byte> other_bytes(buffer.begin(), buffer.end());
+    other_bytes.back() ^= 1;
+    CHECK(cache
+              .Lookup(isolate, ModuleWireBytes(other_bytes.data(),
+                                               other_bytes.data() +
+                                                   other_bytes.size()))
+              .is_null());
+    CHECK(full_cache.Lookup(isolate, wire_bytes).is_null());
+    context->Exit();
+  }
+  to_isolate->Dispose();
+}
+
+namespace {
+
+// Builds a module whose exported function "main" returns {value}.
+void BuildConstantModule(Zone* zone, int8_t value, ZoneBuffer* buffer) {
+  WasmModuleBuilder* builder = new (zone) WasmModuleBuilder(zone);
+  TestSignatures sigs;
+  WasmFunctionBuilder* f = builder->AddFunction(sigs.i_v());
+  byte code[] = {WASM_I32V_1(value)};
+  EMIT_CODE_WITH_END(f, code);
+  ExportAsMain(f);
+  builder->WriteTo(*buffer);
+}
+
+class SharedModuleCacheTestResolver : public CompilationResultResolver {
+ public:
+  explicit SharedModuleCacheTestResolver(int* result) : result_(result) {}
+
+  void OnCompilationSucceeded(Handle<WasmModuleObject> module) override {
+    Isolate* isolate = module->GetIsolate();
+    ErrorThrower thrower(isolate, "");
+    Handle<WasmInstanceObject> instance =
+        isolate->wasm_engine()
+            ->SyncInstantiate(isolate, &thrower, module,
+                              Handle<JSReceiver>::null(),
+                              MaybeHandle<JSArrayBuffer>())
+            .ToHandleChecked();
+    *result_ = testing::RunWasmModuleForTesting(isolate, instance, 0, nullptr);
+  }
+
+  void OnCompilationFailed(Handle<Object> error_reason) override {
+    UNREACHABLE();
+  }
+
+ private:
+  int* result_;
+};
+
+}  // namespace
+
+TEST(SharedModuleCacheEvictsLeastRecentlyUsed) {
+  v8::internal::AccountingAllocator allocator;
+  Zone zone(&allocator, ZONE_NAME);
+  ZoneBuffer bytes1(&zone);
+  ZoneBuffer bytes2(&zone);
+  ZoneBuffer bytes3(&zone);
+  BuildConstantModule(&zone, 1, &bytes1);
+  BuildConstantModule(&zone, 2, &bytes2);
+  BuildConstantModule(&zone, 3, &bytes3);
+  auto wire_bytes = [](const ZoneBuffer& buffer) {
+    return Vector<const byte>(buffer.begin(), buffer.size());
+  };
+
+  Isolate* isolate = CcTest::InitIsolateOnce();
+  HandleScope scope(isolate);
+  testing::SetupIsolateForWasmModule(isolate);
+  ErrorThrower thrower(isolate, "");
+  auto compile = [&](const ZoneBuffer& buffer) {
+    return isolate->wasm_engine()
+        ->SyncCompile(isolate, &thrower,
+                      ModuleWireBytes(buffer.begin(), buffer.end()))
+        .ToHandleChecked();
+  };
+  Handle<WasmModuleObject> module1 = compile(bytes1);
+  Handle<WasmModuleObject> module2 = compile(bytes2);
+  Handle<WasmModuleObject> module3 = compile(bytes3);
+
+  // All three modules serialize to the same size; make room for two.
+  size_t entry_size;
+  {
+    SharedModuleCache probe(MB);
+    probe.Insert(isolate, module1);
+    entry_size = probe.size();
+  }
+  SharedModuleCache cache(2 * entry_size + entry_size / 2);
+  cache.Insert(isolate, module1);
+  cache.Insert(isolate, module2);
+  CHECK_EQ(2 * entry_size, cache.size());
+
+  // Using the first module makes the second one the least recently used.
+  CHECK_NOT_NULL(cache.LookupSerialized(wire_bytes(bytes1)));
+  cache.Insert(isolate, module3);
+  CHECK_EQ(2 * entry_size, cache.size());
+  CHECK_NOT_NULL(cache.LookupSerialized(wire_bytes(bytes1)));
+  CHECK_NULL(cache.LookupSerialized(wire_bytes(bytes2)));
+  CHECK_NOT_NULL(cache.LookupSerialized(wire_bytes(bytes3)));
+  CHECK_EQ(3u, cache.num_hits());
+}
+
+TEST(SharedModuleCacheSyncAndAsyncCompile) {
+  // Run background tasks on the main thread, so that emptying the message
+  // queue finishes asynchronous compilation.
+  FlagScope<int> no_background_tasks(&FLAG_wasm_num_compilation_tasks, 0);
+  FlagScope<unsigned int> cache_size(&FLAG_wasm_shared_module_cache_size, 1);
+  SharedModuleCache::InitializeOncePerProcess();
+  SharedModuleCache* cache = SharedModuleCache::Get();
+  CHECK_NOT_NULL(cache);
+
+  v8::internal::AccountingAllocator allocator;
+  Zone zone(&allocator, ZONE_NAME);
+  ZoneBuffer buffer(&zone);
+  BuildConstantModule(&zone, 42, &buffer);
+  ModuleWireBytes wire_bytes(buffer.begin(), buffer.end());
+
+  // The first isolate compiles the module and fills the cache.
+  Isolate* from_isolate = CcTest::InitIsolateOnce();
+  {
+    HandleScope scope(from_isolate);
+    testing::SetupIsolateForWasmModule(from_isolate);
+    ErrorThrower thrower(from_isolate, "");
+    CHECK(!from_isolate->wasm_engine()
+               ->SyncCompile(from_isolate, &thrower, wire_bytes)
+               .is_null());
+  }
+  CHECK_LT(0u, cache->size());
+  CHECK_EQ(0u, cache->num_hits());
+
+  v8::Isolate::CreateParams create_params;
+  create_params.array_buffer_allocator = from_isolate->array_buffer_allocator();
+  v8::Isolate* to_isolate = v8::Isolate::New(create_params);
+  {
+    v8::HandleScope new_scope(to_isolate);
+    v8::Local<v8::Context> context = v8::Context::New(to_isolate);
+    context->Enter();
+    Isolate* isolate = reinterpret_cast<Isolate*>(to_isolate);
+
+    // Synchronous compilation deserializes the cached module.
+    {
+      HandleScope scope(isolate);
+      ErrorThrower thrower(isolate, "");
+      Handle<WasmModuleObject> module_object =
+          isolate->wasm_engine()
+              ->SyncCompile(isolate, &thrower, wire_bytes)
+              .ToHandleChecked();
+      CHECK_EQ(1u, cache->num_hits());
+      int result = 0;
+      SharedModuleCacheTestResolver(&result).OnCompilationSucceeded(
+          module_object);
+      CHECK_EQ(42, result);
+    }
+
+    // Asynchronous compilation finds the module in a background task and
+    // resolves once the code is deserialized.
+    int result = 0;
+    isolate->wasm_engine()->AsyncCompile(
+        isolate, base::make_unique<SharedModuleCacheTestResolver>(&result),
+        wire_bytes, false);
+    CHECK_EQ(0, result);
+    EmptyMessageQueues(to_isolate);
+    CHECK_EQ(2u, cache->num_hits());
+    CHECK_EQ(42, result);
+    context->Exit();
+  }
+  to_isolate->Dispose();
+  SharedModuleCache::TearDown();
+}
+
+TEST(LazyCompilationValidatesAllFunctions) {
+  FLAG_SCOPE(wasm_lazy_compilation);
+  FLAG_SCOPE(wasm_parallel_validation);
+  {
+    TestSignatures sigs;
+    v8::internal::AccountingAllocator allocator;
+    Zone zone(&allocator, ZONE_NAME);
+
+    // Enough functions for several validation units, two of them invalid.
+    WasmModuleBuilder* builder = new (&zone) WasmModuleBuilder(&zone);
+    for (int i = 0; i < 1000; ++i) {
+      WasmFunctionBuilder* f = builder->AddFunction(sigs.i_v());
+      if (i == 300 || i == 700) {
+        byte code[] = {kExprI32Add};
+        EMIT_CODE_WITH_END(f, code);
+      } else {
+        byte code[] = {WASM_ONE};
+        EMIT_CODE_WITH_END(f, code);
+      }
+    }
+    ZoneBuffer buffer(&zone);
+    builder->WriteTo(buffer);
+
+    Isolate* isolate = CcTest::InitIsolateOnce();
+    HandleScope scope(isolate);
+    testing::SetupIsolateForWasmModule(isolate);
+    ErrorThrower thrower(isolate, "");
+    CHECK(isolate->wasm_engine()
+              ->SyncCompile(isolate, &thrower,
+                            ModuleWireBytes(buffer.begin(), buffer.end()))
+              .is_null());
+    CHECK(thrower.error());
+    // The invalid function with the lowest index is reported, independent of
+    // the order in which the background threads validated the functions.
+    Handle<String> message =
+        Object::NoSideEffectsToString(isolate, thrower.Reify());
+    CHECK_NOT_NULL(strstr(message->ToCString().get(), "#300:"));
+  }
+  Cleanup();
+}
+
 TEST(MemorySize) {
   {
     // Initial memory size is 16, see wasm-module-builder.cc
@@ -1150,6 +1630,56 @@ TEST(Run_WasmModule_Reclaim_Memory) {
 }
 #endif
 
+TEST(Run_WasmModule_Reuse_Pooled_Memory) {
+  FlagScope<unsigned int> pool_size(&FLAG_wasm_memory_pool_size, 1);
+  Isolate* isolate = CcTest::InitIsolateOnce();
+  HandleScope scope(isolate);
+  WasmMemoryTracker* memory_tracker = isolate->wasm_engine()->memory_tracker();
+  Handle<JSArrayBuffer> buffer;
+  CHECK(NewArrayBuffer(isolate, kWasmPageSize).ToHandle(&buffer));
+  void* backing_store = buffer->backing_store();
+  reinterpret_cast<byte*>(backing_store)[kWasmPageSize - 1] = 42;
+  constexpr bool free_memory = true;
+  DetachMemoryBuffer(isolate, buffer, free_memory);
+
+  // The next memory of the same size reuses the reservation, zeroed.
+  CHECK(NewArrayBuffer(isolate, kWasmPageSize).ToHandle(&buffer));
+  CHECK_EQ(backing_store, buffer->backing_store());
+  CHECK_EQ(0, reinterpret_cast<byte*>(backing_store)[kWasmPageSize - 1]);
+  DetachMemoryBuffer(isolate, buffer, free_memory);
+  CHECK(memory_tracker->FreePooledReservations());
+  CHECK(!memory_tracker->FreePooledReservations());
+}
+
+TEST(Run_WasmModule_Reuse_Pooled_Grown_Memory) {
+  FlagScope<unsigned int> pool_size(&FLAG_wasm_memory_pool_size, 2);
+  Isolate* isolate = CcTest::InitIsolateOnce();
+  HandleScope scope(isolate);
+  WasmMemoryTracker* memory_tracker = isolate->wasm_engine()->memory_tracker();
+  constexpr uint32_t kPages = 3;
+  Handle<JSArrayBuffer> buffer;
+  CHECK(NewArrayBuffer(isolate, kWasmPageSize).ToHandle(&buffer));
+  Handle<WasmMemoryObject> mem_obj =
+      WasmMemoryObject::New(isolate, buffer, kPages);
+  CHECK_EQ(1, WasmMemoryObject::Grow(isolate, mem_obj, kPages - 1));
+  buffer = handle(mem_obj->array_buffer(), isolate);
+  byte* mem = reinterpret_cast<byte*>(buffer->backing_store());
+  for (uint32_t page = 1; page <= kPages; ++page) {
+    mem[page * kWasmPageSize - 1] = 42;
+  }
+  constexpr bool free_memory = true;
+  DetachMemoryBuffer(isolate, buffer, free_memory);
+
+  // Whichever reservation is handed out, the grown pages must be zeroed.
+  CHECK(NewArrayBuffer(isolate, kPages * kWasmPageSize).ToHandle(&buffer));
+  mem = reinterpret_cast<byte*>(buffer->backing_store());
+  for (uint32_t page = 1; page <= kPages; ++page) {
+    CHECK_EQ(0, mem[page * kWasmPageSize - 1]);
+  }
+  DetachMemoryBuffer(isolate, buffer, free_memory);
+  memory_tracker->FreePooledReservations();
+}
+
 TEST(AtomicOpDisassembly) {
   {
     EXPERIMENTAL_FLAG_SCOPE(threads);
@@ -3,9 +3,11 @@
 // found in the LICENSE file.
 
 #include "src/assembler-inl.h"
+#include "src/wasm/baseline/liftoff-register.h"
 #include "test/cctest/cctest.h"
 #include "test/cctest/compiler/value-helper.h"
 #include "test/cctest/wasm/wasm-run-utils.h"
+#include "test/common/wasm/flag-utils.h"
 #include "test/common/wasm/wasm-macro-gen.h"
 
 namespace v8 {
@@ -49,6 +51,36 @@ typedef int8_t (*Int8ShiftOp)(int8_t, int);
   void RunWasm_##name##_Impl(LowerSimd lower_simd,              \
                              WasmExecutionMode execution_mode)
 
+// Runs the test with Liftoff. On platforms where Liftoff supports s128, the
+// test aborts if Liftoff falls back to TurboFan.
+#define WASM_SIMD_LIFTOFF_TEST_CASE(name)                                     \
+  TEST(RunWasm_##name##_liftoff) {                                            \
+    EXPERIMENTAL_FLAG_SCOPE(simd);                                            \
+    FlagScope<bool> no_fallback(&FLAG_liftoff_no_fallback, kSupportsS128);    \
+    RunWasm_##name##_Impl(kNoLowerSimd, kExecuteLiftoff);                     \
+  }
+
+// Like WASM_SIMD_TEST, but additionally runs the test with Liftoff, for the
+// operations that Liftoff supports on some platforms.
+#define WASM_SIMD_TEST_WITH_LIFTOFF(name)                       \
+  void RunWasm_##name##_Impl(LowerSimd lower_simd,              \
+                             WasmExecutionMode execution_mode); \
+  TEST(RunWasm_##name##_turbofan) {                             \
+    EXPERIMENTAL_FLAG_SCOPE(simd);                              \
+    RunWasm_##name##_Impl(kNoLowerSimd, kExecuteTurbofan);      \
+  }                                                             \
+  WASM_SIMD_LIFTOFF_TEST_CASE(name)                             \
+  TEST(RunWasm_##name##_interpreter) {                          \
+    EXPERIMENTAL_FLAG_SCOPE(simd);                              \
+    RunWasm_##name##_Impl(kNoLowerSimd, kExecuteInterpreter);   \
+  }                                                             \
+  TEST(RunWasm_##name##_simd_lowered) {                         \
+    EXPERIMENTAL_FLAG_SCOPE(simd);                              \
+    RunWasm_##name##_Impl(kLowerSimd, kExecuteTurbofan);        \
+  }                                                             \
+  void RunWasm_##name##_Impl(LowerSimd lower_simd,              \
+                             WasmExecutionMode execution_mode)
+
 #define WASM_SIMD_COMPILED_AND_LOWERED_TEST(name)               \
   void RunWasm_##name##_Impl(LowerSimd lower_simd,              \
                              WasmExecutionMode execution_mode); \
@@ -63,6 +95,21 @@ typedef int8_t (*Int8ShiftOp)(int8_t, int);
   void RunWasm_##name##_Impl(LowerSimd lower_simd,              \
                              WasmExecutionMode execution_mode)
 
+#define WASM_SIMD_COMPILED_AND_LOWERED_TEST_WITH_LIFTOFF(name) \
+  void RunWasm_##name##_Impl(LowerSimd lower_simd,              \
+                             WasmExecutionMode execution_mode); \
+  TEST(RunWasm_##name##_turbofan) {                             \
+    EXPERIMENTAL_FLAG_SCOPE(simd);                              \
+    RunWasm_##name##_Impl(kNoLowerSimd, kExecuteTurbofan);      \
+  }                                                             \
+  WASM_SIMD_LIFTOFF_TEST_CASE(name)                             \
+  TEST(RunWasm_##name##_simd_lowered) {                         \
+    EXPERIMENTAL_FLAG_SCOPE(simd);                              \
+    RunWasm_##name##_Impl(kLowerSimd, kExecuteTurbofan);        \
+  }                                                             \
+  void RunWasm_##name##_Impl(LowerSimd lower_simd,              \
+                             WasmExecutionMode execution_mode)
+
 #define WASM_SIMD_COMPILED_TEST(name)                           \
   void RunWasm_##name##_Impl(LowerSimd lower_simd,              \
                              WasmExecutionMode execution_mode); \
@@ -73,6 +120,17 @@ typedef int8_t (*Int8ShiftOp)(int8_t, int);
   void RunWasm_##name##_Impl(LowerSimd lower_simd,              \
                              WasmExecutionMode execution_mode)
 
+#define WASM_SIMD_COMPILED_TEST_WITH_LIFTOFF(name)              \
+  void RunWasm_##name##_Impl(LowerSimd lower_simd,              \
+                             WasmExecutionMode execution_mode); \
+  TEST(RunWasm_##name##_turbofan) {                             \
+    EXPERIMENTAL_FLAG_SCOPE(simd);                              \
+    RunWasm_##name##_Impl(kNoLowerSimd, kExecuteTurbofan);      \
+  }                                                             \
+  WASM_SIMD_LIFTOFF_TEST_CASE(name)                             \
+  void RunWasm_##name##_Impl(LowerSimd lower_simd,              \
+                             WasmExecutionMode execution_mode)
+
 // Generic expected value functions.
 template <typename T>
 T Negate(T a) {
@@ -422,7 +480,7 @@ bool SkipFPValue(float x) {
 // doesn't handle NaNs. Also skip extreme values.
 bool SkipFPExpectedValue(float x) { return std::isnan(x) || SkipFPValue(x); }
 
-WASM_SIMD_TEST(F32x4Splat) {
+WASM_SIMD_TEST_WITH_LIFTOFF(F32x4Splat) {
   WasmRunner<int32_t, float> r(execution_mode, lower_simd);
   byte lane_val = 0;
   byte simd = r.AllocateLocal(kWasmS128);
@@ -436,7 +494,7 @@ WASM_SIMD_TEST(F32x4Splat) {
   }
 }
 
-WASM_SIMD_TEST(F32x4ReplaceLane) {
+WASM_SIMD_TEST_WITH_LIFTOFF(F32x4ReplaceLane) {
   WasmRunner<int32_t, float, float> r(execution_mode, lower_simd);
   byte old_val = 0;
   byte new_val = 1;
@@ -556,13 +614,13 @@ void RunF32x4BinOpTest(WasmExecutionMode execution_mode, LowerSimd lower_simd,
   }
 }
 
-WASM_SIMD_TEST(F32x4Add) {
+WASM_SIMD_TEST_WITH_LIFTOFF(F32x4Add) {
   RunF32x4BinOpTest(execution_mode, lower_simd, kExprF32x4Add, Add);
 }
-WASM_SIMD_TEST(F32x4Sub) {
+WASM_SIMD_TEST_WITH_LIFTOFF(F32x4Sub) {
   RunF32x4BinOpTest(execution_mode, lower_simd, kExprF32x4Sub, Sub);
 }
-WASM_SIMD_TEST(F32x4Mul) {
+WASM_SIMD_TEST_WITH_LIFTOFF(F32x4Mul) {
   RunF32x4BinOpTest(execution_mode, lower_simd, kExprF32x4Mul, Mul);
 }
 WASM_SIMD_TEST(F32x4_Min) {
@@ -598,31 +656,31 @@ void RunF32x4CompareOpTest(WasmExecutionMode execution_mode,
   }
 }
 
-WASM_SIMD_TEST(F32x4Eq) {
+WASM_SIMD_TEST_WITH_LIFTOFF(F32x4Eq) {
   RunF32x4CompareOpTest(execution_mode, lower_simd, kExprF32x4Eq, Equal);
 }
 
-WASM_SIMD_TEST(F32x4Ne) {
+WASM_SIMD_TEST_WITH_LIFTOFF(F32x4Ne) {
   RunF32x4CompareOpTest(execution_mode, lower_simd, kExprF32x4Ne, NotEqual);
 }
 
-WASM_SIMD_TEST(F32x4Gt) {
+WASM_SIMD_TEST_WITH_LIFTOFF(F32x4Gt) {
   RunF32x4CompareOpTest(execution_mode, lower_simd, kExprF32x4Gt, Greater);
 }
 
-WASM_SIMD_TEST(F32x4Ge) {
+WASM_SIMD_TEST_WITH_LIFTOFF(F32x4Ge) {
   RunF32x4CompareOpTest(execution_mode, lower_simd, kExprF32x4Ge, GreaterEqual);
 }
 
-WASM_SIMD_TEST(F32x4Lt) {
+WASM_SIMD_TEST_WITH_LIFTOFF(F32x4Lt) {
   RunF32x4CompareOpTest(execution_mode, lower_simd, kExprF32x4Lt, Less);
 }
 
-WASM_SIMD_TEST(F32x4Le) {
+WASM_SIMD_TEST_WITH_LIFTOFF(F32x4Le) {
   RunF32x4CompareOpTest(execution_mode, lower_simd, kExprF32x4Le, LessEqual);
 }
 
-WASM_SIMD_TEST(I32x4Splat) {
+WASM_SIMD_TEST_WITH_LIFTOFF(I32x4Splat) {
   // Store SIMD value in a local variable, use extract lane to check lane values
   // This test is not a test for ExtractLane as Splat does not create
   // interesting SIMD values.
@@ -643,7 +701,7 @@ WASM_SIMD_TEST(I32x4Splat) {
   FOR_INT32_INPUTS(i) { CHECK_EQ(1, r.Call(*i)); }
 }
 
-WASM_SIMD_TEST(I32x4ReplaceLane) {
+WASM_SIMD_TEST_WITH_LIFTOFF(I32x4ReplaceLane) {
   WasmRunner<int32_t, int32_t, int32_t> r(execution_mode, lower_simd);
   byte old_val = 0;
   byte new_val = 1;
@@ -669,7 +727,7 @@ WASM_SIMD_TEST(I32x4ReplaceLane) {
   CHECK_EQ(1, r.Call(1, 2));
 }
 
-WASM_SIMD_TEST(I16x8Splat) {
+WASM_SIMD_TEST_WITH_LIFTOFF(I16x8Splat) {
   WasmRunner<int32_t, int32_t> r(execution_mode, lower_simd);
   byte lane_val = 0;
   byte simd = r.AllocateLocal(kWasmS128);
@@ -680,7 +738,7 @@ WASM_SIMD_TEST(I16x8Splat) {
   FOR_INT16_INPUTS(i) { CHECK_EQ(1, r.Call(*i)); }
 }
 
-WASM_SIMD_TEST(I16x8ReplaceLane) {
+WASM_SIMD_TEST_WITH_LIFTOFF(I16x8ReplaceLane) {
   WasmRunner<int32_t, int32_t, int32_t> r(execution_mode, lower_simd);
   byte old_val = 0;
   byte new_val = 1;
@@ -729,7 +787,7 @@ WASM_SIMD_TEST(I16x8ReplaceLane) {
   CHECK_EQ(1, r.Call(1, 2));
 }
 
-WASM_SIMD_TEST(I8x16Splat) {
+WASM_SIMD_TEST_WITH_LIFTOFF(I8x16Splat) {
   WasmRunner<int32_t, int32_t> r(execution_mode, lower_simd);
   byte lane_val = 0;
   byte simd = r.AllocateLocal(kWasmS128);
@@ -740,7 +798,7 @@ WASM_SIMD_TEST(I8x16Splat) {
   FOR_INT8_INPUTS(i) { CHECK_EQ(1, r.Call(*i)); }
 }
 
-WASM_SIMD_TEST(I8x16ReplaceLane) {
+WASM_SIMD_TEST_WITH_LIFTOFF(I8x16ReplaceLane) {
   WasmRunner<int32_t, int32_t, int32_t> r(execution_mode, lower_simd);
   byte old_val = 0;
   byte new_val = 1;
@@ -952,15 +1010,15 @@ void RunI32x4BinOpTest(WasmExecutionMode execution_mode, LowerSimd lower_simd,
   }
 }
 
-WASM_SIMD_TEST(I32x4Add) {
+WASM_SIMD_TEST_WITH_LIFTOFF(I32x4Add) {
   RunI32x4BinOpTest(execution_mode, lower_simd, kExprI32x4Add, Add);
 }
 
-WASM_SIMD_TEST(I32x4Sub) {
+WASM_SIMD_TEST_WITH_LIFTOFF(I32x4Sub) {
   RunI32x4BinOpTest(execution_mode, lower_simd, kExprI32x4Sub, Sub);
 }
 
-WASM_SIMD_TEST(I32x4Mul) {
+WASM_SIMD_TEST_WITH_LIFTOFF(I32x4Mul) {
   RunI32x4BinOpTest(execution_mode, lower_simd, kExprI32x4Mul, Mul);
 }
 
@@ -982,15 +1040,15 @@ WASM_SIMD_TEST(I32x4MaxU) {
                     UnsignedMaximum);
 }
 
-WASM_SIMD_TEST(S128And) {
+WASM_SIMD_TEST_WITH_LIFTOFF(S128And) {
   RunI32x4BinOpTest(execution_mode, lower_simd, kExprS128And, And);
 }
 
-WASM_SIMD_TEST(S128Or) {
+WASM_SIMD_TEST_WITH_LIFTOFF(S128Or) {
   RunI32x4BinOpTest(execution_mode, lower_simd, kExprS128Or, Or);
 }
 
-WASM_SIMD_TEST(S128Xor) {
+WASM_SIMD_TEST_WITH_LIFTOFF(S128Xor) {
   RunI32x4BinOpTest(execution_mode, lower_simd, kExprS128Xor, Xor);
 }
 
@@ -1014,47 +1072,47 @@ void RunI32x4CompareOpTest(WasmExecutionMode execution_mode,
   }
 }
 
-WASM_SIMD_TEST(I32x4Eq) {
+WASM_SIMD_TEST_WITH_LIFTOFF(I32x4Eq) {
   RunI32x4CompareOpTest(execution_mode, lower_simd, kExprI32x4Eq, Equal);
 }
 
-WASM_SIMD_TEST(I32x4Ne) {
+WASM_SIMD_TEST_WITH_LIFTOFF(I32x4Ne) {
   RunI32x4CompareOpTest(execution_mode, lower_simd, kExprI32x4Ne, NotEqual);
 }
 
-WASM_SIMD_TEST(I32x4LtS) {
+WASM_SIMD_TEST_WITH_LIFTOFF(I32x4LtS) {
   RunI32x4CompareOpTest(execution_mode, lower_simd, kExprI32x4LtS, Less);
 }
 
-WASM_SIMD_TEST(I32x4LeS) {
+WASM_SIMD_TEST_WITH_LIFTOFF(I32x4LeS) {
   RunI32x4CompareOpTest(execution_mode, lower_simd, kExprI32x4LeS, LessEqual);
 }
 
-WASM_SIMD_TEST(I32x4GtS) {
+WASM_SIMD_TEST_WITH_LIFTOFF(I32x4GtS) {
   RunI32x4CompareOpTest(execution_mode, lower_simd, kExprI32x4GtS, Greater);
 }
 
-WASM_SIMD_TEST(I32x4GeS) {
+WASM_SIMD_TEST_WITH_LIFTOFF(I32x4GeS) {
   RunI32x4CompareOpTest(execution_mode, lower_simd, kExprI32x4GeS,
                         GreaterEqual);
 }
 
-WASM_SIMD_TEST(I32x4LtU) {
+WASM_SIMD_TEST_WITH_LIFTOFF(I32x4LtU) {
   RunI32x4CompareOpTest(execution_mode, lower_simd, kExprI32x4LtU,
                         UnsignedLess);
 }
 
-WASM_SIMD_TEST(I32x4LeU) {
+WASM_SIMD_TEST_WITH_LIFTOFF(I32x4LeU) {
   RunI32x4CompareOpTest(execution_mode, lower_simd, kExprI32x4LeU,
                         UnsignedLessEqual);
 }
 
-WASM_SIMD_TEST(I32x4GtU) {
+WASM_SIMD_TEST_WITH_LIFTOFF(I32x4GtU) {
   RunI32x4CompareOpTest(execution_mode, lower_simd, kExprI32x4GtU,
                         UnsignedGreater);
 }
 
-WASM_SIMD_TEST(I32x4GeU) {
+WASM_SIMD_TEST_WITH_LIFTOFF(I32x4GeU) {
   RunI32x4CompareOpTest(execution_mode, lower_simd, kExprI32x4GeU,
                         UnsignedGreaterEqual);
 }
@@ -1074,17 +1132,17 @@ void RunI32x4ShiftOpTest(WasmExecutionMode execution_mode, LowerSimd lower_simd,
   FOR_INT32_INPUTS(i) { CHECK_EQ(1, r.Call(*i, expected_op(*i, shift))); }
 }
 
-WASM_SIMD_COMPILED_AND_LOWERED_TEST(I32x4Shl) {
+WASM_SIMD_COMPILED_AND_LOWERED_TEST_WITH_LIFTOFF(I32x4Shl) {
   RunI32x4ShiftOpTest(execution_mode, lower_simd, kExprI32x4Shl,
                       LogicalShiftLeft, 1);
 }
 
-WASM_SIMD_COMPILED_AND_LOWERED_TEST(I32x4ShrS) {
+WASM_SIMD_COMPILED_AND_LOWERED_TEST_WITH_LIFTOFF(I32x4ShrS) {
   RunI32x4ShiftOpTest(execution_mode, lower_simd, kExprI32x4ShrS,
                       ArithmeticShiftRight, 1);
 }
 
-WASM_SIMD_COMPILED_AND_LOWERED_TEST(I32x4ShrU) {
+WASM_SIMD_COMPILED_AND_LOWERED_TEST_WITH_LIFTOFF(I32x4ShrU) {
   RunI32x4ShiftOpTest(execution_mode, lower_simd, kExprI32x4ShrU,
                       LogicalShiftRight, 1);
 }
@@ -1185,7 +1243,7 @@ void RunI16x8BinOpTest(WasmExecutionMode execution_mode, LowerSimd lower_simd,
   }
 }
 
-WASM_SIMD_TEST(I16x8Add) {
+WASM_SIMD_TEST_WITH_LIFTOFF(I16x8Add) {
   RunI16x8BinOpTest(execution_mode, lower_simd, kExprI16x8Add, Add);
 }
 
@@ -1194,7 +1252,7 @@ WASM_SIMD_TEST(I16x8AddSaturateS) {
                     AddSaturate);
 }
 
-WASM_SIMD_TEST(I16x8Sub) {
+WASM_SIMD_TEST_WITH_LIFTOFF(I16x8Sub) {
   RunI16x8BinOpTest(execution_mode, lower_simd, kExprI16x8Sub, Sub);
 }
 
@@ -1255,47 +1313,47 @@ void RunI16x8CompareOpTest(WasmExecutionMode execution_mode,
   }
 }
 
-WASM_SIMD_TEST(I16x8Eq) {
+WASM_SIMD_TEST_WITH_LIFTOFF(I16x8Eq) {
   RunI16x8CompareOpTest(execution_mode, lower_simd, kExprI16x8Eq, Equal);
 }
 
-WASM_SIMD_TEST(I16x8Ne) {
+WASM_SIMD_TEST_WITH_LIFTOFF(I16x8Ne) {
   RunI16x8CompareOpTest(execution_mode, lower_simd, kExprI16x8Ne, NotEqual);
 }
 
-WASM_SIMD_TEST(I16x8LtS) {
+WASM_SIMD_TEST_WITH_LIFTOFF(I16x8LtS) {
   RunI16x8CompareOpTest(execution_mode, lower_simd, kExprI16x8LtS, Less);
 }
 
-WASM_SIMD_TEST(I16x8LeS) {
+WASM_SIMD_TEST_WITH_LIFTOFF(I16x8LeS) {
   RunI16x8CompareOpTest(execution_mode, lower_simd, kExprI16x8LeS, LessEqual);
 }
 
-WASM_SIMD_TEST(I16x8GtS) {
+WASM_SIMD_TEST_WITH_LIFTOFF(I16x8GtS) {
   RunI16x8CompareOpTest(execution_mode, lower_simd, kExprI16x8GtS, Greater);
 }
 
-WASM_SIMD_TEST(I16x8GeS) {
+WASM_SIMD_TEST_WITH_LIFTOFF(I16x8GeS) {
   RunI16x8CompareOpTest(execution_mode, lower_simd, kExprI16x8GeS,
                         GreaterEqual);
 }
 
-WASM_SIMD_TEST(I16x8GtU) {
+WASM_SIMD_TEST_WITH_LIFTOFF(I16x8GtU) {
   RunI16x8CompareOpTest(execution_mode, lower_simd, kExprI16x8GtU,
                         UnsignedGreater);
 }
 
-WASM_SIMD_TEST(I16x8GeU) {
+WASM_SIMD_TEST_WITH_LIFTOFF(I16x8GeU) {
   RunI16x8CompareOpTest(execution_mode, lower_simd, kExprI16x8GeU,
                         UnsignedGreaterEqual);
 }
 
-WASM_SIMD_TEST(I16x8LtU) {
+WASM_SIMD_TEST_WITH_LIFTOFF(I16x8LtU) {
   RunI16x8CompareOpTest(execution_mode, lower_simd, kExprI16x8LtU,
                         UnsignedLess);
 }
 
-WASM_SIMD_TEST(I16x8LeU) {
+WASM_SIMD_TEST_WITH_LIFTOFF(I16x8LeU) {
   RunI16x8CompareOpTest(execution_mode, lower_simd, kExprI16x8LeU,
                         UnsignedLessEqual);
 }
@@ -1315,17 +1373,17 @@ void RunI16x8ShiftOpTest(WasmExecutionMode execution_mode, LowerSimd lower_simd,
   FOR_INT16_INPUTS(i) { CHECK_EQ(1, r.Call(*i, expected_op(*i, shift))); }
 }
 
-WASM_SIMD_COMPILED_AND_LOWERED_TEST(I16x8Shl) {
+WASM_SIMD_COMPILED_AND_LOWERED_TEST_WITH_LIFTOFF(I16x8Shl) {
   RunI16x8ShiftOpTest(execution_mode, lower_simd, kExprI16x8Shl,
                       LogicalShiftLeft, 1);
 }
 
-WASM_SIMD_COMPILED_AND_LOWERED_TEST(I16x8ShrS) {
+WASM_SIMD_COMPILED_AND_LOWERED_TEST_WITH_LIFTOFF(I16x8ShrS) {
   RunI16x8ShiftOpTest(execution_mode, lower_simd, kExprI16x8ShrS,
                       ArithmeticShiftRight, 1);
 }
 
-WASM_SIMD_COMPILED_AND_LOWERED_TEST(I16x8ShrU) {
+WASM_SIMD_COMPILED_AND_LOWERED_TEST_WITH_LIFTOFF(I16x8ShrU) {
   RunI16x8ShiftOpTest(execution_mode, lower_simd, kExprI16x8ShrU,
                       LogicalShiftRight, 1);
 }
@@ -1398,7 +1456,7 @@ void RunI8x16BinOpTest(WasmExecutionMode execution_mode, LowerSimd lower_simd,
   }
 }
 
-WASM_SIMD_TEST(I8x16Add) {
+WASM_SIMD_TEST_WITH_LIFTOFF(I8x16Add) {
   RunI8x16BinOpTest(execution_mode, lower_simd, kExprI8x16Add, Add);
 }
 
@@ -1407,7 +1465,7 @@ WASM_SIMD_TEST(I8x16AddSaturateS) {
                     AddSaturate);
 }
 
-WASM_SIMD_TEST(I8x16Sub) {
+WASM_SIMD_TEST_WITH_LIFTOFF(I8x16Sub) {
   RunI8x16BinOpTest(execution_mode, lower_simd, kExprI8x16Sub, Sub);
 }
 
@@ -1464,47 +1522,47 @@ void RunI8x16CompareOpTest(WasmExecutionMode execution_mode,
   }
 }
 
-WASM_SIMD_TEST(I8x16Eq) {
+WASM_SIMD_TEST_WITH_LIFTOFF(I8x16Eq) {
   RunI8x16CompareOpTest(execution_mode, lower_simd, kExprI8x16Eq, Equal);
 }
 
-WASM_SIMD_TEST(I8x16Ne) {
+WASM_SIMD_TEST_WITH_LIFTOFF(I8x16Ne) {
   RunI8x16CompareOpTest(execution_mode, lower_simd, kExprI8x16Ne, NotEqual);
 }
 
-WASM_SIMD_TEST(I8x16GtS) {
+WASM_SIMD_TEST_WITH_LIFTOFF(I8x16GtS) {
   RunI8x16CompareOpTest(execution_mode, lower_simd, kExprI8x16GtS, Greater);
 }
 
-WASM_SIMD_TEST(I8x16GeS) {
+WASM_SIMD_TEST_WITH_LIFTOFF(I8x16GeS) {
   RunI8x16CompareOpTest(execution_mode, lower_simd, kExprI8x16GeS,
                         GreaterEqual);
 }
 
-WASM_SIMD_TEST(I8x16LtS) {
+WASM_SIMD_TEST_WITH_LIFTOFF(I8x16LtS) {
   RunI8x16CompareOpTest(execution_mode, lower_simd, kExprI8x16LtS, Less);
 }
 
-WASM_SIMD_TEST(I8x16LeS) {
+WASM_SIMD_TEST_WITH_LIFTOFF(I8x16LeS) {
   RunI8x16CompareOpTest(execution_mode, lower_simd, kExprI8x16LeS, LessEqual);
 }
 
-WASM_SIMD_TEST(I8x16GtU) {
+WASM_SIMD_TEST_WITH_LIFTOFF(I8x16GtU) {
   RunI8x16CompareOpTest(execution_mode, lower_simd, kExprI8x16GtU,
                         UnsignedGreater);
 }
 
-WASM_SIMD_TEST(I8x16GeU) {
+WASM_SIMD_TEST_WITH_LIFTOFF(I8x16GeU) {
   RunI8x16CompareOpTest(execution_mode, lower_simd, kExprI8x16GeU,
                         UnsignedGreaterEqual);
 }
 
-WASM_SIMD_TEST(I8x16LtU) {
+WASM_SIMD_TEST_WITH_LIFTOFF(I8x16LtU) {
   RunI8x16CompareOpTest(execution_mode, lower_simd, kExprI8x16LtU,
                         UnsignedLess);
 }
 
-WASM_SIMD_TEST(I8x16LeU) {
+WASM_SIMD_TEST_WITH_LIFTOFF(I8x16LeU) {
   RunI8x16CompareOpTest(execution_mode, lower_simd, kExprI8x16LeU,
                         UnsignedLessEqual);
 }
@@ -1555,7 +1613,7 @@ WASM_SIMD_COMPILED_AND_LOWERED_TEST(I8x16ShrU) {
 // rest false, and comparing for non-equality with zero to convert to a boolean
 // vector.
 #define WASM_SIMD_SELECT_TEST(format)                                        \
-  WASM_SIMD_COMPILED_AND_LOWERED_TEST(S##format##Select) {                   \
+  WASM_SIMD_COMPILED_AND_LOWERED_TEST_WITH_LIFTOFF(S##format##Select) {      \
     WasmRunner<int32_t, int32_t, int32_t> r(execution_mode, lower_simd);     \
     byte val1 = 0;                                                           \
     byte val2 = 1;                                                           \
@@ -2044,7 +2102,7 @@ WASM_SIMD_BOOL_REDUCTION_TEST(32x4, 4)
 WASM_SIMD_BOOL_REDUCTION_TEST(16x8, 8)
 WASM_SIMD_BOOL_REDUCTION_TEST(8x16, 16)
 
-WASM_SIMD_TEST(SimdI32x4ExtractWithF32x4) {
+WASM_SIMD_TEST_WITH_LIFTOFF(SimdI32x4ExtractWithF32x4) {
   WasmRunner<int32_t> r(execution_mode, lower_simd);
   BUILD(r, WASM_IF_ELSE_I(
                WASM_I32_EQ(WASM_SIMD_I32x4_EXTRACT_LANE(
@@ -2056,7 +2114,7 @@ WASM_SIMD_TEST(SimdI32x4ExtractWithF32x4) {
 #endif  // V8_TARGET_ARCH_ARM || V8_TARGET_ARCH_ARM64 || V8_TARGET_ARCH_MIPS ||
         // V8_TARGET_ARCH_MIPS64 || V8_TARGET_ARCH_IA32
 
-WASM_SIMD_TEST(SimdF32x4ExtractWithI32x4) {
+WASM_SIMD_TEST_WITH_LIFTOFF(SimdF32x4ExtractWithI32x4) {
   WasmRunner<int32_t> r(execution_mode, lower_simd);
   BUILD(r,
         WASM_IF_ELSE_I(WASM_F32_EQ(WASM_SIMD_F32x4_EXTRACT_LANE(
@@ -2066,7 +2124,7 @@ WASM_SIMD_TEST(SimdF32x4ExtractWithI32x4) {
   CHECK_EQ(1, r.Call());
 }
 
-WASM_SIMD_TEST(SimdF32x4AddWithI32x4) {
+WASM_SIMD_TEST_WITH_LIFTOFF(SimdF32x4AddWithI32x4) {
   // Choose two floating point values whose sum is normal and exactly
   // representable as a float.
   const int kOne = 0x3F800000;
@@ -2085,7 +2143,7 @@ WASM_SIMD_TEST(SimdF32x4AddWithI32x4) {
   CHECK_EQ(1, r.Call());
 }
 
-WASM_SIMD_TEST(SimdI32x4AddWithF32x4) {
+WASM_SIMD_TEST_WITH_LIFTOFF(SimdI32x4AddWithF32x4) {
   WasmRunner<int32_t> r(execution_mode, lower_simd);
   BUILD(r,
         WASM_IF_ELSE_I(
@@ -2100,7 +2158,7 @@ WASM_SIMD_TEST(SimdI32x4AddWithF32x4) {
   CHECK_EQ(1, r.Call());
 }
 
-WASM_SIMD_TEST(SimdI32x4Local) {
+WASM_SIMD_TEST_WITH_LIFTOFF(SimdI32x4Local) {
   WasmRunner<int32_t> r(execution_mode, lower_simd);
   r.AllocateLocal(kWasmS128);
   BUILD(r, WASM_SET_LOCAL(0, WASM_SIMD_I32x4_SPLAT(WASM_I32V(31))),
@@ -2109,7 +2167,7 @@ WASM_SIMD_TEST(SimdI32x4Local) {
   CHECK_EQ(31, r.Call());
 }
 
-WASM_SIMD_TEST(SimdI32x4SplatFromExtract) {
+WASM_SIMD_TEST_WITH_LIFTOFF(SimdI32x4SplatFromExtract) {
   WasmRunner<int32_t> r(execution_mode, lower_simd);
   r.AllocateLocal(kWasmI32);
   r.AllocateLocal(kWasmS128);
@@ -2120,7 +2178,7 @@ WASM_SIMD_TEST(SimdI32x4SplatFromExtract) {
   CHECK_EQ(76, r.Call());
 }
 
-WASM_SIMD_TEST(SimdI32x4For) {
+WASM_SIMD_TEST_WITH_LIFTOFF(SimdI32x4For) {
   WasmRunner<int32_t> r(execution_mode, lower_simd);
   r.AllocateLocal(kWasmI32);
   r.AllocateLocal(kWasmS128);
@@ -2154,7 +2212,7 @@ WASM_SIMD_TEST(SimdI32x4For) {
   CHECK_EQ(1, r.Call());
 }
 
-WASM_SIMD_TEST(SimdF32x4For) {
+WASM_SIMD_TEST_WITH_LIFTOFF(SimdF32x4For) {
   WasmRunner<int32_t> r(execution_mode, lower_simd);
   r.AllocateLocal(kWasmI32);
   r.AllocateLocal(kWasmS128);
@@ -2295,7 +2353,7 @@ WASM_SIMD_TEST(SimdF32x4SetGlobal) {
   CHECK_EQ(GetScalar(global, 3), 65.0f);
 }
 
-WASM_SIMD_COMPILED_TEST(SimdLoadStoreLoad) {
+WASM_SIMD_COMPILED_TEST_WITH_LIFTOFF(SimdLoadStoreLoad) {
   WasmRunner<int32_t> r(execution_mode, lower_simd);
   int32_t* memory =
       r.builder().AddMemoryElems<int32_t>(kWasmPageSize / sizeof(int32_t));
@@ -2312,8 +2370,11 @@ WASM_SIMD_COMPILED_TEST(SimdLoadStoreLoad) {
 }
 
 #undef WASM_SIMD_TEST
+#undef WASM_SIMD_LIFTOFF_TEST_CASE
+#undef WASM_SIMD_TEST_WITH_LIFTOFF
 #undef WASM_SIMD_COMPILED_AND_LOWERED_TEST
 #undef WASM_SIMD_COMPILED_TEST
+#undef WASM_SIMD_COMPILED_TEST_WITH_LIFTOFF
 #undef WASM_SIMD_CHECK_LANE
 #undef WASM_SIMD_CHECK4
 #undef WASM_SIMD_CHECK_SPLAT4
@@ -1573,6 +1573,161 @@ WASM_EXEC_TEST(LoadMemI32_offset) {
   CHECK_EQ(44444444, r.Call(8));
 }
 
+WASM_EXEC_TEST(LoadMemI32_offset_redundant_checks) {
+  WasmRunner<int32_t, uint32_t> r(execution_mode);
+  int32_t* memory =
+      r.builder().AddMemoryElems<int32_t>(kWasmPageSize / sizeof(int32_t));
+  r.builder().RandomizeMemory(1111);
+
+  // The check of the first load covers the second one, but not the third.
+  BUILD(r, WASM_I32_ADD(
+               WASM_I32_ADD(
+                   WASM_LOAD_MEM_OFFSET(MachineType::Int32(), 8,
+                                        WASM_GET_LOCAL(0)),
+                   WASM_LOAD_MEM(MachineType::Int32(), WASM_GET_LOCAL(0))),
+               WASM_LOAD_MEM_OFFSET(MachineType::Int32(), 12,
+                                    WASM_GET_LOCAL(0))));
+
+  r.builder().WriteMemory(&memory[0], 1);
+  r.builder().WriteMemory(&memory[2], 20);
+  r.builder().WriteMemory(&memory[3], 300);
+  CHECK_EQ(321, r.Call(0u));
+
+  uint32_t boundary = kWasmPageSize - 16;
+  r.Call(boundary);  // in bounds.
+  for (uint32_t index = boundary + 1; index < boundary + 20; ++index) {
+    CHECK_TRAP(r.Call(index));
+  }
+}
+
+WASM_EXEC_TEST(LoadMemI32_redundant_checks_branch) {
+  WasmRunner<int32_t, uint32_t, int32_t> r(execution_mode);
+  int32_t* memory =
+      r.builder().AddMemoryElems<int32_t>(kWasmPageSize / sizeof(int32_t));
+  r.builder().RandomizeMemory(1111);
+
+  // The check of the load in the first arm does not dominate the last load,
+  // so the last load still needs its own check when the arm is not taken.
+  BUILD(r, WASM_I32_ADD(
+               WASM_I32_ADD(
+                   WASM_LOAD_MEM(MachineType::Int32(), WASM_GET_LOCAL(0)),
+                   WASM_IF_ELSE_I(WASM_GET_LOCAL(1),
+                                  WASM_LOAD_MEM_OFFSET(MachineType::Int32(), 8,
+                                                       WASM_GET_LOCAL(0)),
+                                  WASM_ZERO)),
+               WASM_LOAD_MEM_OFFSET(MachineType::Int32(), 4,
+                                    WASM_GET_LOCAL(0))));
+
+  r.builder().WriteMemory(&memory[0], 1);
+  r.builder().WriteMemory(&memory[1], 20);
+  r.builder().WriteMemory(&memory[2], 300);
+  CHECK_EQ(321, r.Call(0u, 1));
+  CHECK_EQ(21, r.Call(0u, 0));
+
+  uint32_t boundary = kWasmPageSize - 12;
+  r.Call(boundary, 1);  // in bounds.
+  for (uint32_t index = boundary + 1; index < boundary + 20; ++index) {
+    CHECK_TRAP(r.Call(index, 1));
+  }
+  r.Call(boundary + 4, 0);  // in bounds.
+  for (uint32_t index = boundary + 5; index < boundary + 20; ++index) {
+    CHECK_TRAP(r.Call(index, 0));
+  }
+}
+
+WASM_EXEC_TEST(LoadMemI32_redundant_checks_loop) {
+  WasmRunner<int32_t, uint32_t, int32_t> r(execution_mode);
+  int32_t* memory =
+      r.builder().AddMemoryElems<int32_t>(kWasmPageSize / sizeof(int32_t));
+  r.builder().RandomizeMemory(1111);
+  r.AllocateLocal(kWasmI32);
+
+  // The check before the loop covers the loads in the loop body, whose index
+  // does not change.
+  BUILD(r,
+        WASM_SET_LOCAL(2, WASM_LOAD_MEM_OFFSET(MachineType::Int32(), 4,
+                                               WASM_GET_LOCAL(0))),
+        WASM_LOOP(
+            WASM_SET_LOCAL(
+                2, WASM_I32_ADD(WASM_GET_LOCAL(2),
+                                WASM_LOAD_MEM(MachineType::Int32(),
+                                              WASM_GET_LOCAL(0)))),
+            WASM_BR_IF(0, WASM_TEE_LOCAL(1, WASM_I32_SUB(WASM_GET_LOCAL(1),
+                                                         WASM_ONE)))),
+        WASM_GET_LOCAL(2));
+
+  r.builder().WriteMemory(&memory[0], 5);
+  r.builder().WriteMemory(&memory[1], 100);
+  CHECK_EQ(115, r.Call(0u, 3));
+
+  uint32_t boundary = kWasmPageSize - 8;
+  r.Call(boundary, 3);  // in bounds.
+  for (uint32_t index = boundary + 1; index < boundary + 20; ++index) {
+    CHECK_TRAP(r.Call(index, 3));
+  }
+}
+
+WASM_EXEC_TEST(LoadMemI32_redundant_checks_changed_index) {
+  WasmRunner<int32_t, uint32_t> r(execution_mode);
+  int32_t* memory =
+      r.builder().AddMemoryElems<int32_t>(kWasmPageSize / sizeof(int32_t));
+  r.builder().RandomizeMemory(1111);
+  r.AllocateLocal(kWasmI32);
+
+  // Both loads read local 0, but the local changes in between, so the check
+  // of the first load does not cover the second one.
+  BUILD(r,
+        WASM_SET_LOCAL(1,
+                       WASM_LOAD_MEM(MachineType::Int32(), WASM_GET_LOCAL(0))),
+        WASM_SET_LOCAL(0, WASM_I32_ADD(WASM_GET_LOCAL(0), WASM_I32V_1(4))),
+        WASM_I32_ADD(WASM_GET_LOCAL(1),
+                     WASM_LOAD_MEM(MachineType::Int32(), WASM_GET_LOCAL(0))));
+
+  r.builder().WriteMemory(&memory[0], 1);
+  r.builder().WriteMemory(&memory[1], 20);
+  CHECK_EQ(21, r.Call(0u));
+
+  uint32_t boundary = kWasmPageSize - 8;
+  r.Call(boundary);  // in bounds.
+  for (uint32_t index = boundary + 1; index < boundary + 20; ++index) {
+    CHECK_TRAP(r.Call(index));
+  }
+}
+
+WASM_EXEC_TEST(LoadMemI32_redundant_checks_loop_changed_index) {
+  WasmRunner<int32_t, uint32_t, int32_t> r(execution_mode);
+  int32_t* memory =
+      r.builder().AddMemoryElems<int32_t>(kWasmPageSize / sizeof(int32_t));
+  r.builder().RandomizeMemory(1111);
+  r.AllocateLocal(kWasmI32);
+
+  // The index advances in every iteration, so the check before the loop does
+  // not cover the loads in the loop body.
+  BUILD(r,
+        WASM_SET_LOCAL(2,
+                       WASM_LOAD_MEM(MachineType::Int32(), WASM_GET_LOCAL(0))),
+        WASM_LOOP(
+            WASM_SET_LOCAL(
+                2, WASM_I32_ADD(WASM_GET_LOCAL(2),
+                                WASM_LOAD_MEM(MachineType::Int32(),
+                                              WASM_GET_LOCAL(0)))),
+            WASM_SET_LOCAL(0, WASM_I32_ADD(WASM_GET_LOCAL(0), WASM_I32V_1(4))),
+            WASM_BR_IF(0, WASM_TEE_LOCAL(1, WASM_I32_SUB(WASM_GET_LOCAL(1),
+                                                         WASM_ONE)))),
+        WASM_GET_LOCAL(2));
+
+  r.builder().WriteMemory(&memory[0], 1);
+  r.builder().WriteMemory(&memory[1], 20);
+  r.builder().WriteMemory(&memory[2], 300);
+  CHECK_EQ(322, r.Call(0u, 3));
+
+  uint32_t boundary = kWasmPageSize - 12;
+  r.Call(boundary, 3);  // in bounds.
+  for (uint32_t index = boundary + 1; index < boundary + 20; ++index) {
+    CHECK_TRAP(r.Call(index, 3));
+  }
+}
+
 WASM_EXEC_TEST(LoadMemI32_const_oob_misaligned) {
   // This test accesses memory starting at kRunwayLength bytes before the end of
   // the memory until a few bytes beyond.
@@ -15,6 +15,7 @@
 
 #include "test/cctest/cctest.h"
 
+#include "test/common/wasm/flag-utils.h"
 #include "test/common/wasm/test-signatures.h"
 #include "test/common/wasm/wasm-macro-gen.h"
 
@@ -1011,6 +1012,67 @@ STREAM_TEST(TestModuleWithErrorAfterDataSection) {
   tester.RunCompilerTasks();
   CHECK(tester.IsPromiseRejected());
 }
+
+// Test that lazy compilation resolves the promise without compiling any
+// function.
+STREAM_TEST(TestLazyCompilation) {
+  FLAG_SCOPE(wasm_lazy_compilation);
+  i::Isolate* isolate = CcTest::i_isolate();
+  StreamTester tester;
+  ZoneBuffer buffer = GetValidModuleBytes(tester.zone());
+
+  size_t offset = GetFunctionOffset(isolate, buffer.begin(), buffer.size(), 1);
+  tester.OnBytesReceived(buffer.begin(), offset);
+  tester.RunCompilerTasks();
+  CHECK(tester.IsPromisePending());
+  tester.OnBytesReceived(buffer.begin() + offset, buffer.size() - offset);
+  tester.FinishStream();
+  tester.RunCompilerTasks();
+  CHECK(tester.IsPromiseFulfilled());
+}
+
+// Test that lazy compilation still validates the function bodies, and rejects
+// the promise as soon as an invalid body arrives.
+STREAM_TEST(TestLazyCompilationErrorInFunctionBody) {
+  FLAG_SCOPE(wasm_lazy_compilation);
+  StreamTester tester;
+
+  uint8_t code[] = {
+      U32V_1(4),                  // body size
+      U32V_1(0),                  // locals count
+      kExprGetLocal, 0, kExprEnd  // body
+  };
+
+  uint8_t invalid_code[] = {
+      U32V_1(4),                  // body size
+      U32V_1(0),                  // locals count
+      kExprI64Const, 0, kExprEnd  // !!! invalid return type !!!
+  };
+
+  const uint8_t bytes[] = {
+      WASM_MODULE_HEADER,                   // module header
+      kTypeSectionCode,                     // section code
+      U32V_1(1 + SIZEOF_SIG_ENTRY_x_x),     // section size
+      U32V_1(1),                            // type count
+      SIG_ENTRY_x_x(kLocalI32, kLocalI32),  // signature entry
+      kFunctionSectionCode,                 // section code
+      U32V_1(1 + 2),                        // section size
+      U32V_1(2),                            // functions count
+      0,                                    // signature index
+      0,                                    // signature index
+      kCodeSectionCode,                     // section code
+      U32V_1(1 + arraysize(code) + arraysize(invalid_code)),  // section size
+      U32V_1(2),                                              // functions count
+  };
+
+  tester.OnBytesReceived(bytes, arraysize(bytes));
+  tester.OnBytesReceived(code, arraysize(code));
+  tester.RunCompilerTasks();
+  CHECK(tester.IsPromisePending());
+  tester.OnBytesReceived(invalid_code, arraysize(invalid_code));
+  tester.RunCompilerTasks();
+  CHECK(tester.IsPromiseRejected());
+}
 #undef STREAM_TEST
 
 }  // namespace wasm
@@ -0,0 +1,64 @@
+// Copyright 2018 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+function addBenchmark(name, test) {
+  new BenchmarkSuite(name, [1000],
+      [
+        new Benchmark(name, false, false, 0, test)
+      ]);
+}
+
+addBenchmark('Monomorphic-InObject-Load', MonomorphicInObjectLoad);
+addBenchmark('Monomorphic-OutOfObject-Load', MonomorphicOutOfObjectLoad);
+addBenchmark('Monomorphic-Double-Load', MonomorphicDoubleLoad);
+addBenchmark('Polymorphic-Load', PolymorphicLoad);
+
+function load(o) {
+  for (var i = 0; i < 1000; ++i) {
+    o.x; o.x; o.x; o.x; o.x; o.x; o.x; o.x; o.x; o.x;
+    o.x; o.x; o.x; o.x; o.x; o.x; o.x; o.x; o.x; o.x;
+    o.x; o.x; o.x; o.x; o.x; o.x; o.x; o.x; o.x; o.x;
+    o.x; o.x; o.x; o.x; o.x; o.x; o.x; o.x; o.x; o.x;
+    o.x; o.x; o.x; o.x; o.x; o.x; o.x; o.x; o.x; o.x;
+    o.x; o.x; o.x; o.x; o.x; o.x; o.x; o.x; o.x; o.x;
+    o.x; o.x; o.x; o.x; o.x; o.x; o.x; o.x; o.x; o.x;
+    o.x; o.x; o.x; o.x; o.x; o.x; o.x; o.x; o.x; o.x;
+    o.x; o.x; o.x; o.x; o.x; o.x; o.x; o.x; o.x; o.x;
+    o.x; o.x; o.x; o.x; o.x; o.x; o.x; o.x; o.x; o.x;
+  }
+}
+
+function loadPolymorphic(a, b) {
+  for (var i = 0; i < 500; ++i) {
+    a.x; b.x; a.x; b.x; a.x; b.x; a.x; b.x; a.x; b.x;
+    a.x; b.x; a.x; b.x; a.x; b.x; a.x; b.x; a.x; b.x;
+    a.x; b.x; a.x; b.x; a.x; b.x; a.x; b.x; a.x; b.x;
+    a.x; b.x; a.x; b.x; a.x; b.x; a.x; b.x; a.x; b.x;
+    a.x; b.x; a.x; b.x; a.x; b.x; a.x; b.x; a.x; b.x;
+    a.x; b.x; a.x; b.x; a.x; b.x; a.x; b.x; a.x; b.x;
+    a.x; b.x; a.x; b.x; a.x; b.x; a.x; b.x; a.x; b.x;
+    a.x; b.x; a.x; b.x; a.x; b.x; a.x; b.x; a.x; b.x;
+    a.x; b.x; a.x; b.x; a.x; b.x; a.x; b.x; a.x; b.x;
+    a.x; b.x; a.x; b.x; a.x; b.x; a.x; b.x; a.x; b.x;
+  }
+}
+
+function MonomorphicInObjectLoad() {
+  load({x: 1, y: 2});
+}
+
+function MonomorphicOutOfObjectLoad() {
+  var o = {};
+  for (var i = 0; i < 8; ++i) o['p' + i] = i;
+  o.x = 1;
+  load(o);
+}
+
+function MonomorphicDoubleLoad() {
+  load({x: 1.5, y: 2});
+}
+
+function PolymorphicLoad() {
+  loadPolymorphic({x: 1, y: 2}, {y: 1, x: 2});
+}
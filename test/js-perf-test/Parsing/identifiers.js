@@ -0,0 +1,50 @@
+// Copyright 2018 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// Shares iterations, code and Run() with comments.js.
+
+new BenchmarkSuite('Identifiers', [1000], [
+  new Benchmark('Identifiers', false, true, iterations, Run, IdentifiersSetup)
+]);
+
+new BenchmarkSuite('Keywords', [1000], [
+  new Benchmark('Keywords', false, true, iterations, Run, KeywordsSetup)
+]);
+
+new BenchmarkSuite('StringLiterals', [1000], [
+  new Benchmark('StringLiterals', false, true, iterations, Run, StringLiteralsSetup)
+]);
+
+new BenchmarkSuite('Indentation', [1000], [
+  new Benchmark('Indentation', false, true, iterations, Run, IndentationSetup)
+]);
+
+function IdentifiersSetup() {
+  let names = [];
+  for (let i = 0; i < 200; i++) {
+    names.push("someIdentifier" + i, "AnotherIdentifier" + i,
+               "yet_another_identifier_" + i);
+  }
+  code = "var " + names.join(", ") + ";";
+  %FlattenString(code);
+}
+
+function KeywordsSetup() {
+  code = "if (this) { for (var i in this) continue; } else return;\n"
+             .repeat(300);
+  code = "(function() {" + code + "})";
+  %FlattenString(code);
+}
+
+function StringLiteralsSetup() {
+  code = "['" + "This is a string literal... ".repeat(10) + "'" +
+         (", '" + "This is a string literal... ".repeat(10) + "'").repeat(60) +
+         "];";
+  %FlattenString(code);
+}
+
+function IndentationSetup() {
+  code = "{\n" + "        {\n                0;\n        }\n".repeat(300) + "}";
+  %FlattenString(code);
+}
@@ -6,6 +6,7 @@
 load('../base.js');
 
 load('comments.js');
+load('identifiers.js');
 
 var success = true;
 
@@ -0,0 +1,59 @@
+// Copyright 2018 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// Compiles a module with many small functions. With --wasm-lazy-compilation,
+// this measures validation of the function bodies, which is all the work
+// done up front.
+
+new BenchmarkSuite('ManyFunctions', [1000], [
+  new Benchmark('ManyFunctions', false, false, 0, Run, Setup)
+]);
+
+const kNumFunctions = 10000;
+const kAddsPerFunction = 50;
+
+let bytes;
+
+function EmitU32V(out, value) {
+  do {
+    let b = value & 0x7f;
+    value >>>= 7;
+    out.push(value ? b | 0x80 : b);
+  } while (value);
+}
+
+function EmitSection(out, id, contents) {
+  out.push(id);
+  EmitU32V(out, contents.length);
+  for (let b of contents) out.push(b);
+}
+
+function Setup() {
+  // (func (param i32) (result i32)
+  //   (get_local 0) (i32.const 1) (i32.add) ... (i32.const 1) (i32.add))
+  let body = [0x00, 0x20, 0x00];
+  for (let i = 0; i < kAddsPerFunction; ++i) body.push(0x41, 0x01, 0x6a);
+  body.push(0x0b);
+
+  let out = [0x00, 0x61, 0x73, 0x6d, 0x01, 0x00, 0x00, 0x00];
+  EmitSection(out, 1, [0x01, 0x60, 0x01, 0x7f, 0x01, 0x7f]);
+  let functions = [];
+  EmitU32V(functions, kNumFunctions);
+  for (let i = 0; i < kNumFunctions; ++i) functions.push(0x00);
+  EmitSection(out, 3, functions);
+  let code = [];
+  EmitU32V(code, kNumFunctions);
+  for (let i = 0; i < kNumFunctions; ++i) {
+    EmitU32V(code, body.length);
+    for (let b of body) code.push(b);
+  }
+  EmitSection(out, 10, code);
+  bytes = new Uint8Array(out);
+}
+
+function Run() {
+  if (!(new WebAssembly.Module(bytes) instanceof WebAssembly.Module)) {
+    throw new Error("Compilation failed");
+  }
+}
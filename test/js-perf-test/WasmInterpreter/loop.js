@@ -0,0 +1,44 @@
+// Copyright 2018 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+new BenchmarkSuite('Loop', [1000], [
+  new Benchmark('Loop', false, false, 0, Run, Setup)
+]);
+
+// (func (export "main") (param $n i32) (result i32)
+//   (local $sum i32) (local $i i32)
+//   (loop
+//     (set_local $sum (i32.add (get_local $sum) (get_local $i)))
+//     (br_if 0 (i32.lt_s (tee_local $i (i32.add (get_local $i) (i32.const 1)))
+//                        (get_local $n))))
+//   (get_local $sum))
+const bytes = new Uint8Array([
+  0x00, 0x61, 0x73, 0x6d, 0x01, 0x00, 0x00, 0x00,  // magic, version
+  0x01, 0x06, 0x01, 0x60, 0x01, 0x7f, 0x01, 0x7f,  // type section
+  0x03, 0x02, 0x01, 0x00,                          // function section
+  0x07, 0x08, 0x01, 0x04, 0x6d, 0x61, 0x69, 0x6e,  // export section
+  0x00, 0x00,
+  0x0a, 0x1e, 0x01, 0x1c,                          // code section
+  0x01, 0x02, 0x7f,                                // locals
+  0x03, 0x40,                                      // loop
+  0x20, 0x01, 0x20, 0x02, 0x6a, 0x21, 0x01,        // sum += i
+  0x20, 0x02, 0x41, 0x01, 0x6a, 0x22, 0x02,        // i += 1
+  0x20, 0x00, 0x48, 0x0d, 0x00,                    // br_if (i < n)
+  0x0b,                                            // end
+  0x20, 0x01,                                      // get_local $sum
+  0x0b                                             // end
+]);
+
+const iterations = 10000;
+let main;
+
+function Setup() {
+  main = new WebAssembly.Instance(new WebAssembly.Module(bytes)).exports.main;
+}
+
+function Run() {
+  if (main(iterations) != iterations * (iterations - 1) / 2) {
+    throw new Error("Wrong result");
+  }
+}
@@ -0,0 +1,68 @@
+// Copyright 2018 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// Flags: --allow-natives-syntax --opt --no-always-opt
+// Flags: --generalize-feedback-on-deopt-loop --deopt-loop-threshold=2
+
+(function() {
+  function foo(x, y) { return x - y; }
+
+  foo(1, 2);
+  foo(2, 3);
+  %OptimizeFunctionOnNextCall(foo);
+  assertEquals(-1, foo(1, 2));
+  assertOptimized(foo);
+
+  // The first deoptimization just updates the feedback to Number.
+  assertEquals(-0.5, foo(1.5, 2));
+  assertUnoptimized(foo);
+  %OptimizeFunctionOnNextCall(foo);
+  assertEquals(-0.5, foo(1.5, 2));
+  assertOptimized(foo);
+
+  // The second one is for a different reason, so the feedback is only
+  // updated to NumberOrOddball.
+  assertEquals(NaN, foo(undefined, 2));
+  assertUnoptimized(foo);
+  %OptimizeFunctionOnNextCall(foo);
+  assertEquals(-1, foo(1, 2));
+  assertOptimized(foo);
+
+  // So the subtraction still speculates on its inputs.
+  assertEquals(1, foo({ valueOf() { return 3; } }, 2));
+  assertUnoptimized(foo);
+})();
+
+(function() {
+  function bar(x, y) { return x - y; }
+
+  function optimizeForSmis() {
+    bar(1, 2);
+    bar(2, 3);
+    %OptimizeFunctionOnNextCall(bar);
+    assertEquals(-1, bar(1, 2));
+    assertOptimized(bar);
+  }
+
+  optimizeForSmis();
+  assertEquals(-0.5, bar(1.5, 2));
+  assertUnoptimized(bar);
+
+  // Forget the feedback, as if it had not captured the input, so that the
+  // subtraction deoptimizes for the same reason again. That marks it as
+  // generic.
+  %ClearFunctionFeedback(bar);
+  optimizeForSmis();
+  assertEquals(-0.5, bar(1.5, 2));
+  assertUnoptimized(bar);
+  %OptimizeFunctionOnNextCall(bar);
+  assertEquals(-1, bar(1, 2));
+  assertOptimized(bar);
+
+  // So that it no longer deoptimizes on unexpected inputs.
+  assertEquals(1, bar({ valueOf() { return 3; } }, 2));
+  assertOptimized(bar);
+  assertEquals("1", String(bar("3", 2)));
+  assertOptimized(bar);
+})();
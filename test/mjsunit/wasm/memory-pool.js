@@ -0,0 +1,49 @@
+// Copyright 2018 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// Flags: --expose-wasm --expose-gc --wasm-memory-pool-size=2
+
+load("test/mjsunit/wasm/wasm-constants.js");
+load("test/mjsunit/wasm/wasm-module-builder.js");
+
+// Freed memories go to the pool. Memories handed out again must be zeroed,
+// including pages that were only accessible after growing.
+(function TestPooledMemoriesAreZeroed() {
+  print("TestPooledMemoriesAreZeroed...");
+  const kPages = 4;
+  for (let i = 0; i < 10; ++i) {
+    let memory = new WebAssembly.Memory({initial: 1, maximum: kPages});
+    assertEquals(1, memory.grow(kPages - 1));
+    let view = new Uint8Array(memory.buffer);
+    for (let page = 0; page < kPages; ++page) {
+      assertEquals(0, view[page * kPageSize]);
+      assertEquals(0, view[(page + 1) * kPageSize - 1]);
+      view[page * kPageSize] = i + 1;
+      view[(page + 1) * kPageSize - 1] = i + 1;
+    }
+    memory = view = undefined;
+    gc();
+  }
+})();
+
+(function TestPooledMemoriesInInstances() {
+  print("TestPooledMemoriesInInstances...");
+  let builder = new WasmModuleBuilder();
+  builder.addMemory(1, 2, true);
+  builder.addFunction("load", kSig_i_i)
+      .addBody([kExprGetLocal, 0, kExprI32LoadMem, 0, 0])
+      .exportFunc();
+  builder.addFunction("store", kSig_v_ii)
+      .addBody([kExprGetLocal, 0, kExprGetLocal, 1, kExprI32StoreMem, 0, 0])
+      .exportFunc();
+  let module = builder.toModule();
+  for (let i = 0; i < 10; ++i) {
+    let instance = new WebAssembly.Instance(module);
+    assertEquals(0, instance.exports.load(kPageSize - 4));
+    instance.exports.store(kPageSize - 4, i + 1);
+    assertEquals(i + 1, instance.exports.load(kPageSize - 4));
+    instance = undefined;
+    gc();
+  }
+})();
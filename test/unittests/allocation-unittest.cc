@@ -162,5 +162,23 @@ TEST(AllocationTest, ReserveMemory) {
   CHECK(v8::internal::FreePages(mem_addr, kAllocationSize));
 }
 
+TEST(AllocationTest, DecommitPages) {
+  size_t page_size = v8::internal::AllocatePageSize();
+  const size_t kAllocationSize = 1 * v8::internal::MB;
+  void* mem_addr = v8::internal::AllocatePages(
+      v8::internal::GetRandomMmapAddr(), kAllocationSize, page_size,
+      PageAllocator::Permission::kReadWrite);
+  CHECK_NOT_NULL(mem_addr);
+  size_t commit_size = v8::internal::CommitPageSize();
+  int* addr = static_cast<int*>(mem_addr);
+  addr[v8::internal::KB - 1] = 2;
+  CHECK(v8::internal::DecommitPages(mem_addr, commit_size));
+  // Decommitted memory reads as zero once it is accessible again.
+  CHECK(v8::internal::SetPermissions(mem_addr, commit_size,
+                                     PageAllocator::Permission::kReadWrite));
+  CHECK_EQ(0, addr[v8::internal::KB - 1]);
+  CHECK(v8::internal::FreePages(mem_addr, kAllocationSize));
+}
+
 }  // namespace internal
 }  // namespace v8
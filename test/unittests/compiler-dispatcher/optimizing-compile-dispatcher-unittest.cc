@@ -12,6 +12,7 @@
 #include "src/objects-inl.h"
 #include "src/optimized-compilation-info.h"
 #include "src/parsing/parse-info.h"
+#include "test/common/wasm/flag-utils.h"
 #include "test/unittests/test-helpers.h"
 #include "test/unittests/test-utils.h"
 #include "testing/gtest/include/gtest/gtest.h"
@@ -25,13 +26,15 @@ namespace {
 
 class BlockingCompilationJob : public OptimizedCompilationJob {
  public:
-  BlockingCompilationJob(Isolate* isolate, Handle<JSFunction> function)
+  BlockingCompilationJob(Isolate* isolate, Handle<JSFunction> function,
+                         size_t allocated_memory = 0)
       : OptimizedCompilationJob(isolate->stack_guard()->real_climit(), &info_,
                                 "BlockingCompilationJob",
                                 State::kReadyToExecute),
         shared_(function->shared()),
         zone_(isolate->allocator(), ZONE_NAME),
         info_(&zone_, function->GetIsolate(), shared_, function),
+        allocated_memory_(allocated_memory),
         blocking_(false),
         semaphore_(0) {}
   ~BlockingCompilationJob() override = default;
@@ -39,6 +42,8 @@ class BlockingCompilationJob : public OptimizedCompilationJob {
   bool IsBlocking() const { return blocking_.Value(); }
   void Signal() { semaphore_.Signal(); }
 
+  size_t AllocatedMemory() const override { return allocated_memory_; }
+
   // OptimiziedCompilationJob implementation.
   Status PrepareJobImpl(Isolate* isolate) override { UNREACHABLE(); }
 
@@ -55,6 +60,7 @@ class BlockingCompilationJob : public OptimizedCompilationJob {
   Handle<SharedFunctionInfo> shared_;
   Zone zone_;
   OptimizedCompilationInfo info_;
+  size_t allocated_memory_;
   base::AtomicValue<bool> blocking_;
   base::Semaphore semaphore_;
 
@@ -91,5 +97,85 @@ TEST_F(OptimizingCompileDispatcherTest, NonBlockingFlush) {
   dispatcher.Stop();
 }
 
+TEST_F(OptimizingCompileDispatcherTest, PriorityOrder) {
+  Handle<JSFunction> fun =
+      RunJS<JSFunction>("function f() { function g() {}; return g;}; f();");
+
+  // Keep the jobs in the input queue, and take them out by hand in the order
+  // in which the worker threads would get them.
+  FlagScope<bool> block_flag(&FLAG_block_concurrent_recompilation, true);
+  OptimizingCompileDispatcher dispatcher(i_isolate());
+  BlockingCompilationJob* low = new BlockingCompilationJob(i_isolate(), fun);
+  BlockingCompilationJob* high = new BlockingCompilationJob(i_isolate(), fun);
+  BlockingCompilationJob* first = new BlockingCompilationJob(i_isolate(), fun);
+  BlockingCompilationJob* second = new BlockingCompilationJob(i_isolate(), fun);
+  dispatcher.QueueForOptimization(low, 1);
+  dispatcher.QueueForOptimization(first, 3);
+  dispatcher.QueueForOptimization(high, 5);
+  dispatcher.QueueForOptimization(second, 3);
+
+  OptimizedCompilationJob* order[] = {high, first, second, low};
+  size_t memory;
+  for (OptimizedCompilationJob* expected : order) {
+    OptimizedCompilationJob* job = dispatcher.NextInput(&memory);
+    ASSERT_EQ(expected, job);
+    ASSERT_EQ(0u, memory);
+    delete job;
+  }
+  ASSERT_EQ(nullptr, dispatcher.NextInput(&memory));
+  dispatcher.Stop();
+}
+
+TEST_F(OptimizingCompileDispatcherTest, MaxMemoryOfQueuedJobs) {
+  Handle<JSFunction> fun =
+      RunJS<JSFunction>("function f() { function g() {}; return g;}; f();");
+
+  FlagScope<bool> block_flag(&FLAG_block_concurrent_recompilation, true);
+  FlagScope<int> max_memory_flag(&FLAG_concurrent_recompilation_max_memory, 1);
+  OptimizingCompileDispatcher dispatcher(i_isolate());
+  ASSERT_TRUE(dispatcher.IsQueueAvailable());
+  dispatcher.QueueForOptimization(
+      new BlockingCompilationJob(i_isolate(), fun, 2 * MB));
+  ASSERT_EQ(2u * MB, dispatcher.queued_memory());
+  ASSERT_FALSE(dispatcher.IsQueueAvailable());
+
+  // Stopping discards the job before it gets to run.
+  dispatcher.Stop();
+  ASSERT_EQ(0u, dispatcher.queued_memory());
+  ASSERT_TRUE(dispatcher.IsQueueAvailable());
+}
+
+TEST_F(OptimizingCompileDispatcherTest, MaxMemory) {
+  Handle<JSFunction> fun =
+      RunJS<JSFunction>("function f() { function g() {}; return g;}; f();");
+  BlockingCompilationJob* job =
+      new BlockingCompilationJob(i_isolate(), fun, 2 * MB);
+
+  FlagScope<int> max_memory_flag(&FLAG_concurrent_recompilation_max_memory, 1);
+  OptimizingCompileDispatcher dispatcher(i_isolate());
+  ASSERT_TRUE(dispatcher.IsQueueAvailable());
+  dispatcher.QueueForOptimization(job);
+
+  // Busy-wait for the job to run on a background thread. It still counts
+  // against the limit while it is being compiled.
+  while (!job->IsBlocking()) {
+  }
+  ASSERT_EQ(2u * MB, dispatcher.queued_memory());
+  ASSERT_FALSE(dispatcher.IsQueueAvailable());
+  job->Signal();
+
+  // Busy-wait for the job to finish compiling. It counts against the limit
+  // until it is installed.
+  while (job->IsBlocking()) {
+  }
+  ASSERT_EQ(2u * MB, dispatcher.queued_memory());
+  ASSERT_FALSE(dispatcher.IsQueueAvailable());
+
+  dispatcher.Flush(BlockingBehavior::kBlock);
+  ASSERT_EQ(0u, dispatcher.queued_memory());
+  ASSERT_TRUE(dispatcher.IsQueueAvailable());
+  dispatcher.Stop();
+}
+
 }  // namespace internal
 }  // namespace v8
@@ -6,6 +6,7 @@
 #include "src/compiler/js-graph.h"
 #include "src/compiler/linkage.h"
 #include "src/compiler/node-properties.h"
+#include "src/compiler/simplified-operator.h"
 #include "test/unittests/compiler/compiler-test-utils.h"
 #include "test/unittests/compiler/graph-unittest.h"
 #include "test/unittests/compiler/node-test-utils.h"
@@ -19,9 +20,11 @@ class BranchEliminationTest : public GraphTest {
  public:
   BranchEliminationTest()
       : machine_(zone(), MachineType::PointerRepresentation(),
-                 MachineOperatorBuilder::kNoFlags) {}
+                 MachineOperatorBuilder::kNoFlags),
+        simplified_(zone()) {}
 
   MachineOperatorBuilder* machine() { return &machine_; }
+  SimplifiedOperatorBuilder* simplified() { return &simplified_; }
 
   void Reduce() {
     JSOperatorBuilder javascript(zone());
@@ -36,6 +39,7 @@ class BranchEliminationTest : public GraphTest {
 
  private:
   MachineOperatorBuilder machine_;
+  SimplifiedOperatorBuilder simplified_;
 };
 
 
@@ -208,6 +212,92 @@ TEST_F(BranchEliminationTest, BranchInsideLoopSame) {
   EXPECT_THAT(ret1, IsReturn(IsInt32Constant(2), effect, loop));
 }
 
+TEST_F(BranchEliminationTest, CheckBoundsDominatedByLessThan) {
+  // { if (i < length) return a[i]; }
+  // where {i} is known to be non-negative, should not check {i} again.
+  Node* index = Parameter(0);
+  NodeProperties::SetType(index, Type::Range(0.0, 1000.0, zone()));
+  Node* length = Parameter(1);
+  NodeProperties::SetType(length, Type::Range(0.0, 1000.0, zone()));
+  Node* condition =
+      graph()->NewNode(simplified()->NumberLessThan(), index, length);
+  Node* branch =
+      graph()->NewNode(common()->Branch(), condition, graph()->start());
+  Node* if_true = graph()->NewNode(common()->IfTrue(), branch);
+  Node* check =
+      graph()->NewNode(simplified()->CheckBounds(VectorSlotPair()), index,
+                       length, graph()->start(), if_true);
+  NodeProperties::SetType(check, Type::Range(0.0, 999.0, zone()));
+  Node* if_false = graph()->NewNode(common()->IfFalse(), branch);
+  Node* merge = graph()->NewNode(common()->Merge(2), if_true, if_false);
+  Node* other = Parameter(2);
+  Node* phi =
+      graph()->NewNode(common()->Phi(MachineRepresentation::kTagged, 2),
+                       check, other, merge);
+  Node* effect_phi = graph()->NewNode(common()->EffectPhi(2), check,
+                                      graph()->start(), merge);
+  Node* zero = graph()->NewNode(common()->Int32Constant(0));
+  Node* ret =
+      graph()->NewNode(common()->Return(), zero, phi, effect_phi, merge);
+  graph()->SetEnd(graph()->NewNode(common()->End(1), ret));
+
+  Reduce();
+
+  EXPECT_THAT(phi, IsPhi(MachineRepresentation::kTagged,
+                         IsTypeGuard(index, if_true), other, merge));
+  EXPECT_EQ(IsSafetyCheck::kCriticalSafetyCheck, IsSafetyCheckOf(branch->op()));
+}
+
+TEST_F(BranchEliminationTest, CheckBoundsNotDominatedByLessThan) {
+  // { if (length <= i) return a[i]; }
+  // must keep the bounds check.
+  Node* index = Parameter(0);
+  NodeProperties::SetType(index, Type::Range(0.0, 1000.0, zone()));
+  Node* length = Parameter(1);
+  NodeProperties::SetType(length, Type::Range(0.0, 1000.0, zone()));
+  Node* condition =
+      graph()->NewNode(simplified()->NumberLessThanOrEqual(), length, index);
+  Node* branch =
+      graph()->NewNode(common()->Branch(), condition, graph()->start());
+  Node* if_true = graph()->NewNode(common()->IfTrue(), branch);
+  Node* check =
+      graph()->NewNode(simplified()->CheckBounds(VectorSlotPair()), index,
+                       length, graph()->start(), if_true);
+  NodeProperties::SetType(check, Type::Range(0.0, 999.0, zone()));
+  Node* zero = graph()->NewNode(common()->Int32Constant(0));
+  Node* ret = graph()->NewNode(common()->Return(), zero, check, check, if_true);
+  graph()->SetEnd(graph()->NewNode(common()->End(1), ret));
+
+  Reduce();
+
+  EXPECT_THAT(ret, IsReturn(check, check, if_true));
+}
+
+TEST_F(BranchEliminationTest, CheckBoundsPossiblyNegativeIndex) {
+  // { if (i < length) return a[i]; }
+  // where {i} might be negative, must keep the bounds check.
+  Node* index = Parameter(0);
+  NodeProperties::SetType(index, Type::Range(-1.0, 1000.0, zone()));
+  Node* length = Parameter(1);
+  NodeProperties::SetType(length, Type::Range(0.0, 1000.0, zone()));
+  Node* condition =
+      graph()->NewNode(simplified()->NumberLessThan(), index, length);
+  Node* branch =
+      graph()->NewNode(common()->Branch(), condition, graph()->start());
+  Node* if_true = graph()->NewNode(common()->IfTrue(), branch);
+  Node* check =
+      graph()->NewNode(simplified()->CheckBounds(VectorSlotPair()), index,
+                       length, graph()->start(), if_true);
+  NodeProperties::SetType(check, Type::Range(0.0, 999.0, zone()));
+  Node* zero = graph()->NewNode(common()->Int32Constant(0));
+  Node* ret = graph()->NewNode(common()->Return(), zero, check, check, if_true);
+  graph()->SetEnd(graph()->NewNode(common()->End(1), ret));
+
+  Reduce();
+
+  EXPECT_THAT(ret, IsReturn(check, check, if_true));
+}
+
 }  // namespace compiler
 }  // namespace internal
 }  // namespace v8
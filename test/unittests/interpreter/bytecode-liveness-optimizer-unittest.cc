@@ -0,0 +1,125 @@
+// Copyright 2018 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "src/v8.h"
+
+#include "src/interpreter/bytecode-array-builder.h"
+#include "src/interpreter/bytecode-array-iterator.h"
+#include "src/interpreter/bytecode-label.h"
+#include "src/interpreter/bytecode-liveness-optimizer.h"
+#include "src/objects-inl.h"
+#include "test/unittests/test-utils.h"
+
+namespace v8 {
+namespace internal {
+namespace interpreter {
+
+class BytecodeLivenessOptimizerTest : public TestWithIsolateAndZone {
+ public:
+  BytecodeLivenessOptimizerTest() {}
+  ~BytecodeLivenessOptimizerTest() override {}
+};
+
+TEST_F(BytecodeLivenessOptimizerTest, MergesDisjointTemporaries) {
+  FeedbackVectorSpec feedback_spec(zone());
+  BytecodeArrayBuilder builder(zone(), 1, 1, &feedback_spec);
+  Register first = builder.register_allocator()->NewRegister();
+  Register second = builder.register_allocator()->NewRegister();
+  int slot = feedback_spec.AddBinaryOpICSlot().ToInt();
+
+  // {first} is dead by the time {second} is written.
+  builder.LoadLiteral(Smi::FromInt(1))
+      .StoreAccumulatorInRegister(first)
+      .LoadLiteral(Smi::FromInt(2))
+      .BinaryOperation(Token::Value::ADD, first, slot)
+      .StoreAccumulatorInRegister(second)
+      .LoadLiteral(Smi::FromInt(3))
+      .BinaryOperation(Token::Value::ADD, second, slot)
+      .Return();
+
+  Handle<BytecodeArray> bytecode_array = builder.ToBytecodeArray(isolate());
+  EXPECT_EQ(3, bytecode_array->register_count());
+
+  BytecodeLivenessOptimizer optimizer(zone(), bytecode_array,
+                                      builder.fixed_register_count(),
+                                      Register::invalid_value());
+  optimizer.Optimize();
+  EXPECT_EQ(2, optimizer.register_count());
+  EXPECT_EQ(2, bytecode_array->register_count());
+
+  for (BytecodeArrayIterator it(bytecode_array); !it.done(); it.Advance()) {
+    if (it.current_bytecode() == Bytecode::kStar ||
+        it.current_bytecode() == Bytecode::kAdd) {
+      EXPECT_EQ(first.index(), it.GetRegisterOperand(0).index());
+    }
+  }
+}
+
+TEST_F(BytecodeLivenessOptimizerTest, KeepsOverlappingTemporaries) {
+  FeedbackVectorSpec feedback_spec(zone());
+  BytecodeArrayBuilder builder(zone(), 1, 0, &feedback_spec);
+  Register first = builder.register_allocator()->NewRegister();
+  Register second = builder.register_allocator()->NewRegister();
+  int slot = feedback_spec.AddBinaryOpICSlot().ToInt();
+
+  // {first} is still live when {second} is written.
+  builder.LoadLiteral(Smi::FromInt(1))
+      .StoreAccumulatorInRegister(first)
+      .LoadLiteral(Smi::FromInt(2))
+      .StoreAccumulatorInRegister(second)
+      .LoadAccumulatorWithRegister(first)
+      .BinaryOperation(Token::Value::ADD, second, slot)
+      .Return();
+
+  Handle<BytecodeArray> bytecode_array = builder.ToBytecodeArray(isolate());
+  BytecodeLivenessOptimizer optimizer(zone(), bytecode_array,
+                                      builder.fixed_register_count(),
+                                      Register::invalid_value());
+  optimizer.Optimize();
+  EXPECT_EQ(2, bytecode_array->register_count());
+}
+
+TEST_F(BytecodeLivenessOptimizerTest, ThreadsJumpsToJumps) {
+  FeedbackVectorSpec feedback_spec(zone());
+  BytecodeArrayBuilder builder(zone(), 3, 0, &feedback_spec);
+  BytecodeLabel jump_to_jump, other, end;
+  BytecodeArrayBuilder::ToBooleanMode mode =
+      BytecodeArrayBuilder::ToBooleanMode::kAlreadyBoolean;
+
+  builder.LoadAccumulatorWithRegister(builder.Parameter(0))
+      .JumpIfTrue(mode, &jump_to_jump)
+      .LoadAccumulatorWithRegister(builder.Parameter(1))
+      .JumpIfTrue(mode, &other)
+      .LoadLiteral(Smi::FromInt(1))
+      .Return()
+      .Bind(&jump_to_jump)
+      .Jump(&end)
+      .Bind(&other)
+      .LoadLiteral(Smi::FromInt(2))
+      .Return()
+      .Bind(&end)
+      .LoadLiteral(Smi::FromInt(3))
+      .Return();
+
+  Handle<BytecodeArray> bytecode_array = builder.ToBytecodeArray(isolate());
+  BytecodeLivenessOptimizer optimizer(zone(), bytecode_array,
+                                      builder.fixed_register_count(),
+                                      Register::invalid_value());
+  optimizer.Optimize();
+
+  // Both conditional jumps now go straight to a Smi load.
+  int jumps = 0;
+  for (BytecodeArrayIterator it(bytecode_array); !it.done(); it.Advance()) {
+    if (it.current_bytecode() != Bytecode::kJumpIfTrue) continue;
+    int target = it.GetJumpTargetOffset();
+    EXPECT_EQ(Bytecode::kLdaSmi,
+              Bytecodes::FromByte(bytecode_array->get(target)));
+    jumps++;
+  }
+  EXPECT_EQ(2, jumps);
+}
+
+}  // namespace interpreter
+}  // namespace internal
+}  // namespace v8
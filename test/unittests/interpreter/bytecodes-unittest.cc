@@ -322,6 +322,28 @@ TEST(Bytecodes, IsJumpIfToBoolean) {
 #undef OR_IS_BYTECODE
 #undef IN_BYTECODE_LIST
 
+TEST(Bytecodes, IsJumpIfLookahead) {
+  EXPECT_TRUE(Bytecodes::IsJumpIfLookahead(Bytecode::kTestLessThan,
+                                           OperandScale::kSingle));
+  EXPECT_TRUE(Bytecodes::IsJumpIfLookahead(Bytecode::kTestNull,
+                                           OperandScale::kSingle));
+  EXPECT_FALSE(Bytecodes::IsJumpIfLookahead(Bytecode::kTestLessThan,
+                                            OperandScale::kDouble));
+  EXPECT_FALSE(Bytecodes::IsJumpIfLookahead(Bytecode::kTestTypeOf,
+                                            OperandScale::kSingle));
+  EXPECT_FALSE(
+      Bytecodes::IsJumpIfLookahead(Bytecode::kLdaZero, OperandScale::kSingle));
+
+  // A handler never looks ahead for both Star and conditional jumps.
+#define TEST_BYTECODE(Name, ...)                                              \
+  EXPECT_FALSE(                                                               \
+      Bytecodes::IsStarLookahead(Bytecode::k##Name, OperandScale::kSingle) && \
+      Bytecodes::IsJumpIfLookahead(Bytecode::k##Name, OperandScale::kSingle));
+
+  BYTECODE_LIST(TEST_BYTECODE)
+#undef TEST_BYTECODE
+}
+
 TEST(OperandScale, PrefixesRequired) {
   CHECK(!Bytecodes::OperandScaleRequiresPrefixBytecode(OperandScale::kSingle));
   CHECK(Bytecodes::OperandScaleRequiresPrefixBytecode(OperandScale::kDouble));